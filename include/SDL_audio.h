@@ -848,6 +848,153 @@ extern DECLSPEC void SDLCALL SDL_UnlockAudioDevice(SDL_AudioDeviceID dev);
 extern DECLSPEC void SDLCALL SDL_CloseAudio(void);
 extern DECLSPEC void SDLCALL SDL_CloseAudioDevice(SDL_AudioDeviceID dev);
 
+/* SDL_AudioMixer plays any number of voices on one audio device.
+   Each voice is fed like an SDL_AudioStream, in its own format, and has its
+   own gain and pan. The mixer sums the playing voices in float on the audio
+   device's thread. Starting, stopping and changing the gain of a voice go
+   through a lock-free queue, so they never block the device.
+ */
+/* this is opaque to the outside world. */
+struct _SDL_AudioMixer;
+typedef struct _SDL_AudioMixer SDL_AudioMixer;
+
+/**
+ *  A voice of an SDL_AudioMixer. Zero is never a valid voice, and the ID of
+ *  a removed voice isn't reused right away.
+ */
+typedef Uint32 SDL_AudioVoiceID;
+
+/**
+ *  Open an audio device for mixing voices.
+ *
+ *  This opens the device with SDL_OpenAudioDevice(), with the mixer as the
+ *  callback, so the callback and userdata in \c desired are ignored. The
+ *  device always mixes in ::AUDIO_F32SYS; SDL converts to the format the
+ *  hardware wants. Like any other device, it starts paused: call
+ *  SDL_PauseAudioDevice() on SDL_GetAudioMixerDevice() to start it.
+ *
+ *  \param device The name of the device to open, or NULL for the default
+ *  \param desired The requested rate, channels and buffer size
+ *  \param obtained Filled in with the actual device spec, may be NULL
+ *  \param allowed_changes Like SDL_OpenAudioDevice(), format changes are ignored
+ *  \param max_voices The most voices that can be added at once
+ *  \return the new mixer, or NULL on error.
+ *
+ *  \sa SDL_AddAudioMixerVoice
+ *  \sa SDL_CloseAudioMixer
+ */
+extern DECLSPEC SDL_AudioMixer * SDLCALL SDL_OpenAudioMixer(const char *device,
+                                                            const SDL_AudioSpec *desired,
+                                                            SDL_AudioSpec *obtained,
+                                                            int allowed_changes,
+                                                            int max_voices);
+
+/**
+ *  Get the audio device a mixer plays on, to pause or unpause it.
+ *
+ *  \param mixer The mixer to query
+ *  \return the device ID, or 0 on error.
+ */
+extern DECLSPEC SDL_AudioDeviceID SDLCALL SDL_GetAudioMixerDevice(SDL_AudioMixer *mixer);
+
+/**
+ *  Add a voice to a mixer. The voice starts stopped, at full gain and
+ *  centered.
+ *
+ *  \param mixer The mixer to add the voice to
+ *  \param format The format of the audio that will be queued on the voice
+ *  \param channels The number of channels of that audio
+ *  \param rate The sampling rate of that audio
+ *  \return the new voice, or 0 on error.
+ *
+ *  \sa SDL_QueueAudioMixerVoice
+ *  \sa SDL_PlayAudioMixerVoice
+ *  \sa SDL_RemoveAudioMixerVoice
+ */
+extern DECLSPEC SDL_AudioVoiceID SDLCALL SDL_AddAudioMixerVoice(SDL_AudioMixer *mixer,
+                                                                SDL_AudioFormat format,
+                                                                Uint8 channels,
+                                                                int rate);
+
+/**
+ *  Queue audio on a voice. It is converted to the device's format right
+ *  away, so the device thread only has to mix it.
+ *
+ *  \param mixer The mixer that owns the voice
+ *  \param voice The voice to queue audio on
+ *  \param data The audio, in the format the voice was added with
+ *  \param len The number of bytes of audio
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_GetAudioMixerVoiceLatency
+ */
+extern DECLSPEC int SDLCALL SDL_QueueAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice, const void *data, int len);
+
+/**
+ *  Start mixing a voice. A playing voice that runs out of queued audio
+ *  stays playing, and picks up again when more is queued.
+ *
+ *  \param mixer The mixer that owns the voice
+ *  \param voice The voice to start
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_StopAudioMixerVoice
+ */
+extern DECLSPEC int SDLCALL SDL_PlayAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice);
+
+/**
+ *  Stop mixing a voice. Its queued audio is kept, and plays from where it
+ *  stopped when the voice is started again.
+ *
+ *  \param mixer The mixer that owns the voice
+ *  \param voice The voice to stop
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_PlayAudioMixerVoice
+ */
+extern DECLSPEC int SDLCALL SDL_StopAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice);
+
+/**
+ *  Set the gain and pan of a voice.
+ *
+ *  Panning only applies to the front left and right channels; it turns the
+ *  other side down, so a centered voice plays both at full gain.
+ *
+ *  \param mixer The mixer that owns the voice
+ *  \param voice The voice to change
+ *  \param gain The linear gain, 1.0f plays the voice unchanged
+ *  \param pan From -1.0f (left only) through 0.0f (centered) to 1.0f (right only)
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioMixerVoiceGain(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice, float gain, float pan);
+
+/**
+ *  Get how long audio queued on a voice now takes to be heard: the audio
+ *  still queued on the voice plus one device buffer.
+ *
+ *  \param mixer The mixer that owns the voice
+ *  \param voice The voice to query
+ *  \return the latency in milliseconds, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioMixerVoiceLatency(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice);
+
+/**
+ *  Remove a voice from a mixer, dropping any audio still queued on it.
+ *
+ *  \param mixer The mixer that owns the voice
+ *  \param voice The voice to remove
+ */
+extern DECLSPEC void SDLCALL SDL_RemoveAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice);
+
+/**
+ *  Close a mixer's audio device, and free the mixer and all its voices.
+ *
+ *  \param mixer The mixer to close
+ *
+ *  \sa SDL_OpenAudioMixer
+ */
+extern DECLSPEC void SDLCALL SDL_CloseAudioMixer(SDL_AudioMixer *mixer);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
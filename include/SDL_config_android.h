@@ -130,6 +130,7 @@
 #define HAVE_SIGACTION 1
 #define HAVE_SETJMP 1
 #define HAVE_NANOSLEEP  1
+#define HAVE_CLOCK_NANOSLEEP    1
 #define HAVE_SYSCONF    1
 #define HAVE_CLOCK_GETTIME  1
 
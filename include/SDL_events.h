@@ -701,6 +701,23 @@ extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
  */
 extern DECLSPEC int SDLCALL SDL_PollEvent(SDL_Event * event);
 
+/**
+ *  \brief Polls for currently pending events, retrieving as many as fit.
+ *
+ *  This pumps the event loop once and then removes up to \c numevents
+ *  events from the front of the queue, which is much cheaper than calling
+ *  SDL_PollEvent() once per event when many events are pending.
+ *
+ *  \return The number of events stored in \c events, or -1 if there was
+ *          an error.
+ *
+ *  \param events    The array to store the events in.
+ *  \param numevents The maximum number of events to retrieve.
+ *
+ *  \sa SDL_PollEvent()
+ */
+extern DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event * events, int numevents);
+
 /**
  *  \brief Waits indefinitely for the next available event.
  *
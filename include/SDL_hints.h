@@ -153,6 +153,57 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling how many threads the software renderer may use.
+ *
+ *  The output is split into tiles, each draw command is binned into the tiles
+ *  it touches, and the tiles are rendered in parallel on SDL's internal worker
+ *  threads, with the calling thread helping out. Draw order within each tile
+ *  is preserved. Scaled and rotated copies and diagonal lines are still drawn
+ *  on the calling thread, between the parallel runs.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Render on the calling thread (default)
+ *    "N"        - Render tiles on up to N threads
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
+/**
+ *  \brief  A variable controlling whether the software renderer only presents what changed.
+ *
+ *  The software renderer collects the areas each frame draws to, merged into
+ *  a few rectangles, and SDL_RenderPresent() only updates those parts of the
+ *  window. Clears, resizes and exposes update the whole window. The
+ *  rectangles can be read with SDL_RenderGetDamageRects().
+ *
+ *  This is off by default, since anything else drawing to the window surface
+ *  would only be shown where the renderer drew too.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Update the whole window on every present (default)
+ *    "1"       - Only update the areas that were drawn to
+ *
+ *  This hint is checked when the renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_DAMAGE     "SDL_RENDER_SOFTWARE_DAMAGE"
+
+/**
+ *  \brief  A variable controlling whether streaming textures upload through pixel buffers.
+ *
+ *  The OpenGL and OpenGL ES 3 renderers give each streaming texture a few
+ *  pixel unpack buffers and rotate through them. SDL_LockTexture() returns
+ *  mapped buffer memory, and SDL_UpdateTexture() and SDL_UpdateYUVTexture()
+ *  copy into a buffer, so the upload to the texture runs asynchronously
+ *  instead of stalling until the GPU is done with the texture.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Upload directly from client memory
+ *    "1"       - Upload through pixel buffers when supported (default)
+ *
+ *  This hint is checked when the renderer is created.
+ */
+#define SDL_HINT_RENDER_STREAMING_BUFFERS   "SDL_RENDER_STREAMING_BUFFERS"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -1365,19 +1416,22 @@ extern "C" {
  *  If this hint isn't specified to a valid setting, or libsamplerate isn't
  *  available, SDL will use the default, internal resampling algorithm.
  *
- *  Note that this is currently only applicable to resampling audio that is
- *  being written to a device for playback or audio being read from a device
- *  for capture. SDL_AudioCVT always uses the default resampler (although this
- *  might change for SDL 2.1).
+ *  The internal resampler honors the same levels, using a longer filter at
+ *  higher quality settings. It is used by SDL_AudioCVT, and by audio streams
+ *  when libsamplerate isn't available.
  *
- *  This hint is currently only checked at audio subsystem initialization.
+ *  libsamplerate is only used for resampling audio that is being written to a
+ *  device for playback or audio being read from a device for capture, and
+ *  whether to use it is only checked at audio subsystem initialization. The
+ *  internal resampler checks this hint whenever an audio stream is created
+ *  or SDL_ConvertAudio() resamples.
  *
  *  This variable can be set to the following values:
  *
  *    "0" or "default" - Use SDL's internal resampling (Default when not set - low quality, fast)
- *    "1" or "fast"    - Use fast, slightly higher quality resampling, if available
- *    "2" or "medium"  - Use medium quality resampling, if available
- *    "3" or "best"    - Use high quality resampling, if available
+ *    "1" or "fast"    - Use fast, slightly higher quality resampling
+ *    "2" or "medium"  - Use medium quality resampling
+ *    "3" or "best"    - Use high quality resampling
  */
 #define SDL_HINT_AUDIO_RESAMPLING_MODE   "SDL_AUDIO_RESAMPLING_MODE"
 
@@ -1418,6 +1472,25 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_BATCHING  "SDL_RENDER_BATCHING"
 
+/**
+ *  \brief  A variable controlling whether batched render commands are reordered and merged.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "0"     - Send draws to the render backend in the order they were made (default)
+ *    "1"     - Reorder and merge draws to reduce state changes
+ *
+ *  When batching is enabled, SDL can look at the whole batch before it is
+ *  sent to the render backend. With this hint, a draw is moved back to join
+ *  an earlier draw with the same texture, blend mode and color if it doesn't
+ *  overlap anything drawn in between, and adjacent draws of the same kind are
+ *  merged into one. The rendered result is the same, but there are fewer
+ *  texture and color changes. Viewport changes, clip rectangle changes and
+ *  clears are never reordered. This hint is checked when the renderer is
+ *  created, and only has an effect with render backends that support it.
+ */
+#define SDL_HINT_RENDER_OPTIMIZE_BATCHES  "SDL_RENDER_OPTIMIZE_BATCHES"
+
 
 /**
  *  \brief  A variable controlling whether SDL updates joystick state when getting input events
@@ -1466,6 +1539,26 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING   "SDL_EVENT_LOGGING"
 
+/**
+ *  \brief  A variable controlling whether SDL merges redundant motion events as they are queued.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "0"     - Every motion event is queued separately (default)
+ *    "1"     - A new mouse motion, finger motion, joystick axis or game
+ *              controller axis event is merged into the most recently queued
+ *              event if that event hasn't been read yet and is of the same
+ *              type from the same device (and finger or axis). The merged
+ *              event keeps the latest position or axis value and accumulates
+ *              the relative motion.
+ *
+ *  This keeps the queue short with high polling rate devices. Event watchers
+ *  still see every event as it is pushed.
+ *
+ *  This hint can be toggled on and off at runtime.
+ */
+#define SDL_HINT_EVENT_COALESCING   "SDL_EVENT_COALESCING"
+
 
 
 /**
@@ -1587,6 +1680,27 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_STREAM_NAME "SDL_AUDIO_DEVICE_STREAM_NAME"
 
+/**
+ *  \brief Make SDL_QueueAudio() use a fixed-size ring buffer, in sample frames.
+ *
+ * By default, audio queued with SDL_QueueAudio() (or captured for
+ * SDL_DequeueAudio()) goes into a list of packets that grows as needed,
+ * and both the app and the audio thread lock the device to use it.
+ *
+ * If this is set to a number of sample frames when an audio device is
+ * opened without a callback, that device uses a ring buffer of at least
+ * that size instead. Neither side locks the device to move data through
+ * it, and nothing is allocated after the device is opened. Queueing more
+ * than there is room for fails, and captured audio that doesn't fit is
+ * dropped, so pick something comfortably larger than what you keep
+ * queued, and keep queueing whole sample frames.
+ *
+ * The ring buffer is never smaller than one device buffer.
+ *
+ * Setting this to "0" or leaving it unset uses the growing packet queue.
+ */
+#define SDL_HINT_AUDIO_QUEUE_CAPACITY "SDL_AUDIO_QUEUE_CAPACITY"
+
 /**
  *  \brief Specify the behavior of Alt+Tab while the keyboard is grabbed.
  *
@@ -1615,6 +1729,19 @@ extern "C" {
  */
 #define SDL_HINT_PREFERRED_LOCALES "SDL_PREFERRED_LOCALES"
 
+/**
+ *  \brief  A variable controlling how many threads SDL_ConvertSurface() and SDL_ConvertPixels() may use.
+ *
+ *  Large images are split into bands of rows which are converted in parallel
+ *  on SDL's internal worker threads, with the calling thread helping out.
+ *  Small images are always converted on the calling thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Convert images on the calling thread (default)
+ *    "N"        - Split large images into up to N bands converted in parallel
+ */
+#define SDL_HINT_SURFACE_CONVERSION_THREADS "SDL_SURFACE_CONVERSION_THREADS"
+
 
 /**
  *  \brief  An enumeration of hint priorities
@@ -0,0 +1,139 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_jobs_h_
+#define SDL_jobs_h_
+
+/**
+ *  \file SDL_jobs.h
+ *
+ *  Header for the SDL job system, a pool of worker threads that run short
+ *  functions ("jobs") submitted by the application.
+ *
+ *  Each worker keeps its own queue of jobs and steals from the others when
+ *  it runs out, so jobs that submit more jobs scale well. Completion is
+ *  tracked with plain SDL_atomic_t counters: every job submitted with a
+ *  counter increments it, and decrements it again when the job is done.
+ */
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+#include "SDL_atomic.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The SDL job system structure, defined in SDL_jobs.c */
+struct SDL_JobSystem;
+typedef struct SDL_JobSystem SDL_JobSystem;
+
+/**
+ *  The function run by a job, it is passed the data given when the job was submitted.
+ */
+typedef void (SDLCALL * SDL_JobFunction) (void *data);
+
+/**
+ *  Create a job system.
+ *
+ *  \param num_threads The number of worker threads to create, or 0 to
+ *                     create one less than SDL_GetCPUCount(), since the
+ *                     calling thread usually helps out in SDL_WaitJobs().
+ *
+ *  \return The new job system, or NULL if it couldn't be created.
+ */
+extern DECLSPEC SDL_JobSystem * SDLCALL SDL_CreateJobSystem(int num_threads);
+
+/**
+ *  Get the number of worker threads in a job system.
+ */
+extern DECLSPEC int SDLCALL SDL_GetJobSystemThreadCount(SDL_JobSystem * jobs);
+
+/**
+ *  Submit a job to run on one of the worker threads.
+ *
+ *  \param jobs    The job system.
+ *  \param func    The function to run.
+ *  \param data    The data to pass to the function.
+ *  \param counter If not NULL, this is incremented now and decremented once
+ *                 the job has finished, so it reaches zero when every job
+ *                 submitted with it is done.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  This function is thread-safe, and may be called from inside a job.
+ */
+extern DECLSPEC int SDLCALL SDL_SubmitJob(SDL_JobSystem * jobs,
+                                          SDL_JobFunction func, void *data,
+                                          SDL_atomic_t * counter);
+
+/**
+ *  Submit a job that doesn't start until another counter reaches zero.
+ *
+ *  \param jobs       The job system.
+ *  \param dependency The counter that has to reach zero before the job runs,
+ *                    usually the counter other jobs were submitted with.
+ *  \param func       The function to run.
+ *  \param data       The data to pass to the function.
+ *  \param counter    If not NULL, this is incremented now and decremented
+ *                    once the job has finished.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  Deferred jobs are checked when a job brings a counter to zero. If the
+ *  dependency is decremented by the application instead of by a job, the
+ *  deferred job starts on the next call to SDL_SubmitJob(),
+ *  SDL_SubmitJobAfter() or SDL_WaitJobs() on this job system.
+ *
+ *  This function is thread-safe, and may be called from inside a job.
+ */
+extern DECLSPEC int SDLCALL SDL_SubmitJobAfter(SDL_JobSystem * jobs,
+                                               SDL_atomic_t * dependency,
+                                               SDL_JobFunction func, void *data,
+                                               SDL_atomic_t * counter);
+
+/**
+ *  Wait for a counter to reach zero.
+ *
+ *  Instead of blocking, the calling thread runs queued jobs while it waits,
+ *  so this is safe to call from inside a job.
+ */
+extern DECLSPEC void SDLCALL SDL_WaitJobs(SDL_JobSystem * jobs, SDL_atomic_t * counter);
+
+/**
+ *  Destroy a job system.
+ *
+ *  This waits for all submitted jobs to finish, except for jobs whose
+ *  dependency never reached zero, which are discarded without running.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyJobSystem(SDL_JobSystem * jobs);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_jobs_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -125,6 +125,29 @@ typedef enum
     SDL_FLIP_VERTICAL = 0x00000002     /**< flip vertically */
 } SDL_RendererFlip;
 
+/**
+ *  \brief Vertex structure used by SDL_RenderGeometry()
+ */
+typedef struct SDL_Vertex
+{
+    SDL_FPoint position;        /**< Vertex position, in SDL_Renderer coordinates */
+    SDL_Color  color;           /**< Vertex color */
+    SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
+} SDL_Vertex;
+
+/**
+ *  \brief Counters of the rendering work done for one frame, see SDL_GetRenderStats()
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 flushes;             /**< Times the command queue was sent to the renderer */
+    Uint32 commands;            /**< Render commands sent, including state changes */
+    Uint32 state_changes;       /**< Viewport, clip rect, draw color and blend mode changes */
+    Uint32 texture_switches;    /**< Draws using a different texture than the draw before */
+    Uint32 draw_calls;          /**< Draw calls made by the renderer, 0 if it doesn't report them */
+    Uint64 vertex_bytes;        /**< Bytes of vertex data sent to the renderer */
+} SDL_RenderStats;
+
 /**
  *  \brief A structure representing rendering state
  */
@@ -137,6 +160,12 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ *  \brief A set of images packed into a few textures
+ */
+struct SDL_TextureAtlas;
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
 
 /* Function prototypes */
 
@@ -917,6 +946,28 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyEx(SDL_Renderer * renderer,
                                            const SDL_Point *center,
                                            const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many portions of a texture to the current rendering target.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture  The source texture.
+ *  \param srcrects An array of source rectangles, or NULL to use the entire
+ *                  texture for every copy.
+ *  \param dstrects An array of destination rectangles.
+ *  \param count    The number of copies.
+ *
+ *  This draws the same pixels as calling SDL_RenderCopy() for each pair of
+ *  rectangles, but the copies are queued as a single render command, which
+ *  most renderers draw in one go. This is much faster for many sprites from
+ *  the same texture.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatch(SDL_Renderer * renderer,
+                                                SDL_Texture * texture,
+                                                const SDL_Rect * srcrects,
+                                                const SDL_Rect * dstrects,
+                                                int count);
 
 /**
  *  \brief Draw a point on the current rendering target.
@@ -1059,6 +1110,49 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
                                             const SDL_FPoint *center,
                                             const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many portions of a texture to the current rendering target.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture  The source texture.
+ *  \param srcrects An array of source rectangles, or NULL to use the entire
+ *                  texture for every copy.
+ *  \param dstrects An array of destination rectangles.
+ *  \param count    The number of copies.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderCopyBatch()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatchF(SDL_Renderer * renderer,
+                                                 SDL_Texture * texture,
+                                                 const SDL_Rect * srcrects,
+                                                 const SDL_FRect * dstrects,
+                                                 int count);
+
+/**
+ *  \brief Render a list of triangles, optionally using a texture and indices into the vertex array.
+ *
+ *  \param renderer    The renderer which should draw the triangles.
+ *  \param texture     The texture to use, or NULL to draw with the vertex colors only.
+ *  \param vertices    The vertices.
+ *  \param num_vertices The number of vertices.
+ *  \param indices     An array of vertex indices, or NULL to draw the vertices
+ *                     in order, every three of them making a triangle.
+ *  \param num_indices The number of indices, a multiple of three.
+ *
+ *  The color of each pixel is the vertex colors interpolated across the
+ *  triangle, multiplied by the texture, if any. The texture color and alpha
+ *  modulation and blend mode apply as with SDL_RenderCopy(). Without a
+ *  texture, the renderer's draw blend mode is used.
+ *
+ *  \return 0 on success, or -1 if the operation is not supported
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGeometry(SDL_Renderer * renderer,
+                                               SDL_Texture * texture,
+                                               const SDL_Vertex * vertices, int num_vertices,
+                                               const int * indices, int num_indices);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -1125,6 +1219,136 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer * renderer);
  */
 extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get the areas of the output updated by the last SDL_RenderPresent().
+ *
+ *  \param renderer The renderer to query.
+ *  \param rects    An array filled in with the rectangles, in output pixels,
+ *                  or NULL to only get the count.
+ *  \param maxrects The number of rectangles the array can hold.
+ *
+ *  \return The number of rectangles, which may be more than maxrects, or -1
+ *          if the renderer doesn't track them.
+ *
+ *  The software renderer keeps track of what each frame draws and only
+ *  updates those parts of the window when presenting, see
+ *  ::SDL_HINT_RENDER_SOFTWARE_DAMAGE. A frame that draws nothing has no
+ *  rectangles.
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetDamageRects(SDL_Renderer * renderer,
+                                                     SDL_Rect * rects,
+                                                     int maxrects);
+
+/**
+ *  \brief Get counters of the rendering work done for the last frame.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    A pointer filled in with the counters.
+ *
+ *  The counters are collected every time the command queue is flushed, and
+ *  are reset by SDL_RenderPresent(). This returns the counters of the frame
+ *  finished by the last SDL_RenderPresent() call, or all zeros if nothing
+ *  was presented yet.
+ *
+ *  Few commands, flushes and texture switches per frame mean that drawing
+ *  is batched well.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderStats(SDL_Renderer * renderer, SDL_RenderStats * stats);
+
+
+/**
+ *  \brief Create a texture atlas, which packs many images into a few large
+ *         textures so they can be drawn without switching textures.
+ *
+ *  \param renderer The renderer.
+ *  \param format   The pixel format of the atlas textures, one of the
+ *                  packed formats in ::SDL_PixelFormatEnum.
+ *  \param w        The width of each atlas texture.
+ *  \param h        The height of each atlas texture.
+ *
+ *  \return The new atlas, or NULL on error.
+ *
+ *  The atlas creates textures of the given size as it needs them. Destroy
+ *  the atlas before the renderer.
+ *
+ *  \sa SDL_AddTextureAtlasImage()
+ *  \sa SDL_DestroyTextureAtlas()
+ */
+extern DECLSPEC SDL_TextureAtlas * SDLCALL SDL_CreateTextureAtlas(SDL_Renderer * renderer,
+                                                                  Uint32 format,
+                                                                  int w, int h);
+
+/**
+ *  \brief Add an image to a texture atlas.
+ *
+ *  \param atlas   The atlas.
+ *  \param surface The image, converted to the atlas format if needed.
+ *
+ *  \return An id for the image, or -1 on error.
+ *
+ *  The pixels are copied, and only the changed part of the atlas texture is
+ *  updated the next time an image on it is looked up with
+ *  SDL_GetTextureAtlasImage().
+ *
+ *  \sa SDL_GetTextureAtlasImage()
+ *  \sa SDL_RemoveTextureAtlasImage()
+ */
+extern DECLSPEC int SDLCALL SDL_AddTextureAtlasImage(SDL_TextureAtlas * atlas,
+                                                     SDL_Surface * surface);
+
+/**
+ *  \brief Remove an image from a texture atlas.
+ *
+ *  \param atlas The atlas.
+ *  \param id    The id returned by SDL_AddTextureAtlasImage().
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  The space is only reused once all of the images on the same texture are
+ *  gone, or after SDL_DefragmentTextureAtlas().
+ */
+extern DECLSPEC int SDLCALL SDL_RemoveTextureAtlasImage(SDL_TextureAtlas * atlas, int id);
+
+/**
+ *  \brief Get the texture and rectangle to draw an atlas image with.
+ *
+ *  \param atlas   The atlas.
+ *  \param id      The id returned by SDL_AddTextureAtlasImage().
+ *  \param texture A pointer filled in with the texture holding the image,
+ *                 may be NULL.
+ *  \param rect    A pointer filled in with the source rectangle of the image
+ *                 in the texture, may be NULL.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  The texture and rectangle are meant for SDL_RenderCopy(). They stay
+ *  valid until SDL_DefragmentTextureAtlas() moves the images around.
+ */
+extern DECLSPEC int SDLCALL SDL_GetTextureAtlasImage(SDL_TextureAtlas * atlas, int id,
+                                                     SDL_Texture ** texture,
+                                                     SDL_Rect * rect);
+
+/**
+ *  \brief Repack the images of a texture atlas to reclaim the space of
+ *         removed images.
+ *
+ *  \param atlas The atlas.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  Image ids stay the same, but the textures and rectangles returned by
+ *  SDL_GetTextureAtlasImage() before this call are no longer valid.
+ */
+extern DECLSPEC int SDLCALL SDL_DefragmentTextureAtlas(SDL_TextureAtlas * atlas);
+
+/**
+ *  \brief Destroy a texture atlas and its textures.
+ *
+ *  \sa SDL_CreateTextureAtlas()
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas);
 
 /**
  *  \brief Bind the texture to the current OpenGL/ES/ES2 context for use with
@@ -401,6 +401,9 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_DuplicateSurface(SDL_Surface * surface)
  *  semantics.  You can also pass ::SDL_RLEACCEL in the flags parameter and
  *  SDL will try to RLE accelerate colorkey and alpha blits in the resulting
  *  surface.
+ *
+ *  Large surfaces can be converted on several threads at once, see
+ *  ::SDL_HINT_SURFACE_CONVERSION_THREADS.
  */
 extern DECLSPEC SDL_Surface *SDLCALL SDL_ConvertSurface
     (SDL_Surface * src, const SDL_PixelFormat * fmt, Uint32 flags);
@@ -410,6 +413,9 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_ConvertSurfaceFormat
 /**
  * \brief Copy a block of pixels of one format to another format
  *
+ *  Large images can be converted on several threads at once, see
+ *  ::SDL_HINT_SURFACE_CONVERSION_THREADS.
+ *
  *  \return 0 on success, or -1 if there was an error
  */
 extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
@@ -70,6 +70,41 @@ extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceFrequency(void);
  */
 extern DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
 
+/**
+ * \brief Get the current time in nanoseconds, from the high resolution counter.
+ *
+ * The starting point is unspecified, so this is only useful for measuring
+ * intervals and as a deadline for SDL_DelayUntilNS().
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_GetTicksNS(void);
+
+/**
+ * \brief Wait at least a specified number of nanoseconds before returning.
+ *
+ * This sleeps with the finest granularity the platform offers, but like
+ * SDL_Delay() it may return later than requested. On platforms that only
+ * sleep in milliseconds, such as Windows and OS/2, the wait is rounded up to
+ * the next whole millisecond; use SDL_DelayUntilNS() when that matters.
+ */
+extern DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
+
+/**
+ * \brief Wait until SDL_GetTicksNS() reaches the specified value.
+ *
+ * Where the platform can sleep until an absolute time, as with
+ * clock_nanosleep() on unix, this sleeps right up to the deadline. Elsewhere
+ * it sleeps for most of the wait and then spins for the last moment. Either
+ * way it returns much closer to the deadline than SDL_Delay() or
+ * SDL_DelayNS(), which makes it suitable for frame pacing, e.g.:
+ *  Uint64 next_frame = SDL_GetTicksNS();
+ *  for ( ; ; ) {
+ *      ... render a frame
+ *      next_frame += 16666667;
+ *      SDL_DelayUntilNS(next_frame);
+ *  }
+ */
+extern DECLSPEC void SDLCALL SDL_DelayUntilNS(Uint64 ns);
+
 /**
  *  Function prototype for the timer callback function.
  *
@@ -94,6 +129,27 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
                                                  SDL_TimerCallback callback,
                                                  void *param);
 
+/**
+ *  Function prototype for the nanosecond timer callback function.
+ *
+ *  This works like SDL_TimerCallback, but the intervals are in nanoseconds.
+ */
+typedef Uint64 (SDLCALL * SDL_TimerCallbackNS) (Uint64 interval, void *param);
+
+/**
+ * \brief Add a new timer with an interval in nanoseconds.
+ *
+ * This allows intervals below a millisecond, e.g. 250000 to poll every
+ * 250 microseconds. The timer is scheduled against SDL_GetTicksNS(), and
+ * periodic timers are rescheduled from their last deadline, so they don't
+ * drift. Remove the timer with SDL_RemoveTimer().
+ *
+ * \return A timer ID, or 0 when an error occurs.
+ */
+extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval,
+                                                   SDL_TimerCallbackNS callback,
+                                                   void *param);
+
 /**
  * \brief Remove a timer knowing its ID.
  *
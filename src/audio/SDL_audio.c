@@ -560,6 +560,79 @@ SDL_RemoveAudioDevice(const int iscapture, void *handle)
 
 /* buffer queueing support... */
 
+static SDL_AudioRingBuffer *
+SDL_NewAudioRingBuffer(Uint32 minsize)
+{
+    SDL_AudioRingBuffer *ring;
+    Uint32 capacity = 1;
+
+    while (capacity < minsize) {
+        if (capacity >= 0x40000000) {
+            SDL_SetError("Audio queue capacity is too large");
+            return NULL;
+        }
+        capacity <<= 1;
+    }
+
+    ring = (SDL_AudioRingBuffer *) SDL_malloc(sizeof (*ring) + capacity);
+    if (!ring) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->mask = capacity - 1;
+    ring->data = (Uint8 *) (ring + 1);
+    SDL_AtomicSet(&ring->read, 0);
+    SDL_AtomicSet(&ring->write, 0);
+    return ring;
+}
+
+static Uint32
+SDL_CountAudioRingBuffer(SDL_AudioRingBuffer *ring)
+{
+    return (Uint32) SDL_AtomicGet(&ring->write) - (Uint32) SDL_AtomicGet(&ring->read);
+}
+
+/* Only call this from the producing side. All or nothing, so a partial
+   write never leaves the queue holding half a sample frame. */
+static int
+SDL_WriteToAudioRingBuffer(SDL_AudioRingBuffer *ring, const void *data, Uint32 len)
+{
+    const Uint32 write = (Uint32) SDL_AtomicGet(&ring->write);
+    const Uint32 used = write - (Uint32) SDL_AtomicGet(&ring->read);
+    const Uint32 pos = write & ring->mask;
+    const Uint32 cpy = SDL_min(len, ring->mask + 1 - pos);
+
+    if (len > (ring->mask + 1 - used)) {
+        return SDL_SetError("Audio queue is full");
+    }
+
+    SDL_memcpy(ring->data + pos, data, cpy);
+    SDL_memcpy(ring->data, (const Uint8 *) data + cpy, len - cpy);
+
+    /* publish after the copy; SDL_AtomicSet is a full barrier. */
+    SDL_AtomicSet(&ring->write, (int) (write + len));
+    return 0;
+}
+
+/* Only call this from the consuming side. */
+static Uint32
+SDL_ReadFromAudioRingBuffer(SDL_AudioRingBuffer *ring, void *data, Uint32 len)
+{
+    const Uint32 read = (Uint32) SDL_AtomicGet(&ring->read);
+    const Uint32 avail = (Uint32) SDL_AtomicGet(&ring->write) - read;
+    const Uint32 pos = read & ring->mask;
+    Uint32 cpy;
+
+    len = SDL_min(len, avail);
+    cpy = SDL_min(len, ring->mask + 1 - pos);
+    SDL_memcpy(data, ring->data + pos, cpy);
+    SDL_memcpy((Uint8 *) data + cpy, ring->data, len - cpy);
+
+    /* only hand the space back once we're done reading it. */
+    SDL_AtomicSet(&ring->read, (int) (read + len));
+    return len;
+}
+
 static void SDLCALL
 SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
 {
@@ -571,12 +644,16 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(!device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
-    dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    if (device->buffer_ring) {
+        dequeued = SDL_ReadFromAudioRingBuffer(device->buffer_ring, stream, (Uint32) len);
+    } else {
+        dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    }
     stream += dequeued;
     len -= (int) dequeued;
 
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
+        SDL_assert(device->buffer_ring || SDL_CountDataQueue(device->buffer_queue) == 0);
         SDL_memset(stream, device->callbackspec.silence, len);
     }
 }
@@ -593,8 +670,13 @@ SDL_BufferQueueFillCallback(void *userdata, Uint8 *stream, int len)
 
     /* note that if this needs to allocate more space and run out of memory,
        we have no choice but to quietly drop the data and hope it works out
-       later, but you probably have bigger problems in this case anyhow. */
-    SDL_WriteToDataQueue(device->buffer_queue, stream, len);
+       later, but you probably have bigger problems in this case anyhow.
+       The ring buffer does the same when the app doesn't keep up. */
+    if (device->buffer_ring) {
+        SDL_WriteToAudioRingBuffer(device->buffer_ring, stream, (Uint32) len);
+    } else {
+        SDL_WriteToDataQueue(device->buffer_queue, stream, len);
+    }
 }
 
 int
@@ -611,12 +693,17 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
         return SDL_SetError("Audio device has a callback, queueing not allowed");
     }
 
-    if (len > 0) {
-        current_audio.impl.LockDevice(device);
-        rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
-        current_audio.impl.UnlockDevice(device);
+    if (len == 0) {
+        return 0;
+    } else if (device->buffer_ring) {
+        /* the app is the only producer, no lock needed. */
+        return SDL_WriteToAudioRingBuffer(device->buffer_ring, data, len);
     }
 
+    current_audio.impl.LockDevice(device);
+    rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
+    current_audio.impl.UnlockDevice(device);
+
     return rc;
 }
 
@@ -631,6 +718,9 @@ SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
          (!device->iscapture) ||  /* playback devices can't dequeue */
          (device->callbackspec.callback != SDL_BufferQueueFillCallback) ) { /* not set for queueing */
         return 0;  /* just report zero bytes dequeued. */
+    } else if (device->buffer_ring) {
+        /* the app is the only consumer, no lock needed. */
+        return SDL_ReadFromAudioRingBuffer(device->buffer_ring, data, len);
     }
 
     current_audio.impl.LockDevice(device);
@@ -650,7 +740,9 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     }
 
     /* Nothing to do unless we're set up for queueing. */
-    if (device->callbackspec.callback == SDL_BufferQueueDrainCallback ||
+    if (device->buffer_ring) {
+        retval = SDL_CountAudioRingBuffer(device->buffer_ring);
+    } else if (device->callbackspec.callback == SDL_BufferQueueDrainCallback ||
         device->callbackspec.callback == SDL_BufferQueueFillCallback)
     {
         current_audio.impl.LockDevice(device);
@@ -673,13 +765,60 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
     /* Blank out the device and release the mutex. Free it afterwards. */
     current_audio.impl.LockDevice(device);
 
-    /* Keep up to two packets in the pool to reduce future malloc pressure. */
-    SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+    if (device->buffer_ring) {
+        /* The audio thread only touches the ring while holding the device
+           lock, so we can move its read position too. */
+        SDL_AtomicSet(&device->buffer_ring->read, SDL_AtomicGet(&device->buffer_ring->write));
+    } else {
+        /* Keep up to two packets in the pool to reduce future malloc pressure. */
+        SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+    }
 
     current_audio.impl.UnlockDevice(device);
 }
 
 
+/* Fills one device buffer when the callback wants a different buffer size
+   but nothing else needs converting. Whole callback buffers go straight into
+   the device buffer, and the part of the last one that doesn't fit waits in
+   carry_buffer for the next device buffer. */
+static void
+SDL_FillRebufferedAudio(SDL_AudioDevice *device, Uint8 *data)
+{
+    const Uint32 cblen = device->callbackspec.size;
+    Uint32 remaining = device->spec.size;
+
+    if (device->carry_len > 0) {
+        const Uint32 cpy = SDL_min(remaining, device->carry_len);
+        SDL_memcpy(data, device->carry_buffer + (cblen - device->carry_len), cpy);
+        device->carry_len -= cpy;
+        data += cpy;
+        remaining -= cpy;
+    }
+
+    /* !!! FIXME: this should be LockDevice. */
+    SDL_LockMutex(device->mixer_lock);
+    while (remaining > 0) {
+        Uint8 *dst = (remaining >= cblen) ? data : device->carry_buffer;
+
+        if (SDL_AtomicGet(&device->paused)) {
+            SDL_memset(dst, device->callbackspec.silence, cblen);
+        } else {
+            device->callbackspec.callback(device->callbackspec.userdata, dst, (int) cblen);
+        }
+
+        if (dst == device->carry_buffer) {
+            SDL_memcpy(data, dst, remaining);
+            device->carry_len = cblen - remaining;
+            remaining = 0;
+        } else {
+            data += cblen;
+            remaining -= cblen;
+        }
+    }
+    SDL_UnlockMutex(device->mixer_lock);
+}
+
 /* The general mixing thread function */
 static int SDLCALL
 SDL_RunAudio(void *devicep)
@@ -714,7 +853,7 @@ SDL_RunAudio(void *devicep)
 
         /* Fill the current buffer with sound */
         if (!device->stream && SDL_AtomicGet(&device->enabled)) {
-            SDL_assert(data_len == device->spec.size);
+            SDL_assert((data_len == device->spec.size) || device->carry_buffer);
             data = current_audio.impl.GetDeviceBuf(device);
         } else {
             /* if the device isn't enabled, we still write to the
@@ -730,14 +869,18 @@ SDL_RunAudio(void *devicep)
             data = device->work_buffer;
         }
 
-        /* !!! FIXME: this should be LockDevice. */
-        SDL_LockMutex(device->mixer_lock);
-        if (SDL_AtomicGet(&device->paused)) {
-            SDL_memset(data, device->callbackspec.silence, data_len);
+        if (device->carry_buffer && !device->stream) {
+            SDL_FillRebufferedAudio(device, data);
         } else {
-            callback(udata, data, data_len);
+            /* !!! FIXME: this should be LockDevice. */
+            SDL_LockMutex(device->mixer_lock);
+            if (SDL_AtomicGet(&device->paused)) {
+                SDL_memset(data, device->callbackspec.silence, data_len);
+            } else {
+                callback(udata, data, data_len);
+            }
+            SDL_UnlockMutex(device->mixer_lock);
         }
-        SDL_UnlockMutex(device->mixer_lock);
 
         if (device->stream) {
             /* Stream available audio to device, converting/resampling. */
@@ -1147,6 +1290,7 @@ close_audio_device(SDL_AudioDevice * device)
     }
 
     SDL_FreeDataQueue(device->buffer_queue);
+    SDL_free(device->buffer_ring);
 
     SDL_free(device);
 }
@@ -1225,6 +1369,7 @@ open_audio_device(const char *devname, int iscapture,
     SDL_AudioSpec _obtained;
     SDL_AudioDevice *device;
     SDL_bool build_stream;
+    SDL_bool rebuffer = SDL_FALSE;
     void *handle = NULL;
     int i = 0;
 
@@ -1393,6 +1538,17 @@ open_audio_device(const char *devname, int iscapture,
 
     device->callbackspec = *obtained;
 
+    /* If only the buffer size is different, playback doesn't need a stream;
+       SDL_RunAudio lets the callback write right into the device's buffers.
+       Backends that run their own callback thread still use the stream. */
+    if (build_stream && !iscapture && !current_audio.impl.ProvidesOwnCallbackThread &&
+        (obtained->freq == device->spec.freq) &&
+        (obtained->format == device->spec.format) &&
+        (obtained->channels == device->spec.channels)) {
+        build_stream = SDL_FALSE;
+        rebuffer = SDL_TRUE;
+    }
+
     if (build_stream) {
         if (iscapture) {
             device->stream = SDL_NewAudioStream(device->spec.format,
@@ -1411,30 +1567,49 @@ open_audio_device(const char *devname, int iscapture,
     }
 
     if (device->spec.callback == NULL) {  /* use buffer queueing? */
-        /* pool a few packets to start. Enough for two callbacks. */
-        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
-        if (!device->buffer_queue) {
-            close_audio_device(device);
-            SDL_SetError("Couldn't create audio buffer queue");
-            return 0;
+        const char *hint = SDL_GetHint(SDL_HINT_AUDIO_QUEUE_CAPACITY);
+        const int frames = hint ? SDL_atoi(hint) : 0;
+
+        if (frames > 0) {
+            const Uint32 framesize = (SDL_AUDIO_BITSIZE(obtained->format) / 8) * obtained->channels;
+            const Uint32 maxframes = 0x40000000 / framesize;
+            device->buffer_ring = SDL_NewAudioRingBuffer(SDL_max(SDL_min((Uint32) frames, maxframes) * framesize, obtained->size));
+            if (!device->buffer_ring) {
+                close_audio_device(device);
+                return 0;
+            }
+        } else {
+            /* pool a few packets to start. Enough for two callbacks. */
+            device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
+            if (!device->buffer_queue) {
+                close_audio_device(device);
+                SDL_SetError("Couldn't create audio buffer queue");
+                return 0;
+            }
         }
         device->callbackspec.callback = iscapture ? SDL_BufferQueueFillCallback : SDL_BufferQueueDrainCallback;
         device->callbackspec.userdata = device;
     }
 
-    /* Allocate a scratch audio buffer */
-    device->work_buffer_len = build_stream ? device->callbackspec.size : 0;
+    /* Allocate a scratch audio buffer. It has to hold a whole callback
+       buffer whenever the callback's size differs from the device's, even
+       when rebuffering, since a backend might switch to a stream later. */
+    device->work_buffer_len = (build_stream || rebuffer) ? device->callbackspec.size : 0;
     if (device->spec.size > device->work_buffer_len) {
         device->work_buffer_len = device->spec.size;
     }
     SDL_assert(device->work_buffer_len > 0);
 
-    device->work_buffer = (Uint8 *) SDL_malloc(device->work_buffer_len);
+    /* the carry buffer for rebuffering lives right after the work buffer. */
+    device->work_buffer = (Uint8 *) SDL_malloc(device->work_buffer_len + (rebuffer ? device->callbackspec.size : 0));
     if (device->work_buffer == NULL) {
         close_audio_device(device);
         SDL_OutOfMemory();
         return 0;
     }
+    if (rebuffer) {
+        device->carry_buffer = device->work_buffer + device->work_buffer_len;
+    }
 
     open_devices[id] = device;  /* add it to our list of open devices. */
 
@@ -34,6 +34,19 @@
 #define LOG_DEBUG_CONVERT(from, to)
 #endif
 
+/* Audio code for instruction sets beyond what the compiler targets by
+   default is built with per-function target attributes, and only gets used
+   when SDL_cpuinfo says the CPU supports it. */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))) && \
+    defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#define SDL_AUDIO_TARGETING(x) __attribute__((target(x)))
+#define HAVE_AVX2_AUDIO 1
+#elif (defined(_M_IX86) || defined(_M_X64)) && defined(_MSC_VER) && (_MSC_VER >= 1800) && !defined(__clang__)
+#define SDL_AUDIO_TARGETING(x)
+#define HAVE_AVX2_AUDIO 1
+#endif
+
 /* Functions and variables exported from SDL_audio.c for SDL_sysaudio.c */
 
 #ifdef HAVE_LIBSAMPLERATE_H
@@ -70,9 +83,8 @@ extern SDL_AudioFilter SDL_Convert_F32_to_S16;
 extern SDL_AudioFilter SDL_Convert_F32_to_U16;
 extern SDL_AudioFilter SDL_Convert_F32_to_S32;
 
-/* You need to call SDL_PrepareResampleFilter() before using the internal resampler.
-   SDL_AudioQuit() calls SDL_FreeResamplerFilter(), you should never call it yourself. */
-extern int SDL_PrepareResampleFilter(void);
+/* The internal resampler builds its filters on first use.
+   SDL_AudioQuit() calls SDL_FreeResampleFilter(), you should never call it yourself. */
 extern void SDL_FreeResampleFilter(void);
 
 #endif /* SDL_audio_c_h_ */
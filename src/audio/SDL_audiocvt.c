@@ -39,6 +39,18 @@
 #define HAVE_SSE3_INTRINSICS 1
 #endif
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+#if HAVE_AVX2_AUDIO && HAVE_SSE2_INTRINSICS
+#define HAVE_AVX2_RESAMPLER 1
+#endif
+
 #if HAVE_SSE3_INTRINSICS
 /* Convert from stereo to mono. Average left and right. */
 static void SDLCALL
@@ -374,165 +386,601 @@ SDL_Convert51To71(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 /* SDL's resampler uses a "bandlimited interpolation" algorithm:
-     https://ccrma.stanford.edu/~jos/resample/ */
+     https://ccrma.stanford.edu/~jos/resample/
+
+   It's implemented as a polyphase FIR filter. The windowed sinc is sampled
+   for every fractional position an output frame can fall on between two
+   input frames (a "phase"), once per stream or conversion, and the input is
+   stepped through with exact integer math, so no error builds up over time.
+   If the rates need more phases than RESAMPLER_MAX_PHASES, the two nearest
+   phases are blended. */
+
+#define RESAMPLER_SAMPLES_PER_ZERO_CROSSING 512
+#define RESAMPLER_MAX_PHASES 512
+#define RESAMPLER_QUALITY_LEVELS 4
+
+/* Zero crossings on each side of the filter, and the stopband attenuation of
+   its window, for each SDL_HINT_AUDIO_RESAMPLING_MODE. More zero crossings
+   mean a sharper cutoff and more taps per output sample. */
+static const struct
+{
+    int zero_crossings;
+    double dB;
+} ResamplerQuality[RESAMPLER_QUALITY_LEVELS] = {
+    { 5, 80.0 },    /* "default" */
+    { 8, 80.0 },    /* "fast" */
+    { 16, 100.0 },  /* "medium" */
+    { 32, 120.0 }   /* "best" */
+};
 
-#define RESAMPLER_ZERO_CROSSINGS 5
-#define RESAMPLER_BITS_PER_SAMPLE 16
-#define RESAMPLER_SAMPLES_PER_ZERO_CROSSING  (1 << ((RESAMPLER_BITS_PER_SAMPLE / 2) + 1))
-#define RESAMPLER_FILTER_SIZE ((RESAMPLER_SAMPLES_PER_ZERO_CROSSING * RESAMPLER_ZERO_CROSSINGS) + 1)
+typedef void (*SDL_ResampleFrameFunc)(const float *in, const float *coefs, const int taps, const int chans, float *out);
+
+typedef struct SDL_ResampleFilter
+{
+    int inrate;                 /* divided by their greatest common divisor */
+    int outrate;
+    int taps;                   /* input frames read per output frame, a multiple of 4 */
+    int left;                   /* how many of those come before the current input frame */
+    int phases;
+    SDL_bool interpolate;       /* there are fewer phases than outrate */
+    float *table;               /* phases + 1 rows of taps coefficients, 16-byte aligned */
+    float *coefs;               /* the blended row, if interpolate is set */
+    SDL_ResampleFrameFunc resample_frame;
+    void *allocation;
+} SDL_ResampleFilter;
 
 /* This is a "modified" bessel function, so you can't use POSIX j0() */
 static double
 bessel(const double x)
 {
-    const double xdiv2 = x / 2.0;
-    double i0 = 1.0f;
-    double f = 1.0f;
+    const double xdiv2sq = (x / 2.0) * (x / 2.0);
+    double i0 = 1.0;
+    double term = 1.0;
     int i = 1;
 
-    while (SDL_TRUE) {
-        const double diff = SDL_pow(xdiv2, i * 2) / SDL_pow(f, 2);
-        if (diff < 1.0e-21f) {
-            break;
-        }
-        i0 += diff;
+    do {
+        term *= xdiv2sq / ((double) i * i);
+        i0 += term;
         i++;
-        f *= (double) i;
-    }
+    } while (term > 1.0e-21 * i0);
 
     return i0;
 }
 
-/* build kaiser table with cardinal sine applied to it, and array of differences between elements. */
+/* build the right half of a kaiser windowed sinc, tablelen - 1 samples per zero crossing. */
 static void
-kaiser_and_sinc(float *table, float *diffs, const int tablelen, const double beta)
+kaiser_and_sinc(float *table, const int tablelen, const double beta)
 {
     const int lenm1 = tablelen - 1;
-    const int lenm1div2 = lenm1 / 2;
+    const double bessel_beta = bessel(beta);
     int i;
 
     table[0] = 1.0f;
     for (i = 1; i < tablelen; i++) {
-        const double kaiser = bessel(beta * SDL_sqrt(1.0 - SDL_pow(((i - lenm1) / 2.0) / lenm1div2, 2.0))) / bessel(beta);
-        table[tablelen - i] = (float) kaiser;
+        const double w = ((double) i) / ((double) lenm1);
+        const double kaiser = bessel(beta * SDL_sqrt(1.0 - (w * w))) / bessel_beta;
+        const double x = (((double) i) / ((double) RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) * M_PI;
+        table[i] = (float) (kaiser * SDL_sin(x) / x);
     }
-
-    for (i = 1; i < tablelen; i++) {
-        const float x = (((float) i) / ((float) RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) * ((float) M_PI);
-        table[i] *= SDL_sinf(x) / x;
-        diffs[i - 1] = table[i] - table[i - 1];
-    }
-    diffs[lenm1] = 0.0f;
 }
 
 
 static SDL_SpinLock ResampleFilterSpinlock = 0;
-static float *ResamplerFilter = NULL;
-static float *ResamplerFilterDifference = NULL;
+static float *ResamplerFilter[RESAMPLER_QUALITY_LEVELS];
 
-int
-SDL_PrepareResampleFilter(void)
+/* SDL_ConvertAudio() keeps no state between calls, so it keeps the phase
+   tables it built for the last few rate pairs here, most recent first. An
+   entry is taken out while it's in use, since its filter and scratch buffer
+   can't be shared, and a second caller with the same rates builds another. */
+#define RESAMPLER_CACHE_SIZE 4
+
+/* Scratch buffers bigger than this are freed after use instead of cached */
+#define RESAMPLER_CACHE_MAX_WORK (256 * 1024)
+
+typedef struct
+{
+    int inrate;
+    int outrate;
+    int quality;
+    SDL_ResampleFilter *filter;
+    float *work;
+    size_t worklen;
+} SDL_ResampleCacheEntry;
+
+static SDL_ResampleCacheEntry ResampleCache[RESAMPLER_CACHE_SIZE];
+
+static void SDL_DestroyResampleFilter(SDL_ResampleFilter *filter);
+
+/* The finely sampled filter that the phase tables of a quality level are built from. */
+static const float *
+SDL_PrepareResampleFilter(const int quality)
 {
+    float *filter;
+
     SDL_AtomicLock(&ResampleFilterSpinlock);
-    if (!ResamplerFilter) {
+    filter = ResamplerFilter[quality];
+    if (!filter) {
         /* if dB > 50, beta=(0.1102 * (dB - 8.7)), according to Matlab. */
-        const double dB = 80.0;
-        const double beta = 0.1102 * (dB - 8.7);
-        const size_t alloclen = RESAMPLER_FILTER_SIZE * sizeof (float);
+        const double beta = 0.1102 * (ResamplerQuality[quality].dB - 8.7);
+        const int filterlen = (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * ResamplerQuality[quality].zero_crossings) + 1;
 
-        ResamplerFilter = (float *) SDL_malloc(alloclen);
-        if (!ResamplerFilter) {
-            SDL_AtomicUnlock(&ResampleFilterSpinlock);
-            return SDL_OutOfMemory();
+        filter = (float *) SDL_malloc(filterlen * sizeof (float));
+        if (filter) {
+            kaiser_and_sinc(filter, filterlen, beta);
+            ResamplerFilter[quality] = filter;
         }
-
-        ResamplerFilterDifference = (float *) SDL_malloc(alloclen);
-        if (!ResamplerFilterDifference) {
-            SDL_free(ResamplerFilter);
-            ResamplerFilter = NULL;
-            SDL_AtomicUnlock(&ResampleFilterSpinlock);
-            return SDL_OutOfMemory();
-        }
-        kaiser_and_sinc(ResamplerFilter, ResamplerFilterDifference, RESAMPLER_FILTER_SIZE, beta);
     }
     SDL_AtomicUnlock(&ResampleFilterSpinlock);
-    return 0;
+
+    if (!filter) {
+        SDL_OutOfMemory();
+    }
+    return filter;
 }
 
 void
 SDL_FreeResampleFilter(void)
 {
-    SDL_free(ResamplerFilter);
-    SDL_free(ResamplerFilterDifference);
-    ResamplerFilter = NULL;
-    ResamplerFilterDifference = NULL;
+    int i;
+    for (i = 0; i < RESAMPLER_QUALITY_LEVELS; i++) {
+        SDL_free(ResamplerFilter[i]);
+        ResamplerFilter[i] = NULL;
+    }
+    for (i = 0; i < RESAMPLER_CACHE_SIZE; i++) {
+        SDL_DestroyResampleFilter(ResampleCache[i].filter);
+        SDL_free(ResampleCache[i].work);
+        SDL_zero(ResampleCache[i]);
+    }
 }
 
 static int
-ResamplerPadding(const int inrate, const int outrate)
+GetResamplerQuality(void)
 {
-    if (inrate == outrate) {
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
+
+    if (!hint) {
         return 0;
-    } else if (inrate > outrate) {
-        return (int) SDL_ceil(((float) (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * inrate) / ((float) outrate)));
+    } else if (*hint == '1' || SDL_strcasecmp(hint, "fast") == 0) {
+        return 1;
+    } else if (*hint == '2' || SDL_strcasecmp(hint, "medium") == 0) {
+        return 2;
+    } else if (*hint == '3' || SDL_strcasecmp(hint, "best") == 0) {
+        return 3;
+    }
+    return 0;
+}
+
+
+/* Each of these computes one output frame: for every channel, the dot
+   product of coefs with taps consecutive input frames starting at in. The
+   _Channels helpers do count channels of frames that are stride floats apart. */
+
+static void
+SDL_ResampleChannels_Scalar(const float *in, const float *coefs, const int taps, const int stride, const int count, float *out)
+{
+    int chan, i;
+
+    for (chan = 0; chan < count; chan++) {
+        const float *src = in + chan;
+        float sample = 0.0f;
+        for (i = 0; i < taps; i++, src += stride) {
+            sample += coefs[i] * *src;
+        }
+        out[chan] = sample;
+    }
+}
+
+static void
+SDL_ResampleFrame_Scalar(const float *in, const float *coefs, const int taps, const int chans, float *out)
+{
+    SDL_ResampleChannels_Scalar(in, coefs, taps, chans, chans, out);
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+SDL_ResampleChannels_SSE2(const float *in, const float *coefs, const int taps, const int stride, const int count, float *out)
+{
+    int chan = 0;
+    int i;
+
+    /* Four channels at a time, each lane adds up one channel */
+    for (; chan + 8 <= count; chan += 8) {
+        const float *src = in + chan;
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        for (i = 0; i < taps; i++, src += stride) {
+            const __m128 c = _mm_set1_ps(coefs[i]);
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(c, _mm_loadu_ps(src)));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(c, _mm_loadu_ps(src + 4)));
+        }
+        _mm_storeu_ps(out + chan, sum0);
+        _mm_storeu_ps(out + chan + 4, sum1);
+    }
+    for (; chan + 4 <= count; chan += 4) {
+        const float *src = in + chan;
+        __m128 sum = _mm_setzero_ps();
+        for (i = 0; i < taps; i++, src += stride) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(coefs[i]), _mm_loadu_ps(src)));
+        }
+        _mm_storeu_ps(out + chan, sum);
+    }
+    if (chan < count) {
+        SDL_ResampleChannels_Scalar(in + chan, coefs, taps, stride, count - chan, out + chan);
     }
-    return RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
 }
 
-/* lpadding and rpadding are expected to be buffers of (ResamplePadding(inrate, outrate) * chans * sizeof (float)) bytes. */
+static void
+SDL_ResampleFrame_SSE2(const float *in, const float *coefs, const int taps, const int chans, float *out)
+{
+    int i;
+
+    if (chans == 1) {
+        __m128 sum = _mm_setzero_ps();
+        for (i = 0; i < taps; i += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(coefs + i), _mm_loadu_ps(in + i)));
+        }
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_store_ss(out, sum);
+    } else if (chans == 2) {
+        /* Interleaved, so every coefficient is used twice in a row */
+        __m128 sum = _mm_setzero_ps();
+        for (i = 0; i < taps; i += 4) {
+            const __m128 c = _mm_load_ps(coefs + i);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_unpacklo_ps(c, c), _mm_loadu_ps(in + (i * 2))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_unpackhi_ps(c, c), _mm_loadu_ps(in + (i * 2) + 4)));
+        }
+        _mm_storel_pi((__m64 *) out, _mm_add_ps(sum, _mm_movehl_ps(sum, sum)));
+    } else {
+        SDL_ResampleChannels_SSE2(in, coefs, taps, chans, chans, out);
+    }
+}
+#endif
+
+#if HAVE_AVX2_RESAMPLER
+static void SDL_AUDIO_TARGETING("avx2")
+SDL_ResampleFrame_AVX2(const float *in, const float *coefs, const int taps, const int chans, float *out)
+{
+    int chan = 0;
+    int i;
+
+    if (chans == 1) {
+        __m256 sum = _mm256_setzero_ps();
+        __m128 sum128;
+        for (i = 0; i + 8 <= taps; i += 8) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(coefs + i), _mm256_loadu_ps(in + i)));
+        }
+        sum128 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        if (i < taps) {
+            sum128 = _mm_add_ps(sum128, _mm_mul_ps(_mm_load_ps(coefs + i), _mm_loadu_ps(in + i)));
+        }
+        sum128 = _mm_add_ps(sum128, _mm_movehl_ps(sum128, sum128));
+        sum128 = _mm_add_ss(sum128, _mm_shuffle_ps(sum128, sum128, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_store_ss(out, sum128);
+        return;
+    } else if (chans < 8) {
+        SDL_ResampleFrame_SSE2(in, coefs, taps, chans, out);
+        return;
+    }
+
+    /* Eight channels at a time, each lane adds up one channel */
+    for (; chan + 16 <= chans; chan += 16) {
+        const float *src = in + chan;
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        for (i = 0; i < taps; i++, src += chans) {
+            const __m256 c = _mm256_broadcast_ss(coefs + i);
+            sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(c, _mm256_loadu_ps(src)));
+            sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(c, _mm256_loadu_ps(src + 8)));
+        }
+        _mm256_storeu_ps(out + chan, sum0);
+        _mm256_storeu_ps(out + chan + 8, sum1);
+    }
+    for (; chan + 8 <= chans; chan += 8) {
+        const float *src = in + chan;
+        __m256 sum = _mm256_setzero_ps();
+        for (i = 0; i < taps; i++, src += chans) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_broadcast_ss(coefs + i), _mm256_loadu_ps(src)));
+        }
+        _mm256_storeu_ps(out + chan, sum);
+    }
+    if (chan < chans) {
+        SDL_ResampleChannels_SSE2(in + chan, coefs, taps, chans, chans - chan, out + chan);
+    }
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+SDL_ResampleChannels_NEON(const float *in, const float *coefs, const int taps, const int stride, const int count, float *out)
+{
+    int chan = 0;
+    int i;
+
+    /* Four channels at a time, each lane adds up one channel */
+    for (; chan + 8 <= count; chan += 8) {
+        const float *src = in + chan;
+        float32x4_t sum0 = vdupq_n_f32(0.0f);
+        float32x4_t sum1 = vdupq_n_f32(0.0f);
+        for (i = 0; i < taps; i++, src += stride) {
+            sum0 = vmlaq_n_f32(sum0, vld1q_f32(src), coefs[i]);
+            sum1 = vmlaq_n_f32(sum1, vld1q_f32(src + 4), coefs[i]);
+        }
+        vst1q_f32(out + chan, sum0);
+        vst1q_f32(out + chan + 4, sum1);
+    }
+    for (; chan + 4 <= count; chan += 4) {
+        const float *src = in + chan;
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (i = 0; i < taps; i++, src += stride) {
+            sum = vmlaq_n_f32(sum, vld1q_f32(src), coefs[i]);
+        }
+        vst1q_f32(out + chan, sum);
+    }
+    if (chan < count) {
+        SDL_ResampleChannels_Scalar(in + chan, coefs, taps, stride, count - chan, out + chan);
+    }
+}
+
+static void
+SDL_ResampleFrame_NEON(const float *in, const float *coefs, const int taps, const int chans, float *out)
+{
+    int i;
+
+    if (chans == 1) {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        float32x2_t sum2;
+        for (i = 0; i < taps; i += 4) {
+            sum = vmlaq_f32(sum, vld1q_f32(coefs + i), vld1q_f32(in + i));
+        }
+        sum2 = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+        out[0] = vget_lane_f32(vpadd_f32(sum2, sum2), 0);
+    } else if (chans == 2) {
+        /* Interleaved, so every coefficient is used twice in a row */
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (i = 0; i < taps; i += 4) {
+            const float32x4x2_t c = vzipq_f32(vld1q_f32(coefs + i), vld1q_f32(coefs + i));
+            sum = vmlaq_f32(sum, c.val[0], vld1q_f32(in + (i * 2)));
+            sum = vmlaq_f32(sum, c.val[1], vld1q_f32(in + (i * 2) + 4));
+        }
+        vst1_f32(out, vadd_f32(vget_low_f32(sum), vget_high_f32(sum)));
+    } else {
+        SDL_ResampleChannels_NEON(in, coefs, taps, chans, chans, out);
+    }
+}
+#endif
+
+/* How many input frames on each side of an output frame the filter needs.
+   When downsampling, the filter has to cut off below the new Nyquist
+   frequency, which makes it wider. */
 static int
-SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
-                        const float *lpadding, const float *rpadding,
-                        const float *inbuf, const int inbuflen,
-                        float *outbuf, const int outbuflen)
+ResamplerHalfTaps(const int inrate, const int outrate, const int quality)
 {
-    const double finrate = (double) inrate;
-    const double outtimeincr = 1.0 / ((float) outrate);
-    const double  ratio = ((float) outrate) / ((float) inrate);
-    const int paddinglen = ResamplerPadding(inrate, outrate);
-    const int framelen = chans * (int)sizeof (float);
-    const int inframes = inbuflen / framelen;
-    const int wantedoutframes = (int) ((inbuflen / framelen) * ratio);  /* outbuflen isn't total to write, it's total available. */
-    const int maxoutframes = outbuflen / framelen;
-    const int outframes = SDL_min(wantedoutframes, maxoutframes);
-    float *dst = outbuf;
-    double outtime = 0.0;
-    int i, j, chan;
-
-    for (i = 0; i < outframes; i++) {
-        const int srcindex = (int) (outtime * inrate);
-        const double intime = ((double) srcindex) / finrate;
-        const double innexttime = ((double) (srcindex + 1)) / finrate;
-        const double interpolation1 = 1.0 - ((innexttime - outtime) / (innexttime - intime));
-        const int filterindex1 = (int) (interpolation1 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
-        const double interpolation2 = 1.0 - interpolation1;
-        const int filterindex2 = (int) (interpolation2 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
-
-        for (chan = 0; chan < chans; chan++) {
-            float outsample = 0.0f;
-
-            /* do this twice to calculate the sample, once for the "left wing" and then same for the right. */
-            /* !!! FIXME: do both wings in one loop */
-            for (j = 0; (filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
-                const int srcframe = srcindex - j;
-                /* !!! FIXME: we can bubble this conditional out of here by doing a pre loop. */
-                const float insample = (srcframe < 0) ? lpadding[((paddinglen + srcframe) * chans) + chan] : inbuf[(srcframe * chans) + chan];
-                outsample += (float)(insample * (ResamplerFilter[filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)] + (interpolation1 * ResamplerFilterDifference[filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)])));
+    const int zero_crossings = ResamplerQuality[quality].zero_crossings;
+    if (inrate > outrate) {
+        return (int) SDL_ceil(((double) zero_crossings * inrate) / ((double) outrate));
+    }
+    return zero_crossings;
+}
+
+/* How many input frames the filter reads past either end of the frames it resamples */
+static int
+ResamplerPadding(const int inrate, const int outrate, const int quality)
+{
+    const int half = ResamplerHalfTaps(inrate, outrate, quality);
+    return (((half * 2) + 3) & ~3) - half;
+}
+
+/* Builds the phase table for resampling inrate to outrate, NULL on error. */
+static SDL_ResampleFilter *
+SDL_CreateResampleFilter(const int inrate, const int outrate, const int quality)
+{
+    const float *prototype = SDL_PrepareResampleFilter(quality);
+    const int zero_crossings = ResamplerQuality[quality].zero_crossings;
+    SDL_ResampleFilter *filter;
+    double cutoff;
+    int a, b, half, row, i;
+    size_t tablelen;
+    Uint8 *ptr;
+
+    if (!prototype) {
+        return NULL;
+    }
+
+    /* Reduce the ratio, so 44100->48000 steps 147/160 of a frame with 160 phases. */
+    a = inrate;
+    b = outrate;
+    while (b) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    filter = (SDL_ResampleFilter *) SDL_calloc(1, sizeof (*filter));
+    if (!filter) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    filter->inrate = inrate / a;
+    filter->outrate = outrate / a;
+    filter->interpolate = (filter->outrate > RESAMPLER_MAX_PHASES) ? SDL_TRUE : SDL_FALSE;
+    filter->phases = filter->interpolate ? RESAMPLER_MAX_PHASES : filter->outrate;
+
+    cutoff = (inrate > outrate) ? ((double) outrate / (double) inrate) : 1.0;
+    half = ResamplerHalfTaps(inrate, outrate, quality);
+    filter->left = half - 1;
+    filter->taps = ((half * 2) + 3) & ~3;
+
+    /* One more row than phases, the last one is only used for blending */
+    tablelen = (size_t) (filter->phases + 1) * filter->taps;
+    filter->allocation = SDL_malloc(((tablelen + filter->taps) * sizeof (float)) + 15);
+    if (!filter->allocation) {
+        SDL_free(filter);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ptr = (Uint8 *) filter->allocation;
+    ptr += (16 - (((size_t) ptr) & 15)) & 15;
+    filter->table = (float *) ptr;
+    filter->coefs = filter->table + tablelen;
+
+    for (row = 0; row <= filter->phases; row++) {
+        const double frac = ((double) row) / ((double) filter->phases);
+        float *coefs = filter->table + (row * filter->taps);
+        double sum = 0.0;
+
+        for (i = 0; i < filter->taps; i++) {
+            /* distance of this tap from the output frame, in zero crossings */
+            const double x = SDL_fabs((i - filter->left) - frac) * cutoff;
+            const double pos = x * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+            const int idx = (int) pos;
+            double coef = 0.0;
+
+            if (x < zero_crossings) {
+                const double t = pos - idx;
+                coef = prototype[idx] + ((prototype[idx + 1] - prototype[idx]) * t);
             }
+            coefs[i] = (float) coef;
+            sum += coef;
+        }
 
-            for (j = 0; (filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
-                const int srcframe = srcindex + 1 + j;
-                /* !!! FIXME: we can bubble this conditional out of here by doing a post loop. */
-                const float insample = (srcframe >= inframes) ? rpadding[((srcframe - inframes) * chans) + chan] : inbuf[(srcframe * chans) + chan];
-                outsample += (float)(insample * (ResamplerFilter[filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)] + (interpolation2 * ResamplerFilterDifference[filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)])));
+        /* Normalize every phase, so the gain doesn't wobble between them */
+        if (sum != 0.0) {
+            for (i = 0; i < filter->taps; i++) {
+                coefs[i] = (float) (coefs[i] / sum);
             }
-            *(dst++) = outsample;
         }
+    }
 
-        outtime += outtimeincr;
+#if HAVE_AVX2_RESAMPLER
+    if (SDL_HasAVX2()) {
+        filter->resample_frame = SDL_ResampleFrame_AVX2;
+    } else
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        filter->resample_frame = SDL_ResampleFrame_SSE2;
+    } else
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        filter->resample_frame = SDL_ResampleFrame_NEON;
+    } else
+#endif
+    {
+        filter->resample_frame = SDL_ResampleFrame_Scalar;
     }
 
-    return outframes * chans * sizeof (float);
+    return filter;
+}
+
+static void
+SDL_DestroyResampleFilter(SDL_ResampleFilter *filter)
+{
+    if (filter) {
+        SDL_free(filter->allocation);
+        SDL_free(filter);
+    }
+}
+
+/* Takes the cached filter for these rates out of the cache, or builds one. */
+static SDL_bool
+SDL_TakeCachedResampler(const int inrate, const int outrate, const int quality, SDL_ResampleCacheEntry *entry)
+{
+    int i;
+
+    SDL_AtomicLock(&ResampleFilterSpinlock);
+    for (i = 0; i < RESAMPLER_CACHE_SIZE; i++) {
+        if (ResampleCache[i].filter && (ResampleCache[i].inrate == inrate) &&
+            (ResampleCache[i].outrate == outrate) && (ResampleCache[i].quality == quality)) {
+            *entry = ResampleCache[i];
+            SDL_memmove(&ResampleCache[i], &ResampleCache[i + 1], (RESAMPLER_CACHE_SIZE - 1 - i) * sizeof (*entry));
+            SDL_zero(ResampleCache[RESAMPLER_CACHE_SIZE - 1]);
+            SDL_AtomicUnlock(&ResampleFilterSpinlock);
+            return SDL_TRUE;
+        }
+    }
+    SDL_AtomicUnlock(&ResampleFilterSpinlock);
+
+    SDL_zerop(entry);
+    entry->inrate = inrate;
+    entry->outrate = outrate;
+    entry->quality = quality;
+    entry->filter = SDL_CreateResampleFilter(inrate, outrate, quality);
+    return entry->filter ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Puts a filter back at the front of the cache, dropping the oldest one. */
+static void
+SDL_ReturnCachedResampler(SDL_ResampleCacheEntry *entry)
+{
+    SDL_ResampleCacheEntry evicted;
+
+    if (entry->worklen > RESAMPLER_CACHE_MAX_WORK) {
+        SDL_free(entry->work);
+        entry->work = NULL;
+        entry->worklen = 0;
+    }
+
+    SDL_AtomicLock(&ResampleFilterSpinlock);
+    evicted = ResampleCache[RESAMPLER_CACHE_SIZE - 1];
+    SDL_memmove(&ResampleCache[1], &ResampleCache[0], (RESAMPLER_CACHE_SIZE - 1) * sizeof (*entry));
+    ResampleCache[0] = *entry;
+    SDL_AtomicUnlock(&ResampleFilterSpinlock);
+
+    SDL_DestroyResampleFilter(evicted.filter);
+    SDL_free(evicted.work);
+}
+
+/* Resamples inframes frames of inbuf, which must have ResamplerPadding() valid frames before and after them.
+   *position is the input frame the next output frame starts at, and *phase how far past that frame it is, in
+   units of 1/outrate. Both carry over from one call to the next. Returns the number of frames written. */
+static int
+SDL_ResampleAudio(SDL_ResampleFilter *filter, const int chans,
+                  const float *inbuf, const int inframes,
+                  float *outbuf, const int maxoutframes,
+                  int *position, int *phase)
+{
+    const int taps = filter->taps;
+    const int outrate = filter->outrate;
+    const int step = filter->inrate / outrate;
+    const int phasestep = filter->inrate % outrate;
+    int pos = *position;
+    int num = *phase;
+    int outframes = 0;
+    int i;
+
+    while ((pos < inframes) && (outframes < maxoutframes)) {
+        const float *coefs;
+
+        if (filter->interpolate) {
+            const Sint64 x = ((Sint64) num) * filter->phases;
+            const float *row0 = filter->table + ((int) (x / outrate) * taps);
+            const float *row1 = row0 + taps;
+            const float t = ((float) (x % outrate)) / ((float) outrate);
+            for (i = 0; i < taps; i++) {
+                filter->coefs[i] = row0[i] + ((row1[i] - row0[i]) * t);
+            }
+            coefs = filter->coefs;
+        } else {
+            coefs = filter->table + (num * taps);
+        }
+
+        filter->resample_frame(inbuf + ((pos - filter->left) * chans), coefs, taps, chans, outbuf);
+        outbuf += chans;
+        outframes++;
+
+        pos += step;
+        num += phasestep;
+        if (num >= outrate) {
+            num -= outrate;
+            pos++;
+        }
+    }
+
+    *position = pos;
+    *phase = num;
+    return outframes;
 }
 
 int
@@ -710,36 +1158,72 @@ SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioFormat format
        !!! FIXME in 2.1:   so we steal the ninth and tenth slot.  :( */
     const int inrate = (int) (size_t) cvt->filters[SDL_AUDIOCVT_MAX_FILTERS-1];
     const int outrate = (int) (size_t) cvt->filters[SDL_AUDIOCVT_MAX_FILTERS];
-    const float *src = (const float *) cvt->buf;
-    const int srclen = cvt->len_cvt;
-    /*float *dst = (float *) cvt->buf;
-    const int dstlen = (cvt->len * cvt->len_mult);*/
-    /* !!! FIXME: remove this if we can get the resampler to work in-place again. */
-    float *dst = (float *) (cvt->buf + srclen);
-    const int dstlen = (cvt->len * cvt->len_mult) - srclen;
-    const int requestedpadding = ResamplerPadding(inrate, outrate);
-    int paddingsamples;
-    float *padding;
-
-    if (requestedpadding < SDL_MAX_SINT32 / chans) {
-        paddingsamples = requestedpadding * chans;
-    } else {
-        paddingsamples = 0;
-    }
+    const int framelen = chans * (int) sizeof (float);
+    const int inframes = cvt->len_cvt / framelen;
+    const int outframes = SDL_min((int) (inframes * ((double) outrate / (double) inrate)), (cvt->len * cvt->len_mult) / framelen);
+    const int quality = GetResamplerQuality();
+    const int paddingframes = ResamplerPadding(inrate, outrate, quality);
+    const float *inbuf = (const float *) cvt->buf;
+    SDL_ResampleCacheEntry entry;
+    size_t worklen;
+    float *outbuf;
+    float *edge;
+    int written = 0;
+    int position = 0;
+    int phase = 0;
+    int start;
+
     SDL_assert(format == AUDIO_F32SYS);
 
-    /* we keep no streaming state here, so pad with silence on both ends. */
-    padding = (float *) SDL_calloc(paddingsamples ? paddingsamples : 1, sizeof (float));
-    if (!padding) {
-        SDL_OutOfMemory();
+    if (!SDL_TakeCachedResampler(inrate, outrate, quality, &entry)) {
         return;
     }
 
-    cvt->len_cvt = SDL_ResampleAudio(chans, inrate, outrate, padding, padding, src, srclen, dst, dstlen);
+    /* The output goes to scratch space, since it would overwrite input that
+       is still needed, followed by room for one padded edge of the input. */
+    worklen = ((size_t) outframes + (paddingframes * 3)) * framelen;
+    if (worklen > entry.worklen) {
+        float *ptr = (float *) SDL_realloc(entry.work, worklen);
+        if (!ptr) {
+            SDL_ReturnCachedResampler(&entry);
+            SDL_OutOfMemory();
+            return;
+        }
+        entry.work = ptr;
+        entry.worklen = worklen;
+    }
+    outbuf = entry.work;
+    edge = entry.work + ((size_t) outframes * chans);
+
+    /* We keep no streaming state here, so the input is padded with silence
+       on both ends. Only the output frames within paddingframes of an end
+       read past it, and those are resampled from a padded copy of just that
+       edge. Everything in between reads straight from cvt->buf. */
+    for (start = 0; (start < inframes) && (written < outframes); ) {
+        const int interior_end = inframes - paddingframes;
+        int end, first, last;
+
+        if ((start >= paddingframes) && (start < interior_end)) {
+            written += SDL_ResampleAudio(entry.filter, chans, inbuf, interior_end,
+                                         outbuf + (written * chans), outframes - written, &position, &phase);
+        } else {
+            int edgepos = position - start;
+            end = (start < paddingframes) ? SDL_min(paddingframes, inframes) : inframes;
+            first = SDL_max(start - paddingframes, 0);
+            last = SDL_min(end + paddingframes, inframes);
+            SDL_memset(edge, '\0', ((end - start) + (paddingframes * 2)) * framelen);
+            SDL_memcpy(edge + ((first - (start - paddingframes)) * chans), inbuf + (first * chans), (last - first) * framelen);
+            written += SDL_ResampleAudio(entry.filter, chans, edge + (paddingframes * chans), end - start,
+                                         outbuf + (written * chans), outframes - written, &edgepos, &phase);
+            position = edgepos + start;
+        }
+        start = position;
+    }
 
-    SDL_free(padding);
+    SDL_memcpy(cvt->buf, outbuf, written * framelen);
+    cvt->len_cvt = written * framelen;
 
-    SDL_memmove(cvt->buf, dst, cvt->len_cvt);  /* !!! FIXME: remove this if we can get the resampler to work in-place again. */
+    SDL_ReturnCachedResampler(&entry);
 
     if (cvt->filters[++cvt->filter_index]) {
         cvt->filters[cvt->filter_index](cvt, format);
@@ -792,7 +1276,7 @@ SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
         return SDL_SetError("No conversion available for these rates");
     }
 
-    if (SDL_PrepareResampleFilter() < 0) {
+    if (!SDL_PrepareResampleFilter(GetResamplerQuality())) {
         return -1;
     }
 
@@ -818,11 +1302,6 @@ SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
         cvt->len_ratio /= ((double) src_rate) / ((double) dst_rate);
     }
 
-    /* !!! FIXME: remove this if we can get the resampler to work in-place again. */
-    /* the buffer is big enough to hold the destination now, but
-       we need it large enough to hold a separate scratch buffer. */
-    cvt->len_mult *= 2;
-
     return 1;               /* added a converter. */
 }
 
@@ -1225,43 +1704,91 @@ SetupLibSampleRateResampling(SDL_AudioStream *stream)
 #endif /* HAVE_LIBSAMPLERATE_H */
 
 
+typedef struct
+{
+    SDL_ResampleFilter *filter;
+    float *history;  /* the last resampler_padding_samples samples of the previous input */
+    int position;
+    int phase;
+} SDL_AudioStreamResampler;
+
 static int
 SDL_ResampleAudioStream(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
 {
-    const Uint8 *inbufend = ((const Uint8 *) _inbuf) + inbuflen;
-    const float *inbuf = (const float *) _inbuf;
-    float *outbuf = (float *) _outbuf;
+    SDL_AudioStreamResampler *state = (SDL_AudioStreamResampler *) stream->resampler_state;
     const int chans = (int) stream->pre_resample_channels;
-    const int inrate = stream->src_rate;
-    const int outrate = stream->dst_rate;
+    const int framelen = chans * (int) sizeof (float);
+    const int inframes = inbuflen / framelen;
     const int paddingsamples = stream->resampler_padding_samples;
-    const int paddingbytes = paddingsamples * sizeof (float);
-    float *lpadding = (float *) stream->resampler_state;
-    const float *rpadding = (const float *) inbufend; /* we set this up so there are valid padding samples at the end of the input buffer. */
-    const int cpy = SDL_min(inbuflen, paddingbytes);
+    float *inbuf = (float *) _inbuf;
     int retval;
 
-    SDL_assert(inbuf != ((const float *) outbuf));  /* SDL_AudioStreamPut() shouldn't allow in-place resamples. */
+    SDL_assert(inbuf != ((const float *) _outbuf));  /* SDL_AudioStreamPut() shouldn't allow in-place resamples. */
 
-    retval = SDL_ResampleAudio(chans, inrate, outrate, lpadding, rpadding, inbuf, inbuflen, outbuf, outbuflen);
+    /* SDL_AudioStreamPut() reserves room in front of the input for the left
+       padding, and sets things up so there are valid padding samples at the
+       end of it, so the filter can run straight over one buffer. */
+    SDL_memcpy(inbuf - paddingsamples, state->history, paddingsamples * sizeof (float));
 
-    /* update our left padding with end of current input, for next run. */
-    SDL_memcpy((lpadding + paddingsamples) - (cpy / sizeof (float)), inbufend - cpy, cpy);
-    return retval;
+    retval = SDL_ResampleAudio(state->filter, chans, inbuf, inframes, (float *) _outbuf, outbuflen / framelen,
+                               &state->position, &state->phase);
+
+    /* the next input picks up right after this one. */
+    state->position -= inframes;
+    SDL_memcpy(state->history, (inbuf + (inframes * chans)) - paddingsamples, paddingsamples * sizeof (float));
+
+    return retval * framelen;
 }
 
 static void
 SDL_ResetAudioStreamResampler(SDL_AudioStream *stream)
 {
     /* set all the padding to silence. */
-    const int len = stream->resampler_padding_samples;
-    SDL_memset(stream->resampler_state, '\0', len * sizeof (float));
+    SDL_AudioStreamResampler *state = (SDL_AudioStreamResampler *) stream->resampler_state;
+    SDL_memset(state->history, '\0', stream->resampler_padding_samples * sizeof (float));
+    state->position = 0;
+    state->phase = 0;
 }
 
 static void
 SDL_CleanupAudioStreamResampler(SDL_AudioStream *stream)
 {
-    SDL_free(stream->resampler_state);
+    SDL_AudioStreamResampler *state = (SDL_AudioStreamResampler *) stream->resampler_state;
+    if (state) {
+        SDL_DestroyResampleFilter(state->filter);
+        SDL_free(state->history);
+        SDL_free(state);
+    }
+}
+
+static SDL_bool
+SetupResampling(SDL_AudioStream *stream, const int quality)
+{
+    SDL_AudioStreamResampler *state = (SDL_AudioStreamResampler *) SDL_calloc(1, sizeof (*state));
+
+    if (!state) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+
+    stream->resampler_state = state;
+    stream->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
+
+    state->history = (float *) SDL_calloc(stream->resampler_padding_samples, sizeof (float));
+    if (!state->history) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+
+    state->filter = SDL_CreateResampleFilter(stream->src_rate, stream->dst_rate, quality);
+    if (!state->filter) {
+        return SDL_FALSE;
+    }
+
+    stream->resampler_func = SDL_ResampleAudioStream;
+    stream->reset_resampler_func = SDL_ResetAudioStreamResampler;
+
+    return SDL_TRUE;
 }
 
 SDL_AudioStream *
@@ -1273,6 +1800,7 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
                    const int dst_rate)
 {
     const int packetlen = 4096;  /* !!! FIXME: good enough for now. */
+    const int quality = GetResamplerQuality();
     Uint8 pre_resample_channels;
     SDL_AudioStream *retval;
 
@@ -1299,7 +1827,7 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
     retval->pre_resample_channels = pre_resample_channels;
     retval->packetlen = packetlen;
     retval->rate_incr = ((double) dst_rate) / ((double) src_rate);
-    retval->resampler_padding_samples = ResamplerPadding(retval->src_rate, retval->dst_rate) * pre_resample_channels;
+    retval->resampler_padding_samples = ResamplerPadding(retval->src_rate, retval->dst_rate, quality) * pre_resample_channels;
     retval->resampler_padding = (float *) SDL_calloc(retval->resampler_padding_samples ? retval->resampler_padding_samples : 1, sizeof (float));
 
     if (retval->resampler_padding == NULL) {
@@ -1337,24 +1865,9 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
         SetupLibSampleRateResampling(retval);
 #endif
 
-        if (!retval->resampler_func) {
-            retval->resampler_state = SDL_calloc(retval->resampler_padding_samples, sizeof (float));
-            if (!retval->resampler_state) {
-                SDL_FreeAudioStream(retval);
-                SDL_OutOfMemory();
-                return NULL;
-            }
-
-            if (SDL_PrepareResampleFilter() < 0) {
-                SDL_free(retval->resampler_state);
-                retval->resampler_state = NULL;
-                SDL_FreeAudioStream(retval);
-                return NULL;
-            }
-
-            retval->resampler_func = SDL_ResampleAudioStream;
-            retval->reset_resampler_func = SDL_ResetAudioStreamResampler;
-            retval->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
+        if (!retval->resampler_func && !SetupResampling(retval, quality)) {
+            SDL_FreeAudioStream(retval);
+            return NULL;  /* SetupResampling should have called SDL_SetError. */
         }
 
         /* Convert us to the final format after resampling. */
@@ -1383,6 +1896,7 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     int resamplebuflen = 0;
     int neededpaddingbytes;
     int paddingbytes;
+    int reservedbytes;
 
     /* !!! FIXME: several converters can take advantage of SIMD, but only
        !!! FIXME:  if the data is aligned to 16 bytes. EnsureStreamBufferSize()
@@ -1407,7 +1921,8 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
         /* resamples can't happen in place, so make space for second buf. */
         const int framesize = stream->pre_resample_channels * sizeof (float);
         const int frames = workbuflen / framesize;
-        resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
+        /* one extra frame, since where the output lands between input frames carries over from the last put. */
+        resamplebuflen = (((int) SDL_ceil(frames * stream->rate_incr)) + 1) * framesize;
         #if DEBUG_AUDIOSTREAM
         printf("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, resamplebuflen, stream->rate_incr);
         #endif
@@ -1421,14 +1936,19 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
 
     workbuflen += neededpaddingbytes;
 
+    /* the internal resampler puts its left padding right in front of the
+       input; keep that a multiple of 16 bytes so the input stays aligned. */
+    reservedbytes = (stream->resampler_func == SDL_ResampleAudioStream) ? ((neededpaddingbytes + 15) & ~15) : 0;
+
     #if DEBUG_AUDIOSTREAM
-    printf("AUDIOSTREAM: Putting %d bytes of preconverted audio, need %d byte work buffer\n", buflen, workbuflen);
+    printf("AUDIOSTREAM: Putting %d bytes of preconverted audio, need %d byte work buffer\n", buflen, workbuflen + reservedbytes);
     #endif
 
-    workbuf = EnsureStreamBufferSize(stream, workbuflen);
+    workbuf = EnsureStreamBufferSize(stream, workbuflen + reservedbytes);
     if (!workbuf) {
         return -1;  /* probably out of memory. */
     }
+    workbuf += reservedbytes;
 
     resamplebuf = workbuf;  /* default if not resampling. */
 
@@ -1615,6 +2135,9 @@ int SDL_AudioStreamFlush(SDL_AudioStream *stream)
 
     stream->staging_buffer_filled = 0;
     stream->first_run = SDL_TRUE;
+    if (stream->reset_resampler_func) {
+        stream->reset_resampler_func(stream);
+    }
 
     return 0;
 }
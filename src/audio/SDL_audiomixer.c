@@ -0,0 +1,593 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* A mixer that plays many SDL_AudioStreams through one device callback */
+
+#include "SDL_audio.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_timer.h"
+#include "../SDL_dataqueue.h"
+
+/* Voice IDs keep the slot in the low bits, and a count of how many times the
+   slot was reused in the high bits, so a stale ID doesn't reach a new voice. */
+#define VOICE_SLOT_BITS 16
+#define VOICE_MAX_SLOTS ((1 << VOICE_SLOT_BITS) - 1)
+#define VOICE_ID(slot, generation) ((SDL_AudioVoiceID) (((Uint32) (generation) << VOICE_SLOT_BITS) | ((slot) + 1)))
+#define VOICE_SLOT(id) ((int) ((id) & VOICE_MAX_SLOTS) - 1)
+#define VOICE_GENERATION(id) ((int) ((id) >> VOICE_SLOT_BITS))
+
+typedef enum
+{
+    VOICE_COMMAND_PLAY,
+    VOICE_COMMAND_STOP,
+    VOICE_COMMAND_GAIN
+} SDL_AudioVoiceCommandType;
+
+typedef struct
+{
+    SDL_atomic_t sequence;
+    SDL_AudioVoiceCommandType type;
+    int slot;
+    int generation;
+    float gain[3];
+} SDL_AudioVoiceCommand;
+
+/* Converted audio moves from the stream to the queue this much at a time */
+#define VOICE_MOVE_BYTES 4096
+
+typedef struct
+{
+    /* input_lock guards the stream, the app converts audio into it without
+       holding lock, so the device thread never waits for a conversion. */
+    SDL_mutex *input_lock;
+    SDL_AudioStream *stream;
+
+    /* lock guards queue, the converted audio. The device thread only holds
+       it while it copies audio out of the queue. */
+    SDL_mutex *lock;
+    SDL_DataQueue *queue;
+
+    /* stream, queue and generation only change while both locks are held,
+       so either lock is enough to read them. Take input_lock first. */
+    int generation;
+
+    /* Only used by the app, under the mixer's lock. */
+    SDL_bool allocated;
+
+    /* Only used by the device thread, set from commands. */
+    int playing_generation;  /* 0 when stopped */
+    float gain[3];           /* front left, front right, and every other channel */
+} SDL_AudioMixerVoice;
+
+struct _SDL_AudioMixer
+{
+    SDL_AudioDeviceID device;
+    SDL_AudioSpec spec;
+    SDL_mutex *lock;  /* guards adding and removing voices */
+    int max_voices;
+    SDL_AudioMixerVoice *voices;
+
+    /* A bounded multi-producer, single-consumer queue. Every slot has a
+       sequence number that says whether it is free for the producer at
+       that position, or filled for the consumer. */
+    SDL_AudioVoiceCommand *commands;
+    int command_mask;
+    SDL_atomic_t command_write;
+    int command_read;  /* only used by the device thread */
+
+    float *scratch;
+    int scratch_len;
+};
+
+static int
+QueueVoiceCommand(SDL_AudioMixer *mixer, const SDL_AudioVoiceCommand *cmd)
+{
+    SDL_AudioVoiceCommand *slot;
+    int pos = SDL_AtomicGet(&mixer->command_write);
+
+    for (;;) {
+        int diff;
+        slot = &mixer->commands[pos & mixer->command_mask];
+        diff = SDL_AtomicGet(&slot->sequence) - pos;
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&mixer->command_write, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return SDL_SetError("Too many audio mixer commands pending");
+        }
+        pos = SDL_AtomicGet(&mixer->command_write);
+    }
+
+    slot->type = cmd->type;
+    slot->slot = cmd->slot;
+    slot->generation = cmd->generation;
+    slot->gain[0] = cmd->gain[0];
+    slot->gain[1] = cmd->gain[1];
+    slot->gain[2] = cmd->gain[2];
+    SDL_AtomicSet(&slot->sequence, pos + 1);  /* hand it to the device thread. */
+    return 0;
+}
+
+/* Runs on the device thread. */
+static void
+RunVoiceCommands(SDL_AudioMixer *mixer)
+{
+    for (;;) {
+        SDL_AudioVoiceCommand *cmd = &mixer->commands[mixer->command_read & mixer->command_mask];
+        SDL_AudioMixerVoice *voice;
+
+        if (SDL_AtomicGet(&cmd->sequence) != mixer->command_read + 1) {
+            break;  /* nothing more queued. */
+        }
+
+        voice = &mixer->voices[cmd->slot];
+        switch (cmd->type) {
+        case VOICE_COMMAND_PLAY:
+            voice->playing_generation = cmd->generation;
+            break;
+        case VOICE_COMMAND_STOP:
+            if (voice->playing_generation == cmd->generation) {
+                voice->playing_generation = 0;
+            }
+            break;
+        case VOICE_COMMAND_GAIN:
+            voice->gain[0] = cmd->gain[0];
+            voice->gain[1] = cmd->gain[1];
+            voice->gain[2] = cmd->gain[2];
+            break;
+        }
+
+        /* free the slot for the producer one lap ahead. */
+        SDL_AtomicSet(&cmd->sequence, mixer->command_read + mixer->command_mask + 1);
+        mixer->command_read++;
+    }
+}
+
+static void SDLCALL
+SDL_AudioMixerCallback(void *userdata, Uint8 *stream, int len)
+{
+    SDL_AudioMixer *mixer = (SDL_AudioMixer *) userdata;
+    const int channels = mixer->spec.channels;
+    float *dst = (float *) stream;
+    int i;
+
+    RunVoiceCommands(mixer);
+
+    SDL_memset(stream, '\0', len);
+    len = SDL_min(len, mixer->scratch_len);
+
+    for (i = 0; i < mixer->max_voices; i++) {
+        SDL_AudioMixerVoice *voice = &mixer->voices[i];
+        const float *src = mixer->scratch;
+        int samples = 0;
+        int j;
+
+        if (!voice->playing_generation) {
+            continue;
+        }
+
+        SDL_LockMutex(voice->lock);
+        if (voice->queue && (voice->generation == voice->playing_generation)) {
+            samples = (int) (SDL_ReadFromDataQueue(voice->queue, mixer->scratch, len) / sizeof (float));
+        }
+        SDL_UnlockMutex(voice->lock);
+
+        if (samples <= 0) {
+            continue;
+        }
+
+        if (channels == 1) {
+            const float gain = voice->gain[2];
+            for (j = 0; j < samples; j++) {
+                dst[j] += src[j] * gain;
+            }
+        } else {
+            /* pan the front left and right channels, everything else only gets the gain. */
+            const float left = voice->gain[0];
+            const float right = voice->gain[1];
+            const float center = voice->gain[2];
+            for (j = 0; j < samples; j += channels) {
+                int chan;
+                dst[j] += src[j] * left;
+                dst[j + 1] += src[j + 1] * right;
+                for (chan = 2; chan < channels; chan++) {
+                    dst[j + chan] += src[j + chan] * center;
+                }
+            }
+        }
+    }
+}
+
+/* Finds the voice for an ID and locks one of its locks, NULL if it doesn't exist. */
+static SDL_AudioMixerVoice *
+LockVoiceWith(SDL_AudioMixer *mixer, SDL_AudioVoiceID id, SDL_bool input)
+{
+    const int slot = VOICE_SLOT(id);
+    SDL_AudioMixerVoice *voice;
+    SDL_mutex *lock;
+
+    if (!mixer) {
+        SDL_InvalidParamError("mixer");
+        return NULL;
+    } else if ((slot < 0) || (slot >= mixer->max_voices)) {
+        SDL_SetError("Invalid audio mixer voice");
+        return NULL;
+    }
+
+    voice = &mixer->voices[slot];
+    lock = input ? voice->input_lock : voice->lock;
+    SDL_LockMutex(lock);
+    if (!voice->stream || (voice->generation != VOICE_GENERATION(id))) {
+        SDL_UnlockMutex(lock);
+        SDL_SetError("Invalid audio mixer voice");
+        return NULL;
+    }
+    return voice;
+}
+
+static SDL_AudioMixerVoice *
+LockVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID id)
+{
+    return LockVoiceWith(mixer, id, SDL_FALSE);
+}
+
+static SDL_AudioMixerVoice *
+LockVoiceInput(SDL_AudioMixer *mixer, SDL_AudioVoiceID id)
+{
+    return LockVoiceWith(mixer, id, SDL_TRUE);
+}
+
+static int
+SendVoiceCommand(SDL_AudioMixer *mixer, SDL_AudioVoiceID id, SDL_AudioVoiceCommandType type, float left, float right, float gain)
+{
+    SDL_AudioVoiceCommand cmd;
+    int retval;
+    int tries;
+
+    cmd.type = type;
+    cmd.slot = VOICE_SLOT(id);
+    cmd.generation = VOICE_GENERATION(id);
+    cmd.gain[0] = left;
+    cmd.gain[1] = right;
+    cmd.gain[2] = gain;
+
+    for (tries = 0; ; tries++) {
+        SDL_AudioMixerVoice *voice = LockVoice(mixer, id);
+        if (!voice) {
+            return -1;
+        }
+        retval = QueueVoiceCommand(mixer, &cmd);
+        SDL_UnlockMutex(voice->lock);
+
+        if ((retval == 0) || (tries > 0) || !mixer->device) {
+            return retval;
+        }
+
+        /* The queue only fills up when the callback isn't running, like
+           while the device is paused. Holding the device lock keeps the
+           callback out, so drain the queue here and try again. The voice
+           lock can't be held here, the callback takes it under this one. */
+        SDL_LockAudioDevice(mixer->device);
+        RunVoiceCommands(mixer);
+        SDL_UnlockAudioDevice(mixer->device);
+    }
+}
+
+SDL_AudioMixer *
+SDL_OpenAudioMixer(const char *device, const SDL_AudioSpec *desired,
+                   SDL_AudioSpec *obtained, int allowed_changes, int max_voices)
+{
+    SDL_AudioMixer *mixer;
+    SDL_AudioSpec spec;
+    int num_commands;
+    int i;
+
+    if (!desired) {
+        SDL_InvalidParamError("desired");
+        return NULL;
+    } else if ((max_voices <= 0) || (max_voices > VOICE_MAX_SLOTS)) {
+        SDL_InvalidParamError("max_voices");
+        return NULL;
+    }
+
+    mixer = (SDL_AudioMixer *) SDL_calloc(1, sizeof (*mixer));
+    if (!mixer) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    mixer->max_voices = max_voices;
+
+    /* room for a few commands per voice per callback, rounded up to a power of two */
+    num_commands = 64;
+    while (num_commands < max_voices * 4) {
+        num_commands *= 2;
+    }
+    mixer->command_mask = num_commands - 1;
+
+    mixer->lock = SDL_CreateMutex();
+    mixer->voices = (SDL_AudioMixerVoice *) SDL_calloc(max_voices, sizeof (SDL_AudioMixerVoice));
+    mixer->commands = (SDL_AudioVoiceCommand *) SDL_calloc(num_commands, sizeof (SDL_AudioVoiceCommand));
+    if (!mixer->lock || !mixer->voices || !mixer->commands) {
+        SDL_CloseAudioMixer(mixer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    for (i = 0; i < max_voices; i++) {
+        mixer->voices[i].input_lock = SDL_CreateMutex();
+        mixer->voices[i].lock = SDL_CreateMutex();
+        if (!mixer->voices[i].input_lock || !mixer->voices[i].lock) {
+            SDL_CloseAudioMixer(mixer);
+            return NULL;
+        }
+    }
+    for (i = 0; i < num_commands; i++) {
+        SDL_AtomicSet(&mixer->commands[i].sequence, i);
+    }
+
+    /* SDL converts from float for us if the hardware wants something else. */
+    spec = *desired;
+    spec.format = AUDIO_F32SYS;
+    spec.callback = SDL_AudioMixerCallback;
+    spec.userdata = mixer;
+    mixer->device = SDL_OpenAudioDevice(device, 0, &spec, &mixer->spec, allowed_changes & ~SDL_AUDIO_ALLOW_FORMAT_CHANGE);
+    if (!mixer->device) {
+        SDL_CloseAudioMixer(mixer);
+        return NULL;
+    }
+
+    /* The device starts paused, so the callback can't run before this is set up. */
+    mixer->scratch_len = mixer->spec.size;
+    mixer->scratch = (float *) SDL_malloc(mixer->scratch_len);
+    if (!mixer->scratch) {
+        SDL_CloseAudioMixer(mixer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (obtained) {
+        *obtained = mixer->spec;
+    }
+    return mixer;
+}
+
+SDL_AudioDeviceID
+SDL_GetAudioMixerDevice(SDL_AudioMixer *mixer)
+{
+    if (!mixer) {
+        SDL_InvalidParamError("mixer");
+        return 0;
+    }
+    return mixer->device;
+}
+
+SDL_AudioVoiceID
+SDL_AddAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioFormat format, Uint8 channels, int rate)
+{
+    SDL_AudioMixerVoice *voice = NULL;
+    SDL_AudioStream *stream;
+    SDL_DataQueue *queue;
+    SDL_AudioVoiceID id;
+    int slot;
+
+    if (!mixer) {
+        SDL_InvalidParamError("mixer");
+        return 0;
+    }
+
+    stream = SDL_NewAudioStream(format, channels, rate, AUDIO_F32SYS, mixer->spec.channels, mixer->spec.freq);
+    if (!stream) {
+        return 0;
+    }
+    queue = SDL_NewDataQueue(mixer->spec.size, mixer->spec.size * 2);
+    if (!queue) {
+        SDL_FreeAudioStream(stream);
+        return 0;
+    }
+
+    SDL_LockMutex(mixer->lock);
+    for (slot = 0; slot < mixer->max_voices; slot++) {
+        if (!mixer->voices[slot].allocated) {
+            voice = &mixer->voices[slot];
+            break;
+        }
+    }
+    if (!voice) {
+        SDL_UnlockMutex(mixer->lock);
+        SDL_FreeAudioStream(stream);
+        SDL_FreeDataQueue(queue);
+        SDL_SetError("Too many audio mixer voices");
+        return 0;
+    }
+
+    SDL_LockMutex(voice->input_lock);
+    SDL_LockMutex(voice->lock);
+    voice->generation = (voice->generation % ((1 << (32 - VOICE_SLOT_BITS)) - 1)) + 1;
+    voice->stream = stream;
+    voice->queue = queue;
+    id = VOICE_ID(slot, voice->generation);
+    SDL_UnlockMutex(voice->lock);
+    SDL_UnlockMutex(voice->input_lock);
+
+    /* any gain left over from the last voice in this slot is reset by this. */
+    if (SDL_SetAudioMixerVoiceGain(mixer, id, 1.0f, 0.0f) < 0) {
+        SDL_LockMutex(voice->input_lock);
+        SDL_LockMutex(voice->lock);
+        voice->stream = NULL;
+        voice->queue = NULL;
+        SDL_UnlockMutex(voice->lock);
+        SDL_UnlockMutex(voice->input_lock);
+        SDL_UnlockMutex(mixer->lock);
+        SDL_FreeAudioStream(stream);
+        SDL_FreeDataQueue(queue);
+        return 0;
+    }
+
+    voice->allocated = SDL_TRUE;
+    SDL_UnlockMutex(mixer->lock);
+
+    return id;
+}
+
+int
+SDL_QueueAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice, const void *data, int len)
+{
+    SDL_AudioMixerVoice *v = LockVoiceInput(mixer, voice);
+    const int frame_size = mixer ? (mixer->spec.channels * (int) sizeof (float)) : 1;
+    float converted[VOICE_MOVE_BYTES / sizeof (float)];
+    int retval;
+
+    if (!v) {
+        return -1;
+    }
+
+    /* Convert without holding the lock the device thread takes, then hand
+       over the result in pieces short enough not to hold it up. */
+    retval = SDL_AudioStreamPut(v->stream, data, len);
+    while (retval == 0) {
+        const int moved = SDL_AudioStreamGet(v->stream, converted, (VOICE_MOVE_BYTES / frame_size) * frame_size);
+        if (moved <= 0) {
+            retval = moved;
+            break;
+        }
+        SDL_LockMutex(v->lock);
+        retval = SDL_WriteToDataQueue(v->queue, converted, moved);
+        SDL_UnlockMutex(v->lock);
+    }
+    SDL_UnlockMutex(v->input_lock);
+    return retval;
+}
+
+int
+SDL_PlayAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice)
+{
+    return SendVoiceCommand(mixer, voice, VOICE_COMMAND_PLAY, 0.0f, 0.0f, 0.0f);
+}
+
+int
+SDL_StopAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice)
+{
+    return SendVoiceCommand(mixer, voice, VOICE_COMMAND_STOP, 0.0f, 0.0f, 0.0f);
+}
+
+int
+SDL_SetAudioMixerVoiceGain(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice, float gain, float pan)
+{
+    pan = SDL_max(-1.0f, SDL_min(1.0f, pan));
+    return SendVoiceCommand(mixer, voice, VOICE_COMMAND_GAIN,
+                            gain * SDL_min(1.0f, 1.0f - pan),
+                            gain * SDL_min(1.0f, 1.0f + pan),
+                            gain);
+}
+
+int
+SDL_GetAudioMixerVoiceLatency(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice)
+{
+    SDL_AudioMixerVoice *v = LockVoiceInput(mixer, voice);
+    Sint64 frames;
+
+    if (!v) {
+        return -1;
+    }
+    SDL_LockMutex(v->lock);
+    frames = (SDL_AudioStreamAvailable(v->stream) + (Sint64) SDL_CountDataQueue(v->queue)) / (mixer->spec.channels * (int) sizeof (float));
+    SDL_UnlockMutex(v->lock);
+    SDL_UnlockMutex(v->input_lock);
+
+    frames += mixer->spec.samples;
+    return (int) ((frames * 1000) / mixer->spec.freq);
+}
+
+void
+SDL_RemoveAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioVoiceID voice)
+{
+    SDL_AudioMixerVoice *v;
+    SDL_AudioStream *stream;
+    SDL_DataQueue *queue;
+
+    if (!mixer) {
+        SDL_InvalidParamError("mixer");
+        return;
+    }
+
+    SDL_LockMutex(mixer->lock);
+    v = LockVoiceInput(mixer, voice);
+    if (!v) {
+        SDL_UnlockMutex(mixer->lock);
+        return;
+    }
+    SDL_LockMutex(v->lock);
+
+    /* Once the stream is gone, the device thread skips this voice, and
+       bumping the generation when the slot is reused makes the play state
+       it still has stale. No command needed, so this works while paused. */
+    stream = v->stream;
+    queue = v->queue;
+    v->stream = NULL;
+    v->queue = NULL;
+    v->allocated = SDL_FALSE;
+    SDL_UnlockMutex(v->lock);
+    SDL_UnlockMutex(v->input_lock);
+    SDL_UnlockMutex(mixer->lock);
+
+    SDL_FreeAudioStream(stream);
+    SDL_FreeDataQueue(queue);
+}
+
+void
+SDL_CloseAudioMixer(SDL_AudioMixer *mixer)
+{
+    int i;
+
+    if (!mixer) {
+        return;
+    }
+
+    if (mixer->device) {
+        SDL_CloseAudioDevice(mixer->device);  /* waits for the device thread. */
+    }
+
+    if (mixer->voices) {
+        for (i = 0; i < mixer->max_voices; i++) {
+            SDL_FreeAudioStream(mixer->voices[i].stream);
+            SDL_FreeDataQueue(mixer->voices[i].queue);
+            if (mixer->voices[i].input_lock) {
+                SDL_DestroyMutex(mixer->voices[i].input_lock);
+            }
+            if (mixer->voices[i].lock) {
+                SDL_DestroyMutex(mixer->voices[i].lock);
+            }
+        }
+    }
+
+    if (mixer->lock) {
+        SDL_DestroyMutex(mixer->lock);
+    }
+    SDL_free(mixer->voices);
+    SDL_free(mixer->commands);
+    SDL_free(mixer->scratch);
+    SDL_free(mixer);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -26,6 +26,15 @@
 #include "SDL_timer.h"
 #include "SDL_audio.h"
 #include "SDL_sysaudio.h"
+#include "SDL_audio_c.h"
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -85,6 +94,320 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(s, v) (s = (s*v)/SDL_MIX_MAXVOLUME)
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
+/* Mixers for the native byte order versions of AUDIO_S16, AUDIO_S32 and
+   AUDIO_F32, for volumes up to SDL_MIX_MAXVOLUME. They give the same
+   results as the per-sample code in SDL_MixAudioFormat(). */
+#define SDL_MIX_MAXFLOAT 3.402823466e+38F
+
+typedef void (*SDL_MixAudioFunc)(Uint8 *dst, const Uint8 *src, Uint32 num_samples, int volume);
+
+static SDL_MixAudioFunc SDL_MixAudio_S16 = NULL;
+static SDL_MixAudioFunc SDL_MixAudio_S32 = NULL;
+static SDL_MixAudioFunc SDL_MixAudio_F32 = NULL;
+
+/* These finish off whatever the SIMD loops leave over. */
+static void
+SDL_MixAudio_S16_Scalar(Sint16 *dst, const Sint16 *src, Uint32 num_samples, int volume)
+{
+    while (num_samples--) {
+        int dst_sample = ((*src++ * volume) / SDL_MIX_MAXVOLUME) + *dst;
+        if (dst_sample > SDL_MAX_SINT16) {
+            dst_sample = SDL_MAX_SINT16;
+        } else if (dst_sample < SDL_MIN_SINT16) {
+            dst_sample = SDL_MIN_SINT16;
+        }
+        *dst++ = (Sint16) dst_sample;
+    }
+}
+
+static void
+SDL_MixAudio_S32_Scalar(Sint32 *dst, const Sint32 *src, Uint32 num_samples, int volume)
+{
+    while (num_samples--) {
+        Sint64 dst_sample = ((((Sint64) *src++) * volume) / SDL_MIX_MAXVOLUME) + *dst;
+        if (dst_sample > SDL_MAX_SINT32) {
+            dst_sample = SDL_MAX_SINT32;
+        } else if (dst_sample < SDL_MIN_SINT32) {
+            dst_sample = SDL_MIN_SINT32;
+        }
+        *dst++ = (Sint32) dst_sample;
+    }
+}
+
+static void
+SDL_MixAudio_F32_Scalar(float *dst, const float *src, Uint32 num_samples, int volume)
+{
+    const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
+    const float fvolume = (float) volume;
+
+    while (num_samples--) {
+        float dst_sample = ((*src++ * fvolume) * fmaxvolume) + *dst;
+        if (dst_sample > SDL_MIX_MAXFLOAT) {
+            dst_sample = SDL_MIX_MAXFLOAT;
+        } else if (dst_sample < -SDL_MIX_MAXFLOAT) {
+            dst_sample = -SDL_MIX_MAXFLOAT;
+        }
+        *dst++ = dst_sample;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+SDL_MixAudio_S16_SSE2(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    Sint16 *dst = (Sint16 *) _dst;
+    const Sint16 *src = (const Sint16 *) _src;
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    const __m128i round = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+
+    for (; num_samples >= 8; num_samples -= 8, src += 8, dst += 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *) src);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            /* widen the products to 32 bits and divide by 128, rounding toward zero. */
+            const __m128i lo = _mm_mullo_epi16(s, vol);
+            const __m128i hi = _mm_mulhi_epi16(s, vol);
+            __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+            p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), round)), 7);
+            p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), round)), 7);
+            s = _mm_packs_epi32(p0, p1);
+        }
+        _mm_storeu_si128((__m128i *) dst, _mm_adds_epi16(s, _mm_loadu_si128((const __m128i *) dst)));
+    }
+
+    SDL_MixAudio_S16_Scalar(dst, src, num_samples, volume);
+}
+
+static void
+SDL_MixAudio_S32_SSE2(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    Sint32 *dst = (Sint32 *) _dst;
+    const Sint32 *src = (const Sint32 *) _src;
+    /* Doubles hold every product and sum exactly, and truncating them rounds toward zero like the integer division. */
+    const __m128d vol = _mm_set1_pd(((double) volume) / SDL_MIX_MAXVOLUME);
+    const __m128d max_audioval = _mm_set1_pd((double) SDL_MAX_SINT32);
+    const __m128d min_audioval = _mm_set1_pd((double) SDL_MIN_SINT32);
+
+    for (; num_samples >= 4; num_samples -= 4, src += 4, dst += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) src);
+        const __m128i d = _mm_loadu_si128((const __m128i *) dst);
+        __m128d s0 = _mm_cvtepi32_pd(s);
+        __m128d s1 = _mm_cvtepi32_pd(_mm_srli_si128(s, 8));
+        s0 = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_mul_pd(s0, vol)));
+        s1 = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_mul_pd(s1, vol)));
+        s0 = _mm_min_pd(_mm_max_pd(_mm_add_pd(s0, _mm_cvtepi32_pd(d)), min_audioval), max_audioval);
+        s1 = _mm_min_pd(_mm_max_pd(_mm_add_pd(s1, _mm_cvtepi32_pd(_mm_srli_si128(d, 8))), min_audioval), max_audioval);
+        _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi64(_mm_cvttpd_epi32(s0), _mm_cvttpd_epi32(s1)));
+    }
+
+    SDL_MixAudio_S32_Scalar(dst, src, num_samples, volume);
+}
+
+static void
+SDL_MixAudio_F32_SSE2(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    float *dst = (float *) _dst;
+    const float *src = (const float *) _src;
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m128 max_audioval = _mm_set1_ps(SDL_MIX_MAXFLOAT);
+    const __m128 min_audioval = _mm_set1_ps(-SDL_MIX_MAXFLOAT);
+
+    for (; num_samples >= 8; num_samples -= 8, src += 8, dst += 8) {
+        /* the limit goes first, so NaN passes through like in the scalar code. */
+        const __m128 s0 = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(src), fvolume), fmaxvolume);
+        const __m128 s1 = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(src + 4), fvolume), fmaxvolume);
+        _mm_storeu_ps(dst, _mm_min_ps(max_audioval, _mm_max_ps(min_audioval, _mm_add_ps(s0, _mm_loadu_ps(dst)))));
+        _mm_storeu_ps(dst + 4, _mm_min_ps(max_audioval, _mm_max_ps(min_audioval, _mm_add_ps(s1, _mm_loadu_ps(dst + 4)))));
+    }
+
+    SDL_MixAudio_F32_Scalar(dst, src, num_samples, volume);
+}
+#endif
+
+#if HAVE_AVX2_AUDIO
+static void SDL_AUDIO_TARGETING("avx2")
+SDL_MixAudio_S16_AVX2(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    Sint16 *dst = (Sint16 *) _dst;
+    const Sint16 *src = (const Sint16 *) _src;
+    const __m256i vol = _mm256_set1_epi16((Sint16) volume);
+    const __m256i round = _mm256_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+
+    for (; num_samples >= 16; num_samples -= 16, src += 16, dst += 16) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) src);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            /* unpacking and packing both work within 128-bit lanes, so the order survives. */
+            const __m256i lo = _mm256_mullo_epi16(s, vol);
+            const __m256i hi = _mm256_mulhi_epi16(s, vol);
+            __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+            __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+            p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), round)), 7);
+            p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), round)), 7);
+            s = _mm256_packs_epi32(p0, p1);
+        }
+        _mm256_storeu_si256((__m256i *) dst, _mm256_adds_epi16(s, _mm256_loadu_si256((const __m256i *) dst)));
+    }
+
+    SDL_MixAudio_S16_Scalar(dst, src, num_samples, volume);
+}
+
+static void SDL_AUDIO_TARGETING("avx2")
+SDL_MixAudio_S32_AVX2(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    Sint32 *dst = (Sint32 *) _dst;
+    const Sint32 *src = (const Sint32 *) _src;
+    const __m256d vol = _mm256_set1_pd(((double) volume) / SDL_MIX_MAXVOLUME);
+    const __m256d max_audioval = _mm256_set1_pd((double) SDL_MAX_SINT32);
+    const __m256d min_audioval = _mm256_set1_pd((double) SDL_MIN_SINT32);
+
+    for (; num_samples >= 8; num_samples -= 8, src += 8, dst += 8) {
+        __m256d s0 = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *) src));
+        __m256d s1 = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *) (src + 4)));
+        s0 = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(_mm256_mul_pd(s0, vol)));
+        s1 = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(_mm256_mul_pd(s1, vol)));
+        s0 = _mm256_add_pd(s0, _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *) dst)));
+        s1 = _mm256_add_pd(s1, _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *) (dst + 4))));
+        s0 = _mm256_min_pd(_mm256_max_pd(s0, min_audioval), max_audioval);
+        s1 = _mm256_min_pd(_mm256_max_pd(s1, min_audioval), max_audioval);
+        _mm_storeu_si128((__m128i *) dst, _mm256_cvttpd_epi32(s0));
+        _mm_storeu_si128((__m128i *) (dst + 4), _mm256_cvttpd_epi32(s1));
+    }
+
+    SDL_MixAudio_S32_Scalar(dst, src, num_samples, volume);
+}
+
+static void SDL_AUDIO_TARGETING("avx2")
+SDL_MixAudio_F32_AVX2(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    float *dst = (float *) _dst;
+    const float *src = (const float *) _src;
+    const __m256 fvolume = _mm256_set1_ps((float) volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m256 max_audioval = _mm256_set1_ps(SDL_MIX_MAXFLOAT);
+    const __m256 min_audioval = _mm256_set1_ps(-SDL_MIX_MAXFLOAT);
+
+    for (; num_samples >= 16; num_samples -= 16, src += 16, dst += 16) {
+        const __m256 s0 = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(src), fvolume), fmaxvolume);
+        const __m256 s1 = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(src + 8), fvolume), fmaxvolume);
+        _mm256_storeu_ps(dst, _mm256_min_ps(max_audioval, _mm256_max_ps(min_audioval, _mm256_add_ps(s0, _mm256_loadu_ps(dst)))));
+        _mm256_storeu_ps(dst + 8, _mm256_min_ps(max_audioval, _mm256_max_ps(min_audioval, _mm256_add_ps(s1, _mm256_loadu_ps(dst + 8)))));
+    }
+
+    SDL_MixAudio_F32_Scalar(dst, src, num_samples, volume);
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+SDL_MixAudio_S16_NEON(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    Sint16 *dst = (Sint16 *) _dst;
+    const Sint16 *src = (const Sint16 *) _src;
+    const int16x4_t vol = vdup_n_s16((int16_t) volume);
+
+    for (; num_samples >= 8; num_samples -= 8, src += 8, dst += 8) {
+        int16x8_t s = vld1q_s16(src);
+        if (volume != SDL_MIX_MAXVOLUME) {
+            /* widen the products to 32 bits and divide by 128, rounding toward zero. */
+            int32x4_t p0 = vmull_s16(vget_low_s16(s), vol);
+            int32x4_t p1 = vmull_s16(vget_high_s16(s), vol);
+            p0 = vshrq_n_s32(vaddq_s32(p0, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p0, 31)), 25))), 7);
+            p1 = vshrq_n_s32(vaddq_s32(p1, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p1, 31)), 25))), 7);
+            s = vcombine_s16(vmovn_s32(p0), vmovn_s32(p1));
+        }
+        vst1q_s16(dst, vqaddq_s16(s, vld1q_s16(dst)));
+    }
+
+    SDL_MixAudio_S16_Scalar(dst, src, num_samples, volume);
+}
+
+static void
+SDL_MixAudio_S32_NEON(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    Sint32 *dst = (Sint32 *) _dst;
+    const Sint32 *src = (const Sint32 *) _src;
+    const int32x2_t vol = vdup_n_s32(volume);
+
+    for (; num_samples >= 4; num_samples -= 4, src += 4, dst += 4) {
+        const int32x4_t s = vld1q_s32(src);
+        const int32x4_t d = vld1q_s32(dst);
+        /* widen to 64 bits, divide by 128 rounding toward zero, add, then narrow with saturation. */
+        int64x2_t p0 = vmull_s32(vget_low_s32(s), vol);
+        int64x2_t p1 = vmull_s32(vget_high_s32(s), vol);
+        p0 = vshrq_n_s64(vaddq_s64(p0, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(p0, 63)), 57))), 7);
+        p1 = vshrq_n_s64(vaddq_s64(p1, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(p1, 63)), 57))), 7);
+        p0 = vaddw_s32(p0, vget_low_s32(d));
+        p1 = vaddw_s32(p1, vget_high_s32(d));
+        vst1q_s32(dst, vcombine_s32(vqmovn_s64(p0), vqmovn_s64(p1)));
+    }
+
+    SDL_MixAudio_S32_Scalar(dst, src, num_samples, volume);
+}
+
+static void
+SDL_MixAudio_F32_NEON(Uint8 *_dst, const Uint8 *_src, Uint32 num_samples, int volume)
+{
+    float *dst = (float *) _dst;
+    const float *src = (const float *) _src;
+    const float32x4_t fvolume = vdupq_n_f32((float) volume);
+    const float32x4_t fmaxvolume = vdupq_n_f32(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const float32x4_t max_audioval = vdupq_n_f32(SDL_MIX_MAXFLOAT);
+    const float32x4_t min_audioval = vdupq_n_f32(-SDL_MIX_MAXFLOAT);
+
+    for (; num_samples >= 8; num_samples -= 8, src += 8, dst += 8) {
+        /* vmaxq/vminq return NaN if either input is NaN, like the scalar code. */
+        const float32x4_t s0 = vmulq_f32(vmulq_f32(vld1q_f32(src), fvolume), fmaxvolume);
+        const float32x4_t s1 = vmulq_f32(vmulq_f32(vld1q_f32(src + 4), fvolume), fmaxvolume);
+        vst1q_f32(dst, vminq_f32(vmaxq_f32(vaddq_f32(s0, vld1q_f32(dst)), min_audioval), max_audioval));
+        vst1q_f32(dst + 4, vminq_f32(vmaxq_f32(vaddq_f32(s1, vld1q_f32(dst + 4)), min_audioval), max_audioval));
+    }
+
+    SDL_MixAudio_F32_Scalar(dst, src, num_samples, volume);
+}
+#endif
+
+static void
+SDL_ChooseAudioMixers(void)
+{
+    static SDL_bool mixers_chosen = SDL_FALSE;
+
+    if (mixers_chosen) {
+        return;
+    }
+
+#define SET_MIXER_FUNCS(fntype) \
+        SDL_MixAudio_S16 = SDL_MixAudio_S16_##fntype; \
+        SDL_MixAudio_S32 = SDL_MixAudio_S32_##fntype; \
+        SDL_MixAudio_F32 = SDL_MixAudio_F32_##fntype; \
+        mixers_chosen = SDL_TRUE
+
+#if HAVE_AVX2_AUDIO
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+        return;
+    }
+#endif
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+        return;
+    }
+#endif
+
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_MIXER_FUNCS(NEON);
+        return;
+    }
+#endif
+
+#undef SET_MIXER_FUNCS
+
+    /* no SIMD here, SDL_MixAudioFormat() does it one sample at a time. */
+    mixers_chosen = SDL_TRUE;
+}
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
@@ -94,6 +417,21 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         return;
     }
 
+    SDL_ChooseAudioMixers();
+
+    if (volume <= SDL_MIX_MAXVOLUME) {
+        if ((format == AUDIO_S16SYS) && SDL_MixAudio_S16) {
+            SDL_MixAudio_S16(dst, src, len / 2, volume);
+            return;
+        } else if ((format == AUDIO_S32SYS) && SDL_MixAudio_S32) {
+            SDL_MixAudio_S32(dst, src, len / 4, volume);
+            return;
+        } else if ((format == AUDIO_F32SYS) && SDL_MixAudio_F32) {
+            SDL_MixAudio_F32(dst, src, len / 4, volume);
+            return;
+        }
+    }
+
     switch (format) {
 
     case AUDIO_U8:
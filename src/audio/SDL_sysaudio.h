@@ -62,6 +62,18 @@ extern void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device);
    The system preallocates enough packets for 2 callbacks' worth of data. */
 #define SDL_AUDIOBUFFERQUEUE_PACKETLEN (8 * 1024)
 
+/* A single-producer, single-consumer ring buffer used by SDL_QueueAudio()
+   instead of the packet queue when SDL_HINT_AUDIO_QUEUE_CAPACITY is set.
+   read and write only ever count up; each is only changed by its own side,
+   so neither side needs the device lock. The data follows the struct. */
+typedef struct SDL_AudioRingBuffer
+{
+    Uint32 mask;  /* capacity - 1, capacity is a power of two */
+    SDL_atomic_t read;
+    SDL_atomic_t write;
+    Uint8 *data;
+} SDL_AudioRingBuffer;
+
 typedef struct SDL_AudioDriverImpl
 {
     void (*DetectDevices) (void);
@@ -155,6 +167,14 @@ struct SDL_AudioDevice
     /* Size, in bytes, of work_buffer. */
     Uint32 work_buffer_len;
 
+    /* Holds the end of the last callback buffer that didn't fit in a device
+       buffer, when only the buffer size differs from the device. Points into
+       the allocation of work_buffer, NULL when not rebuffering. */
+    Uint8 *carry_buffer;
+
+    /* Bytes at the end of carry_buffer still waiting to be played. */
+    Uint32 carry_len;
+
     /* A mutex for locking the mixing buffers */
     SDL_mutex *mixer_lock;
 
@@ -165,6 +185,9 @@ struct SDL_AudioDevice
     /* Queued buffers (if app not using callback). */
     SDL_DataQueue *buffer_queue;
 
+    /* Used instead of buffer_queue if SDL_HINT_AUDIO_QUEUE_CAPACITY is set. */
+    SDL_AudioRingBuffer *buffer_ring;
+
     /* * * */
     /* Data private to this driver */
     struct SDL_PrivateAudioData *hidden;
@@ -41,6 +41,7 @@
 #define DISKENVR_INFILE         "SDL_DISKAUDIOFILEIN"
 #define DISKDEFAULT_INFILE      "sdlaudio-in.raw"
 #define DISKENVR_IODELAY      "SDL_DISKAUDIODELAY"
+#define DISKENVR_SAMPLES      "SDL_DISKAUDIOSAMPLES"
 
 /* This function waits until it is possible to write a full sound buffer */
 static void
@@ -131,6 +132,13 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     /* handle != NULL means "user specified the placeholder name on the fake detected device list" */
     const char *fname = get_filename(iscapture, handle ? NULL : devname);
     const char *envr = SDL_getenv(DISKENVR_IODELAY);
+    const char *samples = SDL_getenv(DISKENVR_SAMPLES);
+
+    /* Lets tests get a device buffer size other than the one asked for. */
+    if (samples != NULL && SDL_atoi(samples) > 0) {
+        this->spec.samples = (Uint16) SDL_atoi(samples);
+        SDL_CalculateAudioSpec(&this->spec);
+    }
 
     this->hidden = (struct SDL_PrivateAudioData *)
         SDL_malloc(sizeof(*this->hidden));
@@ -191,7 +191,8 @@ UpdateAudioStream(_THIS, const SDL_AudioSpec *oldspec)
         /* no need to buffer/convert in an AudioStream! */
         SDL_FreeAudioStream(this->stream);
         this->stream = NULL;
-    } else if ( (oldspec->channels == this->spec.channels) &&
+    } else if ( this->stream &&
+         (oldspec->channels == this->spec.channels) &&
          (oldspec->format == this->spec.format) &&
          (oldspec->freq == this->spec.freq) ) {
         /* The existing audio stream is okay to keep using. */
@@ -216,14 +217,22 @@ UpdateAudioStream(_THIS, const SDL_AudioSpec *oldspec)
         }
     }
 
-    /* make sure our scratch buffer can cover the new device spec. */
-    if (this->spec.size > this->work_buffer_len) {
-        Uint8 *ptr = (Uint8 *) SDL_realloc(this->work_buffer, this->spec.size);
+    /* The stream handles any buffer size difference from here on, and
+       carry_buffer lives in work_buffer's allocation, so stop rebuffering
+       before that might be reallocated. */
+    this->carry_buffer = NULL;
+    this->carry_len = 0;
+
+    /* make sure our scratch buffer can cover the new device spec, and the
+       callback's buffer, which SDL_RunAudio writes there for the stream. */
+    if (SDL_max(this->spec.size, this->callbackspec.size) > this->work_buffer_len) {
+        const Uint32 len = SDL_max(this->spec.size, this->callbackspec.size);
+        Uint8 *ptr = (Uint8 *) SDL_realloc(this->work_buffer, len);
         if (ptr == NULL) {
             return SDL_OutOfMemory();
         }
         this->work_buffer = ptr;
-        this->work_buffer_len = this->spec.size;
+        this->work_buffer_len = len;
     }
 
     return 0;
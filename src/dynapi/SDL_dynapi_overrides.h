@@ -799,3 +799,35 @@
 #define SDL_SetWindowMouseGrab SDL_SetWindowMouseGrab_REAL
 #define SDL_GetWindowKeyboardGrab SDL_GetWindowKeyboardGrab_REAL
 #define SDL_GetWindowMouseGrab SDL_GetWindowMouseGrab_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_GetTicksNS SDL_GetTicksNS_REAL
+#define SDL_DelayNS SDL_DelayNS_REAL
+#define SDL_DelayUntilNS SDL_DelayUntilNS_REAL
+#define SDL_CreateJobSystem SDL_CreateJobSystem_REAL
+#define SDL_GetJobSystemThreadCount SDL_GetJobSystemThreadCount_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_SubmitJobAfter SDL_SubmitJobAfter_REAL
+#define SDL_WaitJobs SDL_WaitJobs_REAL
+#define SDL_DestroyJobSystem SDL_DestroyJobSystem_REAL
+#define SDL_RenderGeometry SDL_RenderGeometry_REAL
+#define SDL_RenderCopyBatch SDL_RenderCopyBatch_REAL
+#define SDL_RenderCopyBatchF SDL_RenderCopyBatchF_REAL
+#define SDL_GetRenderStats SDL_GetRenderStats_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_AddTextureAtlasImage SDL_AddTextureAtlasImage_REAL
+#define SDL_RemoveTextureAtlasImage SDL_RemoveTextureAtlasImage_REAL
+#define SDL_GetTextureAtlasImage SDL_GetTextureAtlasImage_REAL
+#define SDL_DefragmentTextureAtlas SDL_DefragmentTextureAtlas_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_RenderGetDamageRects SDL_RenderGetDamageRects_REAL
+#define SDL_OpenAudioMixer SDL_OpenAudioMixer_REAL
+#define SDL_GetAudioMixerDevice SDL_GetAudioMixerDevice_REAL
+#define SDL_AddAudioMixerVoice SDL_AddAudioMixerVoice_REAL
+#define SDL_QueueAudioMixerVoice SDL_QueueAudioMixerVoice_REAL
+#define SDL_PlayAudioMixerVoice SDL_PlayAudioMixerVoice_REAL
+#define SDL_StopAudioMixerVoice SDL_StopAudioMixerVoice_REAL
+#define SDL_SetAudioMixerVoiceGain SDL_SetAudioMixerVoiceGain_REAL
+#define SDL_GetAudioMixerVoiceLatency SDL_GetAudioMixerVoiceLatency_REAL
+#define SDL_RemoveAudioMixerVoice SDL_RemoveAudioMixerVoice_REAL
+#define SDL_CloseAudioMixer SDL_CloseAudioMixer_REAL
+#define SDL_AddTimerNS SDL_AddTimerNS_REAL
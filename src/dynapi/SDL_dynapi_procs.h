@@ -862,3 +862,35 @@ SDL_DYNAPI_PROC(void,SDL_SetWindowKeyboardGrab,(SDL_Window *a, SDL_bool b),(a,b)
 SDL_DYNAPI_PROC(void,SDL_SetWindowMouseGrab,(SDL_Window *a, SDL_bool b),(a,b),)
 SDL_DYNAPI_PROC(SDL_bool,SDL_GetWindowKeyboardGrab,(SDL_Window *a),(a),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_GetWindowMouseGrab,(SDL_Window *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetTicksNS,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_DelayNS,(Uint64 a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DelayUntilNS,(Uint64 a),(a),)
+SDL_DYNAPI_PROC(SDL_JobSystem*,SDL_CreateJobSystem,(int a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobSystemThreadCount,(SDL_JobSystem *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitJob,(SDL_JobSystem *a, SDL_JobFunction b, void *c, SDL_atomic_t *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitJobAfter,(SDL_JobSystem *a, SDL_atomic_t *b, SDL_JobFunction c, void *d, SDL_atomic_t *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJobs,(SDL_JobSystem *a, SDL_atomic_t *b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_DestroyJobSystem,(SDL_JobSystem *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderGeometry,(SDL_Renderer *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatch,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_Rect *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatchF,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a, Uint32 b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AddTextureAtlasImage,(SDL_TextureAtlas *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RemoveTextureAtlasImage,(SDL_TextureAtlas *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetTextureAtlasImage,(SDL_TextureAtlas *a, int b, SDL_Texture **c, SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_DefragmentTextureAtlas,(SDL_TextureAtlas *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderGetDamageRects,(SDL_Renderer *a, SDL_Rect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AudioMixer*,SDL_OpenAudioMixer,(const char *a, const SDL_AudioSpec *b, SDL_AudioSpec *c, int d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_AudioDeviceID,SDL_GetAudioMixerDevice,(SDL_AudioMixer *a),(a),return)
+SDL_DYNAPI_PROC(SDL_AudioVoiceID,SDL_AddAudioMixerVoice,(SDL_AudioMixer *a, SDL_AudioFormat b, Uint8 c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_QueueAudioMixerVoice,(SDL_AudioMixer *a, SDL_AudioVoiceID b, const void *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_PlayAudioMixerVoice,(SDL_AudioMixer *a, SDL_AudioVoiceID b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_StopAudioMixerVoice,(SDL_AudioMixer *a, SDL_AudioVoiceID b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioMixerVoiceGain,(SDL_AudioMixer *a, SDL_AudioVoiceID b, float c, float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioMixerVoiceLatency,(SDL_AudioMixer *a, SDL_AudioVoiceID b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_RemoveAudioMixerVoice,(SDL_AudioMixer *a, SDL_AudioVoiceID b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_CloseAudioMixer,(SDL_AudioMixer *a),(a),)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerNS,(Uint64 a, SDL_TimerCallbackNS b, void *c),(a,b,c),return)
@@ -26,6 +26,7 @@
 #include "SDL_events.h"
 #include "SDL_thread.h"
 #include "SDL_events_c.h"
+#include "../SDL_hints_c.h"
 #include "../timer/SDL_timer_c.h"
 #if !SDL_JOYSTICK_DISABLED
 #include "../joystick/SDL_joystick_c.h"
@@ -63,33 +64,192 @@ typedef struct {
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_USEREVENT;
 
-/* Private data -- event queue */
-typedef struct _SDL_EventEntry
-{
-    SDL_Event event;
-    SDL_SysWMmsg msg;
-    struct _SDL_EventEntry *prev;
-    struct _SDL_EventEntry *next;
-} SDL_EventEntry;
+/* Private data -- event queue
+
+   The queue is a bounded multi-producer ring: producers claim a slot by
+   advancing the tail with a CAS and publish it by bumping the slot sequence,
+   so pushing an event never takes a lock.  Readers (peep, flush, filter) are
+   serialized by SDL_EventQ.lock and may remove events from the middle of the
+   ring by marking them removed; slots are handed back to producers once the
+   head of the ring moves past them.
 
+   The ring starts small and doubles when a producer finds it full.  Producers
+   register in SDL_EventQ.writers while they use the ring, and the reader that
+   replaces it sets SDL_EVENT_RING_RESIZING there and waits for them to finish,
+   so the ring only has to be moved while nobody else is touching it.
+ */
 typedef struct _SDL_SysWMEntry
 {
     SDL_SysWMmsg msg;
     struct _SDL_SysWMEntry *next;
 } SDL_SysWMEntry;
 
+typedef struct
+{
+    SDL_atomic_t sequence;  /* stored relative to the slot index, so a zeroed ring is ready to use */
+    SDL_bool removed;
+    SDL_Event event;
+} SDL_EventSlot;
+
+/* Must be powers of two, the largest one bigger than SDL_MAX_QUEUED_EVENTS */
+#define SDL_EVENT_RING_MIN_SIZE 1024
+#define SDL_EVENT_RING_MAX_SIZE 65536
+
+/* Set in SDL_EventQ.writers while the ring is being replaced */
+#define SDL_EVENT_RING_RESIZING 0x40000000
+
 static struct
 {
     SDL_mutex *lock;
     SDL_atomic_t active;
     SDL_atomic_t count;
-    int max_events_seen;
-    SDL_EventEntry *head;
-    SDL_EventEntry *tail;
-    SDL_EventEntry *free;
+    SDL_atomic_t tail;
+    SDL_atomic_t max_events_seen;
+    SDL_atomic_t writers;
+    Uint32 head;
+    Uint32 size;
+    SDL_EventSlot *slots;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+    SDL_bool filtering;
+} SDL_EventQ = { NULL, { 1 }, { 0 }, { 0 }, { 0 }, { 0 }, 0, 0, NULL, NULL, NULL, SDL_FALSE };
+
+static SDL_INLINE Uint32
+SDL_GetEventSlotSequence(SDL_EventSlot *slots, Uint32 index)
+{
+    return (Uint32)SDL_AtomicGet(&slots[index].sequence) + index;
+}
+
+static SDL_INLINE void
+SDL_SetEventSlotSequence(SDL_EventSlot *slots, Uint32 index, Uint32 sequence)
+{
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&slots[index].sequence, (int)(sequence - index));
+}
+
+/* Start using the event ring as a producer.  Returns NULL if there is no ring
+   yet or it is being replaced, otherwise SDL_EndEventWrite() must be called
+   once the claimed slot is published.  *size is the ring size, or 0. */
+static SDL_EventSlot *
+SDL_BeginEventWrite(Uint32 *size)
+{
+    SDL_EventSlot *slots;
+
+    *size = 0;
+    if (SDL_AtomicAdd(&SDL_EventQ.writers, 1) & SDL_EVENT_RING_RESIZING) {
+        SDL_AtomicAdd(&SDL_EventQ.writers, -1);
+        return NULL;
+    }
+    slots = (SDL_EventSlot *)SDL_AtomicGetPtr((void **)&SDL_EventQ.slots);
+    if (!slots) {
+        SDL_AtomicAdd(&SDL_EventQ.writers, -1);
+        return NULL;
+    }
+    *size = SDL_EventQ.size;
+    return slots;
+}
+
+static void
+SDL_EndEventWrite(void)
+{
+    SDL_AtomicAdd(&SDL_EventQ.writers, -1);
+}
+
+/* Keep producers off the ring, waiting for the ones using it to publish their
+   events -- called with the queue locked */
+static void
+SDL_BlockEventWriters(void)
+{
+    int writers;
+
+    do {
+        writers = SDL_AtomicGet(&SDL_EventQ.writers);
+    } while (!SDL_AtomicCAS(&SDL_EventQ.writers, writers, writers | SDL_EVENT_RING_RESIZING));
+
+    while (SDL_AtomicGet(&SDL_EventQ.writers) != SDL_EVENT_RING_RESIZING) {
+        SDL_Delay(0);
+    }
+    SDL_MemoryBarrierAcquire();
+}
+
+static void
+SDL_UnblockEventWriters(void)
+{
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicAdd(&SDL_EventQ.writers, -SDL_EVENT_RING_RESIZING);
+}
+
+/* Replace a ring of the given size (0 if there is none yet) with one twice as
+   big, moving the unread events to the front of it in order.  Returns SDL_FALSE
+   if the new ring couldn't be allocated. */
+static SDL_bool
+SDL_GrowEventSlots(Uint32 size)
+{
+    SDL_EventSlot *slots, *old;
+    Uint32 pos, tail, count = 0;
+
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return SDL_FALSE;
+    }
+    SDL_BlockEventWriters();
+
+    if (SDL_EventQ.size != size) {
+        /* Another thread got here first */
+        SDL_UnblockEventWriters();
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+        return SDL_TRUE;
+    }
+    if (SDL_EventQ.filtering) {
+        /* An SDL_FilterEvents() callback on this thread is pushing events, it's
+           still walking the ring so it can't be moved */
+        SDL_UnblockEventWriters();
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+        SDL_SetError("Event queue is full (%d events)", size);
+        return SDL_FALSE;
+    }
+
+    size = size ? size * 2 : SDL_EVENT_RING_MIN_SIZE;
+    slots = (SDL_EventSlot *)SDL_calloc(size, sizeof(*slots));
+    if (!slots) {
+        SDL_UnblockEventWriters();
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+
+    /* With the producers drained every claimed slot has been published, so the
+       unread events can be packed at the front of the new ring */
+    old = SDL_EventQ.slots;
+    if (old) {
+        tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+        for (pos = SDL_EventQ.head; pos != tail; ++pos) {
+            const SDL_EventSlot *slot = &old[pos & (SDL_EventQ.size - 1)];
+            if (!slot->removed) {
+                slots[count].event = slot->event;
+                SDL_AtomicSet(&slots[count].sequence, 1);
+                ++count;
+            }
+        }
+        SDL_free(old);
+    }
+
+    SDL_EventQ.head = 0;
+    SDL_EventQ.size = size;
+    SDL_AtomicSet(&SDL_EventQ.tail, (int)count);
+    SDL_AtomicSetPtr((void **)&SDL_EventQ.slots, slots);
+
+    SDL_UnblockEventWriters();
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    return SDL_TRUE;
+}
 
 
 #if !SDL_JOYSTICK_DISABLED
@@ -149,6 +309,14 @@ SDL_EventLoggingChanged(void *userdata, const char *name, const char *oldValue,
     SDL_DoEventLogging = (hint && *hint) ? SDL_max(SDL_min(SDL_atoi(hint), 2), 0) : 0;
 }
 
+static SDL_bool SDL_DoEventCoalescing = SDL_FALSE;
+
+static void SDLCALL
+SDL_EventCoalescingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_DoEventCoalescing = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
 static void
 SDL_LogEvent(const SDL_Event *event)
 {
@@ -396,7 +564,7 @@ SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
     int i;
-    SDL_EventEntry *entry;
+    SDL_EventSlot *slots;
     SDL_SysWMEntry *wmmsg;
 
     if (SDL_EventQ.lock) {
@@ -407,20 +575,28 @@ SDL_StopEventLoop(void)
 
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
-                SDL_EventQ.max_events_seen);
+                SDL_AtomicGet(&SDL_EventQ.max_events_seen));
     }
 
     /* Clean out EventQ */
-    for (entry = SDL_EventQ.head; entry; ) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
-    }
-    for (entry = SDL_EventQ.free; entry; ) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
+    SDL_BlockEventWriters();
+    slots = SDL_EventQ.slots;
+    if (slots) {
+        const Uint32 tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+        Uint32 pos;
+
+        for (pos = SDL_EventQ.head; pos != tail; ++pos) {
+            const Uint32 index = pos & (SDL_EventQ.size - 1);
+            SDL_EventSlot *slot = &slots[index];
+            if (SDL_GetEventSlotSequence(slots, index) == pos + 1 &&
+                !slot->removed && slot->event.type == SDL_SYSWMEVENT) {
+                SDL_free((SDL_SysWMEntry *)slot->event.syswm.msg);
+            }
+        }
+        SDL_AtomicSetPtr((void **)&SDL_EventQ.slots, NULL);
+        SDL_free(slots);
     }
+    SDL_EventQ.size = 0;
     for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; ) {
         SDL_SysWMEntry *next = wmmsg->next;
         SDL_free(wmmsg);
@@ -433,10 +609,10 @@ SDL_StopEventLoop(void)
     }
 
     SDL_AtomicSet(&SDL_EventQ.count, 0);
-    SDL_EventQ.max_events_seen = 0;
-    SDL_EventQ.head = NULL;
-    SDL_EventQ.tail = NULL;
-    SDL_EventQ.free = NULL;
+    SDL_AtomicSet(&SDL_EventQ.tail, 0);
+    SDL_AtomicSet(&SDL_EventQ.max_events_seen, 0);
+    SDL_EventQ.head = 0;
+    SDL_UnblockEventWriters();
     SDL_EventQ.wmmsg_used = NULL;
     SDL_EventQ.wmmsg_free = NULL;
 
@@ -506,84 +682,315 @@ SDL_StartEventLoop(void)
 }
 
 
-/* Add an event to the event queue -- called with the queue locked */
+/* Claim the slot at the tail of the ring, returns SDL_FALSE if the ring is full */
+static SDL_bool
+SDL_ClaimEventSlot(SDL_EventSlot *slots, Uint32 size, Uint32 *pos)
+{
+    *pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+    for (;;) {
+        const int diff = (int)(SDL_GetEventSlotSequence(slots, *pos & (size - 1)) - *pos);
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&SDL_EventQ.tail, (int)*pos, (int)(*pos + 1))) {
+                return SDL_TRUE;
+            }
+        } else if (diff < 0) {
+            /* The reader hasn't released this slot yet */
+            return SDL_FALSE;
+        }
+        *pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+    }
+}
+
+/* Add an event to the event queue -- safe to call from any thread without the queue locked */
 static int
 SDL_AddEvent(SDL_Event * event)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
+    SDL_EventSlot *slots;
+    SDL_SysWMEntry *wmmsg = NULL;
+    Uint32 size, pos, index;
     int final_count;
 
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
+    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
+    if (final_count > SDL_MAX_QUEUED_EVENTS) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        SDL_SetError("Event queue is full (%d events)", final_count - 1);
         return 0;
     }
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (!entry) {
+    if (event->type == SDL_SYSWMEVENT) {
+        /* The free list belongs to the readers, but SysWM events are rare
+           (and off by default), so just take the lock to reuse an entry. */
+        if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+            wmmsg = SDL_EventQ.wmmsg_free;
+            if (wmmsg) {
+                SDL_EventQ.wmmsg_free = wmmsg->next;
+            }
+            if (SDL_EventQ.lock) {
+                SDL_UnlockMutex(SDL_EventQ.lock);
+            }
+        }
+        if (!wmmsg) {
+            wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
+        }
+        if (!wmmsg) {
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            SDL_OutOfMemory();
             return 0;
         }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
+        wmmsg->msg = *event->syswm.msg;
+        wmmsg->next = NULL;
     }
 
+    /* Logged before using the ring, a log callback might queue events too */
     if (SDL_DoEventLogging) {
         SDL_LogEvent(event);
     }
 
-    entry->event = *event;
-    if (event->type == SDL_SYSWMEVENT) {
-        entry->msg = *event->syswm.msg;
-        entry->event.syswm.msg = &entry->msg;
+    /* Claim the slot at the tail of the ring, growing the ring when it's full */
+    for (;;) {
+        slots = SDL_BeginEventWrite(&size);
+        if (slots) {
+            if (SDL_ClaimEventSlot(slots, size, &pos)) {
+                break;
+            }
+            SDL_EndEventWrite();
+        }
+        if (size >= SDL_EVENT_RING_MAX_SIZE) {
+            /* The reader hasn't released this slot yet, the ring is full */
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            SDL_free(wmmsg);
+            SDL_SetError("Event queue is full (%d events)", final_count - 1);
+            return 0;
+        }
+        if (!SDL_GrowEventSlots(size)) {
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            SDL_free(wmmsg);
+            return 0;
+        }
     }
 
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
+    index = pos & (size - 1);
+    slots[index].removed = SDL_FALSE;
+    slots[index].event = *event;
+    if (wmmsg) {
+        slots[index].event.syswm.msg = &wmmsg->msg;
     }
+    SDL_SetEventSlotSequence(slots, index, pos + 1);
+    SDL_EndEventWrite();
 
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    if (final_count > SDL_AtomicGet(&SDL_EventQ.max_events_seen)) {
+        SDL_AtomicSet(&SDL_EventQ.max_events_seen, final_count);
     }
 
     return 1;
 }
 
+/* Get the first event still in the queue at or after *pos, or NULL if there
+   are no more published events -- called with the queue locked */
+static SDL_EventSlot *
+SDL_NextEventSlot(Uint32 *pos, Uint32 tail)
+{
+    SDL_EventSlot *slots = SDL_EventQ.slots;
+
+    for ( ; *pos != tail; ++*pos) {
+        const Uint32 index = *pos & (SDL_EventQ.size - 1);
+        if (SDL_GetEventSlotSequence(slots, index) != *pos + 1) {
+            /* A producer is still filling in this slot, stop here to keep events in order */
+            break;
+        }
+        SDL_MemoryBarrierAcquire();
+        if (!slots[index].removed) {
+            return &slots[index];
+        }
+    }
+    return NULL;
+}
+
 /* Remove an event from the queue -- called with the queue locked */
 static void
-SDL_CutEvent(SDL_EventEntry *entry)
+SDL_CutEvent(SDL_EventSlot *slot)
 {
-    if (entry->prev) {
-        entry->prev->next = entry->next;
+    if (slot->event.type == SDL_SYSWMEVENT) {
+        SDL_SysWMEntry *wmmsg = (SDL_SysWMEntry *)slot->event.syswm.msg;
+        wmmsg->next = SDL_EventQ.wmmsg_free;
+        SDL_EventQ.wmmsg_free = wmmsg;
     }
-    if (entry->next) {
-        entry->next->prev = entry->prev;
+    slot->removed = SDL_TRUE;
+
+    SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
+    SDL_AtomicAdd(&SDL_EventQ.count, -1);
+}
+
+/* Hand removed events at the head of the ring back to the producers -- called with the queue locked */
+static void
+SDL_AdvanceEventHead(SDL_EventSlot *slots)
+{
+    for (;;) {
+        const Uint32 pos = SDL_EventQ.head;
+        const Uint32 index = pos & (SDL_EventQ.size - 1);
+        if (SDL_GetEventSlotSequence(slots, index) != pos + 1 || !slots[index].removed) {
+            break;
+        }
+        SDL_SetEventSlotSequence(slots, index, pos + SDL_EventQ.size);
+        SDL_EventQ.head = pos + 1;
     }
+}
 
-    if (entry == SDL_EventQ.head) {
-        SDL_assert(entry->prev == NULL);
-        SDL_EventQ.head = entry->next;
+/* Slide the unread events up against the newest published one, keeping their
+   order, so the removed slots behind an unread event at the head can be
+   handed back too -- called with the queue locked */
+static void
+SDL_CompactEventSlots(SDL_EventSlot *slots)
+{
+    const Uint32 tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+    Uint32 end, src, dst;
+
+    /* Only published slots can move, producers still own the rest */
+    for (end = SDL_EventQ.head; end != tail; ++end) {
+        if (SDL_GetEventSlotSequence(slots, end & (SDL_EventQ.size - 1)) != end + 1) {
+            break;
+        }
     }
-    if (entry == SDL_EventQ.tail) {
-        SDL_assert(entry->next == NULL);
-        SDL_EventQ.tail = entry->prev;
+    SDL_MemoryBarrierAcquire();
+
+    dst = end;
+    for (src = end; src != SDL_EventQ.head; ) {
+        SDL_EventSlot *from = &slots[--src & (SDL_EventQ.size - 1)];
+        if (!from->removed) {
+            SDL_EventSlot *to = &slots[--dst & (SDL_EventQ.size - 1)];
+            if (to != from) {
+                to->event = from->event;
+                to->removed = SDL_FALSE;
+                from->removed = SDL_TRUE;
+            }
+        }
     }
+}
 
-    entry->next = SDL_EventQ.free;
-    SDL_EventQ.free = entry;
-    SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
-    SDL_AtomicAdd(&SDL_EventQ.count, -1);
+/* Release what we can at the head of the ring, compacting it once enough
+   removed slots are stuck behind an unread event -- called with the queue locked */
+static void
+SDL_ReleaseEventSlots(void)
+{
+    SDL_EventSlot *slots = SDL_EventQ.slots;
+    Uint32 span, count;
+
+    if (!slots) {
+        return;
+    }
+
+    SDL_AdvanceEventHead(slots);
+
+    /* count includes events producers are still adding, so it can be ahead of the tail */
+    span = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail) - SDL_EventQ.head;
+    count = (Uint32)SDL_AtomicGet(&SDL_EventQ.count);
+    if (span > count && (span - count) >= SDL_EventQ.size / 8) {
+        SDL_CompactEventSlots(slots);
+        SDL_AdvanceEventHead(slots);
+    }
+}
+
+/* Merge a motion event into the most recently queued event, if that is still
+   unread and comes from the same device.  Returns SDL_TRUE if it was merged. */
+static SDL_bool
+SDL_CoalesceEvent(const SDL_Event * event)
+{
+    SDL_EventSlot *slots;
+    SDL_bool merged = SDL_FALSE;
+
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+    case SDL_FINGERMOTION:
+    case SDL_JOYAXISMOTION:
+    case SDL_CONTROLLERAXISMOTION:
+        break;
+    default:
+        return SDL_FALSE;
+    }
+
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        return SDL_FALSE;
+    }
+
+    /* Hold off readers while we modify the event in place */
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return SDL_FALSE;
+    }
+
+    slots = SDL_EventQ.slots;
+    if (slots) {
+        const Uint32 tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+        const Uint32 index = (tail - 1) & (SDL_EventQ.size - 1);
+
+        if (tail != SDL_EventQ.head && SDL_GetEventSlotSequence(slots, index) == tail) {
+            SDL_Event *last = &slots[index].event;
+            SDL_Event saved;
+
+            SDL_MemoryBarrierAcquire();
+            saved = *last;
+            if (!slots[index].removed && last->type == event->type) {
+                switch (event->type) {
+                case SDL_MOUSEMOTION:
+                    if (last->motion.windowID == event->motion.windowID &&
+                        last->motion.which == event->motion.which &&
+                        last->motion.state == event->motion.state) {
+                        last->motion.x = event->motion.x;
+                        last->motion.y = event->motion.y;
+                        last->motion.xrel += event->motion.xrel;
+                        last->motion.yrel += event->motion.yrel;
+                        merged = SDL_TRUE;
+                    }
+                    break;
+                case SDL_FINGERMOTION:
+                    if (last->tfinger.touchId == event->tfinger.touchId &&
+                        last->tfinger.fingerId == event->tfinger.fingerId &&
+                        last->tfinger.windowID == event->tfinger.windowID) {
+                        last->tfinger.x = event->tfinger.x;
+                        last->tfinger.y = event->tfinger.y;
+                        last->tfinger.dx += event->tfinger.dx;
+                        last->tfinger.dy += event->tfinger.dy;
+                        last->tfinger.pressure = event->tfinger.pressure;
+                        merged = SDL_TRUE;
+                    }
+                    break;
+                case SDL_JOYAXISMOTION:
+                    if (last->jaxis.which == event->jaxis.which &&
+                        last->jaxis.axis == event->jaxis.axis) {
+                        last->jaxis.value = event->jaxis.value;
+                        merged = SDL_TRUE;
+                    }
+                    break;
+                case SDL_CONTROLLERAXISMOTION:
+                    if (last->caxis.which == event->caxis.which &&
+                        last->caxis.axis == event->caxis.axis) {
+                        last->caxis.value = event->caxis.value;
+                        merged = SDL_TRUE;
+                    }
+                    break;
+                default:
+                    break;
+                }
+                if (merged) {
+                    last->common.timestamp = event->common.timestamp;
+
+                    /* If another producer claimed a slot meanwhile, its event
+                       is newer than the one we merged into but older than
+                       ours, so put things back and queue ours after it.
+                       The CAS is a full barrier, so it can't see the tail
+                       from before the merge. */
+                    if (!SDL_AtomicCAS(&SDL_EventQ.tail, (int)tail, (int)tail)) {
+                        *last = saved;
+                        merged = SDL_FALSE;
+                    }
+                }
+            }
+        }
+    }
+
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    return merged;
 }
 
 /* Lock the event queue, take a peep at it, and unlock it */
@@ -601,61 +1008,72 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
         }
         return (-1);
     }
-    /* Lock the event queue */
     used = 0;
+    if (action == SDL_ADDEVENT) {
+        /* Producers don't need the lock */
+        for (i = 0; i < numevents; ++i) {
+            used += SDL_AddEvent(&events[i]);
+        }
+        return (used);
+    }
+
+    /* Nothing queued, no need to lock */
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        return (used);
+    }
+
+    /* Lock the event queue */
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
-            }
-        } else {
-            SDL_EventEntry *entry, *next;
-            SDL_SysWMEntry *wmmsg, *wmmsg_next;
-            Uint32 type;
-
-            if (action == SDL_GETEVENT) {
-                /* Clean out any used wmmsg data
-                   FIXME: Do we want to retain the data for some period of time?
-                 */
-                for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
-                    wmmsg_next = wmmsg->next;
-                    wmmsg->next = SDL_EventQ.wmmsg_free;
-                    SDL_EventQ.wmmsg_free = wmmsg;
-                }
-                SDL_EventQ.wmmsg_used = NULL;
+        SDL_EventSlot *slot;
+        SDL_SysWMEntry *wmmsg, *wmmsg_next;
+        const Uint32 tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+        Uint32 pos = SDL_EventQ.head;
+        Uint32 type;
+
+        if (action == SDL_GETEVENT) {
+            /* Clean out any used wmmsg data
+               FIXME: Do we want to retain the data for some period of time?
+             */
+            for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
+                wmmsg_next = wmmsg->next;
+                wmmsg->next = SDL_EventQ.wmmsg_free;
+                SDL_EventQ.wmmsg_free = wmmsg;
             }
+            SDL_EventQ.wmmsg_used = NULL;
+        }
 
-            for (entry = SDL_EventQ.head; entry && (!events || used < numevents); entry = next) {
-                next = entry->next;
-                type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        events[used] = entry->event;
-                        if (entry->event.type == SDL_SYSWMEVENT) {
-                            /* We need to copy the wmmsg somewhere safe.
-                               For now we'll guarantee it's valid at least until
-                               the next call to SDL_PeepEvents()
-                             */
-                            if (SDL_EventQ.wmmsg_free) {
-                                wmmsg = SDL_EventQ.wmmsg_free;
-                                SDL_EventQ.wmmsg_free = wmmsg->next;
-                            } else {
-                                wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
-                            }
-                            wmmsg->msg = *entry->event.syswm.msg;
-                            wmmsg->next = SDL_EventQ.wmmsg_used;
-                            SDL_EventQ.wmmsg_used = wmmsg;
-                            events[used].syswm.msg = &wmmsg->msg;
+        while ((!events || used < numevents) && (slot = SDL_NextEventSlot(&pos, tail)) != NULL) {
+            ++pos;
+            type = slot->event.type;
+            if (minType <= type && type <= maxType) {
+                if (events) {
+                    events[used] = slot->event;
+                    if (slot->event.type == SDL_SYSWMEVENT) {
+                        /* We need to copy the wmmsg somewhere safe.
+                           For now we'll guarantee it's valid at least until
+                           the next call to SDL_PeepEvents()
+                         */
+                        if (SDL_EventQ.wmmsg_free) {
+                            wmmsg = SDL_EventQ.wmmsg_free;
+                            SDL_EventQ.wmmsg_free = wmmsg->next;
+                        } else {
+                            wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
                         }
+                        wmmsg->msg = *slot->event.syswm.msg;
+                        wmmsg->next = SDL_EventQ.wmmsg_used;
+                        SDL_EventQ.wmmsg_used = wmmsg;
+                        events[used].syswm.msg = &wmmsg->msg;
+                    }
 
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
-                        }
+                    if (action == SDL_GETEVENT) {
+                        SDL_CutEvent(slot);
                     }
-                    ++used;
                 }
+                ++used;
             }
         }
+        SDL_ReleaseEventSlots();
+
         if (SDL_EventQ.lock) {
             SDL_UnlockMutex(SDL_EventQ.lock);
         }
@@ -703,17 +1121,26 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     SDL_PumpEvents();
 #endif
 
+    /* Nothing queued, no need to lock */
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        return;
+    }
+
     /* Lock the event queue */
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        SDL_EventEntry *entry, *next;
+        SDL_EventSlot *slot;
+        const Uint32 tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+        Uint32 pos = SDL_EventQ.head;
         Uint32 type;
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
+        while ((slot = SDL_NextEventSlot(&pos, tail)) != NULL) {
+            ++pos;
+            type = slot->event.type;
             if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
+                SDL_CutEvent(slot);
             }
         }
+        SDL_ReleaseEventSlots();
+
         if (SDL_EventQ.lock) {
             SDL_UnlockMutex(SDL_EventQ.lock);
         }
@@ -759,6 +1186,22 @@ SDL_PollEvent(SDL_Event * event)
     return SDL_WaitEventTimeout(event, 0);
 }
 
+int
+SDL_PollEvents(SDL_Event * events, int numevents)
+{
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents <= 0) {
+        return 0;
+    }
+
+    SDL_PumpEvents();
+
+    /* Drain as many events as will fit with a single trip through the queue lock */
+    return SDL_PeepEvents(events, numevents, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+}
+
 int
 SDL_WaitEvent(SDL_Event * event)
 {
@@ -841,8 +1284,10 @@ SDL_PushEvent(SDL_Event * event)
         }
     }
 
-    if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
-        return -1;
+    if (!SDL_DoEventCoalescing || !SDL_CoalesceEvent(event)) {
+        if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
+            return -1;
+        }
     }
 
     SDL_GestureProcessEvent(event);
@@ -943,14 +1388,24 @@ SDL_DelEventWatch(SDL_EventFilter filter, void *userdata)
 void
 SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
+    if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
+        return;
+    }
+
     if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        SDL_EventEntry *entry, *next;
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            if (!filter(userdata, &entry->event)) {
-                SDL_CutEvent(entry);
+        SDL_EventSlot *slot;
+        const Uint32 tail = (Uint32)SDL_AtomicGet(&SDL_EventQ.tail);
+        Uint32 pos = SDL_EventQ.head;
+        SDL_EventQ.filtering = SDL_TRUE;
+        while ((slot = SDL_NextEventSlot(&pos, tail)) != NULL) {
+            ++pos;
+            if (!filter(userdata, &slot->event)) {
+                SDL_CutEvent(slot);
             }
         }
+        SDL_EventQ.filtering = SDL_FALSE;
+        SDL_ReleaseEventSlots();
+
         if (SDL_EventQ.lock) {
             SDL_UnlockMutex(SDL_EventQ.lock);
         }
@@ -1084,7 +1539,9 @@ SDL_EventsInit(void)
     SDL_AddHintCallback(SDL_HINT_AUTO_UPDATE_SENSORS, SDL_AutoUpdateSensorsChanged, NULL);
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
     if (SDL_StartEventLoop() < 0) {
+        SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return -1;
     }
@@ -1099,6 +1556,7 @@ SDL_EventsQuit(void)
 {
     SDL_QuitQuit();
     SDL_StopEventLoop();
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #if !SDL_JOYSTICK_DISABLED
     SDL_DelHintCallback(SDL_HINT_AUTO_UPDATE_JOYSTICKS, SDL_AutoUpdateJoysticksChanged, NULL);
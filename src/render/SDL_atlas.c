@@ -0,0 +1,567 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Texture atlases: many small images packed into a few large textures */
+
+#include "SDL_render.h"
+
+/* Empty pixels kept to the right of and below every image, so linear
+   filtering doesn't pick up its neighbours */
+#define ATLAS_PADDING   1
+
+/* One segment of the skyline: the lowest free row over [x, x + w) */
+typedef struct
+{
+    int x;
+    int y;
+    int w;
+} SDL_AtlasNode;
+
+typedef struct
+{
+    SDL_Texture *texture;
+    SDL_Surface *surface;       /* the pixels, kept for defragmenting */
+    SDL_AtlasNode *skyline;
+    int num_nodes;
+    int max_nodes;
+    int num_images;
+    SDL_Rect dirty;             /* not uploaded to the texture yet, empty if w == 0 */
+} SDL_AtlasPage;
+
+typedef struct
+{
+    int page;                   /* -1 if the slot is free */
+    SDL_Rect rect;              /* for a free slot, rect.x is the next free slot */
+} SDL_AtlasImage;
+
+struct SDL_TextureAtlas
+{
+    SDL_Renderer *renderer;
+    Uint32 format;
+    int page_w;
+    int page_h;
+
+    SDL_AtlasPage *pages;
+    int num_pages;
+
+    SDL_AtlasImage *images;
+    int num_images;
+    int max_images;
+    int free_image;             /* first free slot, -1 if none */
+};
+
+static void
+ResetSkyline(SDL_AtlasPage *page, int w)
+{
+    page->skyline[0].x = 0;
+    page->skyline[0].y = 0;
+    page->skyline[0].w = w;
+    page->num_nodes = 1;
+}
+
+static int
+CreateAtlasPage(SDL_TextureAtlas *atlas)
+{
+    SDL_AtlasPage *pages;
+    SDL_AtlasPage *page;
+
+    pages = (SDL_AtlasPage *) SDL_realloc(atlas->pages, (atlas->num_pages + 1) * sizeof (*pages));
+    if (!pages) {
+        return SDL_OutOfMemory();
+    }
+    atlas->pages = pages;
+
+    page = &pages[atlas->num_pages];
+    SDL_zerop(page);
+
+    /* Every segment is at least a pixel wide, plus one while inserting */
+    page->max_nodes = atlas->page_w + 1;
+    page->skyline = (SDL_AtlasNode *) SDL_malloc(page->max_nodes * sizeof (SDL_AtlasNode));
+    if (!page->skyline) {
+        return SDL_OutOfMemory();
+    }
+    ResetSkyline(page, atlas->page_w);
+
+    page->surface = SDL_CreateRGBSurfaceWithFormat(0, atlas->page_w, atlas->page_h, 0, atlas->format);
+    if (!page->surface) {
+        SDL_free(page->skyline);
+        return -1;
+    }
+
+    page->texture = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->page_w, atlas->page_h);
+    if (!page->texture) {
+        SDL_FreeSurface(page->surface);
+        SDL_free(page->skyline);
+        return -1;
+    }
+    SDL_SetTextureBlendMode(page->texture, SDL_BLENDMODE_BLEND);
+
+    /* Upload the cleared page the first time it is used */
+    page->dirty.w = atlas->page_w;
+    page->dirty.h = atlas->page_h;
+
+    return atlas->num_pages++;
+}
+
+static void
+DestroyAtlasPage(SDL_AtlasPage *page)
+{
+    SDL_DestroyTexture(page->texture);
+    SDL_FreeSurface(page->surface);
+    SDL_free(page->skyline);
+}
+
+/* Returns the lowest row a w pixel wide image can go at skyline[index].x,
+   or -1 if it runs off the page */
+static int
+SkylineFit(const SDL_AtlasPage *page, int index, int w, int h, int page_w, int page_h)
+{
+    const SDL_AtlasNode *node = &page->skyline[index];
+    int x = node->x;
+    int y = 0;
+    int left = w;
+
+    if (x + w > page_w) {
+        return -1;
+    }
+    while (left > 0) {
+        if (node->y > y) {
+            y = node->y;
+        }
+        if (y + h > page_h) {
+            return -1;
+        }
+        left -= node->w;
+        ++node;
+    }
+    return y;
+}
+
+/* Places the skyline segment for a new image at skyline[index] */
+static void
+SkylineInsert(SDL_AtlasPage *page, int index, int x, int y, int w)
+{
+    SDL_AtlasNode *skyline = page->skyline;
+    int i;
+
+    SDL_memmove(&skyline[index + 1], &skyline[index], (page->num_nodes - index) * sizeof (*skyline));
+    skyline[index].x = x;
+    skyline[index].y = y;
+    skyline[index].w = w;
+    page->num_nodes++;
+
+    /* Cut the segments that are now covered */
+    for (i = index + 1; i < page->num_nodes; ) {
+        const int right = skyline[i - 1].x + skyline[i - 1].w;
+        if (skyline[i].x >= right) {
+            break;
+        }
+        if (skyline[i].x + skyline[i].w <= right) {
+            SDL_memmove(&skyline[i], &skyline[i + 1], (page->num_nodes - i - 1) * sizeof (*skyline));
+            page->num_nodes--;
+        } else {
+            skyline[i].w -= right - skyline[i].x;
+            skyline[i].x = right;
+            break;
+        }
+    }
+
+    /* Merge neighbours at the same height */
+    for (i = 0; i < page->num_nodes - 1; ) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].w += skyline[i + 1].w;
+            SDL_memmove(&skyline[i + 1], &skyline[i + 2], (page->num_nodes - i - 2) * sizeof (*skyline));
+            page->num_nodes--;
+        } else {
+            ++i;
+        }
+    }
+}
+
+/* Bottom-left skyline packing: the spot where the image's bottom edge is
+   lowest, ties going to the narrowest segment */
+static SDL_bool
+SkylinePack(SDL_AtlasPage *page, int w, int h, int page_w, int page_h, SDL_Rect *rect)
+{
+    int best_index = -1;
+    int best_bottom = page_h + 1;
+    int best_w = page_w + 1;
+    int best_y = 0;
+    int i;
+
+    for (i = 0; i < page->num_nodes; ++i) {
+        const int y = SkylineFit(page, i, w, h, page_w, page_h);
+        if (y >= 0) {
+            const int bottom = y + h;
+            if (bottom < best_bottom || (bottom == best_bottom && page->skyline[i].w < best_w)) {
+                best_index = i;
+                best_bottom = bottom;
+                best_w = page->skyline[i].w;
+                best_y = y;
+            }
+        }
+    }
+    if (best_index < 0) {
+        return SDL_FALSE;
+    }
+
+    rect->x = page->skyline[best_index].x;
+    rect->y = best_y;
+    SkylineInsert(page, best_index, rect->x, best_y + h, w);
+    return SDL_TRUE;
+}
+
+/* Finds room for a w x h image, adding a page if needed, and returns the page */
+static int
+AllocateAtlasRect(SDL_TextureAtlas *atlas, int w, int h, SDL_Rect *rect)
+{
+    const int padded_w = SDL_min(w + ATLAS_PADDING, atlas->page_w);
+    const int padded_h = SDL_min(h + ATLAS_PADDING, atlas->page_h);
+    int i;
+
+    for (i = 0; i < atlas->num_pages; ++i) {
+        if (SkylinePack(&atlas->pages[i], padded_w, padded_h, atlas->page_w, atlas->page_h, rect)) {
+            break;
+        }
+    }
+    if (i == atlas->num_pages) {
+        i = CreateAtlasPage(atlas);
+        if (i < 0) {
+            return -1;
+        }
+        if (!SkylinePack(&atlas->pages[i], padded_w, padded_h, atlas->page_w, atlas->page_h, rect)) {
+            return SDL_SetError("Couldn't pack image");  /* can't happen, it fits an empty page */
+        }
+    }
+    rect->w = w;
+    rect->h = h;
+    atlas->pages[i].num_images++;
+    return i;
+}
+
+static void
+CopyAtlasPixels(SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Surface *src, int srcx, int srcy)
+{
+    const int bpp = dst->format->BytesPerPixel;
+    const Uint8 *srcrow = (const Uint8 *) src->pixels + srcy * src->pitch + srcx * bpp;
+    Uint8 *dstrow = (Uint8 *) dst->pixels + dstrect->y * dst->pitch + dstrect->x * bpp;
+    const size_t length = (size_t) dstrect->w * bpp;
+    int row;
+
+    for (row = 0; row < dstrect->h; ++row) {
+        SDL_memcpy(dstrow, srcrow, length);
+        srcrow += src->pitch;
+        dstrow += dst->pitch;
+    }
+}
+
+static void
+AddAtlasDirtyRect(SDL_AtlasPage *page, const SDL_Rect *rect)
+{
+    if (page->dirty.w == 0) {
+        page->dirty = *rect;
+    } else {
+        SDL_UnionRect(&page->dirty, rect, &page->dirty);
+    }
+}
+
+SDL_TextureAtlas *
+SDL_CreateTextureAtlas(SDL_Renderer * renderer, Uint32 format, int w, int h)
+{
+    SDL_TextureAtlas *atlas;
+    SDL_RendererInfo info;
+
+    if (SDL_GetRendererInfo(renderer, &info) < 0) {
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_SetError("Texture atlases need a packed pixel format");
+        return NULL;
+    }
+    if (w <= 0 || h <= 0) {
+        SDL_InvalidParamError("w");
+        return NULL;
+    }
+    if ((info.max_texture_width && w > info.max_texture_width) ||
+        (info.max_texture_height && h > info.max_texture_height)) {
+        SDL_SetError("Texture dimensions are limited to %dx%d", info.max_texture_width, info.max_texture_height);
+        return NULL;
+    }
+
+    atlas = (SDL_TextureAtlas *) SDL_calloc(1, sizeof (*atlas));
+    if (!atlas) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    atlas->renderer = renderer;
+    atlas->format = format;
+    atlas->page_w = w;
+    atlas->page_h = h;
+    atlas->free_image = -1;
+    return atlas;
+}
+
+int
+SDL_AddTextureAtlasImage(SDL_TextureAtlas * atlas, SDL_Surface * surface)
+{
+    SDL_Surface *converted = NULL;
+    SDL_AtlasImage *image;
+    SDL_Rect rect;
+    int page;
+    int id;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (surface->w <= 0 || surface->h <= 0) {
+        return SDL_SetError("Image is empty");
+    }
+    if (surface->w > atlas->page_w || surface->h > atlas->page_h) {
+        return SDL_SetError("Image is larger than the atlas pages");
+    }
+
+    /* Get a slot for the image first, nothing is left to undo if it fails */
+    if (atlas->free_image < 0 && atlas->num_images == atlas->max_images) {
+        const int max_images = atlas->max_images ? atlas->max_images * 2 : 64;
+        SDL_AtlasImage *images = (SDL_AtlasImage *) SDL_realloc(atlas->images, max_images * sizeof (*images));
+        if (!images) {
+            return SDL_OutOfMemory();
+        }
+        atlas->images = images;
+        atlas->max_images = max_images;
+    }
+
+    if (surface->format->format != atlas->format || SDL_MUSTLOCK(surface)) {
+        converted = SDL_ConvertSurfaceFormat(surface, atlas->format, 0);
+        if (!converted) {
+            return -1;
+        }
+        surface = converted;
+    }
+
+    page = AllocateAtlasRect(atlas, surface->w, surface->h, &rect);
+    if (page < 0) {
+        SDL_FreeSurface(converted);
+        return -1;
+    }
+    CopyAtlasPixels(atlas->pages[page].surface, &rect, surface, 0, 0);
+    AddAtlasDirtyRect(&atlas->pages[page], &rect);
+    SDL_FreeSurface(converted);
+
+    if (atlas->free_image >= 0) {
+        id = atlas->free_image;
+        atlas->free_image = atlas->images[id].rect.x;
+    } else {
+        id = atlas->num_images++;
+    }
+    image = &atlas->images[id];
+    image->page = page;
+    image->rect = rect;
+    return id;
+}
+
+int
+SDL_RemoveTextureAtlasImage(SDL_TextureAtlas * atlas, int id)
+{
+    SDL_AtlasImage *image;
+    SDL_AtlasPage *page;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    if (id < 0 || id >= atlas->num_images || atlas->images[id].page < 0) {
+        return SDL_InvalidParamError("id");
+    }
+
+    image = &atlas->images[id];
+    page = &atlas->pages[image->page];
+    if (--page->num_images == 0) {
+        /* The whole page is free again, no need to wait for a defragment.
+           The old pixels are cleared too, or the next images would have
+           them in their padding, where linear filtering picks them up. */
+        ResetSkyline(page, atlas->page_w);
+        SDL_FillRect(page->surface, NULL, 0);
+        page->dirty.x = 0;
+        page->dirty.y = 0;
+        page->dirty.w = atlas->page_w;
+        page->dirty.h = atlas->page_h;
+    }
+
+    image->page = -1;
+    image->rect.x = atlas->free_image;
+    atlas->free_image = id;
+    return 0;
+}
+
+int
+SDL_GetTextureAtlasImage(SDL_TextureAtlas * atlas, int id, SDL_Texture ** texture, SDL_Rect * rect)
+{
+    SDL_AtlasImage *image;
+    SDL_AtlasPage *page;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    if (id < 0 || id >= atlas->num_images || atlas->images[id].page < 0) {
+        return SDL_InvalidParamError("id");
+    }
+
+    image = &atlas->images[id];
+    page = &atlas->pages[image->page];
+    if (page->dirty.w > 0) {
+        const SDL_Rect *dirty = &page->dirty;
+        const Uint8 *pixels = (const Uint8 *) page->surface->pixels +
+                              dirty->y * page->surface->pitch +
+                              dirty->x * page->surface->format->BytesPerPixel;
+        if (SDL_UpdateTexture(page->texture, dirty, pixels, page->surface->pitch) < 0) {
+            return -1;
+        }
+        SDL_zero(page->dirty);
+    }
+
+    if (texture) {
+        *texture = page->texture;
+    }
+    if (rect) {
+        *rect = image->rect;
+    }
+    return 0;
+}
+
+typedef struct
+{
+    int id;
+    int w;
+    int h;
+} SDL_AtlasSortItem;
+
+static int SDLCALL
+CompareAtlasSortItems(const void *a, const void *b)
+{
+    const SDL_AtlasSortItem *A = (const SDL_AtlasSortItem *) a;
+    const SDL_AtlasSortItem *B = (const SDL_AtlasSortItem *) b;
+    if (A->h != B->h) {
+        return B->h - A->h;
+    }
+    if (A->w != B->w) {
+        return B->w - A->w;
+    }
+    return A->id - B->id;
+}
+
+int
+SDL_DefragmentTextureAtlas(SDL_TextureAtlas * atlas)
+{
+    SDL_AtlasSortItem *items;
+    SDL_AtlasPage *old_pages;
+    SDL_Rect *rects;
+    int *new_page;
+    int num_old_pages;
+    int num_items = 0;
+    int retval = 0;
+    int i;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+
+    items = (SDL_AtlasSortItem *) SDL_malloc(SDL_max(atlas->num_images, 1) * (sizeof (*items) + sizeof (*rects) + sizeof (*new_page)));
+    if (!items) {
+        return SDL_OutOfMemory();
+    }
+    rects = (SDL_Rect *) &items[SDL_max(atlas->num_images, 1)];
+    new_page = (int *) &rects[SDL_max(atlas->num_images, 1)];
+
+    for (i = 0; i < atlas->num_images; ++i) {
+        if (atlas->images[i].page >= 0) {
+            items[num_items].id = i;
+            items[num_items].w = atlas->images[i].rect.w;
+            items[num_items].h = atlas->images[i].rect.h;
+            ++num_items;
+        }
+    }
+
+    /* Tallest first packs a skyline tightly */
+    SDL_qsort(items, num_items, sizeof (*items), CompareAtlasSortItems);
+
+    /* Pack into fresh pages, the old ones still have the pixels */
+    old_pages = atlas->pages;
+    num_old_pages = atlas->num_pages;
+    atlas->pages = NULL;
+    atlas->num_pages = 0;
+
+    for (i = 0; i < num_items; ++i) {
+        new_page[i] = AllocateAtlasRect(atlas, items[i].w, items[i].h, &rects[i]);
+        if (new_page[i] < 0) {
+            retval = -1;
+            break;
+        }
+    }
+
+    if (retval < 0) {
+        /* Keep the old layout */
+        for (i = 0; i < atlas->num_pages; ++i) {
+            DestroyAtlasPage(&atlas->pages[i]);
+        }
+        SDL_free(atlas->pages);
+        atlas->pages = old_pages;
+        atlas->num_pages = num_old_pages;
+        SDL_free(items);
+        return -1;
+    }
+
+    for (i = 0; i < num_items; ++i) {
+        SDL_AtlasImage *image = &atlas->images[items[i].id];
+        CopyAtlasPixels(atlas->pages[new_page[i]].surface, &rects[i],
+                        old_pages[image->page].surface, image->rect.x, image->rect.y);
+        image->page = new_page[i];
+        image->rect = rects[i];
+    }
+
+    for (i = 0; i < num_old_pages; ++i) {
+        DestroyAtlasPage(&old_pages[i]);
+    }
+    SDL_free(old_pages);
+    SDL_free(items);
+    return 0;
+}
+
+void
+SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas)
+{
+    int i;
+
+    if (!atlas) {
+        return;
+    }
+    for (i = 0; i < atlas->num_pages; ++i) {
+        DestroyAtlasPage(&atlas->pages[i]);
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas->images);
+    SDL_free(atlas);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -198,12 +198,347 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
                         (int) cmd->data.draw.b, (int) cmd->data.draw.a,
                         (int) cmd->data.draw.blend, cmd->data.draw.texture);
                 break;
+
+            case SDL_RENDERCMD_GEOMETRY:
+                SDL_Log(" %u. geometry (first=%u, count=%u, r=%d, g=%d, b=%d, a=%d, blend=%d, tex=%p)", i++,
+                        (unsigned int) cmd->data.draw.first,
+                        (unsigned int) cmd->data.draw.count,
+                        (int) cmd->data.draw.r, (int) cmd->data.draw.g,
+                        (int) cmd->data.draw.b, (int) cmd->data.draw.a,
+                        (int) cmd->data.draw.blend, cmd->data.draw.texture);
+                break;
         }
         cmd = cmd->next;
     }
 #endif
 }
 
+/* How far back a draw may move to join an earlier draw with the same state */
+#define OPTIMIZE_BATCH_WINDOW   64
+
+typedef struct
+{
+    SDL_RenderCommand *cmd;
+    Uint32 color;  /* the draw color in effect when the command was queued */
+} SDL_RenderQueueItem;
+
+static SDL_bool
+IsDrawCommand(const SDL_RenderCommand *cmd)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            return SDL_TRUE;
+        default:
+            return SDL_FALSE;
+    }
+}
+
+static SDL_bool
+SameDrawState(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    return (a->command == b->command &&
+            a->data.draw.texture == b->data.draw.texture &&
+            a->data.draw.blend == b->data.draw.blend &&
+            a->data.draw.r == b->data.draw.r &&
+            a->data.draw.g == b->data.draw.g &&
+            a->data.draw.b == b->data.draw.b &&
+            a->data.draw.a == b->data.draw.a) ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_bool
+DrawsOverlap(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    const SDL_FRect *A = &a->data.draw.bounds;
+    const SDL_FRect *B = &b->data.draw.bounds;
+
+    if (A->w < 0.0f || B->w < 0.0f) {
+        return SDL_TRUE;  /* we don't know where one of them lands */
+    }
+    return (A->x < B->x + B->w && B->x < A->x + A->w &&
+            A->y < B->y + B->h && B->y < A->y + A->h) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Copy the vertex data of the draws into a new buffer in queue order, so
+   draws that were moved next to each other have contiguous data again. */
+static void
+RepackRenderVertices(SDL_Renderer *renderer)
+{
+    Uint8 *vertices;
+    size_t used = 0;
+    SDL_RenderCommand *cmd;
+
+    if (renderer->MapVertexData) {
+        return;  /* mapped vertex data may be write-only */
+    }
+
+    vertices = (Uint8 *) SDL_malloc(renderer->vertex_data_allocation);
+    if (!vertices) {
+        return;  /* the moved draws just won't be merged */
+    }
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        if (IsDrawCommand(cmd)) {
+            SDL_memcpy(vertices + used, (Uint8 *) renderer->vertex_data + cmd->data.draw.first, cmd->data.draw.size);
+            cmd->data.draw.first = used;
+            used += cmd->data.draw.size;
+        }
+    }
+    SDL_assert(used <= renderer->vertex_data_used);
+
+    SDL_free(renderer->vertex_data);
+    renderer->vertex_data = vertices;
+    renderer->vertex_data_used = used;
+}
+
+/* Merge adjacent draws with the same state whose vertex data is contiguous */
+static void
+MergeRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        SDL_RenderCommand *next;
+
+        if ((renderer->mergeable_commands & (1 << cmd->command)) == 0) {
+            continue;
+        }
+
+        while ((next = cmd->next) != NULL &&
+               SameDrawState(cmd, next) &&
+               next->data.draw.first == cmd->data.draw.first + cmd->data.draw.size) {
+            cmd->data.draw.count += next->data.draw.count;
+            cmd->data.draw.size += next->data.draw.size;
+            cmd->next = next->next;
+            if (renderer->render_commands_tail == next) {
+                renderer->render_commands_tail = cmd;
+            }
+            next->next = renderer->render_commands_pool;
+            renderer->render_commands_pool = next;
+        }
+    }
+}
+
+/* Move each draw back to the last earlier draw with the same texture, blend
+   mode and color, as long as it doesn't overlap any of the draws in between,
+   then merge what ended up next to each other. Draws never move across
+   viewport, clip rect or clear commands, and SETDRAWCOLOR commands are
+   rebuilt to match the new order. If anything goes wrong along the way the
+   queue is left as it was. */
+static void
+OptimizeRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderQueueItem *items = (SDL_RenderQueueItem *) renderer->optimize_items;
+    SDL_RenderCommand *cmd, *next;
+    SDL_RenderCommand *spare = NULL;
+    SDL_RenderCommand *tail = NULL;
+    SDL_bool have_color = SDL_FALSE;
+    SDL_bool moved = SDL_FALSE;
+    Uint32 color = 0;
+    int numitems = 0;
+    int numspare = 0;
+    int needed = 0;
+    int i, j;
+
+    /* Gather everything but the color commands, which get rebuilt */
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        if (cmd->command == SDL_RENDERCMD_SETDRAWCOLOR) {
+            color = ((cmd->data.color.a << 24) | (cmd->data.color.r << 16) | (cmd->data.color.g << 8) | cmd->data.color.b);
+            have_color = SDL_TRUE;
+            ++numspare;
+            continue;
+        }
+        if (cmd->command == SDL_RENDERCMD_NO_OP) {
+            ++numspare;
+            continue;
+        }
+        if (IsDrawCommand(cmd) && !have_color) {
+            return;  /* shouldn't happen, every batch sets its draw color first */
+        }
+
+        if (numitems == renderer->optimize_items_allocation) {
+            const int newsize = numitems ? (numitems * 2) : 128;
+            items = (SDL_RenderQueueItem *) SDL_realloc(items, newsize * sizeof (*items));
+            if (!items) {
+                return;
+            }
+            renderer->optimize_items = items;
+            renderer->optimize_items_allocation = newsize;
+        }
+        items[numitems].cmd = cmd;
+        items[numitems].color = color;
+        ++numitems;
+    }
+
+    for (i = 1; i < numitems; ++i) {
+        const SDL_RenderQueueItem item = items[i];
+
+        if (!IsDrawCommand(item.cmd)) {
+            continue;
+        }
+
+        for (j = i - 1; j >= 0 && j >= (i - OPTIMIZE_BATCH_WINDOW); --j) {
+            const SDL_RenderCommand *other = items[j].cmd;
+
+            if (!IsDrawCommand(other)) {
+                break;
+            }
+            if (items[j].color == item.color && SameDrawState(other, item.cmd)) {
+                if (j != (i - 1)) {
+                    SDL_memmove(&items[j + 2], &items[j + 1], (i - j - 1) * sizeof (*items));
+                    items[j + 1] = item;
+                    moved = SDL_TRUE;
+                }
+                break;
+            }
+            if (DrawsOverlap(other, item.cmd)) {
+                break;
+            }
+        }
+    }
+
+    if (!moved) {
+        MergeRenderCommands(renderer);
+        return;
+    }
+
+    /* Make sure we have enough commands to set the colors in the new order */
+    have_color = SDL_FALSE;
+    for (i = 0; i < numitems; ++i) {
+        if (IsDrawCommand(items[i].cmd) && (!have_color || items[i].color != color)) {
+            color = items[i].color;
+            have_color = SDL_TRUE;
+            ++needed;
+        }
+    }
+    while (numspare < needed) {
+        cmd = renderer->render_commands_pool;
+        if (cmd) {
+            renderer->render_commands_pool = cmd->next;
+        } else {
+            cmd = (SDL_RenderCommand *) SDL_calloc(1, sizeof (*cmd));
+            if (!cmd) {
+                /* Give back what we took and draw things in the original order */
+                while (spare) {
+                    next = spare->next;
+                    spare->next = renderer->render_commands_pool;
+                    renderer->render_commands_pool = spare;
+                    spare = next;
+                }
+                MergeRenderCommands(renderer);
+                return;
+            }
+        }
+        cmd->next = spare;
+        spare = cmd;
+        ++numspare;
+    }
+
+    /* Rebuild the queue */
+    for (cmd = renderer->render_commands; cmd; cmd = next) {
+        next = cmd->next;
+        if (cmd->command == SDL_RENDERCMD_SETDRAWCOLOR || cmd->command == SDL_RENDERCMD_NO_OP) {
+            cmd->next = spare;
+            spare = cmd;
+        }
+    }
+
+    have_color = SDL_FALSE;
+    renderer->render_commands = NULL;
+    for (i = 0; i < numitems; ++i) {
+        cmd = items[i].cmd;
+        if (IsDrawCommand(cmd) && (!have_color || items[i].color != color)) {
+            SDL_RenderCommand *setcolor = spare;
+            SDL_assert(setcolor != NULL);
+            spare = setcolor->next;
+
+            color = items[i].color;
+            have_color = SDL_TRUE;
+            setcolor->command = SDL_RENDERCMD_SETDRAWCOLOR;
+            setcolor->data.color.first = 0;
+            setcolor->data.color.a = (Uint8) (color >> 24);
+            setcolor->data.color.r = (Uint8) (color >> 16);
+            setcolor->data.color.g = (Uint8) (color >> 8);
+            setcolor->data.color.b = (Uint8) color;
+            if (tail) {
+                tail->next = setcolor;
+            } else {
+                renderer->render_commands = setcolor;
+            }
+            tail = setcolor;
+        }
+        if (tail) {
+            tail->next = cmd;
+        } else {
+            renderer->render_commands = cmd;
+        }
+        tail = cmd;
+    }
+    tail->next = NULL;
+    renderer->render_commands_tail = tail;
+
+    while (spare) {
+        next = spare->next;
+        spare->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = spare;
+        spare = next;
+    }
+
+    if (renderer->mergeable_commands) {
+        RepackRenderVertices(renderer);
+        MergeRenderCommands(renderer);
+    }
+}
+
+static void
+CountRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+    const SDL_RenderCommand *cmd;
+    Uint32 texture_id;
+
+    stats->flushes++;
+    stats->vertex_bytes += renderer->vertex_data_used;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+            case SDL_RENDERCMD_NO_OP:
+                continue;
+
+            case SDL_RENDERCMD_SETVIEWPORT:
+            case SDL_RENDERCMD_SETCLIPRECT:
+            case SDL_RENDERCMD_SETDRAWCOLOR:
+                stats->state_changes++;
+                break;
+
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS:
+            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY_EX:
+            case SDL_RENDERCMD_GEOMETRY:
+                if (cmd->data.draw.blend != renderer->stats_blend) {
+                    renderer->stats_blend = cmd->data.draw.blend;
+                    stats->state_changes++;
+                }
+                texture_id = cmd->data.draw.texture ? cmd->data.draw.texture->id : 0;
+                if (texture_id != renderer->stats_texture_id) {
+                    renderer->stats_texture_id = texture_id;
+                    stats->texture_switches++;
+                }
+                break;
+
+            default:
+                break;
+        }
+        stats->commands++;
+    }
+}
+
 static int
 FlushRenderCommands(SDL_Renderer *renderer)
 {
@@ -216,10 +551,21 @@ FlushRenderCommands(SDL_Renderer *renderer)
         return 0;
     }
 
+    if (renderer->optimize_batches) {
+        OptimizeRenderCommands(renderer);
+    }
+
     DebugLogRenderCommands(renderer->render_commands);
+    CountRenderCommands(renderer);
 
     retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
 
+    if (renderer->MapVertexData) {
+        /* the backend is done with it, the next batch maps new vertex data */
+        renderer->vertex_data = NULL;
+        renderer->vertex_data_allocation = 0;
+    }
+
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
     if (renderer->render_commands_tail != NULL) {
         renderer->render_commands_tail->next = renderer->render_commands_pool;
@@ -258,6 +604,29 @@ SDL_RenderFlush(SDL_Renderer * renderer)
     return FlushRenderCommands(renderer);
 }
 
+int
+SDL_RenderGetDamageRects(SDL_Renderer * renderer, SDL_Rect * rects, int maxrects)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->GetDamageRects) {
+        return SDL_Unsupported();
+    }
+    return renderer->GetDamageRects(renderer, rects, maxrects);
+}
+
+int
+SDL_GetRenderStats(SDL_Renderer * renderer, SDL_RenderStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    *stats = renderer->last_stats;
+    return 0;
+}
+
 void *
 SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
 {
@@ -274,10 +643,20 @@ SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const
         while (newsize < needed) {
             newsize *= 2;
         }
-        ptr = SDL_realloc(renderer->vertex_data, newsize);
-        if (ptr == NULL) {
-            SDL_OutOfMemory();
-            return NULL;
+        if (renderer->MapVertexData) {
+            ptr = renderer->MapVertexData(renderer, current_offset, newsize, &newsize);
+            if (ptr == NULL) {
+                /* the old mapping is gone too, the backend kept what was queued */
+                renderer->vertex_data = NULL;
+                renderer->vertex_data_allocation = 0;
+                return NULL;
+            }
+        } else {
+            ptr = SDL_realloc(renderer->vertex_data, newsize);
+            if (ptr == NULL) {
+                SDL_OutOfMemory();
+                return NULL;
+            }
         }
         renderer->vertex_data = ptr;
         renderer->vertex_data_allocation = newsize;
@@ -428,6 +807,49 @@ PrepQueueCmdDraw(SDL_Renderer *renderer, const Uint8 r, const Uint8 g, const Uin
     return retval;
 }
 
+/* Remember where a draw lands and how much vertex data it used, for
+   OptimizeRenderCommands(). The bounds are padded a little, since the
+   backends round coordinates in their own ways. */
+static void
+SetDrawBounds(SDL_Renderer *renderer, SDL_RenderCommand *cmd, float minx, float miny, float maxx, float maxy)
+{
+    cmd->data.draw.bounds.x = minx - 2.0f;
+    cmd->data.draw.bounds.y = miny - 2.0f;
+    cmd->data.draw.bounds.w = (maxx - minx) + 4.0f;
+    cmd->data.draw.bounds.h = (maxy - miny) + 4.0f;
+    cmd->data.draw.size = renderer->vertex_data_used - cmd->data.draw.first;
+}
+
+static void
+SetDrawBoundsFromPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const SDL_FPoint * points, const int count)
+{
+    float minx = 0.0f, miny = 0.0f, maxx = 0.0f, maxy = 0.0f;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (i == 0 || points[i].x < minx) minx = points[i].x;
+        if (i == 0 || points[i].y < miny) miny = points[i].y;
+        if (i == 0 || points[i].x > maxx) maxx = points[i].x;
+        if (i == 0 || points[i].y > maxy) maxy = points[i].y;
+    }
+    SetDrawBounds(renderer, cmd, minx, miny, maxx + 1.0f, maxy + 1.0f);
+}
+
+static void
+SetDrawBoundsFromRects(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const SDL_FRect * rects, const int count)
+{
+    float minx = 0.0f, miny = 0.0f, maxx = 0.0f, maxy = 0.0f;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (i == 0 || rects[i].x < minx) minx = rects[i].x;
+        if (i == 0 || rects[i].y < miny) miny = rects[i].y;
+        if (i == 0 || rects[i].x + rects[i].w > maxx) maxx = rects[i].x + rects[i].w;
+        if (i == 0 || rects[i].y + rects[i].h > maxy) maxy = rects[i].y + rects[i].h;
+    }
+    SetDrawBounds(renderer, cmd, minx, miny, maxx, maxy);
+}
+
 static SDL_RenderCommand *
 PrepQueueCmdDrawSolid(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtype)
 {
@@ -445,6 +867,8 @@ PrepQueueCmdDrawSolid(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtyp
             cmd->data.draw.a = renderer->a;
             cmd->data.draw.blend = renderer->blendMode;
             cmd->data.draw.texture = NULL;  /* no texture. */
+            cmd->data.draw.bounds.w = -1.0f;  /* set after queueing when optimizing batches. */
+            cmd->data.draw.size = 0;
         }
     }
     return cmd;
@@ -459,6 +883,8 @@ QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint * points, const int
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            SetDrawBoundsFromPoints(renderer, cmd, points, count);
         }
     }
     return retval;
@@ -473,6 +899,8 @@ QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint * points, const int c
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            SetDrawBoundsFromPoints(renderer, cmd, points, count);
         }
     }
     return retval;
@@ -487,6 +915,8 @@ QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int cou
         retval = renderer->QueueFillRects(renderer, cmd, rects, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            SetDrawBoundsFromRects(renderer, cmd, rects, count);
         }
     }
     return retval;
@@ -509,6 +939,8 @@ PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_
             cmd->data.draw.a = texture->a;
             cmd->data.draw.blend = texture->blendMode;
             cmd->data.draw.texture = texture;
+            cmd->data.draw.bounds.w = -1.0f;  /* set after queueing when optimizing batches. */
+            cmd->data.draw.size = 0;
         }
     }
     return cmd;
@@ -523,6 +955,38 @@ QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * src
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            SetDrawBoundsFromRects(renderer, cmd, dstrect, 1);
+        }
+    }
+    return retval;
+}
+
+static int
+QueueCmdCopyBatch(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
+{
+    SDL_RenderCommand *cmd;
+    int retval = -1;
+    int i;
+
+    if (!renderer->QueueCopyBatch) {
+        /* Queue them one at a time, the backend will still get them all at once */
+        for (i = 0; i < count; ++i) {
+            retval = QueueCmdCopy(renderer, texture, &srcrects[i], &dstrects[i]);
+            if (retval < 0) {
+                break;
+            }
+        }
+        return retval;
+    }
+
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
+    if (cmd != NULL) {
+        retval = renderer->QueueCopyBatch(renderer, cmd, texture, srcrects, dstrects, count);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            SetDrawBoundsFromRects(renderer, cmd, dstrects, count);
         }
     }
     return retval;
@@ -540,11 +1004,67 @@ QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture,
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            /* The corners of the destination, rotated around the center */
+            const float radians = (float) (angle * (M_PI / 180.0));
+            const float c = SDL_cosf(radians), s = SDL_sinf(radians);
+            const float cx = dstrect->x + center->x, cy = dstrect->y + center->y;
+            SDL_FPoint corners[4];
+            int i;
+
+            for (i = 0; i < 4; ++i) {
+                const float x = ((i & 1) ? (dstrect->x + dstrect->w) : dstrect->x) - cx;
+                const float y = ((i & 2) ? (dstrect->y + dstrect->h) : dstrect->y) - cy;
+                corners[i].x = cx + x * c - y * s;
+                corners[i].y = cy + x * s + y * c;
+            }
+            SetDrawBoundsFromPoints(renderer, cmd, corners, 4);
         }
     }
     return retval;
 }
 
+static int
+QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Vertex *vertices, int num_vertices,
+                 const int *indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    SDL_RenderCommand *cmd;
+    int retval = -1;
+
+    if (texture) {
+        cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_GEOMETRY);
+    } else {
+        cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_GEOMETRY);
+        if (cmd != NULL) {
+            /* The vertex colors replace the draw color, nothing to modulate */
+            cmd->data.draw.r = 0xFF;
+            cmd->data.draw.g = 0xFF;
+            cmd->data.draw.b = 0xFF;
+            cmd->data.draw.a = 0xFF;
+        }
+    }
+    if (cmd != NULL) {
+        retval = renderer->QueueGeometry(renderer, cmd, texture, vertices, num_vertices, indices, num_indices, scale_x, scale_y);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->optimize_batches) {
+            float minx = vertices[0].position.x, miny = vertices[0].position.y;
+            float maxx = minx, maxy = miny;
+            int i;
+
+            for (i = 1; i < num_vertices; ++i) {
+                minx = SDL_min(minx, vertices[i].position.x);
+                miny = SDL_min(miny, vertices[i].position.y);
+                maxx = SDL_max(maxx, vertices[i].position.x);
+                maxy = SDL_max(maxy, vertices[i].position.y);
+            }
+            SetDrawBounds(renderer, cmd, minx * scale_x, miny * scale_y, maxx * scale_x, maxy * scale_y);
+        }
+    }
+    return retval;
+}
 
 static int UpdateLogicalSize(SDL_Renderer *renderer);
 
@@ -873,9 +1393,13 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
     }
 
     renderer->batching = batching;
+    if (batching && renderer->mergeable_commands) {
+        renderer->optimize_batches = SDL_GetHintBoolean(SDL_HINT_RENDER_OPTIMIZE_BATCHES, SDL_FALSE);
+    }
     renderer->magic = &renderer_magic;
     renderer->window = window;
     renderer->target_mutex = SDL_CreateMutex();
+    renderer->stats_blend = SDL_BLENDMODE_INVALID;
     renderer->scale.x = 1.0f;
     renderer->scale.y = 1.0f;
     renderer->dpi_scale.x = 1.0f;
@@ -941,6 +1465,7 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         VerifyDrawQueueFunctions(renderer);
         renderer->magic = &renderer_magic;
         renderer->target_mutex = SDL_CreateMutex();
+        renderer->stats_blend = SDL_BLENDMODE_INVALID;
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
 
@@ -1095,6 +1620,7 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
         return NULL;
     }
     texture->magic = &texture_magic;
+    texture->id = ++renderer->next_texture_id;
     texture->format = format;
     texture->access = access;
     texture->w = w;
@@ -3125,6 +3651,125 @@ SDL_RenderCopyF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+int
+SDL_RenderCopyBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * srcrects, const SDL_Rect * dstrects, int count)
+{
+    SDL_FRect *dstfrects;
+    int i;
+    int retval;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    dstfrects = SDL_small_alloc(SDL_FRect, count, &isstack);
+    if (!dstfrects) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        dstfrects[i].x = (float) dstrects[i].x;
+        dstfrects[i].y = (float) dstrects[i].y;
+        dstfrects[i].w = (float) dstrects[i].w;
+        dstfrects[i].h = (float) dstrects[i].h;
+    }
+
+    retval = SDL_RenderCopyBatchF(renderer, texture, srcrects, dstfrects, count);
+
+    SDL_small_free(dstfrects, isstack);
+
+    return retval;
+}
+
+int
+SDL_RenderCopyBatchF(SDL_Renderer * renderer, SDL_Texture * texture,
+                     const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
+{
+    SDL_Rect texture_rect;
+    SDL_FRect viewport;
+    SDL_Rect *real_srcrects;
+    SDL_FRect *real_dstrects;
+    int i, num_copies = 0;
+    int retval = 0;
+    SDL_bool isstack;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+    if (count > SDL_MAX_SINT32 / (int) (sizeof (SDL_FRect) + sizeof (SDL_Rect))) {
+        return SDL_InvalidParamError("count");
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    /* Both arrays are allocated together, the source rects go after the destination rects */
+    real_dstrects = (SDL_FRect *) SDL_small_alloc(Uint8, count * (sizeof (SDL_FRect) + sizeof (SDL_Rect)), &isstack);
+    if (!real_dstrects) {
+        return SDL_OutOfMemory();
+    }
+    real_srcrects = (SDL_Rect *) (real_dstrects + count);
+
+    texture_rect.x = 0;
+    texture_rect.y = 0;
+    texture_rect.w = texture->w;
+    texture_rect.h = texture->h;
+    RenderGetViewportSize(renderer, &viewport);
+
+    /* Drop the copies that wouldn't draw anything, the same as SDL_RenderCopyF() */
+    for (i = 0; i < count; ++i) {
+        SDL_Rect *srcrect = &real_srcrects[num_copies];
+        SDL_FRect *dstrect = &real_dstrects[num_copies];
+
+        if (srcrects) {
+            if (!SDL_IntersectRect(&srcrects[i], &texture_rect, srcrect)) {
+                continue;
+            }
+        } else {
+            *srcrect = texture_rect;
+        }
+        if (!SDL_HasIntersectionF(&dstrects[i], &viewport)) {
+            continue;
+        }
+        dstrect->x = dstrects[i].x * renderer->scale.x;
+        dstrect->y = dstrects[i].y * renderer->scale.y;
+        dstrect->w = dstrects[i].w * renderer->scale.x;
+        dstrect->h = dstrects[i].h * renderer->scale.y;
+        ++num_copies;
+    }
+
+    if (num_copies > 0) {
+        if (texture->native) {
+            texture = texture->native;
+        }
+
+        texture->last_command_generation = renderer->render_command_generation;
+
+        retval = QueueCmdCopyBatch(renderer, texture, real_srcrects, real_dstrects, num_copies);
+    }
+
+    SDL_small_free(real_dstrects, isstack);
+
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect,
@@ -3223,6 +3868,64 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+int
+SDL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Vertex * vertices, int num_vertices,
+                   const int * indices, int num_indices)
+{
+    int i;
+    int retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 3) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (indices) {
+        if (num_indices < 3 || (num_indices % 3) != 0) {
+            return SDL_InvalidParamError("num_indices");
+        }
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Vertex index %d is out of range", indices[i]);
+            }
+        }
+    } else if ((num_vertices % 3) != 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    if (texture) {
+        if (texture->native) {
+            texture = texture->native;
+        }
+        texture->last_command_generation = renderer->render_command_generation;
+    }
+
+    retval = QueueCmdGeometry(renderer, texture, vertices, num_vertices, indices, num_indices,
+                              renderer->scale.x, renderer->scale.y);
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
@@ -3269,6 +3972,12 @@ SDL_RenderPresent(SDL_Renderer * renderer)
 
     FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
 
+    /* The frame is done, start counting the next one */
+    renderer->last_stats = renderer->stats;
+    SDL_zero(renderer->stats);
+    renderer->stats_texture_id = 0;
+    renderer->stats_blend = SDL_BLENDMODE_INVALID;
+
     /* Don't present while we're hidden */
     if (renderer->hidden) {
         return;
@@ -3345,7 +4054,10 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
         cmd = next;
     }
 
-    SDL_free(renderer->vertex_data);
+    if (!renderer->MapVertexData) {
+        SDL_free(renderer->vertex_data);
+    }
+    SDL_free(renderer->optimize_items);
 
     /* Free existing textures for this renderer */
     while (renderer->textures) {
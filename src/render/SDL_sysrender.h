@@ -56,6 +56,7 @@ struct SDL_Texture
     SDL_Surface *locked_surface;  /**< Locked region exposed as a SDL surface */
 
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
+    Uint32 id;                  /* never reused by the renderer, unlike the texture address */
 
     void *driverdata;           /**< Driver specific texture representation */
 
@@ -74,7 +75,8 @@ typedef enum
     SDL_RENDERCMD_DRAW_LINES,
     SDL_RENDERCMD_FILL_RECTS,
     SDL_RENDERCMD_COPY,
-    SDL_RENDERCMD_COPY_EX
+    SDL_RENDERCMD_COPY_EX,
+    SDL_RENDERCMD_GEOMETRY
 } SDL_RenderCommandType;
 
 typedef struct SDL_RenderCommand
@@ -95,6 +97,8 @@ typedef struct SDL_RenderCommand
             Uint8 r, g, b, a;
             SDL_BlendMode blend;
             SDL_Texture *texture;
+            SDL_FRect bounds;  /* only set when optimizing batches, w < 0 if unknown */
+            size_t size;  /* bytes of vertex data, only set when optimizing batches */
         } draw;
         struct {
             size_t first;
@@ -124,10 +128,25 @@ struct SDL_Renderer
                             int count);
     int (*QueueCopy) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                        const SDL_Rect * srcrect, const SDL_FRect * dstrect);
+    /* Optional, queues count copies as one SDL_RENDERCMD_COPY command */
+    int (*QueueCopyBatch) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                           const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count);
     int (*QueueCopyEx) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                         const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    int (*QueueGeometry) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Vertex * vertices, int num_vertices,
+                          const int * indices, int num_indices,
+                          float scale_x, float scale_y);
     int (*RunCommandQueue) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
+    /* Optional, provides the memory vertex data is queued into, so it can be
+       written straight to where the backend draws from. Returns at least
+       numbytes bytes starting with the first 'used' bytes of the current
+       vertex data, and the real size in *allocation. The memory is only
+       valid until the next RunCommandQueue, so it is never freed by SDL.
+       On failure the old memory isn't valid either, RunCommandQueue then
+       gets NULL vertices and draws the first 'used' bytes kept by the backend. */
+    void *(*MapVertexData) (SDL_Renderer * renderer, size_t used, size_t numbytes, size_t *allocation);
     int (*UpdateTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * rect, const void *pixels,
                           int pitch);
@@ -150,6 +169,8 @@ struct SDL_Renderer
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
     void (*RenderPresent) (SDL_Renderer * renderer);
+    /* Optional, returns the rects updated by the last RenderPresent */
+    int (*GetDamageRects) (SDL_Renderer * renderer, SDL_Rect * rects, int maxrects);
     void (*DestroyTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
 
     void (*DestroyRenderer) (SDL_Renderer * renderer);
@@ -212,6 +233,16 @@ struct SDL_Renderer
 
     SDL_bool always_batch;
     SDL_bool batching;
+
+    /* Draw commands whose vertex data can be concatenated, as a mask of
+       (1 << SDL_RENDERCMD_*). Backends that set this promise that
+       QueueSetDrawColor doesn't allocate vertex data, which lets
+       SDL_HINT_RENDER_OPTIMIZE_BATCHES reorder and merge their draws. */
+    Uint32 mergeable_commands;
+    SDL_bool optimize_batches;
+    void *optimize_items;
+    int optimize_items_allocation;
+
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
     SDL_RenderCommand *render_commands_pool;
@@ -228,6 +259,14 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Counters for the frame being drawn, backends add their draw calls in
+       RunCommandQueue. They move to last_stats in SDL_RenderPresent(). */
+    SDL_RenderStats stats;
+    SDL_RenderStats last_stats;
+    Uint32 stats_texture_id;        /* of the last draw, 0 without a texture */
+    SDL_BlendMode stats_blend;
+    Uint32 next_texture_id;
+
     void *driverdata;
 };
 
@@ -1492,6 +1492,7 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 const size_t count = cmd->data.draw.count;
                 const MTLPrimitiveType primtype = (cmd->command == SDL_RENDERCMD_DRAW_POINTS) ? MTLPrimitiveTypePoint : MTLPrimitiveTypeLineStrip;
                 SetDrawState(renderer, cmd, SDL_METAL_FRAGMENT_SOLID, CONSTANTS_OFFSET_HALF_PIXEL_TRANSFORM, mtlbufvertex, &statecache);
+                renderer->stats.draw_calls++;
                 [data.mtlcmdencoder drawPrimitives:primtype vertexStart:0 vertexCount:count];
                 break;
             }
@@ -1501,6 +1502,7 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 const size_t maxcount = UINT16_MAX / 4;
                 SetDrawState(renderer, cmd, SDL_METAL_FRAGMENT_SOLID, CONSTANTS_OFFSET_IDENTITY, mtlbufvertex, &statecache);
                 if (count == 1) {
+                    renderer->stats.draw_calls++;
                     [data.mtlcmdencoder drawPrimitives:MTLPrimitiveTypeTriangleStrip vertexStart:0 vertexCount:4];
                 } else {
                     /* Our index buffer has 16 bit indices, so we can only draw
@@ -1509,6 +1511,7 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                         /* Set the vertex buffer offset for our current positions.
                          * The vertex buffer itself was bound in SetDrawState. */
                         [data.mtlcmdencoder setVertexBufferOffset:cmd->data.draw.first + i*sizeof(float)*8 atIndex:0];
+                        renderer->stats.draw_calls++;
                         [data.mtlcmdencoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
                                                        indexCount:SDL_min(maxcount, count - i) * 6
                                                         indexType:MTLIndexTypeUInt16
@@ -1521,6 +1524,7 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
 
             case SDL_RENDERCMD_COPY: {
                 SetCopyState(renderer, cmd, CONSTANTS_OFFSET_IDENTITY, mtlbufvertex, &statecache);
+                renderer->stats.draw_calls++;
                 [data.mtlcmdencoder drawPrimitives:MTLPrimitiveTypeTriangleStrip vertexStart:0 vertexCount:4];
                 break;
             }
@@ -1528,10 +1532,14 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
             case SDL_RENDERCMD_COPY_EX: {
                 SetCopyState(renderer, cmd, CONSTANTS_OFFSET_INVALID, mtlbufvertex, &statecache);
                 [data.mtlcmdencoder setVertexBuffer:mtlbufvertex offset:cmd->data.draw.count atIndex:3];  // transform
+                renderer->stats.draw_calls++;
                 [data.mtlcmdencoder drawPrimitives:MTLPrimitiveTypeTriangleStrip vertexStart:0 vertexCount:4];
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                break;  /* unsupported */
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
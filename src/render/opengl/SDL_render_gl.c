@@ -111,12 +111,37 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    /* Pixel buffer objects, used for asynchronous streaming texture uploads */
+    SDL_bool GL_ARB_pixel_buffer_object_supported;
+    PFNGLGENBUFFERSARBPROC glGenBuffersARB;
+    PFNGLDELETEBUFFERSARBPROC glDeleteBuffersARB;
+    PFNGLBINDBUFFERARBPROC glBindBufferARB;
+    PFNGLBUFFERDATAARBPROC glBufferDataARB;
+    PFNGLMAPBUFFERARBPROC glMapBufferARB;
+    PFNGLUNMAPBUFFERARBPROC glUnmapBufferARB;
+
+    /* Fences, NULL without GL_ARB_sync */
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+
     /* Shader support */
     GL_ShaderContext *shaders;
 
     GL_DrawStateCache drawstate;
 } GL_RenderData;
 
+/* Streaming textures rotate through this many pixel buffers, so an upload
+   the GPU hasn't finished yet doesn't stall the next one. */
+#define GL_PIXEL_BUFFER_COUNT 3
+
+typedef struct
+{
+    GLuint buffer;
+    GLsizeiptrARB size;
+    GLsync fence;       /* set after the buffer was last uploaded from */
+} GL_PixelBuffer;
+
 typedef struct
 {
     GLuint texture;
@@ -128,6 +153,11 @@ typedef struct
     int pitch;
     SDL_Rect locked_rect;
 
+    /* Pixel buffers for streaming textures, all zero if they aren't used */
+    GL_PixelBuffer pbos[GL_PIXEL_BUFFER_COUNT];
+    int current_pbo;
+    SDL_bool locked_pbo;
+
 #if SDL_HAVE_YUV
     /* YUV texture support */
     SDL_bool yuv;
@@ -507,6 +537,14 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     }
     texture->driverdata = data;
 
+    if (texture->access == SDL_TEXTUREACCESS_STREAMING &&
+        renderdata->GL_ARB_pixel_buffer_object_supported) {
+        int i;
+        for (i = 0; i < GL_PIXEL_BUFFER_COUNT; ++i) {
+            renderdata->glGenBuffersARB(1, &data->pbos[i].buffer);
+        }
+    }
+
     if (renderdata->GL_ARB_texture_non_power_of_two_supported) {
         texture_w = texture->w;
         texture_h = texture->h;
@@ -634,8 +672,9 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     return GL_CheckError("", renderer);
 }
 
+/* Uploads from client memory, or from the bound pixel buffer if pixels is an offset into it */
 static int
-GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
+GL_UploadTexture(SDL_Renderer * renderer, SDL_Texture * texture,
                  const SDL_Rect * rect, const void *pixels, int pitch)
 {
     GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
@@ -645,8 +684,6 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 
     SDL_assert(texturebpp != 0);  /* otherwise, division by zero later. */
 
-    GL_ActivateRenderer(renderer);
-
     renderdata->drawstate.texture = NULL;  /* we trash this state. */
 
     renderdata->glBindTexture(textype, data->texture);
@@ -696,6 +733,170 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
+/* The size of a tightly packed upload of h rows, including the chroma planes */
+static size_t
+GL_GetPixelBufferSize(SDL_Texture * texture, int h, int pitch)
+{
+    size_t size = (size_t) h * pitch;
+
+#if SDL_HAVE_YUV
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    if (data->yuv || data->nv12) {
+        size += 2 * ((h + 1) / 2) * ((pitch + 1) / 2);
+    }
+#endif
+    return size;
+}
+
+/* Maps the next pixel buffer of a streaming texture for writing.
+   Returns NULL if there isn't one, and the caller uploads from client memory instead. */
+static void *
+GL_MapPixelBuffer(SDL_Renderer * renderer, GL_TextureData * data, size_t size)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_PixelBuffer *pbo;
+    SDL_bool busy;
+    void *pixels;
+
+    if (!data->pbos[0].buffer || size == 0) {
+        return NULL;
+    }
+
+    data->current_pbo = (data->current_pbo + 1) % GL_PIXEL_BUFFER_COUNT;
+    pbo = &data->pbos[data->current_pbo];
+
+    if (pbo->fence) {
+        const GLenum status = renderdata->glClientWaitSync(pbo->fence, 0, 0);
+        busy = (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED);
+        renderdata->glDeleteSync(pbo->fence);
+        pbo->fence = NULL;
+    } else {
+        /* Without fences we can't tell, so assume the GPU still reads from it */
+        busy = renderdata->glFenceSync ? SDL_FALSE : SDL_TRUE;
+    }
+
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, pbo->buffer);
+    if (busy || (GLsizeiptrARB) size > pbo->size) {
+        /* Orphan the old storage instead of waiting for the GPU to finish with it */
+        renderdata->glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, (GLsizeiptrARB) size, NULL, GL_STREAM_DRAW_ARB);
+        pbo->size = (GLsizeiptrARB) size;
+    }
+    pixels = renderdata->glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+
+    /* Leave nothing bound, so other uploads keep reading from client memory */
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+    if (!pixels) {
+        GL_CheckError("glMapBufferARB()", renderer);
+    }
+    return pixels;
+}
+
+/* Unmaps the current pixel buffer and starts copying it into the texture.
+   The buffer holds the rows of rect packed at the given pitch, followed by the chroma planes. */
+static int
+GL_UnmapPixelBuffer(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * rect, int pitch)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    GL_PixelBuffer *pbo = &data->pbos[data->current_pbo];
+    int status;
+
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, pbo->buffer);
+    if (!renderdata->glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB)) {
+        /* The buffer contents got lost, e.g. by a display mode change */
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        pbo->size = 0;
+        return SDL_SetError("glUnmapBufferARB() failed, the texture data was lost");
+    }
+
+    status = GL_UploadTexture(renderer, texture, rect, NULL, pitch);
+    if (renderdata->glFenceSync) {
+        pbo->fence = renderdata->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+    return status;
+}
+
+static void
+GL_CopyRows(Uint8 *dst, int dst_pitch, const Uint8 *src, int src_pitch, int length, int rows)
+{
+    if (dst_pitch == src_pitch) {
+        SDL_memcpy(dst, src, (size_t) rows * length);
+        return;
+    }
+    while (rows--) {
+        SDL_memcpy(dst, src, length);
+        dst += dst_pitch;
+        src += src_pitch;
+    }
+}
+
+/* Copies the planes of an update into a pixel buffer and uploads it from there.
+   planes[1] is the plane that GL_UploadTexture() expects right after the Y plane.
+   Returns -1 if the caller has to upload from client memory instead. */
+static int
+GL_UpdateTextureBuffered(SDL_Renderer * renderer, SDL_Texture * texture,
+                         const SDL_Rect * rect, const Uint8 *planes[3], const int pitches[3])
+{
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    const int pitch = rect->w * SDL_BYTESPERPIXEL(texture->format);
+    Uint8 *dst;
+
+    dst = (Uint8 *) GL_MapPixelBuffer(renderer, data, GL_GetPixelBufferSize(texture, rect->h, pitch));
+    if (!dst) {
+        return -1;
+    }
+
+    GL_CopyRows(dst, pitch, planes[0], pitches[0], pitch, rect->h);
+#if SDL_HAVE_YUV
+    if (data->yuv) {
+        const int uvpitch = (pitch + 1) / 2;
+        const int uvrows = (rect->h + 1) / 2;
+
+        dst += rect->h * pitch;
+        GL_CopyRows(dst, uvpitch, planes[1], pitches[1], (rect->w + 1) / 2, uvrows);
+        dst += uvrows * uvpitch;
+        GL_CopyRows(dst, uvpitch, planes[2], pitches[2], (rect->w + 1) / 2, uvrows);
+    } else if (data->nv12) {
+        dst += rect->h * pitch;
+        GL_CopyRows(dst, 2 * ((pitch + 1) / 2), planes[1], pitches[1], 2 * ((rect->w + 1) / 2), (rect->h + 1) / 2);
+    }
+#endif
+
+    return GL_UnmapPixelBuffer(renderer, texture, rect, pitch);
+}
+
+static int
+GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
+                 const SDL_Rect * rect, const void *pixels, int pitch)
+{
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+
+    GL_ActivateRenderer(renderer);
+
+    if (data->pbos[0].buffer) {
+        const Uint8 *planes[3];
+        int pitches[3];
+
+        planes[0] = (const Uint8 *) pixels;
+        pitches[0] = pitch;
+#if SDL_HAVE_YUV
+        if (data->yuv || data->nv12) {
+            /* The chroma planes follow the Y plane, the same as GL_UploadTexture() reads them */
+            planes[1] = planes[0] + rect->h * pitch;
+            pitches[1] = data->nv12 ? 2 * ((pitch + 1) / 2) : (pitch + 1) / 2;
+            planes[2] = planes[1] + ((rect->h + 1) / 2) * pitches[1];
+            pitches[2] = pitches[1];
+        }
+#endif
+        if (GL_UpdateTextureBuffered(renderer, texture, rect, planes, pitches) == 0) {
+            return 0;
+        }
+    }
+    return GL_UploadTexture(renderer, texture, rect, pixels, pitch);
+}
+
 #if SDL_HAVE_YUV
 static int
 GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
@@ -710,6 +911,21 @@ GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
 
     GL_ActivateRenderer(renderer);
 
+    if (data->pbos[0].buffer) {
+        const Uint8 *planes[3];
+        int pitches[3];
+
+        planes[0] = Yplane;
+        pitches[0] = Ypitch;
+        planes[1] = (texture->format == SDL_PIXELFORMAT_YV12) ? Vplane : Uplane;
+        pitches[1] = (texture->format == SDL_PIXELFORMAT_YV12) ? Vpitch : Upitch;
+        planes[2] = (texture->format == SDL_PIXELFORMAT_YV12) ? Uplane : Vplane;
+        pitches[2] = (texture->format == SDL_PIXELFORMAT_YV12) ? Upitch : Vpitch;
+        if (GL_UpdateTextureBuffered(renderer, texture, rect, planes, pitches) == 0) {
+            return 0;
+        }
+    }
+
     renderdata->drawstate.texture = NULL;  /* we trash this state. */
 
     renderdata->glBindTexture(textype, data->texture);
@@ -746,6 +962,19 @@ GL_UpdateTextureNV(SDL_Renderer * renderer, SDL_Texture * texture,
 
     GL_ActivateRenderer(renderer);
 
+    if (data->pbos[0].buffer) {
+        const Uint8 *planes[3];
+        int pitches[3];
+
+        planes[0] = Yplane;
+        pitches[0] = Ypitch;
+        planes[1] = UVplane;
+        pitches[1] = UVpitch;
+        if (GL_UpdateTextureBuffered(renderer, texture, rect, planes, pitches) == 0) {
+            return 0;
+        }
+    }
+
     renderdata->drawstate.texture = NULL;  /* we trash this state. */
 
     renderdata->glBindTexture(textype, data->texture);
@@ -773,6 +1002,21 @@ GL_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
 
     data->locked_rect = *rect;
+
+    if (data->pbos[0].buffer) {
+        /* Hand out the upload buffer itself, packed to the locked rectangle */
+        const int locked_pitch = rect->w * SDL_BYTESPERPIXEL(texture->format);
+        void *mapped;
+
+        GL_ActivateRenderer(renderer);
+        mapped = GL_MapPixelBuffer(renderer, data, GL_GetPixelBufferSize(texture, rect->h, locked_pitch));
+        if (mapped) {
+            data->locked_pbo = SDL_TRUE;
+            *pixels = mapped;
+            *pitch = locked_pitch;
+            return 0;
+        }
+    }
     *pixels =
         (void *) ((Uint8 *) data->pixels + rect->y * data->pitch +
                   rect->x * SDL_BYTESPERPIXEL(texture->format));
@@ -788,10 +1032,18 @@ GL_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     void *pixels;
 
     rect = &data->locked_rect;
+    if (data->locked_pbo) {
+        data->locked_pbo = SDL_FALSE;
+        GL_ActivateRenderer(renderer);
+        GL_UnmapPixelBuffer(renderer, texture, rect, rect->w * SDL_BYTESPERPIXEL(texture->format));
+        return;
+    }
+
     pixels =
         (void *) ((Uint8 *) data->pixels + rect->y * data->pitch +
                   rect->x * SDL_BYTESPERPIXEL(texture->format));
-    GL_UpdateTexture(renderer, texture, rect, pixels, data->pitch);
+    GL_ActivateRenderer(renderer);
+    GL_UploadTexture(renderer, texture, rect, pixels, data->pitch);
 }
 
 static void
@@ -952,46 +1204,61 @@ GL_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
 }
 
 static int
-GL_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+GL_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
     GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
     GLfloat minx, miny, maxx, maxy;
     GLfloat minu, maxu, minv, maxv;
-    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, 8 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    GLfloat *verts;
+    int i;
 
+    if ((size_t) count > ((size_t) -1) / (8 * sizeof (GLfloat))) {
+        return SDL_OutOfMemory();
+    }
+    verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, count * 8 * sizeof (GLfloat), 0, &cmd->data.draw.first);
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
-
-    minx = dstrect->x;
-    miny = dstrect->y;
-    maxx = dstrect->x + dstrect->w;
-    maxy = dstrect->y + dstrect->h;
-
-    minu = (GLfloat) srcrect->x / texture->w;
-    minu *= texturedata->texw;
-    maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
-    maxu *= texturedata->texw;
-    minv = (GLfloat) srcrect->y / texture->h;
-    minv *= texturedata->texh;
-    maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
-    maxv *= texturedata->texh;
-
-    cmd->data.draw.count = 1;
-    *(verts++) = minx;
-    *(verts++) = miny;
-    *(verts++) = maxx;
-    *(verts++) = maxy;
-    *(verts++) = minu;
-    *(verts++) = maxu;
-    *(verts++) = minv;
-    *(verts++) = maxv;
+    cmd->data.draw.count = count;
+    for (i = 0; i < count; i++) {
+        const SDL_Rect *srcrect = &srcrects[i];
+        const SDL_FRect *dstrect = &dstrects[i];
+
+        minx = dstrect->x;
+        miny = dstrect->y;
+        maxx = dstrect->x + dstrect->w;
+        maxy = dstrect->y + dstrect->h;
+
+        minu = (GLfloat) srcrect->x / texture->w;
+        minu *= texturedata->texw;
+        maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
+        maxu *= texturedata->texw;
+        minv = (GLfloat) srcrect->y / texture->h;
+        minv *= texturedata->texh;
+        maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
+        maxv *= texturedata->texh;
+
+        *(verts++) = minx;
+        *(verts++) = miny;
+        *(verts++) = maxx;
+        *(verts++) = maxy;
+        *(verts++) = minu;
+        *(verts++) = maxu;
+        *(verts++) = minv;
+        *(verts++) = maxv;
+    }
     return 0;
 }
 
+static int
+GL_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return GL_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 static int
 GL_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_FRect * dstrect,
@@ -1052,6 +1319,45 @@ GL_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
     return 0;
 }
 
+static int
+GL_QueueGeometry(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                 const SDL_Vertex * vertices, int num_vertices,
+                 const int * indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    GL_TextureData *texturedata = texture ? (GL_TextureData *) texture->driverdata : NULL;
+    const int count = indices ? num_indices : num_vertices;
+    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, count * 8 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    const GLfloat r = cmd->data.draw.r * inv255f;
+    const GLfloat g = cmd->data.draw.g * inv255f;
+    const GLfloat b = cmd->data.draw.b * inv255f;
+    const GLfloat a = cmd->data.draw.a * inv255f;
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+    for (i = 0; i < count; i++) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[i] : i];
+        *(verts++) = vertex->position.x * scale_x;
+        *(verts++) = vertex->position.y * scale_y;
+        *(verts++) = vertex->color.r * r * inv255f;
+        *(verts++) = vertex->color.g * g * inv255f;
+        *(verts++) = vertex->color.b * b * inv255f;
+        *(verts++) = vertex->color.a * a * inv255f;
+        if (texturedata) {
+            *(verts++) = vertex->tex_coord.x * texturedata->texw;
+            *(verts++) = vertex->tex_coord.y * texturedata->texh;
+        } else {
+            *(verts++) = 0.0f;
+            *(verts++) = 0.0f;
+        }
+    }
+    return 0;
+}
+
 static void
 SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const GL_Shader shader)
 {
@@ -1276,6 +1582,7 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                     data->drawstate.cliprect_enabled_dirty = data->drawstate.cliprect_enabled;
                 }
 
+                renderer->stats.draw_calls++;
                 data->glClear(GL_COLOR_BUFFER_BIT);
 
                 break;
@@ -1285,6 +1592,7 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const size_t count = cmd->data.draw.count;
                 const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 SetDrawState(data, cmd, SHADER_SOLID);
+                renderer->stats.draw_calls++;
                 data->glBegin(GL_POINTS);
                 for (i = 0; i < count; i++, verts += 2) {
                     data->glVertex2f(verts[0], verts[1]);
@@ -1298,6 +1606,7 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const size_t count = cmd->data.draw.count;
                 SDL_assert(count >= 2);
                 SetDrawState(data, cmd, SHADER_SOLID);
+                renderer->stats.draw_calls++;
                 data->glBegin(GL_LINE_STRIP);
                 for (i = 0; i < count; ++i, verts += 2) {
                     data->glVertex2f(verts[0], verts[1]);
@@ -1310,6 +1619,7 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const size_t count = cmd->data.draw.count;
                 const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 SetDrawState(data, cmd, SHADER_SOLID);
+                renderer->stats.draw_calls += (Uint32) count;
                 for (i = 0; i < count; ++i, verts += 4) {
                     data->glRectf(verts[0], verts[1], verts[2], verts[3]);
                 }
@@ -1317,25 +1627,34 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
             }
 
             case SDL_RENDERCMD_COPY: {
+                const size_t count = cmd->data.draw.count;
                 const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const GLfloat minx = verts[0];
-                const GLfloat miny = verts[1];
-                const GLfloat maxx = verts[2];
-                const GLfloat maxy = verts[3];
-                const GLfloat minu = verts[4];
-                const GLfloat maxu = verts[5];
-                const GLfloat minv = verts[6];
-                const GLfloat maxv = verts[7];
                 SetCopyState(data, cmd);
-                data->glBegin(GL_TRIANGLE_STRIP);
-                data->glTexCoord2f(minu, minv);
-                data->glVertex2f(minx, miny);
-                data->glTexCoord2f(maxu, minv);
-                data->glVertex2f(maxx, miny);
-                data->glTexCoord2f(minu, maxv);
-                data->glVertex2f(minx, maxy);
-                data->glTexCoord2f(maxu, maxv);
-                data->glVertex2f(maxx, maxy);
+                /* The same two triangles as a strip, but a batch of copies can share one glBegin() */
+                renderer->stats.draw_calls++;
+                data->glBegin(GL_TRIANGLES);
+                for (i = 0; i < count; ++i, verts += 8) {
+                    const GLfloat minx = verts[0];
+                    const GLfloat miny = verts[1];
+                    const GLfloat maxx = verts[2];
+                    const GLfloat maxy = verts[3];
+                    const GLfloat minu = verts[4];
+                    const GLfloat maxu = verts[5];
+                    const GLfloat minv = verts[6];
+                    const GLfloat maxv = verts[7];
+                    data->glTexCoord2f(minu, minv);
+                    data->glVertex2f(minx, miny);
+                    data->glTexCoord2f(maxu, minv);
+                    data->glVertex2f(maxx, miny);
+                    data->glTexCoord2f(minu, maxv);
+                    data->glVertex2f(minx, maxy);
+                    data->glTexCoord2f(maxu, minv);
+                    data->glVertex2f(maxx, miny);
+                    data->glTexCoord2f(minu, maxv);
+                    data->glVertex2f(minx, maxy);
+                    data->glTexCoord2f(maxu, maxv);
+                    data->glVertex2f(maxx, maxy);
+                }
                 data->glEnd();
                 break;
             }
@@ -1359,6 +1678,7 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 data->glPushMatrix();
                 data->glTranslatef(translatex, translatey, 0.0f);
                 data->glRotated(angle, 0.0, 0.0, 1.0);
+                renderer->stats.draw_calls++;
                 data->glBegin(GL_TRIANGLE_STRIP);
                 data->glTexCoord2f(minu, minv);
                 data->glVertex2f(minx, miny);
@@ -1373,6 +1693,34 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY: {
+                const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                const size_t count = cmd->data.draw.count;
+                const Uint32 color = data->drawstate.color;
+
+                if (cmd->data.draw.texture) {
+                    SetCopyState(data, cmd);
+                } else {
+                    SetDrawState(data, cmd, SHADER_SOLID);
+                }
+
+                renderer->stats.draw_calls++;
+                data->glBegin(GL_TRIANGLES);
+                for (i = 0; i < count; ++i, verts += 8) {
+                    data->glColor4f(verts[2], verts[3], verts[4], verts[5]);
+                    data->glTexCoord2f(verts[6], verts[7]);
+                    data->glVertex2f(verts[0], verts[1]);
+                }
+                data->glEnd();
+
+                /* Restore the current draw color */
+                data->glColor4f((GLfloat) ((color >> 16) & 0xFF) * inv255f,
+                                (GLfloat) ((color >> 8) & 0xFF) * inv255f,
+                                (GLfloat) (color & 0xFF) * inv255f,
+                                (GLfloat) (color >> 24) * inv255f);
+                break;
+            }
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -1483,6 +1831,15 @@ GL_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     if (data->texture) {
         renderdata->glDeleteTextures(1, &data->texture);
     }
+    if (data->pbos[0].buffer) {
+        int i;
+        for (i = 0; i < GL_PIXEL_BUFFER_COUNT; ++i) {
+            if (data->pbos[i].fence) {
+                renderdata->glDeleteSync(data->pbos[i].fence);
+            }
+            renderdata->glDeleteBuffersARB(1, &data->pbos[i].buffer);
+        }
+    }
 #if SDL_HAVE_YUV
     if (data->yuv) {
         renderdata->glDeleteTextures(1, &data->utexture);
@@ -1653,7 +2010,11 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->QueueDrawLines = GL_QueueDrawLines;
     renderer->QueueFillRects = GL_QueueFillRects;
     renderer->QueueCopy = GL_QueueCopy;
+    renderer->QueueCopyBatch = GL_QueueCopyBatch;
     renderer->QueueCopyEx = GL_QueueCopyEx;
+    renderer->QueueGeometry = GL_QueueGeometry;
+    renderer->mergeable_commands = (1 << SDL_RENDERCMD_DRAW_POINTS) | (1 << SDL_RENDERCMD_FILL_RECTS) |
+                                   (1 << SDL_RENDERCMD_COPY) | (1 << SDL_RENDERCMD_GEOMETRY);
     renderer->RunCommandQueue = GL_RunCommandQueue;
     renderer->RenderReadPixels = GL_RenderReadPixels;
     renderer->RenderPresent = GL_RenderPresent;
@@ -1781,6 +2142,40 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     }
     data->framebuffers = NULL;
 
+    /* Streaming textures upload through pixel buffer objects */
+    if (SDL_GetHintBoolean(SDL_HINT_RENDER_STREAMING_BUFFERS, SDL_TRUE) &&
+        SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object")) {
+        data->glGenBuffersARB = (PFNGLGENBUFFERSARBPROC)
+            SDL_GL_GetProcAddress("glGenBuffersARB");
+        data->glDeleteBuffersARB = (PFNGLDELETEBUFFERSARBPROC)
+            SDL_GL_GetProcAddress("glDeleteBuffersARB");
+        data->glBindBufferARB = (PFNGLBINDBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glBindBufferARB");
+        data->glBufferDataARB = (PFNGLBUFFERDATAARBPROC)
+            SDL_GL_GetProcAddress("glBufferDataARB");
+        data->glMapBufferARB = (PFNGLMAPBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glMapBufferARB");
+        data->glUnmapBufferARB = (PFNGLUNMAPBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glUnmapBufferARB");
+        if (data->glGenBuffersARB && data->glDeleteBuffersARB && data->glBindBufferARB &&
+            data->glBufferDataARB && data->glMapBufferARB && data->glUnmapBufferARB) {
+            data->GL_ARB_pixel_buffer_object_supported = SDL_TRUE;
+        }
+
+        /* With fences we only orphan buffers the GPU is still reading from */
+        if (SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+            data->glFenceSync = (PFNGLFENCESYNCPROC)
+                SDL_GL_GetProcAddress("glFenceSync");
+            data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+                SDL_GL_GetProcAddress("glClientWaitSync");
+            data->glDeleteSync = (PFNGLDELETESYNCPROC)
+                SDL_GL_GetProcAddress("glDeleteSync");
+            if (!data->glFenceSync || !data->glClientWaitSync || !data->glDeleteSync) {
+                data->glFenceSync = NULL;
+            }
+        }
+    }
+
     /* Set up parameters for rendering */
     data->glMatrixMode(GL_MODELVIEW);
     data->glLoadIdentity();
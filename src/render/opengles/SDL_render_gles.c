@@ -925,6 +925,7 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                     data->drawstate.cliprect_enabled_dirty = data->drawstate.cliprect_enabled;
                 }
 
+                renderer->stats.draw_calls++;
                 data->glClear(GL_COLOR_BUFFER_BIT);
 
                 break;
@@ -935,6 +936,7 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 SetDrawState(data, cmd);
                 data->glVertexPointer(2, GL_FLOAT, 0, verts);
+                renderer->stats.draw_calls++;
                 data->glDrawArrays(GL_POINTS, 0, (GLsizei) count);
                 break;
             }
@@ -945,6 +947,7 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 SDL_assert(count >= 2);
                 SetDrawState(data, cmd);
                 data->glVertexPointer(2, GL_FLOAT, 0, verts);
+                renderer->stats.draw_calls++;
                 data->glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) count);
                 break;
             }
@@ -956,6 +959,7 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 SetDrawState(data, cmd);
                 data->glVertexPointer(2, GL_FLOAT, 0, verts);
                 for (i = 0; i < count; ++i, offset += 4) {
+                    renderer->stats.draw_calls++;
                     data->glDrawArrays(GL_TRIANGLE_STRIP, offset, 4);
                 }
                 break;
@@ -966,6 +970,7 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 SetCopyState(data, cmd);
                 data->glVertexPointer(2, GL_FLOAT, 0, verts);
                 data->glTexCoordPointer(2, GL_FLOAT, 0, verts + 8);
+                renderer->stats.draw_calls++;
                 data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
                 break;
             }
@@ -983,11 +988,15 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 data->glPushMatrix();
                 data->glTranslatef(translatex, translatey, 0.0f);
                 data->glRotatef(angle, 0.0, 0.0, 1.0);
+                renderer->stats.draw_calls++;
                 data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
                 data->glPopMatrix();
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                break;  /* unsupported */
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -34,6 +34,32 @@
 #define RENDERER_CONTEXT_MAJOR 2
 #define RENDERER_CONTEXT_MINOR 0
 
+/* OpenGL ES 3.0 buffer functionality, used when the context supports it */
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT                0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#define GL_MAP_INVALIDATE_BUFFER_BIT    0x0008
+#endif
+#ifndef GL_COPY_READ_BUFFER
+#define GL_COPY_READ_BUFFER             0x8F36
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#define GL_MAP_UNSYNCHRONIZED_BIT       0x0020
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER          0x88EC
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE   0x9117
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED             0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED          0x911C
+#endif
+
 /* Used to re-create the window with OpenGL ES capability */
 extern int SDL_RecreateWindow(SDL_Window * window, Uint32 flags);
 
@@ -50,6 +76,17 @@ struct GLES2_FBOList
    GLES2_FBOList *next;
 };
 
+/* Streaming textures rotate through this many pixel buffers, so an upload
+   the GPU hasn't finished yet doesn't stall the next one. */
+#define GLES2_PIXEL_BUFFER_COUNT 3
+
+typedef struct GLES2_PixelBuffer
+{
+    GLuint buffer;
+    size_t size;
+    void *fence;        /* set after the buffer was last uploaded from */
+} GLES2_PixelBuffer;
+
 typedef struct GLES2_TextureData
 {
     GLenum texture;
@@ -58,6 +95,11 @@ typedef struct GLES2_TextureData
     GLenum pixel_type;
     void *pixel_data;
     int pitch;
+    /* Pixel buffers for streaming textures, all zero if they aren't used */
+    GLES2_PixelBuffer pbos[GLES2_PIXEL_BUFFER_COUNT];
+    int current_pbo;
+    SDL_bool locked_pbo;
+    SDL_Rect locked_rect;
 #if SDL_HAVE_YUV
     /* YUV texture support */
     SDL_bool yuv;
@@ -74,7 +116,6 @@ typedef struct GLES2_ProgramCacheEntry
     GLuint vertex_shader;
     GLuint fragment_shader;
     GLuint uniform_locations[16];
-    Uint32 color;
     GLfloat projection[4][4];
     struct GLES2_ProgramCacheEntry *prev;
     struct GLES2_ProgramCacheEntry *next;
@@ -93,13 +134,13 @@ typedef enum
     GLES2_ATTRIBUTE_TEXCOORD = 1,
     GLES2_ATTRIBUTE_ANGLE = 2,
     GLES2_ATTRIBUTE_CENTER = 3,
+    GLES2_ATTRIBUTE_COLOR = 4,
 } GLES2_Attribute;
 
 typedef enum
 {
     GLES2_UNIFORM_PROJECTION,
     GLES2_UNIFORM_TEXTURE,
-    GLES2_UNIFORM_COLOR,
     GLES2_UNIFORM_TEXTURE_U,
     GLES2_UNIFORM_TEXTURE_V
 } GLES2_Uniform;
@@ -118,6 +159,14 @@ typedef enum
     GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES
 } GLES2_ImageSource;
 
+/* The interleaved vertex layout used for geometry */
+typedef struct
+{
+    GLfloat x, y;
+    SDL_Color color;
+    GLfloat u, v;
+} GLES2_Vertex;
+
 typedef struct
 {
     SDL_Rect viewport;
@@ -131,7 +180,9 @@ typedef struct
     SDL_Rect cliprect;
     SDL_bool texturing;
     SDL_bool is_copy_ex;
+    SDL_bool is_geometry;
     Uint32 color;
+    Uint32 vertex_color;
     Uint32 clear_color;
     int drawablew;
     int drawableh;
@@ -159,7 +210,17 @@ typedef struct GLES2_RenderData
     GLuint vertex_buffers[8];
     size_t vertex_buffer_size[8];
     int current_vertex_buffer;
+    SDL_bool vertex_buffer_mapped;
     GLES2_DrawStateCache drawstate;
+
+    /* OpenGL ES 3.0 entry points, NULL with an OpenGL ES 2.0 context */
+    void *(APIENTRY *glMapBufferRange) (GLenum, GLintptr, GLsizeiptr, GLbitfield);
+    GLboolean (APIENTRY *glUnmapBuffer) (GLenum);
+    void (APIENTRY *glCopyBufferSubData) (GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr);
+    void *(APIENTRY *glFenceSync) (GLenum, GLbitfield);
+    GLenum (APIENTRY *glClientWaitSync) (void *, GLbitfield, Uint64);
+    void (APIENTRY *glDeleteSync) (void *);
+    SDL_bool pixel_buffers_supported;
 } GLES2_RenderData;
 
 #define GLES2_MAX_CACHED_PROGRAMS 8
@@ -425,6 +486,7 @@ GLES2_CacheProgram(GLES2_RenderData *data, GLuint vertex, GLuint fragment)
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_ANGLE, "a_angle");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_CENTER, "a_center");
+    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
     data->glLinkProgram(entry->id);
     data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
     if (!linkSuccessful) {
@@ -443,10 +505,6 @@ GLES2_CacheProgram(GLES2_RenderData *data, GLuint vertex, GLuint fragment)
         data->glGetUniformLocation(entry->id, "u_texture_u");
     entry->uniform_locations[GLES2_UNIFORM_TEXTURE] =
         data->glGetUniformLocation(entry->id, "u_texture");
-    entry->uniform_locations[GLES2_UNIFORM_COLOR] =
-        data->glGetUniformLocation(entry->id, "u_color");
-
-    entry->color = 0;
 
     data->glUseProgram(entry->id);
     if (entry->uniform_locations[GLES2_UNIFORM_TEXTURE_V] != -1) {
@@ -461,9 +519,6 @@ GLES2_CacheProgram(GLES2_RenderData *data, GLuint vertex, GLuint fragment)
     if (entry->uniform_locations[GLES2_UNIFORM_PROJECTION] != -1) {
         data->glUniformMatrix4fv(entry->uniform_locations[GLES2_UNIFORM_PROJECTION], 1, GL_FALSE, (GLfloat *)entry->projection);
     }
-    if (entry->uniform_locations[GLES2_UNIFORM_COLOR] != -1) {
-        data->glUniform4f(entry->uniform_locations[GLES2_UNIFORM_COLOR], 0.0f, 0.0f, 0.0f, 0.0f);
-    }
 
     /* Cache the linked program */
     if (data->program_cache.head) {
@@ -701,24 +756,33 @@ GLES2_QueueDrawLines(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_
     }
 
     /* Make the last line segment one pixel longer, to satisfy the
-       diamond-exit rule. */
+       diamond-exit rule. This works from the points rather than reading
+       back, since the vertex memory might be a write-only mapping. */
     verts -= 4;
     {
-        const GLfloat xstart = verts[0];
-        const GLfloat ystart = verts[1];
-        const GLfloat xend = verts[2];
-        const GLfloat yend = verts[3];
+        const GLfloat xstart = 0.5f + points[count - 2].x;
+        const GLfloat ystart = 0.5f + points[count - 2].y;
+        const GLfloat xend = 0.5f + points[count - 1].x;
+        const GLfloat yend = 0.5f + points[count - 1].y;
 
         if (ystart == yend) {  /* horizontal line */
-            verts[(xend > xstart) ? 2 : 0] += 1.0f;
+            if (xend > xstart) {
+                verts[2] = xend + 1.0f;
+            } else {
+                verts[0] = xstart + 1.0f;
+            }
         } else if (xstart == xend) {  /* vertical line */
-            verts[(yend > ystart) ? 3 : 1] += 1.0f;
+            if (yend > ystart) {
+                verts[3] = yend + 1.0f;
+            } else {
+                verts[1] = ystart + 1.0f;
+            }
         } else {  /* bump a pixel in the direction we are moving in. */
             const GLfloat deltax = xend - xstart;
             const GLfloat deltay = yend - ystart;
             const GLfloat angle = SDL_atan2f(deltay, deltax);
-            verts[2] += SDL_cosf(angle);
-            verts[3] += SDL_sinf(angle);
+            verts[2] = xend + SDL_cosf(angle);
+            verts[3] = yend + SDL_sinf(angle);
         }
     }
 
@@ -757,50 +821,78 @@ GLES2_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_
 }
 
 static int
-GLES2_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+GLES2_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                     const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
     GLfloat minx, miny, maxx, maxy;
     GLfloat minu, maxu, minv, maxv;
-    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, 16 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    GLfloat *verts;
+    GLfloat *texcoords;
+    int i;
 
+    if ((size_t) count > ((size_t) -1) / (24 * sizeof (GLfloat))) {
+        return SDL_OutOfMemory();
+    }
+    verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, count * 24 * sizeof (GLfloat), 0, &cmd->data.draw.first);
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    minx = dstrect->x;
-    miny = dstrect->y;
-    maxx = dstrect->x + dstrect->w;
-    maxy = dstrect->y + dstrect->h;
+    /* Two triangles per copy, all the positions followed by all the texture coordinates */
+    texcoords = verts + count * 12;
+    for (i = 0; i < count; i++) {
+        const SDL_Rect *srcrect = &srcrects[i];
+        const SDL_FRect *dstrect = &dstrects[i];
 
-    minu = (GLfloat) srcrect->x / texture->w;
-    maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
-    minv = (GLfloat) srcrect->y / texture->h;
-    maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
+        minx = dstrect->x;
+        miny = dstrect->y;
+        maxx = dstrect->x + dstrect->w;
+        maxy = dstrect->y + dstrect->h;
 
-    *(verts++) = minx;
-    *(verts++) = miny;
-    *(verts++) = maxx;
-    *(verts++) = miny;
-    *(verts++) = minx;
-    *(verts++) = maxy;
-    *(verts++) = maxx;
-    *(verts++) = maxy;
+        minu = (GLfloat) srcrect->x / texture->w;
+        maxu = (GLfloat) (srcrect->x + srcrect->w) / texture->w;
+        minv = (GLfloat) srcrect->y / texture->h;
+        maxv = (GLfloat) (srcrect->y + srcrect->h) / texture->h;
 
-    *(verts++) = minu;
-    *(verts++) = minv;
-    *(verts++) = maxu;
-    *(verts++) = minv;
-    *(verts++) = minu;
-    *(verts++) = maxv;
-    *(verts++) = maxu;
-    *(verts++) = maxv;
+        *(verts++) = minx;
+        *(verts++) = miny;
+        *(verts++) = maxx;
+        *(verts++) = miny;
+        *(verts++) = minx;
+        *(verts++) = maxy;
+        *(verts++) = maxx;
+        *(verts++) = miny;
+        *(verts++) = minx;
+        *(verts++) = maxy;
+        *(verts++) = maxx;
+        *(verts++) = maxy;
+
+        *(texcoords++) = minu;
+        *(texcoords++) = minv;
+        *(texcoords++) = maxu;
+        *(texcoords++) = minv;
+        *(texcoords++) = minu;
+        *(texcoords++) = maxv;
+        *(texcoords++) = maxu;
+        *(texcoords++) = minv;
+        *(texcoords++) = minu;
+        *(texcoords++) = maxv;
+        *(texcoords++) = maxu;
+        *(texcoords++) = maxv;
+    }
 
     return 0;
 }
 
+static int
+GLES2_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return GLES2_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 static int
 GLES2_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
@@ -883,11 +975,49 @@ GLES2_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture *
     return 0;
 }
 
+static int
+GLES2_QueueGeometry(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                    const SDL_Vertex * vertices, int num_vertices,
+                    const int * indices, int num_indices,
+                    float scale_x, float scale_y)
+{
+    const SDL_bool colorswap = (renderer->target && (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 || renderer->target->format == SDL_PIXELFORMAT_RGB888));
+    const int count = indices ? num_indices : num_vertices;
+    GLES2_Vertex *verts = (GLES2_Vertex *) SDL_AllocateRenderVertices(renderer, count * sizeof (GLES2_Vertex), 0, &cmd->data.draw.first);
+    const Uint8 r = cmd->data.draw.r;
+    const Uint8 g = cmd->data.draw.g;
+    const Uint8 b = cmd->data.draw.b;
+    const Uint8 a = cmd->data.draw.a;
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+    for (i = 0; i < count; i++, verts++) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[i] : i];
+        const Uint8 vr = (Uint8) ((vertex->color.r * r) / 255);
+        const Uint8 vb = (Uint8) ((vertex->color.b * b) / 255);
+        verts->x = vertex->position.x * scale_x;
+        verts->y = vertex->position.y * scale_y;
+        verts->color.r = colorswap ? vb : vr;
+        verts->color.g = (Uint8) ((vertex->color.g * g) / 255);
+        verts->color.b = colorswap ? vr : vb;
+        verts->color.a = (Uint8) ((vertex->color.a * a) / 255);
+        verts->u = vertex->tex_coord.x;
+        verts->v = vertex->tex_coord.y;
+    }
+    return 0;
+}
+
 static int
 SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_ImageSource imgsrc)
 {
     const SDL_bool was_copy_ex = data->drawstate.is_copy_ex;
     const SDL_bool is_copy_ex = (cmd->command == SDL_RENDERCMD_COPY_EX);
+    const SDL_bool was_geometry = data->drawstate.is_geometry;
+    const SDL_bool is_geometry = (cmd->command == SDL_RENDERCMD_GEOMETRY);
     SDL_Texture *texture = cmd->data.draw.texture;
     const SDL_BlendMode blend = cmd->data.draw.blend;
     GLES2_ProgramCacheEntry *program;
@@ -960,7 +1090,13 @@ SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_I
         data->drawstate.texture = texture;
     }
 
-    if (texture) {
+    if (is_geometry) {
+        if (texture) {
+            data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof (GLES2_Vertex), (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 2) + sizeof (SDL_Color)));
+        }
+    } else if (cmd->command == SDL_RENDERCMD_COPY) {
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 12 * cmd->data.draw.count)));
+    } else if (texture) {
         data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 8)));
     }
 
@@ -977,15 +1113,26 @@ SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_I
         }
     }
 
-    if (program->uniform_locations[GLES2_UNIFORM_COLOR] != -1) {
-        if (data->drawstate.color != program->color) {
-            const Uint8 r = (data->drawstate.color >> 16) & 0xFF;
-            const Uint8 g = (data->drawstate.color >> 8) & 0xFF;
-            const Uint8 b = (data->drawstate.color >> 0) & 0xFF;
-            const Uint8 a = (data->drawstate.color >> 24) & 0xFF;
-            data->glUniform4f(program->uniform_locations[GLES2_UNIFORM_COLOR], r * inv255f, g * inv255f, b * inv255f, a * inv255f);
-            program->color = data->drawstate.color;
+    /* Geometry has a color per vertex, everything else uses the draw color for all of them */
+    if (is_geometry != was_geometry) {
+        if (is_geometry) {
+            data->glEnableVertexAttribArray((GLenum) GLES2_ATTRIBUTE_COLOR);
+        } else {
+            data->glDisableVertexAttribArray((GLenum) GLES2_ATTRIBUTE_COLOR);
         }
+        data->drawstate.is_geometry = is_geometry;
+    }
+
+    if (is_geometry) {
+        data->glVertexAttribPointer(GLES2_ATTRIBUTE_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof (GLES2_Vertex), (const GLvoid *) (cmd->data.draw.first + (sizeof (GLfloat) * 2)));
+    } else if (data->drawstate.color != data->drawstate.vertex_color || was_geometry) {
+        /* The current attribute value is undefined after drawing with the array enabled */
+        const Uint8 r = (data->drawstate.color >> 16) & 0xFF;
+        const Uint8 g = (data->drawstate.color >> 8) & 0xFF;
+        const Uint8 b = (data->drawstate.color >> 0) & 0xFF;
+        const Uint8 a = (data->drawstate.color >> 24) & 0xFF;
+        data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, r * inv255f, g * inv255f, b * inv255f, a * inv255f);
+        data->drawstate.vertex_color = data->drawstate.color;
     }
 
     if (blend != data->drawstate.blend) {
@@ -1004,7 +1151,7 @@ SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_I
     }
 
     /* all drawing commands use this */
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) cmd->data.draw.first);
+    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, is_geometry ? sizeof (GLES2_Vertex) : 0, (const GLvoid *) cmd->data.draw.first);
 
     if (is_copy_ex != was_copy_ex) {
         if (is_copy_ex) {
@@ -1139,6 +1286,62 @@ SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
     return SetDrawState(data, cmd, sourceType);
 }
 
+/* With OpenGL ES 3.0, vertices are queued straight into the VBO the next
+   batch draws from, instead of being copied there with glBufferSubData. */
+static void *
+GLES2_MapVertexData(SDL_Renderer * renderer, size_t used, size_t numbytes, size_t *allocation)
+{
+    GLES2_RenderData *data = (GLES2_RenderData *) renderer->driverdata;
+    const int vboidx = data->current_vertex_buffer;
+    void *vertices;
+
+    if (GLES2_ActivateRenderer(renderer) < 0) {
+        return NULL;
+    }
+
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_buffers[vboidx]);
+
+    if (data->vertex_buffer_mapped) {
+        data->glUnmapBuffer(GL_ARRAY_BUFFER);
+        data->vertex_buffer_mapped = SDL_FALSE;
+    }
+
+    if (used == 0) {
+        /* Starting a new batch, throw away whatever the buffer had */
+        if (data->vertex_buffer_size[vboidx] < numbytes) {
+            data->glBufferData(GL_ARRAY_BUFFER, numbytes, NULL, GL_STREAM_DRAW);
+            data->vertex_buffer_size[vboidx] = numbytes;
+        }
+        vertices = data->glMapBufferRange(GL_ARRAY_BUFFER, 0, data->vertex_buffer_size[vboidx],
+                                          GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    } else {
+        /* Growing during a batch, move what was queued so far to a bigger buffer */
+        GLuint vbo = 0;
+
+        data->glGenBuffers(1, &vbo);
+        data->glBindBuffer(GL_COPY_READ_BUFFER, data->vertex_buffers[vboidx]);
+        data->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        data->glBufferData(GL_ARRAY_BUFFER, numbytes, NULL, GL_STREAM_DRAW);
+        data->glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, used);
+        data->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        data->glDeleteBuffers(1, &data->vertex_buffers[vboidx]);
+        data->vertex_buffers[vboidx] = vbo;
+        data->vertex_buffer_size[vboidx] = numbytes;
+        vertices = data->glMapBufferRange(GL_ARRAY_BUFFER, 0, numbytes, GL_MAP_WRITE_BIT);
+    }
+
+    if (!vertices) {
+        /* Nothing is mapped now, but the buffer still has the first 'used' bytes */
+        GL_CheckError("glMapBufferRange()", renderer);
+        SDL_SetError("Couldn't map vertex buffer");
+        return NULL;
+    }
+
+    data->vertex_buffer_mapped = SDL_TRUE;
+    *allocation = data->vertex_buffer_size[vboidx];
+    return vertices;
+}
+
 static int
 GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
@@ -1159,7 +1362,17 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
 
     /* upload the new VBO data for this set of commands. */
     data->glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    if (data->vertex_buffer_size[vboidx] < vertsize) {
+    if (data->vertex_buffer_mapped) {
+        /* it's already there, we just have to give it back to the GL */
+        data->vertex_buffer_mapped = SDL_FALSE;
+        if (!data->glUnmapBuffer(GL_ARRAY_BUFFER)) {
+            /* the contents were lost, which can happen on a display mode change */
+            data->current_vertex_buffer = (vboidx + 1) % SDL_arraysize(data->vertex_buffers);
+            return SDL_SetError("Vertex buffer contents were lost");
+        }
+    } else if (!vertices) {
+        /* mapping a bigger buffer failed, what was queued before is already in this one */
+    } else if (data->vertex_buffer_size[vboidx] < vertsize) {
         data->glBufferData(GL_ARRAY_BUFFER, vertsize, vertices, GL_STREAM_DRAW);
         data->vertex_buffer_size[vboidx] = vertsize;
     } else {
@@ -1226,12 +1439,14 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                     data->drawstate.cliprect_enabled_dirty = data->drawstate.cliprect_enabled;
                 }
 
+                renderer->stats.draw_calls++;
                 data->glClear(GL_COLOR_BUFFER_BIT);
                 break;
             }
 
             case SDL_RENDERCMD_DRAW_POINTS: {
                 if (SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID) == 0) {
+                    renderer->stats.draw_calls++;
                     data->glDrawArrays(GL_POINTS, 0, (GLsizei) cmd->data.draw.count);
                 }
                 break;
@@ -1241,6 +1456,7 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 const size_t count = cmd->data.draw.count;
                 SDL_assert(count >= 2);
                 if (SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID) == 0) {
+                    renderer->stats.draw_calls++;
                     data->glDrawArrays(GL_LINE_STRIP, 0, (GLsizei) count);
                 }
                 break;
@@ -1251,20 +1467,43 @@ GLES2_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 size_t offset = 0;
                 if (SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID) == 0) {
                     for (i = 0; i < count; ++i, offset += 4) {
+                        renderer->stats.draw_calls++;
                         data->glDrawArrays(GL_TRIANGLE_STRIP, (GLsizei) offset, 4);
                     }
                 }
                 break;
             }
 
-            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY: {
+                if (SetCopyState(renderer, cmd) == 0) {
+                    renderer->stats.draw_calls++;
+                    data->glDrawArrays(GL_TRIANGLES, 0, (GLsizei) (cmd->data.draw.count * 6));
+                }
+                break;
+            }
+
             case SDL_RENDERCMD_COPY_EX: {
                 if (SetCopyState(renderer, cmd) == 0) {
+                    renderer->stats.draw_calls++;
                     data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
                 }
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY: {
+                int ret;
+                if (cmd->data.draw.texture) {
+                    ret = SetCopyState(renderer, cmd);
+                } else {
+                    ret = SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID);
+                }
+                if (ret == 0) {
+                    renderer->stats.draw_calls++;
+                    data->glDrawArrays(GL_TRIANGLES, 0, (GLsizei) cmd->data.draw.count);
+                }
+                break;
+            }
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -1485,6 +1724,14 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
        data->fbo = NULL;
     }
 
+    if (texture->access == SDL_TEXTUREACCESS_STREAMING && renderdata->pixel_buffers_supported &&
+        texture->format != SDL_PIXELFORMAT_EXTERNAL_OES) {
+        int i;
+        for (i = 0; i < GLES2_PIXEL_BUFFER_COUNT; ++i) {
+            renderdata->glGenBuffers(1, &data->pbos[i].buffer);
+        }
+    }
+
     return GL_CheckError("", renderer);
 }
 
@@ -1525,20 +1772,15 @@ GLES2_TexSubImage2D(GLES2_RenderData *data, GLenum target, GLint xoffset, GLint
     return 0;
 }
 
+/* Uploads from client memory, or from the bound pixel buffer if pixels is an offset into it.
+   Data in a pixel buffer has to be tightly packed, GLES2_TexSubImage2D() can't repack it. */
 static int
-GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
+GLES2_UploadTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
                     const void *pixels, int pitch)
 {
     GLES2_RenderData *data = (GLES2_RenderData *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
 
-    GLES2_ActivateRenderer(renderer);
-
-    /* Bail out if we're supposed to update an empty rectangle */
-    if (rect->w <= 0 || rect->h <= 0) {
-        return 0;
-    }
-
     data->drawstate.texture = NULL;  /* we trash this state. */
 
     /* Create a texture subimage with the supplied data */
@@ -1604,6 +1846,174 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
+/* The size of a tightly packed upload of h rows, including the chroma planes */
+static size_t
+GLES2_GetPixelBufferSize(SDL_Texture *texture, int h, int pitch)
+{
+    size_t size = (size_t) h * pitch;
+
+#if SDL_HAVE_YUV
+    GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+    if (tdata->yuv || tdata->nv12) {
+        size += 2 * ((h + 1) / 2) * ((pitch + 1) / 2);
+    }
+#endif
+    return size;
+}
+
+/* Maps the next pixel buffer of a streaming texture for writing.
+   Returns NULL if there isn't one, and the caller uploads from client memory instead. */
+static void *
+GLES2_MapPixelBuffer(SDL_Renderer *renderer, GLES2_TextureData *tdata, size_t size)
+{
+    GLES2_RenderData *data = (GLES2_RenderData *)renderer->driverdata;
+    GLES2_PixelBuffer *pbo;
+    GLbitfield access = GL_MAP_WRITE_BIT;
+    SDL_bool busy = SDL_FALSE;
+    void *pixels;
+
+    if (!tdata->pbos[0].buffer || size == 0) {
+        return NULL;
+    }
+
+    tdata->current_pbo = (tdata->current_pbo + 1) % GLES2_PIXEL_BUFFER_COUNT;
+    pbo = &tdata->pbos[tdata->current_pbo];
+
+    if (pbo->fence) {
+        const GLenum status = data->glClientWaitSync(pbo->fence, 0, 0);
+        busy = (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED);
+        data->glDeleteSync(pbo->fence);
+        pbo->fence = NULL;
+    }
+
+    data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo->buffer);
+    if (busy || size > pbo->size) {
+        /* Orphan the old storage instead of waiting for the GPU to finish with it */
+        data->glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        pbo->size = size;
+        access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+    } else {
+        /* The fence says the GPU is done with it, so skip the driver's own checks */
+        access |= GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    }
+    pixels = data->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, access);
+
+    /* Leave nothing bound, so other uploads keep reading from client memory */
+    data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!pixels) {
+        GL_CheckError("glMapBufferRange()", renderer);
+    }
+    return pixels;
+}
+
+/* Unmaps the current pixel buffer and starts copying it into the texture.
+   The buffer holds the rows of rect packed at the given pitch, followed by the chroma planes. */
+static int
+GLES2_UnmapPixelBuffer(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect, int pitch)
+{
+    GLES2_RenderData *data = (GLES2_RenderData *)renderer->driverdata;
+    GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+    GLES2_PixelBuffer *pbo = &tdata->pbos[tdata->current_pbo];
+    int status;
+
+    data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo->buffer);
+    if (!data->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+        /* The buffer contents got lost */
+        data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        pbo->size = 0;
+        return SDL_SetError("glUnmapBuffer() failed, the texture data was lost");
+    }
+
+    status = GLES2_UploadTexture(renderer, texture, rect, NULL, pitch);
+    pbo->fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    data->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return status;
+}
+
+static void
+GLES2_CopyRows(Uint8 *dst, int dst_pitch, const Uint8 *src, int src_pitch, int length, int rows)
+{
+    if (dst_pitch == src_pitch) {
+        SDL_memcpy(dst, src, (size_t) rows * length);
+        return;
+    }
+    while (rows--) {
+        SDL_memcpy(dst, src, length);
+        dst += dst_pitch;
+        src += src_pitch;
+    }
+}
+
+/* Copies the planes of an update into a pixel buffer and uploads it from there.
+   planes[1] is the plane that GLES2_UploadTexture() expects right after the Y plane.
+   Returns -1 if the caller has to upload from client memory instead. */
+static int
+GLES2_UpdateTextureBuffered(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
+                            const Uint8 *planes[3], const int pitches[3])
+{
+    GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+    const int pitch = rect->w * SDL_BYTESPERPIXEL(texture->format);
+    Uint8 *dst;
+
+    dst = (Uint8 *) GLES2_MapPixelBuffer(renderer, tdata, GLES2_GetPixelBufferSize(texture, rect->h, pitch));
+    if (!dst) {
+        return -1;
+    }
+
+    GLES2_CopyRows(dst, pitch, planes[0], pitches[0], pitch, rect->h);
+#if SDL_HAVE_YUV
+    if (tdata->yuv) {
+        const int uvpitch = (pitch + 1) / 2;
+        const int uvrows = (rect->h + 1) / 2;
+
+        dst += rect->h * pitch;
+        GLES2_CopyRows(dst, uvpitch, planes[1], pitches[1], (rect->w + 1) / 2, uvrows);
+        dst += uvrows * uvpitch;
+        GLES2_CopyRows(dst, uvpitch, planes[2], pitches[2], (rect->w + 1) / 2, uvrows);
+    } else if (tdata->nv12) {
+        dst += rect->h * pitch;
+        GLES2_CopyRows(dst, 2 * ((pitch + 1) / 2), planes[1], pitches[1], 2 * ((rect->w + 1) / 2), (rect->h + 1) / 2);
+    }
+#endif
+
+    return GLES2_UnmapPixelBuffer(renderer, texture, rect, pitch);
+}
+
+static int
+GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
+                    const void *pixels, int pitch)
+{
+    GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+
+    GLES2_ActivateRenderer(renderer);
+
+    /* Bail out if we're supposed to update an empty rectangle */
+    if (rect->w <= 0 || rect->h <= 0) {
+        return 0;
+    }
+
+    if (tdata->pbos[0].buffer) {
+        const Uint8 *planes[3];
+        int pitches[3];
+
+        planes[0] = (const Uint8 *) pixels;
+        pitches[0] = pitch;
+#if SDL_HAVE_YUV
+        if (tdata->yuv || tdata->nv12) {
+            /* The chroma planes follow the Y plane, the same as GLES2_UploadTexture() reads them */
+            planes[1] = planes[0] + rect->h * pitch;
+            pitches[1] = tdata->nv12 ? 2 * ((pitch + 1) / 2) : (pitch + 1) / 2;
+            planes[2] = planes[1] + ((rect->h + 1) / 2) * pitches[1];
+            pitches[2] = pitches[1];
+        }
+#endif
+        if (GLES2_UpdateTextureBuffered(renderer, texture, rect, planes, pitches) == 0) {
+            return 0;
+        }
+    }
+    return GLES2_UploadTexture(renderer, texture, rect, pixels, pitch);
+}
+
 #if SDL_HAVE_YUV
 static int
 GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
@@ -1622,6 +2032,21 @@ GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
         return 0;
     }
 
+    if (tdata->pbos[0].buffer) {
+        const Uint8 *planes[3];
+        int pitches[3];
+
+        planes[0] = Yplane;
+        pitches[0] = Ypitch;
+        planes[1] = (texture->format == SDL_PIXELFORMAT_YV12) ? Vplane : Uplane;
+        pitches[1] = (texture->format == SDL_PIXELFORMAT_YV12) ? Vpitch : Upitch;
+        planes[2] = (texture->format == SDL_PIXELFORMAT_YV12) ? Uplane : Vplane;
+        pitches[2] = (texture->format == SDL_PIXELFORMAT_YV12) ? Upitch : Vpitch;
+        if (GLES2_UpdateTextureBuffered(renderer, texture, rect, planes, pitches) == 0) {
+            return 0;
+        }
+    }
+
     data->drawstate.texture = NULL;  /* we trash this state. */
 
     data->glBindTexture(tdata->texture_type, tdata->texture_v);
@@ -1673,6 +2098,19 @@ GLES2_UpdateTextureNV(SDL_Renderer * renderer, SDL_Texture * texture,
         return 0;
     }
 
+    if (tdata->pbos[0].buffer) {
+        const Uint8 *planes[3];
+        int pitches[3];
+
+        planes[0] = Yplane;
+        pitches[0] = Ypitch;
+        planes[1] = UVplane;
+        pitches[1] = UVpitch;
+        if (GLES2_UpdateTextureBuffered(renderer, texture, rect, planes, pitches) == 0) {
+            return 0;
+        }
+    }
+
     data->drawstate.texture = NULL;  /* we trash this state. */
 
     data->glBindTexture(tdata->texture_type, tdata->texture_u);
@@ -1705,6 +2143,22 @@ GLES2_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *
 {
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
 
+    if (tdata->pbos[0].buffer && rect->w > 0 && rect->h > 0) {
+        /* Hand out the upload buffer itself, packed to the locked rectangle */
+        const int locked_pitch = rect->w * SDL_BYTESPERPIXEL(texture->format);
+        void *mapped;
+
+        GLES2_ActivateRenderer(renderer);
+        mapped = GLES2_MapPixelBuffer(renderer, tdata, GLES2_GetPixelBufferSize(texture, rect->h, locked_pitch));
+        if (mapped) {
+            tdata->locked_pbo = SDL_TRUE;
+            tdata->locked_rect = *rect;
+            *pixels = mapped;
+            *pitch = locked_pitch;
+            return 0;
+        }
+    }
+
     /* Retrieve the buffer/pitch for the specified region */
     *pixels = (Uint8 *)tdata->pixel_data +
               (tdata->pitch * rect->y) +
@@ -1720,6 +2174,14 @@ GLES2_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
     SDL_Rect rect;
 
+    if (tdata->locked_pbo) {
+        tdata->locked_pbo = SDL_FALSE;
+        GLES2_ActivateRenderer(renderer);
+        GLES2_UnmapPixelBuffer(renderer, texture, &tdata->locked_rect,
+                               tdata->locked_rect.w * SDL_BYTESPERPIXEL(texture->format));
+        return;
+    }
+
     /* We do whole texture updates, at least for now */
     rect.x = 0;
     rect.y = 0;
@@ -1811,6 +2273,15 @@ GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
             data->glDeleteTextures(1, &tdata->texture_u);
         }
 #endif
+        if (tdata->pbos[0].buffer) {
+            int i;
+            for (i = 0; i < GLES2_PIXEL_BUFFER_COUNT; ++i) {
+                if (tdata->pbos[i].fence) {
+                    data->glDeleteSync(tdata->pbos[i].fence);
+                }
+                data->glDeleteBuffers(1, &tdata->pbos[i].buffer);
+            }
+        }
         SDL_free(tdata->pixel_data);
         SDL_free(tdata);
         texture->driverdata = NULL;
@@ -2034,6 +2505,26 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     /* we keep a few of these and cycle through them, so data can live for a few frames. */
     data->glGenBuffers(SDL_arraysize(data->vertex_buffers), data->vertex_buffers);
 
+    /* OpenGL ES 3.0 lets us map those and skip the copy into them */
+    {
+        const char *version = (const char *) data->glGetString(GL_VERSION);
+        if (version && SDL_strncmp(version, "OpenGL ES ", 10) == 0 && SDL_atoi(version + 10) >= 3) {
+            data->glMapBufferRange = SDL_GL_GetProcAddress("glMapBufferRange");
+            data->glUnmapBuffer = SDL_GL_GetProcAddress("glUnmapBuffer");
+            data->glCopyBufferSubData = SDL_GL_GetProcAddress("glCopyBufferSubData");
+            data->glFenceSync = SDL_GL_GetProcAddress("glFenceSync");
+            data->glClientWaitSync = SDL_GL_GetProcAddress("glClientWaitSync");
+            data->glDeleteSync = SDL_GL_GetProcAddress("glDeleteSync");
+        }
+    }
+
+    /* ... and upload streaming textures through pixel buffer objects */
+    if (SDL_GetHintBoolean(SDL_HINT_RENDER_STREAMING_BUFFERS, SDL_TRUE) &&
+        data->glMapBufferRange && data->glUnmapBuffer &&
+        data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+        data->pixel_buffers_supported = SDL_TRUE;
+    }
+
     data->framebuffers = NULL;
     data->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &window_framebuffer);
     data->window_framebuffer = (GLuint)window_framebuffer;
@@ -2058,8 +2549,16 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->QueueDrawLines      = GLES2_QueueDrawLines;
     renderer->QueueFillRects      = GLES2_QueueFillRects;
     renderer->QueueCopy           = GLES2_QueueCopy;
+    renderer->QueueCopyBatch      = GLES2_QueueCopyBatch;
     renderer->QueueCopyEx         = GLES2_QueueCopyEx;
+    renderer->QueueGeometry       = GLES2_QueueGeometry;
+    /* Copies keep their positions and texture coordinates in separate blocks, so they can't be concatenated */
+    renderer->mergeable_commands  = (1 << SDL_RENDERCMD_DRAW_POINTS) | (1 << SDL_RENDERCMD_FILL_RECTS) |
+                                    (1 << SDL_RENDERCMD_GEOMETRY);
     renderer->RunCommandQueue     = GLES2_RunCommandQueue;
+    if (data->glMapBufferRange && data->glUnmapBuffer && data->glCopyBufferSubData) {
+        renderer->MapVertexData   = GLES2_MapVertexData;
+    }
     renderer->RenderReadPixels    = GLES2_RenderReadPixels;
     renderer->RenderPresent       = GLES2_RenderPresent;
     renderer->DestroyTexture      = GLES2_DestroyTexture;
@@ -2082,11 +2581,14 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
 
     data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_POSITION);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
 
     data->glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
 
     data->drawstate.blend = SDL_BLENDMODE_INVALID;
     data->drawstate.color = 0xFFFFFFFF;
+    data->drawstate.vertex_color = 0xFFFFFFFF;
     data->drawstate.clear_color = 0xFFFFFFFF;
     data->drawstate.projection[3][0] = -1.0f;
     data->drawstate.projection[3][3] = 1.0f;
@@ -847,6 +847,9 @@ PSP_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                break;  /* unsupported */
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -33,6 +33,10 @@
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
+#include "SDL_triangle.h"
+#include "../../thread/SDL_jobs_c.h"
+#include "../../video/SDL_pixels_c.h"
+#include "../../video/SDL_RLEaccel_c.h"
 
 /* SDL surface based renderer implementation */
 
@@ -43,10 +47,78 @@ typedef struct
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+/* With SDL_HINT_RENDER_SOFTWARE_THREADS the output is split into tiles of
+   this size, which are rendered in parallel */
+#define SW_TILE_SIZE    128
+
+typedef struct
+{
+    const SDL_RenderCommand *cmd;
+    SDL_Rect clip;      /* viewport and clip rect in surface coordinates */
+} SW_TileCommand;
+
+typedef struct
+{
+    int *commands;      /* indices of the commands touching this tile, in draw order */
+    int num_commands;
+    int max_commands;
+} SW_Tile;
+
+typedef struct
+{
+    SDL_Surface *texture;
+    SDL_Surface *clone;
+} SW_TextureClone;
+
+struct SW_TileQueue;
+
+/* Clip rects and blit maps are kept in the surfaces, so each worker draws
+   through its own surfaces sharing the pixels of the target and textures.
+   They are kept across flushes, so the blit maps don't have to be rebuilt. */
+typedef struct
+{
+    struct SW_TileQueue *queue;
+    SDL_Surface *surface;
+    SW_TextureClone *clones;
+    int num_clones;
+    int max_clones;
+} SW_TileWorker;
+
+typedef struct SW_TileQueue
+{
+    SDL_Surface *surface;
+    void *vertices;
+    int tiles_x;
+    int tiles_y;
+    SW_Tile *tiles;
+    int max_tiles;
+    SW_TileCommand *commands;
+    int num_commands;
+    int max_commands;
+    SW_TileWorker *workers;
+    int num_workers;
+    int max_workers;
+    SDL_atomic_t next_tile;
+} SW_TileQueue;
+
+/* Damage rectangles beyond this are merged into the closest one */
+#define SW_MAX_DAMAGE_RECTS 16
+
+typedef struct
+{
+    SDL_Rect rects[SW_MAX_DAMAGE_RECTS];
+    int num_rects;
+    SDL_bool all;       /* the whole output, rects are unused */
+} SW_Damage;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    SW_TileQueue tiles;
+    SDL_bool track_damage;
+    SW_Damage damage;       /* drawn to the output since the last present */
+    SW_Damage presented;    /* updated by the last present */
 } SW_RenderData;
 
 
@@ -76,6 +148,14 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
         data->surface = NULL;
         data->window = NULL;
     }
+
+    /* The window contents may be gone, present everything next time */
+    if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+        event->event == SDL_WINDOWEVENT_EXPOSED ||
+        event->event == SDL_WINDOWEVENT_SHOWN ||
+        event->event == SDL_WINDOWEVENT_RESTORED) {
+        data->damage.all = SDL_TRUE;
+    }
 }
 
 static int
@@ -266,33 +346,47 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
 }
 
 static int
-SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+SW_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
 {
-    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, count * 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
 
-    SDL_memcpy(verts, srcrect, sizeof (SDL_Rect));
-    verts++;
+    /* Each copy is a source rect followed by a destination rect */
+    for (i = 0; i < count; i++) {
+        const SDL_FRect *dstrect = &dstrects[i];
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        verts->x = (int)(renderer->viewport.x + dstrect->x);
-        verts->y = (int)(renderer->viewport.y + dstrect->y);
-    } else {
-        verts->x = (int)dstrect->x;
-        verts->y = (int)dstrect->y;
+        SDL_memcpy(verts, &srcrects[i], sizeof (SDL_Rect));
+        verts++;
+
+        if (renderer->viewport.x || renderer->viewport.y) {
+            verts->x = (int)(renderer->viewport.x + dstrect->x);
+            verts->y = (int)(renderer->viewport.y + dstrect->y);
+        } else {
+            verts->x = (int)dstrect->x;
+            verts->y = (int)dstrect->y;
+        }
+        verts->w = (int)dstrect->w;
+        verts->h = (int)dstrect->h;
+        verts++;
     }
-    verts->w = (int)dstrect->w;
-    verts->h = (int)dstrect->h;
 
     return 0;
 }
 
+static int
+SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    return SW_QueueCopyBatch(renderer, cmd, texture, srcrect, dstrect, 1);
+}
+
 typedef struct CopyExData
 {
     SDL_Rect srcrect;
@@ -333,6 +427,51 @@ SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
     return 0;
 }
 
+static int
+SW_QueueGeometry(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                 const SDL_Vertex * vertices, int num_vertices,
+                 const int * indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    const int count = indices ? num_indices : num_vertices;
+    SDL_Vertex *verts = (SDL_Vertex *) SDL_AllocateRenderVertices(renderer, count * sizeof (SDL_Vertex), 0, &cmd->data.draw.first);
+    const float x = (float) renderer->viewport.x;
+    const float y = (float) renderer->viewport.y;
+    const float texw = texture ? (float) texture->w : 0.0f;
+    const float texh = texture ? (float) texture->h : 0.0f;
+    const Uint8 r = cmd->data.draw.r;
+    const Uint8 g = cmd->data.draw.g;
+    const Uint8 b = cmd->data.draw.b;
+    const Uint8 a = cmd->data.draw.a;
+    const SDL_bool modulate = ((r & g & b & a) != 0xFF);
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+
+    /* Positions go to surface pixels and texture coordinates to texels,
+       and the texture color and alpha modulation is applied up front */
+    for (i = 0; i < count; i++, verts++) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[i] : i];
+        verts->position.x = x + vertex->position.x * scale_x;
+        verts->position.y = y + vertex->position.y * scale_y;
+        verts->color = vertex->color;
+        if (modulate) {
+            verts->color.r = (Uint8) ((verts->color.r * r) / 255);
+            verts->color.g = (Uint8) ((verts->color.g * g) / 255);
+            verts->color.b = (Uint8) ((verts->color.b * b) / 255);
+            verts->color.a = (Uint8) ((verts->color.a * a) / 255);
+        }
+        verts->tex_coord.x = vertex->tex_coord.x * texw;
+        verts->tex_coord.y = vertex->tex_coord.y * texh;
+    }
+
+    return 0;
+}
+
 static int
 SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
                 const SDL_Rect * srcrect, const SDL_Rect * final_rect,
@@ -366,6 +505,17 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
         SDL_LockSurface(src);
     }
 
+    /* Common 32-bit formats are sampled and blended straight into the target */
+    if (SDLgfx_transformBlit(src, srcrect, surface, final_rect, angle,
+                             final_rect->x + (int)center->x, final_rect->y + (int)center->y,
+                             texture->scaleMode != SDL_ScaleModeNearest,
+                             flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL)) {
+        if (SDL_MUSTLOCK(src)) {
+            SDL_UnlockSurface(src);
+        }
+        return 0;
+    }
+
     /* Clone the source surface but use its pixel buffer directly.
      * The original source surface must be treated as read-only.
      */
@@ -561,15 +711,13 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
 }
 
 static void
-PrepTextureForCopy(const SDL_RenderCommand *cmd)
+PrepTextureForCopy(const SDL_RenderCommand *cmd, SDL_Surface *surface)
 {
     const Uint8 r = cmd->data.draw.r;
     const Uint8 g = cmd->data.draw.g;
     const Uint8 b = cmd->data.draw.b;
     const Uint8 a = cmd->data.draw.a;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
     const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -584,34 +732,654 @@ PrepTextureForCopy(const SDL_RenderCommand *cmd)
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
+static void
+GetDrawStateClipRect(const SW_DrawStateCache *drawstate, SDL_Rect *clip_rect)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    const SDL_Rect *cliprect = drawstate->cliprect;
+    SDL_assert(viewport != NULL);  /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
+
+    if (cliprect != NULL) {
+        clip_rect->x = cliprect->x + viewport->x;
+        clip_rect->y = cliprect->y + viewport->y;
+        clip_rect->w = cliprect->w;
+        clip_rect->h = cliprect->h;
+        SDL_IntersectRect(viewport, clip_rect, clip_rect);
+    } else {
+        *clip_rect = *viewport;
+    }
+}
+
 static void
 SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 {
     if (drawstate->surface_cliprect_dirty) {
-        const SDL_Rect *viewport = drawstate->viewport;
-        const SDL_Rect *cliprect = drawstate->cliprect;
-        SDL_assert(viewport != NULL);  /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
-
-        if (cliprect != NULL) {
-            SDL_Rect clip_rect;
-            clip_rect.x = cliprect->x + viewport->x;
-            clip_rect.y = cliprect->y + viewport->y;
-            clip_rect.w = cliprect->w;
-            clip_rect.h = cliprect->h;
-            SDL_IntersectRect(viewport, &clip_rect, &clip_rect);
-            SDL_SetClipRect(surface, &clip_rect);
+        SDL_Rect clip_rect;
+        GetDrawStateClipRect(drawstate, &clip_rect);
+        SDL_SetClipRect(surface, &clip_rect);
+        drawstate->surface_cliprect_dirty = SDL_FALSE;
+    }
+}
+
+static void
+SW_DrawPrimitives(SDL_Surface *surface, const SDL_RenderCommand *cmd, void *vertices)
+{
+    const Uint8 r = cmd->data.draw.r;
+    const Uint8 g = cmd->data.draw.g;
+    const Uint8 b = cmd->data.draw.b;
+    const Uint8 a = cmd->data.draw.a;
+    const int count = (int) cmd->data.draw.count;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS: {
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static SW_TileQueue *
+SW_SetupTiles(SW_RenderData *data, SDL_Surface *surface, void *vertices)
+{
+    SW_TileQueue *queue = &data->tiles;
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    const int num_threads = hint ? SDL_atoi(hint) : 0;
+    int num_tiles;
+
+    if (num_threads <= 1 || !surface->pixels || SDL_MUSTLOCK(surface)) {
+        return NULL;
+    }
+
+    queue->tiles_x = (surface->w + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    queue->tiles_y = (surface->h + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    num_tiles = queue->tiles_x * queue->tiles_y;
+    if (num_tiles < 2 || !SDL_GetInternalJobSystem()) {
+        return NULL;
+    }
+
+    if (num_tiles > queue->max_tiles) {
+        SW_Tile *tiles = (SW_Tile *) SDL_realloc(queue->tiles, num_tiles * sizeof (*tiles));
+        if (!tiles) {
+            return NULL;
+        }
+        SDL_memset(&tiles[queue->max_tiles], 0, (num_tiles - queue->max_tiles) * sizeof (*tiles));
+        queue->tiles = tiles;
+        queue->max_tiles = num_tiles;
+    }
+
+    if (num_threads > queue->max_workers) {
+        SW_TileWorker *workers = (SW_TileWorker *) SDL_realloc(queue->workers, num_threads * sizeof (*workers));
+        if (!workers) {
+            return NULL;
+        }
+        SDL_memset(&workers[queue->max_workers], 0, (num_threads - queue->max_workers) * sizeof (*workers));
+        queue->workers = workers;
+        queue->max_workers = num_threads;
+    }
+
+    queue->surface = surface;
+    queue->vertices = vertices;
+    queue->num_workers = SDL_min(num_threads, num_tiles);
+    queue->num_commands = 0;
+    return queue;
+}
+
+static SDL_bool
+SW_CanBinCommand(const SDL_RenderCommand *cmd, void *vertices)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR:
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_FILL_RECTS:
+            return SDL_TRUE;
+
+        case SDL_RENDERCMD_DRAW_LINES: {
+            /* Clipping moves the endpoints of a diagonal line, which changes
+               the pixels it covers, so those are drawn in one piece. */
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            int i;
+
+            for (i = 1; i < count; ++i) {
+                if (verts[i].x != verts[i - 1].x && verts[i].y != verts[i - 1].y) {
+                    return SDL_FALSE;
+                }
+            }
+            return SDL_TRUE;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            /* Scaled copies sample the source relative to the clipped area */
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            int i;
+
+            for (i = 0; i < count; ++i, verts += 2) {
+                if (verts[0].w != verts[1].w || verts[0].h != verts[1].h) {
+                    return SDL_FALSE;
+                }
+            }
+            return SDL_TRUE;
+        }
+
+        default:
+            return SDL_FALSE;
+    }
+}
+
+static SDL_bool
+SW_GetCommandBounds(void *vertices, const SDL_RenderCommand *cmd, const SDL_Rect *clip, SDL_Rect *bounds)
+{
+    const int count = (int) cmd->data.draw.count;
+    void *verts = ((Uint8 *) vertices) + cmd->data.draw.first;
+    SDL_Rect rect;
+    int i;
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR:
+            *bounds = *clip;
+            return SDL_TRUE;
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+            if (!SDL_EnclosePoints((const SDL_Point *) verts, count, NULL, &rect)) {
+                return SDL_FALSE;
+            }
+            break;
+
+        case SDL_RENDERCMD_FILL_RECTS:
+            if (count <= 0) {
+                return SDL_FALSE;
+            }
+            rect = ((const SDL_Rect *) verts)[0];
+            for (i = 1; i < count; ++i) {
+                SDL_UnionRect(&rect, &((const SDL_Rect *) verts)[i], &rect);
+            }
+            break;
+
+        case SDL_RENDERCMD_COPY:
+            if (count <= 0) {
+                return SDL_FALSE;
+            }
+            rect = ((const SDL_Rect *) verts)[1];
+            for (i = 1; i < count; ++i) {
+                SDL_UnionRect(&rect, &((const SDL_Rect *) verts)[i * 2 + 1], &rect);
+            }
+            break;
+
+        case SDL_RENDERCMD_COPY_EX: {
+            /* The corners rotated around the center like SW_RenderCopyEx does,
+               with a pixel to spare for rounding */
+            const CopyExData *copydata = (const CopyExData *) verts;
+            const SDL_Rect *dstrect = &copydata->dstrect;
+            const double cx = dstrect->x + (int) copydata->center.x;
+            const double cy = dstrect->y + (int) copydata->center.y;
+            double minx = cx, miny = cy, maxx = cx, maxy = cy;
+            double c, s;
+            int dstwidth, dstheight;
+
+            SDLgfx_rotozoomSurfaceSizeTrig(dstrect->w, dstrect->h, copydata->angle, &dstwidth, &dstheight, &c, &s);
+            s = -s;
+            for (i = 0; i < 4; ++i) {
+                const double px = dstrect->x + ((i & 1) ? dstrect->w : 0) - cx;
+                const double py = dstrect->y + ((i & 2) ? dstrect->h : 0) - cy;
+                const double x = px * c - py * s + cx;
+                const double y = px * s + py * c + cy;
+                minx = SDL_min(minx, x);
+                miny = SDL_min(miny, y);
+                maxx = SDL_max(maxx, x);
+                maxy = SDL_max(maxy, y);
+            }
+            rect.x = (int) SDL_floor(minx) - 1;
+            rect.y = (int) SDL_floor(miny) - 1;
+            rect.w = SDL_max((int) SDL_ceil(maxx) + 1 - rect.x, dstwidth + 2);
+            rect.h = SDL_max((int) SDL_ceil(maxy) + 1 - rect.y, dstheight + 2);
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY: {
+            const SDL_Vertex *vertex = (const SDL_Vertex *) verts;
+            float minx, miny, maxx, maxy;
+
+            if (count <= 0) {
+                return SDL_FALSE;
+            }
+            minx = maxx = vertex->position.x;
+            miny = maxy = vertex->position.y;
+            for (i = 1, ++vertex; i < count; ++i, ++vertex) {
+                minx = SDL_min(minx, vertex->position.x);
+                miny = SDL_min(miny, vertex->position.y);
+                maxx = SDL_max(maxx, vertex->position.x);
+                maxy = SDL_max(maxy, vertex->position.y);
+            }
+            /* Clamped so the conversion can't overflow, the clip rect cuts it down anyway */
+            minx = SDL_max(minx, -16777216.0f);
+            miny = SDL_max(miny, -16777216.0f);
+            maxx = SDL_min(maxx, 16777216.0f);
+            maxy = SDL_min(maxy, 16777216.0f);
+            rect.x = (int) SDL_floorf(minx);
+            rect.y = (int) SDL_floorf(miny);
+            rect.w = (int) SDL_ceilf(maxx) + 1 - rect.x;
+            rect.h = (int) SDL_ceilf(maxy) + 1 - rect.y;
+            break;
+        }
+
+        default:
+            return SDL_FALSE;
+    }
+    return SDL_IntersectRect(&rect, clip, bounds);
+}
+
+static Sint64
+SW_RectArea(const SDL_Rect *rect)
+{
+    return (Sint64) rect->w * rect->h;
+}
+
+static void
+SW_AddDamage(SW_Damage *damage, const SDL_Rect *area)
+{
+    SDL_Rect rect = *area;
+    SDL_Rect merged;
+    Sint64 best_growth = 0;
+    int best = -1;
+    int i;
+
+    if (damage->all) {
+        return;
+    }
+
+    /* Absorb the rects that cost nothing extra to merge with, which may
+       make the result overlap others */
+    for (i = 0; i < damage->num_rects; ) {
+        SDL_UnionRect(&damage->rects[i], &rect, &merged);
+        if (SW_RectArea(&merged) <= SW_RectArea(&damage->rects[i]) + SW_RectArea(&rect)) {
+            rect = merged;
+            damage->rects[i] = damage->rects[--damage->num_rects];
+            i = 0;
         } else {
-            SDL_SetClipRect(surface, drawstate->viewport);
+            ++i;
         }
-        drawstate->surface_cliprect_dirty = SDL_FALSE;
+    }
+
+    if (damage->num_rects < SW_MAX_DAMAGE_RECTS) {
+        damage->rects[damage->num_rects++] = rect;
+        return;
+    }
+
+    /* Full, grow the rect that grows least */
+    for (i = 0; i < damage->num_rects; ++i) {
+        Sint64 growth;
+        SDL_UnionRect(&damage->rects[i], &rect, &merged);
+        growth = SW_RectArea(&merged) - SW_RectArea(&damage->rects[i]);
+        if (best < 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    SDL_UnionRect(&damage->rects[best], &rect, &damage->rects[best]);
+}
+
+/* Adds the area a command draws on the output to the damage */
+static void
+SW_DamageCommand(SW_RenderData *data, SDL_Surface *surface, const SDL_RenderCommand *cmd,
+                 const SW_DrawStateCache *drawstate, void *vertices)
+{
+    SDL_Rect surface_rect, clip, bounds;
+
+    if (data->damage.all) {
+        return;
+    }
+
+    surface_rect.x = 0;
+    surface_rect.y = 0;
+    surface_rect.w = surface->w;
+    surface_rect.h = surface->h;
+
+    if (cmd->command == SDL_RENDERCMD_CLEAR) {
+        /* By definition the clear ignores the clip rect */
+        data->damage.all = SDL_TRUE;
+        return;
+    }
+    GetDrawStateClipRect(drawstate, &clip);
+    if (SDL_IntersectRect(&clip, &surface_rect, &clip) &&
+        SW_GetCommandBounds(vertices, cmd, &clip, &bounds)) {
+        SW_AddDamage(&data->damage, &bounds);
+    }
+}
+
+/* Decodes an RLE encoded texture for code that reads its pixels directly.
+   It is still marked for RLE, so the next blit from it encodes it again. */
+static void
+SW_DecodeTexture(SDL_Surface *src)
+{
+    if (src->flags & SDL_RLEACCEL) {
+        SDL_UnRLESurface(src, 1);
+        SDL_InvalidateMap(src->map);
+    }
+}
+
+static int
+SW_BinCommand(SW_TileQueue *queue, const SDL_RenderCommand *cmd, const SW_DrawStateCache *drawstate)
+{
+    SDL_Surface *surface = queue->surface;
+    SW_TileCommand *command;
+    SDL_Rect surface_rect, clip, bounds;
+    int index, x, y, x0, y0, x1, y1;
+
+    surface_rect.x = 0;
+    surface_rect.y = 0;
+    surface_rect.w = surface->w;
+    surface_rect.h = surface->h;
+
+    /* By definition the clear ignores the clip rect */
+    if (cmd->command == SDL_RENDERCMD_CLEAR) {
+        clip = surface_rect;
+    } else {
+        GetDrawStateClipRect(drawstate, &clip);
+        if (!SDL_IntersectRect(&clip, &surface_rect, &clip)) {
+            return 0;  /* nothing to draw */
+        }
+    }
+    if (!SW_GetCommandBounds(queue->vertices, cmd, &clip, &bounds)) {
+        return 0;  /* nothing to draw */
+    }
+
+    if (cmd->command == SDL_RENDERCMD_COPY) {
+        /* The workers read the texture pixels directly */
+        SW_DecodeTexture((SDL_Surface *) cmd->data.draw.texture->driverdata);
+    }
+
+    if (queue->num_commands == queue->max_commands) {
+        const int max_commands = queue->max_commands ? queue->max_commands * 2 : 128;
+        SW_TileCommand *commands = (SW_TileCommand *) SDL_realloc(queue->commands, max_commands * sizeof (*commands));
+        if (!commands) {
+            return SDL_OutOfMemory();
+        }
+        queue->commands = commands;
+        queue->max_commands = max_commands;
+    }
+
+    x0 = bounds.x / SW_TILE_SIZE;
+    y0 = bounds.y / SW_TILE_SIZE;
+    x1 = (bounds.x + bounds.w - 1) / SW_TILE_SIZE;
+    y1 = (bounds.y + bounds.h - 1) / SW_TILE_SIZE;
+    /* Make room in every tile first, so a failure leaves the tiles untouched */
+    for (y = y0; y <= y1; ++y) {
+        for (x = x0; x <= x1; ++x) {
+            SW_Tile *tile = &queue->tiles[y * queue->tiles_x + x];
+            if (tile->num_commands == tile->max_commands) {
+                const int max_commands = tile->max_commands ? tile->max_commands * 2 : 16;
+                int *commands = (int *) SDL_realloc(tile->commands, max_commands * sizeof (*commands));
+                if (!commands) {
+                    return SDL_OutOfMemory();
+                }
+                tile->commands = commands;
+                tile->max_commands = max_commands;
+            }
+        }
+    }
+    for (y = y0; y <= y1; ++y) {
+        for (x = x0; x <= x1; ++x) {
+            SW_Tile *tile = &queue->tiles[y * queue->tiles_x + x];
+            tile->commands[tile->num_commands++] = queue->num_commands;
+        }
+    }
+
+    index = queue->num_commands++;
+    command = &queue->commands[index];
+    command->cmd = cmd;
+    command->clip = clip;
+    return 0;
+}
+
+/* Whether a surface made by SW_CreateSurfaceView() still shares the pixels of the surface */
+static SDL_bool
+SW_IsSurfaceView(const SDL_Surface *view, const SDL_Surface *surface)
+{
+    return (view->pixels == surface->pixels &&
+            view->w == surface->w && view->h == surface->h &&
+            view->pitch == surface->pitch &&
+            view->format->format == surface->format->format);
+}
+
+static SDL_Surface *
+SW_CreateSurfaceView(SDL_Surface *surface)
+{
+    SDL_Surface *view = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                                           surface->format->BitsPerPixel, surface->pitch,
+                                                           surface->format->format);
+    if (view && surface->format->palette) {
+        SDL_SetSurfacePalette(view, surface->format->palette);
+    }
+    return view;
+}
+
+static SDL_Surface *
+SW_GetTextureClone(SW_TileWorker *worker, SDL_Surface *texture)
+{
+    SDL_Surface *clone;
+    int i;
+
+    for (i = 0; i < worker->num_clones; ++i) {
+        if (worker->clones[i].texture == texture) {
+            /* Decoding RLE or relocking may have moved the pixels */
+            if (!SW_IsSurfaceView(worker->clones[i].clone, texture)) {
+                clone = SW_CreateSurfaceView(texture);
+                if (!clone) {
+                    return NULL;
+                }
+                SDL_FreeSurface(worker->clones[i].clone);
+                worker->clones[i].clone = clone;
+            }
+            return worker->clones[i].clone;
+        }
+    }
+
+    if (worker->num_clones == worker->max_clones) {
+        const int max_clones = worker->max_clones ? worker->max_clones * 2 : 8;
+        SW_TextureClone *clones = (SW_TextureClone *) SDL_realloc(worker->clones, max_clones * sizeof (*clones));
+        if (!clones) {
+            return NULL;
+        }
+        worker->clones = clones;
+        worker->max_clones = max_clones;
+    }
+
+    clone = SW_CreateSurfaceView(texture);
+    if (clone) {
+        worker->clones[worker->num_clones].texture = texture;
+        worker->clones[worker->num_clones].clone = clone;
+        ++worker->num_clones;
+    }
+    return clone;
+}
+
+static void
+SW_DrawTileCommand(SW_TileWorker *worker, const SW_TileCommand *command, const SDL_Rect *tile)
+{
+    const SDL_RenderCommand *cmd = command->cmd;
+    SDL_Surface *surface = worker->surface;
+    SDL_Rect clip;
+
+    if (!SDL_IntersectRect(&command->clip, tile, &clip)) {
+        return;
+    }
+    SDL_SetClipRect(surface, &clip);
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR: {
+            const Uint8 r = cmd->data.color.r;
+            const Uint8 g = cmd->data.color.g;
+            const Uint8 b = cmd->data.color.b;
+            const Uint8 a = cmd->data.color.a;
+            SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const int count = (int) cmd->data.draw.count;
+            const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) worker->queue->vertices) + cmd->data.draw.first);
+            SDL_Surface *src = SW_GetTextureClone(worker, (SDL_Surface *) cmd->data.draw.texture->driverdata);
+            int i;
+
+            if (src) {
+                PrepTextureForCopy(cmd, src);
+                for (i = 0; i < count; ++i, verts += 2) {
+                    SDL_Rect dstrect = verts[1];  /* the blit writes back the clipped rect */
+
+                    if (SDL_HasIntersection(&dstrect, &clip)) {
+                        SDL_BlitSurface(src, &verts[0], surface, &dstrect);
+                    }
+                }
+            }
+            break;
+        }
+
+        default:
+            SW_DrawPrimitives(surface, cmd, worker->queue->vertices);
+            break;
+    }
+}
+
+static void
+SW_RunTiles(SW_TileWorker *worker)
+{
+    SW_TileQueue *queue = worker->queue;
+    const int num_tiles = queue->tiles_x * queue->tiles_y;
+    int index;
+
+    while ((index = SDL_AtomicAdd(&queue->next_tile, 1)) < num_tiles) {
+        const SW_Tile *tile = &queue->tiles[index];
+        SDL_Rect rect;
+        int i;
+
+        rect.x = (index % queue->tiles_x) * SW_TILE_SIZE;
+        rect.y = (index / queue->tiles_x) * SW_TILE_SIZE;
+        rect.w = SDL_min(SW_TILE_SIZE, queue->surface->w - rect.x);
+        rect.h = SDL_min(SW_TILE_SIZE, queue->surface->h - rect.y);
+        for (i = 0; i < tile->num_commands; ++i) {
+            SW_DrawTileCommand(worker, &queue->commands[tile->commands[i]], &rect);
+        }
+    }
+}
+
+static void SDLCALL
+SW_RunTilesJob(void *data)
+{
+    SW_RunTiles((SW_TileWorker *) data);
+}
+
+/* Render the commands binned so far, this is done before any command that
+   has to be drawn in one piece, and at the end of the command queue. */
+static int
+SW_FlushTiles(SW_TileQueue *queue)
+{
+    SDL_JobSystem *jobs = SDL_GetInternalJobSystem();
+    SDL_Surface *surface = queue->surface;
+    const int num_tiles = queue->tiles_x * queue->tiles_y;
+    SDL_atomic_t counter;
+    int retval = 0;
+    int num_workers;
+    int i;
+
+    if (queue->num_commands == 0) {
+        return 0;
+    }
+
+    for (num_workers = 0; num_workers < queue->num_workers; ++num_workers) {
+        SW_TileWorker *worker = &queue->workers[num_workers];
+        worker->queue = queue;
+        if (worker->surface && !SW_IsSurfaceView(worker->surface, surface)) {
+            SDL_FreeSurface(worker->surface);
+            worker->surface = NULL;
+        }
+        if (!worker->surface) {
+            worker->surface = SW_CreateSurfaceView(surface);
+            if (!worker->surface) {
+                break;
+            }
+        } else if (worker->surface->format->palette != surface->format->palette) {
+            SDL_SetSurfacePalette(worker->surface, surface->format->palette);
+        }
+    }
+
+    if (num_workers == 0) {
+        retval = -1;
+    } else {
+        SDL_AtomicSet(&queue->next_tile, 0);
+        SDL_AtomicSet(&counter, 0);
+        for (i = 1; i < num_workers; ++i) {
+            SDL_SubmitJob(jobs, SW_RunTilesJob, &queue->workers[i], &counter);
+        }
+        SW_RunTiles(&queue->workers[0]);
+        SDL_WaitJobs(jobs, &counter);
+    }
+
+    for (i = 0; i < num_tiles; ++i) {
+        queue->tiles[i].num_commands = 0;
+    }
+    queue->num_commands = 0;
+
+    return retval;
+}
+
+/* Each copy of a batch is its own blit, everything else draws in one call */
+static Uint32
+SW_CountDrawCalls(const SDL_RenderCommand *cmd)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_COPY:
+            return (Uint32) cmd->data.draw.count;
+        case SDL_RENDERCMD_CLEAR:
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            return 1;
+        default:
+            return 0;
     }
 }
 
 static int
 SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SW_DrawStateCache drawstate;
+    SW_TileQueue *tiles;
+    int retval = 0;
 
     if (!surface) {
         return -1;
@@ -621,7 +1389,36 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = SDL_TRUE;
 
+    tiles = SW_SetupTiles(data, surface, vertices);
+
     while (cmd) {
+        const Uint32 draw_calls = SW_CountDrawCalls(cmd);
+
+        renderer->stats.draw_calls += draw_calls;
+        if (draw_calls > 0 && data->track_damage && surface == data->window) {
+            SW_DamageCommand(data, surface, cmd, &drawstate, vertices);
+        }
+
+        if (tiles) {
+            if (SW_CanBinCommand(cmd, vertices) && SW_BinCommand(tiles, cmd, &drawstate) == 0) {
+                cmd = cmd->next;
+                continue;
+            }
+
+            /* Everything else is drawn in one piece on top of the tiles so far */
+            if (cmd->command == SDL_RENDERCMD_CLEAR ||
+                cmd->command == SDL_RENDERCMD_DRAW_POINTS ||
+                cmd->command == SDL_RENDERCMD_DRAW_LINES ||
+                cmd->command == SDL_RENDERCMD_FILL_RECTS ||
+                cmd->command == SDL_RENDERCMD_COPY ||
+                cmd->command == SDL_RENDERCMD_COPY_EX ||
+                cmd->command == SDL_RENDERCMD_GEOMETRY) {
+                if (SW_FlushTiles(tiles) < 0) {
+                    retval = -1;
+                }
+            }
+        }
+
         switch (cmd->command) {
             case SDL_RENDERCMD_SETDRAWCOLOR: {
                 break;  /* Not used in this backend. */
@@ -651,76 +1448,38 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 break;
             }
 
-            case SDL_RENDERCMD_DRAW_POINTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
-                }
-                break;
-            }
-
-            case SDL_RENDERCMD_DRAW_LINES: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-                }
-                break;
-            }
-
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
             case SDL_RENDERCMD_FILL_RECTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
                 SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
-                }
+                SW_DrawPrimitives(surface, cmd, vertices);
                 break;
             }
 
             case SDL_RENDERCMD_COPY: {
+                const size_t count = cmd->data.draw.count;
                 SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_Rect *srcrect = verts;
-                SDL_Rect *dstrect = verts + 1;
                 SDL_Texture *texture = cmd->data.draw.texture;
                 SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+                size_t i;
 
                 SetDrawState(surface, &drawstate);
 
-                PrepTextureForCopy(cmd);
+                PrepTextureForCopy(cmd, src);
 
-                if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
-                } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-                    SDL_PrivateUpperBlitScaled(src, srcrect, surface, dstrect, texture->scaleMode);
+                for (i = 0; i < count; i++, verts += 2) {
+                    const SDL_Rect *srcrect = verts;
+                    SDL_Rect *dstrect = verts + 1;
+
+                    if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
+                        SDL_BlitSurface(src, srcrect, surface, dstrect);
+                    } else {
+                        /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+                         * to avoid potentially frequent RLE encoding/decoding.
+                         */
+                        SDL_SetSurfaceRLE(surface, 0);
+                        SDL_PrivateUpperBlitScaled(src, srcrect, surface, dstrect, texture->scaleMode);
+                    }
                 }
                 break;
             }
@@ -728,12 +1487,30 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
             case SDL_RENDERCMD_COPY_EX: {
                 const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 SetDrawState(surface, &drawstate);
-                PrepTextureForCopy(cmd);
+                PrepTextureForCopy(cmd, (SDL_Surface *) cmd->data.draw.texture->driverdata);
                 SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                                 &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY: {
+                const SDL_Vertex *verts = (SDL_Vertex *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                SDL_Texture *texture = cmd->data.draw.texture;
+                SDL_Surface *src = texture ? (SDL_Surface *) texture->driverdata : NULL;
+
+                SetDrawState(surface, &drawstate);
+
+                if (src) {
+                    /* The rasterizer reads the texture pixels directly */
+                    SW_DecodeTexture(src);
+                }
+                if (SDL_FillTriangles(surface, verts, (int) cmd->data.draw.count, src, cmd->data.draw.blend,
+                                      texture ? texture->scaleMode : SDL_ScaleModeNearest) < 0) {
+                    retval = -1;
+                }
+                break;
+            }
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -741,7 +1518,11 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
         cmd = cmd->next;
     }
 
-    return 0;
+    if (tiles && SW_FlushTiles(tiles) < 0) {
+        retval = -1;
+    }
+
+    return retval;
 }
 
 static int
@@ -778,18 +1559,67 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
 
+    if (!data->track_damage) {
+        data->damage.all = SDL_TRUE;
+    }
+    data->presented = data->damage;
+    data->damage.num_rects = 0;
+    data->damage.all = SDL_FALSE;
+
     if (window) {
-        SDL_UpdateWindowSurface(window);
+        if (data->presented.all) {
+            SDL_UpdateWindowSurface(window);
+        } else if (data->presented.num_rects > 0) {
+            SDL_UpdateWindowSurfaceRects(window, data->presented.rects, data->presented.num_rects);
+        }
+    }
+}
+
+static int
+SW_GetDamageRects(SDL_Renderer * renderer, SDL_Rect * rects, int maxrects)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const SW_Damage *presented = &data->presented;
+    int i;
+
+    if (presented->all) {
+        if (rects && maxrects > 0) {
+            rects->x = 0;
+            rects->y = 0;
+            if (SW_GetOutputSize(renderer, &rects->w, &rects->h) < 0) {
+                return -1;
+            }
+        }
+        return 1;
     }
+
+    for (i = 0; rects && i < SDL_min(maxrects, presented->num_rects); ++i) {
+        rects[i] = presented->rects[i];
+    }
+    return presented->num_rects;
 }
 
 static void
 SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
-
+    int i, j;
+
+    /* Drop the worker clones, a new texture may get the same surface address */
+    for (i = 0; i < data->tiles.max_workers; ++i) {
+        SW_TileWorker *worker = &data->tiles.workers[i];
+        for (j = 0; j < worker->num_clones; ++j) {
+            if (worker->clones[j].texture == surface) {
+                SDL_FreeSurface(worker->clones[j].clone);
+                worker->clones[j] = worker->clones[--worker->num_clones];
+                break;
+            }
+        }
+    }
     SDL_FreeSurface(surface);
 }
 
@@ -798,6 +1628,25 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SW_TileQueue *queue = &data->tiles;
+        int i;
+
+        for (i = 0; i < queue->max_tiles; ++i) {
+            SDL_free(queue->tiles[i].commands);
+        }
+        for (i = 0; i < queue->max_workers; ++i) {
+            SW_TileWorker *worker = &queue->workers[i];
+            while (worker->num_clones > 0) {
+                SDL_FreeSurface(worker->clones[--worker->num_clones].clone);
+            }
+            SDL_free(worker->clones);
+            SDL_FreeSurface(worker->surface);
+        }
+        SDL_free(queue->tiles);
+        SDL_free(queue->commands);
+        SDL_free(queue->workers);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -827,6 +1676,8 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->track_damage = SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_DAMAGE, SDL_FALSE);
+    data->damage.all = SDL_TRUE;
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -842,10 +1693,15 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->QueueDrawLines = SW_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = SW_QueueFillRects;
     renderer->QueueCopy = SW_QueueCopy;
+    renderer->QueueCopyBatch = SW_QueueCopyBatch;
     renderer->QueueCopyEx = SW_QueueCopyEx;
+    renderer->QueueGeometry = SW_QueueGeometry;
+    renderer->mergeable_commands = (1 << SDL_RENDERCMD_DRAW_POINTS) | (1 << SDL_RENDERCMD_FILL_RECTS) |
+                                   (1 << SDL_RENDERCMD_COPY) | (1 << SDL_RENDERCMD_GEOMETRY);
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
+    renderer->GetDamageRects = SW_GetDamageRects;
     renderer->DestroyTexture = SW_DestroyTexture;
     renderer->DestroyRenderer = SW_DestroyRenderer;
     renderer->info = SW_RenderDriver.info;
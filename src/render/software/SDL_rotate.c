@@ -42,6 +42,24 @@ Andreas Schiffler -- aschiffler at ferzkopp dot net
 #include "SDL.h"
 #include "SDL_rotate.h"
 
+/* The SIMD span loops are only used when SDL_HasSSE2() / SDL_HasNEON() report
+   the instruction set at runtime; on x86 the SSE2 loop is built with a target
+   attribute so builds that don't enable SSE2 by default (32-bit) still get it.
+ */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))) && \
+    defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#define HAVE_SSE2_TRANSFORM 1
+#define SDL_TARGETING_SSE2 __attribute__((target("sse2")))
+#elif defined(__SSE2__)
+#define HAVE_SSE2_TRANSFORM 1
+#define SDL_TARGETING_SSE2
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_TRANSFORM 1
+#endif
+
 /* ---- Internally used structures */
 
 /* !
@@ -535,4 +553,627 @@ SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery,
     return rz_dst;
 }
 
+/* !
+\brief Parameters of a direct transform blit, see SDLgfx_transformBlit().
+*/
+typedef struct tTransform {
+    const Uint8 *pixels;    /* source pixels */
+    int pitch;
+    int minu, maxu;         /* source rectangle, texel coordinates are clamped to it */
+    int minv, maxv;
+    Sint32 dsx, dsy;        /* 16.16 source step per destination pixel */
+    Uint32 alpha;           /* OR'ed into the texels of sources without alpha */
+    int swaprb;             /* red and blue are swapped between source and destination */
+    Uint32 modulate;        /* color and alpha modulation, in the pixel layout */
+    int modulated;
+    int smooth;
+    SDL_BlendMode blend;
+} tTransform;
+
+/* !
+\brief Converts a texel to the destination layout.
+*/
+static SDL_INLINE Uint32
+transformConvert(const tTransform *t, Uint32 texel)
+{
+    if (t->swaprb) {
+        texel = (texel & 0xFF00FF00) | ((texel >> 16) & 0xFF) | ((texel & 0xFF) << 16);
+    }
+    return texel | t->alpha;
+}
+
+/* !
+\brief Fetches the four texels around a 16.16 source position for bilinear filtering.
+*/
+static SDL_INLINE void
+transformTaps(const tTransform *t, Sint32 sx, Sint32 sy, Uint32 *taps, int *wx, int *wy)
+{
+    const int u = sx >> 16;
+    const int v = sy >> 16;
+    const int u0 = SDL_min(SDL_max(u, t->minu), t->maxu);
+    const int u1 = SDL_min(SDL_max(u + 1, t->minu), t->maxu);
+    const Uint8 *row0 = t->pixels + SDL_min(SDL_max(v, t->minv), t->maxv) * t->pitch;
+    const Uint8 *row1 = t->pixels + SDL_min(SDL_max(v + 1, t->minv), t->maxv) * t->pitch;
+
+    taps[0] = transformConvert(t, *(const Uint32 *) (row0 + u0 * 4));
+    taps[1] = transformConvert(t, *(const Uint32 *) (row0 + u1 * 4));
+    taps[2] = transformConvert(t, *(const Uint32 *) (row1 + u0 * 4));
+    taps[3] = transformConvert(t, *(const Uint32 *) (row1 + u1 * 4));
+    *wx = (sx >> 8) & 0xFF;
+    *wy = (sy >> 8) & 0xFF;
+}
+
+/* !
+\brief Fetches the texel nearest to a 16.16 source position.
+*/
+static SDL_INLINE Uint32
+transformTexel(const tTransform *t, Sint32 sx, Sint32 sy)
+{
+    const int u = SDL_min(SDL_max(sx >> 16, t->minu), t->maxu);
+    const int v = SDL_min(SDL_max(sy >> 16, t->minv), t->maxv);
+
+    return transformConvert(t, *(const Uint32 *) (t->pixels + v * t->pitch + u * 4));
+}
+
+/* !
+\brief Fetches the raw texel at a 16.16 source position known to be inside the source rectangle.
+*/
+static SDL_INLINE Uint32
+transformFetch(const tTransform *t, Sint32 sx, Sint32 sy)
+{
+    return *(const Uint32 *) (t->pixels + (sy >> 16) * t->pitch + (sx >> 16) * 4);
+}
+
+/* !
+\brief Fetches the four raw texels for bilinear filtering at a 16.16 source position
+whose neighbors to the right and below are inside the source rectangle too.
+*/
+static SDL_INLINE void
+transformFetchTaps(const tTransform *t, Sint32 sx, Sint32 sy, Uint32 *taps, int *wx, int *wy)
+{
+    const Uint8 *row = t->pixels + (sy >> 16) * t->pitch + (sx >> 16) * 4;
+
+    taps[0] = ((const Uint32 *) row)[0];
+    taps[1] = ((const Uint32 *) row)[1];
+    taps[2] = ((const Uint32 *) (row + t->pitch))[0];
+    taps[3] = ((const Uint32 *) (row + t->pitch))[1];
+    *wx = (sx >> 8) & 0xFF;
+    *wy = (sy >> 8) & 0xFF;
+}
+
+/* !
+\brief Samples, modulates and blends a single pixel; the reference for the SIMD versions.
+*/
+static Uint32
+transformPixel(const tTransform *t, Sint32 sx, Sint32 sy, Uint32 dst)
+{
+    Uint32 src = 0, sa, out = 0;
+    int shift;
+
+    if (t->smooth) {
+        Uint32 taps[4];
+        int wx, wy;
+
+        transformTaps(t, sx, sy, taps, &wx, &wy);
+        for (shift = 0; shift < 32; shift += 8) {
+            const Uint32 c00 = (taps[0] >> shift) & 0xFF, c01 = (taps[1] >> shift) & 0xFF;
+            const Uint32 c10 = (taps[2] >> shift) & 0xFF, c11 = (taps[3] >> shift) & 0xFF;
+            const Uint32 top = (c00 * (256 - wx) + c01 * wx) >> 8;
+            const Uint32 bottom = (c10 * (256 - wx) + c11 * wx) >> 8;
+            src |= ((top * (256 - wy) + bottom * wy) >> 8) << shift;
+        }
+    } else {
+        src = transformTexel(t, sx, sy);
+    }
+
+    if (t->modulated) {
+        Uint32 modulated = 0;
+        for (shift = 0; shift < 32; shift += 8) {
+            modulated |= ((((src >> shift) & 0xFF) * ((t->modulate >> shift) & 0xFF)) / 255) << shift;
+        }
+        src = modulated;
+    }
+    if (t->blend == SDL_BLENDMODE_NONE) {
+        return src;
+    }
+
+    /* The blend modes of the generic blitter, the alpha channel is the top byte */
+    sa = src >> 24;
+    for (shift = 0; shift < 32; shift += 8) {
+        const Uint32 s = (src >> shift) & 0xFF;
+        const Uint32 d = (dst >> shift) & 0xFF;
+        Uint32 o;
+        if (t->blend == SDL_BLENDMODE_BLEND) {
+            o = ((shift == 24 ? 255 : s) * sa + d * (255 - sa)) / 255;
+        } else if (shift == 24) {
+            o = d;
+        } else if (t->blend == SDL_BLENDMODE_ADD) {
+            o = d + (s * sa) / 255;
+        } else if (t->blend == SDL_BLENDMODE_MOD) {
+            o = (s * d) / 255;
+        } else {
+            o = (s * d) / 255 + (d * (255 - sa)) / 255;
+        }
+        out |= SDL_min(o, 255) << shift;
+    }
+    return out;
+}
+
+#if HAVE_SSE2_TRANSFORM
+/* !
+\brief Divides 16-bit products of two 8-bit values by 255, rounding down.
+*/
+static SDL_INLINE __m128i SDL_TARGETING_SSE2
+transformDiv255_SSE2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+/* !
+\brief Converts four raw texels to the destination layout.
+*/
+static SDL_INLINE __m128i SDL_TARGETING_SSE2
+transformConvert_SSE2(const tTransform *t, __m128i texels)
+{
+    if (t->swaprb) {
+        const __m128i low = _mm_set1_epi32(0xFF);
+        texels = _mm_or_si128(_mm_and_si128(texels, _mm_set1_epi32((int) 0xFF00FF00)),
+                              _mm_or_si128(_mm_and_si128(_mm_srli_epi32(texels, 16), low),
+                                           _mm_slli_epi32(_mm_and_si128(texels, low), 16)));
+    }
+    return _mm_or_si128(texels, _mm_set1_epi32((int) t->alpha));
+}
+
+/* !
+\brief Interpolates unpacked pixels a and b by 8-bit weights w.
+*/
+static SDL_INLINE __m128i SDL_TARGETING_SSE2
+transformLerp_SSE2(__m128i a, __m128i b, __m128i w)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, _mm_sub_epi16(_mm_set1_epi16(256), w)),
+                                        _mm_mullo_epi16(b, w)), 8);
+}
+
+/* !
+\brief Modulates and blends two unpacked source pixels onto two unpacked destination pixels.
+*/
+static SDL_INLINE __m128i SDL_TARGETING_SSE2
+transformBlend_SSE2(const tTransform *t, __m128i s, __m128i d, __m128i modulate)
+{
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i colors = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    __m128i sa;
+
+    if (t->modulated) {
+        s = transformDiv255_SSE2(_mm_mullo_epi16(s, modulate));
+    }
+    sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    switch (t->blend) {
+    case SDL_BLENDMODE_BLEND:
+        return transformDiv255_SSE2(_mm_add_epi16(_mm_mullo_epi16(_mm_or_si128(s, _mm_andnot_si128(colors, ff)), sa),
+                                                  _mm_mullo_epi16(d, _mm_sub_epi16(ff, sa))));
+    case SDL_BLENDMODE_ADD:
+        return _mm_add_epi16(d, transformDiv255_SSE2(_mm_mullo_epi16(s, _mm_and_si128(sa, colors))));
+    case SDL_BLENDMODE_MOD:
+        return transformDiv255_SSE2(_mm_mullo_epi16(_mm_or_si128(s, _mm_andnot_si128(colors, ff)), d));
+    case SDL_BLENDMODE_MUL:
+        return _mm_add_epi16(transformDiv255_SSE2(_mm_mullo_epi16(_mm_or_si128(s, _mm_andnot_si128(colors, ff)), d)),
+                             transformDiv255_SSE2(_mm_mullo_epi16(d, _mm_and_si128(_mm_sub_epi16(ff, sa), colors))));
+    default:
+        return s;
+    }
+}
+
+/* !
+\brief Transforms four pixels at a time with SSE2, returns the number of pixels done.
+All samples have to be inside the source rectangle, see transformInside().
+*/
+static int SDL_TARGETING_SSE2
+transformSpan_SSE2(const tTransform *transform, Uint32 *dst, int n, Sint32 *psx, Sint32 *psy)
+{
+    /* A local copy, so the compiler knows the stores to dst leave it alone */
+    const tTransform copy = *transform;
+    const tTransform *t = &copy;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i modulate = _mm_unpacklo_epi8(_mm_set1_epi32((int) t->modulate), zero);
+    Sint32 sx = *psx, sy = *psy;
+    int i, k;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i d = _mm_loadu_si128((const __m128i *) &dst[i]);
+        __m128i lo, hi;
+
+        if (t->smooth) {
+            Uint32 taps[4][4];
+            int wx[4], wy[4];
+            __m128i c00, c01, c10, c11, w, wxlo, wxhi, wylo, wyhi;
+
+            for (k = 0; k < 4; ++k, sx += t->dsx, sy += t->dsy) {
+                transformFetchTaps(t, sx, sy, taps[k], &wx[k], &wy[k]);
+            }
+            c00 = transformConvert_SSE2(t, _mm_set_epi32((int) taps[3][0], (int) taps[2][0], (int) taps[1][0], (int) taps[0][0]));
+            c01 = transformConvert_SSE2(t, _mm_set_epi32((int) taps[3][1], (int) taps[2][1], (int) taps[1][1], (int) taps[0][1]));
+            c10 = transformConvert_SSE2(t, _mm_set_epi32((int) taps[3][2], (int) taps[2][2], (int) taps[1][2], (int) taps[0][2]));
+            c11 = transformConvert_SSE2(t, _mm_set_epi32((int) taps[3][3], (int) taps[2][3], (int) taps[1][3], (int) taps[0][3]));
+
+            /* Spread each pixel's weight over its four channels */
+            w = _mm_packs_epi32(_mm_set_epi32(wx[3], wx[2], wx[1], wx[0]), zero);
+            w = _mm_unpacklo_epi16(w, w);
+            wxlo = _mm_unpacklo_epi32(w, w);
+            wxhi = _mm_unpackhi_epi32(w, w);
+            w = _mm_packs_epi32(_mm_set_epi32(wy[3], wy[2], wy[1], wy[0]), zero);
+            w = _mm_unpacklo_epi16(w, w);
+            wylo = _mm_unpacklo_epi32(w, w);
+            wyhi = _mm_unpackhi_epi32(w, w);
+
+            lo = transformLerp_SSE2(transformLerp_SSE2(_mm_unpacklo_epi8(c00, zero), _mm_unpacklo_epi8(c01, zero), wxlo),
+                                    transformLerp_SSE2(_mm_unpacklo_epi8(c10, zero), _mm_unpacklo_epi8(c11, zero), wxlo), wylo);
+            hi = transformLerp_SSE2(transformLerp_SSE2(_mm_unpackhi_epi8(c00, zero), _mm_unpackhi_epi8(c01, zero), wxhi),
+                                    transformLerp_SSE2(_mm_unpackhi_epi8(c10, zero), _mm_unpackhi_epi8(c11, zero), wxhi), wyhi);
+        } else {
+            const Uint32 t0 = transformFetch(t, sx, sy);
+            const Uint32 t1 = transformFetch(t, sx + t->dsx, sy + t->dsy);
+            const Uint32 t2 = transformFetch(t, sx + 2 * t->dsx, sy + 2 * t->dsy);
+            const Uint32 t3 = transformFetch(t, sx + 3 * t->dsx, sy + 3 * t->dsy);
+            const __m128i s = transformConvert_SSE2(t, _mm_set_epi32((int) t3, (int) t2, (int) t1, (int) t0));
+
+            sx += 4 * t->dsx;
+            sy += 4 * t->dsy;
+            lo = _mm_unpacklo_epi8(s, zero);
+            hi = _mm_unpackhi_epi8(s, zero);
+        }
+
+        lo = transformBlend_SSE2(t, lo, _mm_unpacklo_epi8(d, zero), modulate);
+        hi = transformBlend_SSE2(t, hi, _mm_unpackhi_epi8(d, zero), modulate);
+        _mm_storeu_si128((__m128i *) &dst[i], _mm_packus_epi16(lo, hi));
+    }
+
+    *psx = sx;
+    *psy = sy;
+    return i;
+}
+#endif /* HAVE_SSE2_TRANSFORM */
+
+#if HAVE_NEON_TRANSFORM
+/* !
+\brief Divides 16-bit products of two 8-bit values by 255, rounding down.
+*/
+static SDL_INLINE uint16x8_t
+transformDiv255_NEON(uint16x8_t x)
+{
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+/* !
+\brief Interpolates unpacked pixels a and b by 8-bit weights w.
+*/
+static SDL_INLINE uint16x8_t
+transformLerp_NEON(uint16x8_t a, uint16x8_t b, uint16x8_t w)
+{
+    return vshrq_n_u16(vmlaq_u16(vmulq_u16(a, vsubq_u16(vdupq_n_u16(256), w)), b, w), 8);
+}
+
+/* !
+\brief Converts four raw texels to the destination layout.
+*/
+static SDL_INLINE uint32x4_t
+transformConvert_NEON(const tTransform *t, uint32x4_t texels)
+{
+    if (t->swaprb) {
+        const uint32x4_t low = vdupq_n_u32(0xFF);
+        texels = vorrq_u32(vandq_u32(texels, vdupq_n_u32(0xFF00FF00)),
+                           vorrq_u32(vandq_u32(vshrq_n_u32(texels, 16), low),
+                                     vshlq_n_u32(vandq_u32(texels, low), 16)));
+    }
+    return vorrq_u32(texels, vdupq_n_u32(t->alpha));
+}
+
+/* !
+\brief Spreads four 8-bit weights over the channels of two pairs of unpacked pixels.
+*/
+static SDL_INLINE uint16x8x2_t
+transformWeights_NEON(const int *w)
+{
+    const uint16_t w16[4] = { (uint16_t) w[0], (uint16_t) w[1], (uint16_t) w[2], (uint16_t) w[3] };
+    const uint16x4_t w4 = vld1_u16(w16);
+    const uint16x4x2_t pairs = vzip_u16(w4, w4);
+    const uint16x4x2_t lo = vzip_u16(pairs.val[0], pairs.val[0]);
+    const uint16x4x2_t hi = vzip_u16(pairs.val[1], pairs.val[1]);
+    uint16x8x2_t result;
+
+    result.val[0] = vcombine_u16(lo.val[0], lo.val[1]);
+    result.val[1] = vcombine_u16(hi.val[0], hi.val[1]);
+    return result;
+}
+
+/* !
+\brief Modulates and blends two unpacked source pixels onto two unpacked destination pixels.
+*/
+static SDL_INLINE uint16x8_t
+transformBlend_NEON(const tTransform *t, uint16x8_t s, uint16x8_t d, uint16x8_t modulate)
+{
+    const uint16x8_t ff = vdupq_n_u16(0xFF);
+    const uint16x8_t colors = vreinterpretq_u16_u64(vdupq_n_u64(0x0000FFFFFFFFFFFFULL));
+    const uint16x8_t alpha = vbicq_u16(ff, colors);
+    uint16x8_t sa;
+
+    if (t->modulated) {
+        s = transformDiv255_NEON(vmulq_u16(s, modulate));
+    }
+    sa = vcombine_u16(vdup_lane_u16(vget_low_u16(s), 3), vdup_lane_u16(vget_high_u16(s), 3));
+
+    switch (t->blend) {
+    case SDL_BLENDMODE_BLEND:
+        return transformDiv255_NEON(vmlaq_u16(vmulq_u16(vorrq_u16(s, alpha), sa), d, vsubq_u16(ff, sa)));
+    case SDL_BLENDMODE_ADD:
+        return vaddq_u16(d, transformDiv255_NEON(vmulq_u16(s, vandq_u16(sa, colors))));
+    case SDL_BLENDMODE_MOD:
+        return transformDiv255_NEON(vmulq_u16(vorrq_u16(s, alpha), d));
+    case SDL_BLENDMODE_MUL:
+        return vaddq_u16(transformDiv255_NEON(vmulq_u16(vorrq_u16(s, alpha), d)),
+                         transformDiv255_NEON(vmulq_u16(d, vandq_u16(vsubq_u16(ff, sa), colors))));
+    default:
+        return s;
+    }
+}
+
+/* !
+\brief Transforms four pixels at a time with NEON, returns the number of pixels done.
+All samples have to be inside the source rectangle, see transformInside().
+*/
+static int
+transformSpan_NEON(const tTransform *transform, Uint32 *dst, int n, Sint32 *psx, Sint32 *psy)
+{
+    /* A local copy, so the compiler knows the stores to dst leave it alone */
+    const tTransform copy = *transform;
+    const tTransform *t = &copy;
+    const uint16x8_t modulate = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(t->modulate)));
+    Sint32 sx = *psx, sy = *psy;
+    int i, k;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(&dst[i]));
+        uint16x8_t lo, hi;
+
+        if (t->smooth) {
+            Uint32 taps[4][4];
+            int wx[4], wy[4];
+            uint8x16_t c00, c01, c10, c11;
+            uint16x8x2_t wxv, wyv;
+
+            for (k = 0; k < 4; ++k, sx += t->dsx, sy += t->dsy) {
+                transformFetchTaps(t, sx, sy, taps[k], &wx[k], &wy[k]);
+            }
+            /* Transpose the taps so each vector holds the same tap of four pixels */
+            {
+                const uint32x4x4_t v = vld4q_u32(&taps[0][0]);
+                c00 = vreinterpretq_u8_u32(transformConvert_NEON(t, v.val[0]));
+                c01 = vreinterpretq_u8_u32(transformConvert_NEON(t, v.val[1]));
+                c10 = vreinterpretq_u8_u32(transformConvert_NEON(t, v.val[2]));
+                c11 = vreinterpretq_u8_u32(transformConvert_NEON(t, v.val[3]));
+            }
+            wxv = transformWeights_NEON(wx);
+            wyv = transformWeights_NEON(wy);
+
+            lo = transformLerp_NEON(transformLerp_NEON(vmovl_u8(vget_low_u8(c00)), vmovl_u8(vget_low_u8(c01)), wxv.val[0]),
+                                    transformLerp_NEON(vmovl_u8(vget_low_u8(c10)), vmovl_u8(vget_low_u8(c11)), wxv.val[0]), wyv.val[0]);
+            hi = transformLerp_NEON(transformLerp_NEON(vmovl_u8(vget_high_u8(c00)), vmovl_u8(vget_high_u8(c01)), wxv.val[1]),
+                                    transformLerp_NEON(vmovl_u8(vget_high_u8(c10)), vmovl_u8(vget_high_u8(c11)), wxv.val[1]), wyv.val[1]);
+        } else {
+            Uint32 texels[4];
+            uint8x16_t s;
+
+            for (k = 0; k < 4; ++k, sx += t->dsx, sy += t->dsy) {
+                texels[k] = transformFetch(t, sx, sy);
+            }
+            s = vreinterpretq_u8_u32(transformConvert_NEON(t, vld1q_u32(texels)));
+            lo = vmovl_u8(vget_low_u8(s));
+            hi = vmovl_u8(vget_high_u8(s));
+        }
+
+        lo = transformBlend_NEON(t, lo, vmovl_u8(vget_low_u8(d)), modulate);
+        hi = transformBlend_NEON(t, hi, vmovl_u8(vget_high_u8(d)), modulate);
+        vst1q_u32(&dst[i], vreinterpretq_u32_u8(vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi))));
+    }
+
+    *psx = sx;
+    *psy = sy;
+    return i;
+}
+#endif /* HAVE_NEON_TRANSFORM */
+
+/* !
+\brief Checks whether the SIMD loops can sample at a 16.16 source position without clamping.
+*/
+static SDL_INLINE SDL_bool
+transformInside(const tTransform *t, Sint32 sx, Sint32 sy)
+{
+    const int u = sx >> 16;
+    const int v = sy >> 16;
+
+    return (u >= t->minu && u <= t->maxu - t->smooth && v >= t->minv && v <= t->maxv - t->smooth);
+}
+
+/* !
+\brief Narrows [*x0, *x1) to the pixels x whose centers map to 0 <= p0 + dp * (x + 0.5) < limit.
+*/
+static void
+transformLimitSpan(double p0, double dp, double limit, double *x0, double *x1)
+{
+    if (dp == 0.0) {
+        if (p0 < 0.0 || p0 >= limit) {
+            *x1 = *x0;
+        }
+    } else if (dp > 0.0) {
+        *x0 = SDL_max(*x0, SDL_ceil(-p0 / dp - 0.5));
+        *x1 = SDL_min(*x1, SDL_ceil((limit - p0) / dp - 0.5));
+    } else {
+        *x0 = SDL_max(*x0, SDL_floor((limit - p0) / dp - 0.5) + 1.0);
+        *x1 = SDL_min(*x1, SDL_floor(-p0 / dp - 0.5) + 1.0);
+    }
+}
+
+/* !
+
+\brief Rotates, scales and blits a 32-bit 'src' surface directly onto 'dst'.
+
+Draws 'srcrect' of 'src' to 'dstrect' of 'dst', rotated by 'angle' degrees clockwise around the
+point ('centerx', 'centery') of 'dst', and optionally mirrored before the rotation. Every
+destination pixel inside the rotated rectangle and the clip rectangle of 'dst' is sampled from
+the source, modulated and blended in a single pass, using the blend mode, color and alpha
+modulation of 'src'. No intermediate surface is created.
+
+Both surfaces need 32 bits per pixel with the RGB or BGR channels in the lower 24 bits, the
+alpha channel, if any, in the top byte, and no colorkey. Otherwise SDL_FALSE is returned without
+drawing anything, and the caller has to fall back to SDLgfx_rotateSurface().
+
+\param src The source surface, locked if needed.
+\param srcrect The part of the source surface to draw.
+\param dst The destination surface.
+\param dstrect The destination rectangle before the rotation.
+\param angle The angle to rotate in degrees.
+\param centerx Horizontal center of the rotation in 'dst'.
+\param centery Vertical center of the rotation in 'dst'.
+\param smooth Flag indicating bilinear filtering should be used.
+\param flipx Flag indicating horizontal mirroring should be applied.
+\param flipy Flag indicating vertical mirroring should be applied.
+
+\return SDL_TRUE if the surfaces are supported and the blit was done.
+
+*/
+SDL_bool
+SDLgfx_transformBlit(SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, const SDL_Rect * dstrect,
+                     double angle, int centerx, int centery, int smooth, int flipx, int flipy)
+{
+    const SDL_PixelFormat *sf = src->format;
+    const SDL_PixelFormat *df = dst->format;
+    const SDL_Rect *clip = &dst->clip_rect;
+    tTransform t;
+    Uint8 r, g, b, a;
+    double cangle, sangle, scalex, scaley, minx, miny, maxx, maxy;
+    int dstwidth, dstheight, i, y, y0, y1;
+#if HAVE_SSE2_TRANSFORM
+    const SDL_bool has_sse2 = SDL_HasSSE2();
+#endif
+#if HAVE_NEON_TRANSFORM
+    const SDL_bool has_neon = SDL_HasNEON();
+#endif
+
+    if (sf->BytesPerPixel != 4 || df->BytesPerPixel != 4 ||
+        sf->Gmask != 0x0000FF00 || df->Gmask != 0x0000FF00 ||
+        (sf->Rmask | sf->Bmask) != 0x00FF00FF || (df->Rmask | df->Bmask) != 0x00FF00FF ||
+        (sf->Amask != 0 && sf->Amask != 0xFF000000) || (df->Amask != 0 && df->Amask != 0xFF000000) ||
+        SDL_HasColorKey(src) || SDL_MUSTLOCK(dst) || src->w > 32767 || src->h > 32767) {
+        return SDL_FALSE;
+    }
+    if (srcrect->w <= 0 || srcrect->h <= 0 || dstrect->w <= 0 || dstrect->h <= 0) {
+        return SDL_TRUE;
+    }
+
+    SDL_zero(t);
+    t.pixels = (const Uint8 *) src->pixels;
+    t.pitch = src->pitch;
+    t.minu = SDL_max(srcrect->x, 0);
+    t.maxu = SDL_min(srcrect->x + srcrect->w, src->w) - 1;
+    t.minv = SDL_max(srcrect->y, 0);
+    t.maxv = SDL_min(srcrect->y + srcrect->h, src->h) - 1;
+    if (t.minu > t.maxu || t.minv > t.maxv) {
+        return SDL_TRUE;
+    }
+    t.alpha = sf->Amask ? 0 : 0xFF000000;
+    t.swaprb = (sf->Rmask != df->Rmask);
+    t.smooth = smooth;
+    SDL_GetSurfaceBlendMode(src, &t.blend);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    t.modulate = SDL_MapRGBA(df, r, g, b, a) | ((Uint32) a << 24);
+    t.modulated = (r & g & b & a) != 255;
+
+    /* The same rotation SW_RenderCopyEx() uses to place the rotated rectangle */
+    SDLgfx_rotozoomSurfaceSizeTrig(dstrect->w, dstrect->h, angle, &dstwidth, &dstheight, &cangle, &sangle);
+    sangle = -sangle;
+    scalex = (double) srcrect->w / dstrect->w;
+    scaley = (double) srcrect->h / dstrect->h;
+
+    minx = maxx = centerx;
+    miny = maxy = centery;
+    for (i = 0; i < 4; ++i) {
+        const double px = dstrect->x + ((i & 1) ? dstrect->w : 0) - centerx;
+        const double py = dstrect->y + ((i & 2) ? dstrect->h : 0) - centery;
+        const double x = px * cangle - py * sangle + centerx;
+        const double yy = px * sangle + py * cangle + centery;
+        minx = SDL_min(minx, x);
+        miny = SDL_min(miny, yy);
+        maxx = SDL_max(maxx, x);
+        maxy = SDL_max(maxy, yy);
+    }
+    y0 = (int) SDL_max(SDL_floor(miny), (double) clip->y);
+    y1 = (int) SDL_min(SDL_ceil(maxy), (double) (clip->y + clip->h));
+
+    /* Steps through the source for each destination pixel; the fraction
+       is kept for bilinear filtering, which samples between texel centers */
+    t.dsx = (Sint32) SDL_floor((flipx ? -cangle : cangle) * scalex * 65536.0 + 0.5);
+    t.dsy = (Sint32) SDL_floor((flipy ? sangle : -sangle) * scaley * 65536.0 + 0.5);
+
+    for (y = y0; y < y1; ++y) {
+        /* Where the pixel centers of this row land in the unrotated destination rectangle,
+           lx = cangle * X + lx0 and ly = -sangle * X + ly0 */
+        const double dy = y + 0.5 - centery;
+        const double lx0 = sangle * dy - cangle * centerx + centerx - dstrect->x;
+        const double ly0 = cangle * dy + sangle * centerx + centery - dstrect->y;
+        double x0 = SDL_max(SDL_floor(minx), (double) clip->x);
+        double x1 = SDL_min(SDL_ceil(maxx), (double) (clip->x + clip->w));
+        double lx, ly, sx, sy;
+        Uint32 *pixels;
+        int n, inside, done = 0;
+        Sint32 fx, fy;
+
+        transformLimitSpan(lx0, cangle, dstrect->w, &x0, &x1);
+        transformLimitSpan(ly0, -sangle, dstrect->h, &x0, &x1);
+        if (x0 >= x1) {
+            continue;
+        }
+
+        lx = cangle * (x0 + 0.5) + lx0;
+        ly = -sangle * (x0 + 0.5) + ly0;
+        sx = srcrect->x + (flipx ? dstrect->w - lx : lx) * scalex;
+        sy = srcrect->y + (flipy ? dstrect->h - ly : ly) * scaley;
+        if (smooth) {
+            sx -= 0.5;
+            sy -= 0.5;
+        }
+        fx = (Sint32) SDL_floor(sx * 65536.0 + 0.5);
+        fy = (Sint32) SDL_floor(sy * 65536.0 + 0.5);
+
+        pixels = (Uint32 *) ((Uint8 *) dst->pixels + y * dst->pitch) + (int) x0;
+        n = (int) (x1 - x0);
+
+        /* Samples that need clamping to the source rectangle can only be at the ends
+           of the span; they are done one at a time, the SIMD loops take the rest */
+        for (; done < n && !transformInside(&t, fx, fy); ++done, fx += t.dsx, fy += t.dsy) {
+            pixels[done] = transformPixel(&t, fx, fy, pixels[done]);
+        }
+        inside = n;
+        while (inside > done && !transformInside(&t, (Sint32) (fx + (Sint64) (inside - 1 - done) * t.dsx),
+                                                 (Sint32) (fy + (Sint64) (inside - 1 - done) * t.dsy))) {
+            --inside;
+        }
+#if HAVE_SSE2_TRANSFORM
+        if (has_sse2) {
+            done += transformSpan_SSE2(&t, pixels + done, inside - done, &fx, &fy);
+        }
+#endif
+#if HAVE_NEON_TRANSFORM
+        if (has_neon) {
+            done += transformSpan_NEON(&t, pixels + done, inside - done, &fx, &fy);
+        }
+#endif
+        for (; done < n; ++done, fx += t.dsx, fy += t.dsy) {
+            pixels[done] = transformPixel(&t, fx, fy, pixels[done]);
+        }
+    }
+    return SDL_TRUE;
+}
+
 #endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
@@ -0,0 +1,410 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+
+#if SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED
+
+#include "SDL_cpuinfo.h"
+#include "SDL_surface.h"
+#include "SDL_triangle.h"
+
+/* Vertex positions are snapped to this many bits of subpixel precision.
+   The edge functions are then evaluated exactly in 64 bits, so triangles
+   sharing an edge never overlap or leave gaps between them. */
+#define TRIANGLE_SUBPIXEL_BITS  4
+#define TRIANGLE_SUBPIXEL_ONE   (1 << TRIANGLE_SUBPIXEL_BITS)
+#define TRIANGLE_SUBPIXEL_HALF  (TRIANGLE_SUBPIXEL_ONE / 2)
+
+/* Positions further out are clamped, which keeps the edge functions in range */
+#define TRIANGLE_COORD_LIMIT    16777216.0f
+
+/* Color and texture coordinates, interpolated across the triangle */
+#define TRIANGLE_NUM_ATTRIBUTES 6
+
+typedef struct
+{
+    Sint64 value;   /* at pixel 0 of the current row, biased by the fill rule */
+    Sint64 step_x;  /* change per pixel to the right */
+    Sint64 step_y;  /* change per row down */
+} TriangleEdge;
+
+typedef struct
+{
+    const Uint8 *pixels;
+    int pitch;
+    float max_u;
+    float max_v;
+    Uint32 alpha;   /* set in every texel of formats without an alpha channel */
+    SDL_bool linear;
+} TriangleTexture;
+
+static Sint64
+TriangleToFixed(float v)
+{
+    if (!(v > -TRIANGLE_COORD_LIMIT)) {  /* also catches NaN */
+        v = -TRIANGLE_COORD_LIMIT;
+    } else if (v > TRIANGLE_COORD_LIMIT) {
+        v = TRIANGLE_COORD_LIMIT;
+    }
+    return (Sint64) SDL_floor((double) v * TRIANGLE_SUBPIXEL_ONE + 0.5);
+}
+
+/* Rounds towards negative infinity, b must be positive */
+static Sint64
+TriangleFloorDiv(Sint64 a, Sint64 b)
+{
+    Sint64 q = a / b;
+    if ((a % b) != 0 && a < 0) {
+        --q;
+    }
+    return q;
+}
+
+/* The same rounding for both the SIMD and plain C paths, so the pixels
+   don't depend on where a span starts */
+static SDL_INLINE float
+TriangleClamp(float v, float max)
+{
+    v = (v > 0.0f) ? v : 0.0f;
+    return (v < max) ? v : max;
+}
+
+/* Mixes two texels by weight / 256, two channels at a time */
+static SDL_INLINE Uint32
+TriangleLerpTexel(Uint32 p, Uint32 q, Uint32 weight)
+{
+    const Uint32 rb = ((((p & 0x00FF00FF) * (256 - weight)) + ((q & 0x00FF00FF) * weight)) >> 8) & 0x00FF00FF;
+    const Uint32 ag = ((((p >> 8) & 0x00FF00FF) * (256 - weight)) + (((q >> 8) & 0x00FF00FF) * weight)) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static SDL_INLINE Uint32
+TriangleSampleTexture(const TriangleTexture *texture, float u, float v)
+{
+    if (texture->linear) {
+        /* Texel centers are at .5, mixed like the linear scaled blitter does */
+        const float fu = TriangleClamp(u - 0.5f, texture->max_u);
+        const float fv = TriangleClamp(v - 0.5f, texture->max_v);
+        const int u0 = (int) fu;
+        const int v0 = (int) fv;
+        const int u1 = ((float) u0 < texture->max_u) ? u0 + 1 : u0;
+        const int v1 = ((float) v0 < texture->max_v) ? v0 + 1 : v0;
+        const Uint32 wu = (Uint32) ((fu - (float) u0) * 256.0f + 0.5f);
+        const Uint32 wv = (Uint32) ((fv - (float) v0) * 256.0f + 0.5f);
+        const Uint32 *row0 = (const Uint32 *) (texture->pixels + v0 * texture->pitch);
+        const Uint32 *row1 = (const Uint32 *) (texture->pixels + v1 * texture->pitch);
+        const Uint32 top = TriangleLerpTexel(row0[u0] | texture->alpha, row0[u1] | texture->alpha, wu);
+        const Uint32 bottom = TriangleLerpTexel(row1[u0] | texture->alpha, row1[u1] | texture->alpha, wu);
+        return TriangleLerpTexel(top, bottom, wv);
+    } else {
+        const int x = (int) TriangleClamp(u, texture->max_u);
+        const int y = (int) TriangleClamp(v, texture->max_v);
+        return *(const Uint32 *) (texture->pixels + y * texture->pitch + x * 4) | texture->alpha;
+    }
+}
+
+static SDL_INLINE Uint32
+TriangleShadePixel(const float *base, const float *step, int i, const TriangleTexture *texture)
+{
+    const float index = (float) i;
+    Uint32 r = (Uint32) (TriangleClamp(base[0] + step[0] * index, 255.0f) + 0.5f);
+    Uint32 g = (Uint32) (TriangleClamp(base[1] + step[1] * index, 255.0f) + 0.5f);
+    Uint32 b = (Uint32) (TriangleClamp(base[2] + step[2] * index, 255.0f) + 0.5f);
+    Uint32 a = (Uint32) (TriangleClamp(base[3] + step[3] * index, 255.0f) + 0.5f);
+
+    if (texture) {
+        const Uint32 texel = TriangleSampleTexture(texture, base[4] + step[4] * index, base[5] + step[5] * index);
+        r = (((texel >> 16) & 0xFF) * r) / 255;
+        g = (((texel >> 8) & 0xFF) * g) / 255;
+        b = ((texel & 0xFF) * b) / 255;
+        a = ((texel >> 24) * a) / 255;
+    }
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+#ifdef __SSE2__
+static SDL_INLINE __m128i
+TriangleInterpolate_SSE2(float base, float step, __m128 index, __m128 max, SDL_bool round)
+{
+    __m128 v = _mm_add_ps(_mm_set1_ps(base), _mm_mul_ps(_mm_set1_ps(step), index));
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), max);
+    if (round) {
+        v = _mm_add_ps(v, _mm_set1_ps(0.5f));
+    }
+    return _mm_cvttps_epi32(v);
+}
+#endif
+
+/* Write n pixels of ARGB8888 color, starting with the attributes in base */
+static void
+TriangleShadeSpan(Uint32 *dst, int n, const float *base, const float *step, const TriangleTexture *texture)
+{
+    int i = 0;
+
+#ifdef __SSE2__
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 max_color = _mm_set1_ps(255.0f);
+    const __m128i zero = _mm_setzero_si128();
+    /* x / 255 == (x * 0x8081) >> 23 for any product of two 8-bit values */
+    const __m128i div255 = _mm_set1_epi16((short) 0x8081);
+
+    /* Linear filtering is only done by the plain C path */
+    for (; i + 4 <= n && !(texture && texture->linear); i += 4) {
+        const __m128 index = _mm_add_ps(_mm_set1_ps((float) i), lanes);
+        const __m128i r = TriangleInterpolate_SSE2(base[0], step[0], index, max_color, SDL_TRUE);
+        const __m128i g = TriangleInterpolate_SSE2(base[1], step[1], index, max_color, SDL_TRUE);
+        const __m128i b = TriangleInterpolate_SSE2(base[2], step[2], index, max_color, SDL_TRUE);
+        const __m128i a = TriangleInterpolate_SSE2(base[3], step[3], index, max_color, SDL_TRUE);
+        __m128i color = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, 24), _mm_slli_epi32(r, 16)),
+                                     _mm_or_si128(_mm_slli_epi32(g, 8), b));
+
+        if (texture) {
+            const Uint8 *pixels = texture->pixels;
+            const int pitch = texture->pitch;
+            int u[4], v[4];
+            __m128i texel, lo, hi;
+
+            _mm_storeu_si128((__m128i *) u, TriangleInterpolate_SSE2(base[4], step[4], index, _mm_set1_ps(texture->max_u), SDL_FALSE));
+            _mm_storeu_si128((__m128i *) v, TriangleInterpolate_SSE2(base[5], step[5], index, _mm_set1_ps(texture->max_v), SDL_FALSE));
+            texel = _mm_set_epi32(*(const int *) (pixels + v[3] * pitch + u[3] * 4),
+                                  *(const int *) (pixels + v[2] * pitch + u[2] * 4),
+                                  *(const int *) (pixels + v[1] * pitch + u[1] * 4),
+                                  *(const int *) (pixels + v[0] * pitch + u[0] * 4));
+            texel = _mm_or_si128(texel, _mm_set1_epi32((int) texture->alpha));
+
+            lo = _mm_mullo_epi16(_mm_unpacklo_epi8(texel, zero), _mm_unpacklo_epi8(color, zero));
+            hi = _mm_mullo_epi16(_mm_unpackhi_epi8(texel, zero), _mm_unpackhi_epi8(color, zero));
+            lo = _mm_srli_epi16(_mm_mulhi_epu16(lo, div255), 7);
+            hi = _mm_srli_epi16(_mm_mulhi_epu16(hi, div255), 7);
+            color = _mm_packus_epi16(lo, hi);
+        }
+        _mm_storeu_si128((__m128i *) &dst[i], color);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        dst[i] = TriangleShadePixel(base, step, i, texture);
+    }
+}
+
+static int
+FillTriangle(SDL_Surface *dst, SDL_Surface *span, const SDL_Vertex *vertices, const TriangleTexture *texture)
+{
+    const SDL_Rect *clip = &dst->clip_rect;
+    const SDL_Vertex *v[3];
+    Sint64 X[3], Y[3];
+    double fx[3], fy[3];
+    float attributes[3][TRIANGLE_NUM_ATTRIBUTES];
+    double step_x[TRIANGLE_NUM_ATTRIBUTES], step_y[TRIANGLE_NUM_ATTRIBUTES];
+    float step[TRIANGLE_NUM_ATTRIBUTES];
+    TriangleEdge edges[3];
+    Sint64 area;
+    double det;
+    int minx, maxx, miny, maxy, x, y, i, k;
+    const int num_attributes = texture ? TRIANGLE_NUM_ATTRIBUTES : 4;
+
+    v[0] = &vertices[0];
+    v[1] = &vertices[1];
+    v[2] = &vertices[2];
+    for (i = 0; i < 3; ++i) {
+        X[i] = TriangleToFixed(v[i]->position.x);
+        Y[i] = TriangleToFixed(v[i]->position.y);
+    }
+
+    /* Put the vertices in the order where the inside is on the positive side of every edge */
+    area = (X[1] - X[0]) * (Y[2] - Y[0]) - (Y[1] - Y[0]) * (X[2] - X[0]);
+    if (area == 0) {
+        return 0;
+    }
+    if (area < 0) {
+        const SDL_Vertex *tv = v[1];
+        Sint64 t = X[1];
+        X[1] = X[2];
+        X[2] = t;
+        t = Y[1];
+        Y[1] = Y[2];
+        Y[2] = t;
+        v[1] = v[2];
+        v[2] = tv;
+        area = -area;
+    }
+
+    /* The pixels with their center inside the bounding box and the clip rect */
+    minx = (int) SDL_max((SDL_min(SDL_min(X[0], X[1]), X[2]) - TRIANGLE_SUBPIXEL_HALF + TRIANGLE_SUBPIXEL_ONE - 1) >> TRIANGLE_SUBPIXEL_BITS, clip->x);
+    maxx = (int) SDL_min((SDL_max(SDL_max(X[0], X[1]), X[2]) - TRIANGLE_SUBPIXEL_HALF) >> TRIANGLE_SUBPIXEL_BITS, clip->x + clip->w - 1);
+    miny = (int) SDL_max((SDL_min(SDL_min(Y[0], Y[1]), Y[2]) - TRIANGLE_SUBPIXEL_HALF + TRIANGLE_SUBPIXEL_ONE - 1) >> TRIANGLE_SUBPIXEL_BITS, clip->y);
+    maxy = (int) SDL_min((SDL_max(SDL_max(Y[0], Y[1]), Y[2]) - TRIANGLE_SUBPIXEL_HALF) >> TRIANGLE_SUBPIXEL_BITS, clip->y + clip->h - 1);
+    if (minx > maxx || miny > maxy) {
+        return 0;
+    }
+
+    /* Edge function of a -> b at pixel center p: (b - a) x (p - a) */
+    for (i = 0; i < 3; ++i) {
+        const int a = i;
+        const int b = (i + 1) % 3;
+        const Sint64 dx = X[b] - X[a];
+        const Sint64 dy = Y[b] - Y[a];
+        TriangleEdge *edge = &edges[i];
+
+        edge->step_x = -dy * TRIANGLE_SUBPIXEL_ONE;
+        edge->step_y = dx * TRIANGLE_SUBPIXEL_ONE;
+        edge->value = dx * (((Sint64) miny << TRIANGLE_SUBPIXEL_BITS) + TRIANGLE_SUBPIXEL_HALF - Y[a]) -
+                      dy * (TRIANGLE_SUBPIXEL_HALF - X[a]);
+
+        /* Top-left fill rule: pixels exactly on an edge belong to the triangle
+           only if it is a top or left edge */
+        if (!(dy < 0 || (dy == 0 && dx > 0))) {
+            edge->value -= 1;
+        }
+    }
+
+    /* Plane equations of the attributes */
+    for (i = 0; i < 3; ++i) {
+        fx[i] = (double) X[i] / TRIANGLE_SUBPIXEL_ONE;
+        fy[i] = (double) Y[i] / TRIANGLE_SUBPIXEL_ONE;
+        attributes[i][0] = v[i]->color.r;
+        attributes[i][1] = v[i]->color.g;
+        attributes[i][2] = v[i]->color.b;
+        attributes[i][3] = v[i]->color.a;
+        attributes[i][4] = v[i]->tex_coord.x;
+        attributes[i][5] = v[i]->tex_coord.y;
+    }
+    det = (double) area / (TRIANGLE_SUBPIXEL_ONE * TRIANGLE_SUBPIXEL_ONE);
+    for (k = 0; k < num_attributes; ++k) {
+        const double d1 = (double) attributes[1][k] - attributes[0][k];
+        const double d2 = (double) attributes[2][k] - attributes[0][k];
+        step_x[k] = (d1 * (fy[2] - fy[0]) - d2 * (fy[1] - fy[0])) / det;
+        step_y[k] = (d2 * (fx[1] - fx[0]) - d1 * (fx[2] - fx[0])) / det;
+        step[k] = (float) step_x[k];
+    }
+
+    for (y = miny; y <= maxy; ++y) {
+        Sint64 x0 = minx;
+        Sint64 x1 = maxx;
+
+        /* Solve value + step_x * x >= 0 for each edge */
+        for (i = 0; i < 3; ++i) {
+            const TriangleEdge *edge = &edges[i];
+            if (edge->step_x > 0) {
+                x0 = SDL_max(x0, -TriangleFloorDiv(edge->value, edge->step_x));
+            } else if (edge->step_x < 0) {
+                x1 = SDL_min(x1, TriangleFloorDiv(edge->value, -edge->step_x));
+            } else if (edge->value < 0) {
+                x1 = x0 - 1;
+            }
+            edges[i].value += edge->step_y;
+        }
+
+        if (x0 <= x1) {
+            const double px = (double) x0 + 0.5 - fx[0];
+            const double py = (double) y + 0.5 - fy[0];
+            float base[TRIANGLE_NUM_ATTRIBUTES];
+            SDL_Rect srcrect, dstrect;
+
+            x = (int) x0;
+            for (k = 0; k < num_attributes; ++k) {
+                base[k] = (float) (attributes[0][k] + step_x[k] * px + step_y[k] * py);
+            }
+            TriangleShadeSpan((Uint32 *) span->pixels + x, (int) (x1 - x0 + 1), base, step, texture);
+
+            srcrect.x = x;
+            srcrect.y = 0;
+            srcrect.w = (int) (x1 - x0 + 1);
+            srcrect.h = 1;
+            dstrect.x = x;
+            dstrect.y = y;
+            dstrect.w = srcrect.w;
+            dstrect.h = 1;
+            if (SDL_LowerBlit(span, &srcrect, dst, &dstrect) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int
+SDL_FillTriangles(SDL_Surface * dst, const SDL_Vertex * vertices, int count,
+                  SDL_Surface * texture, SDL_BlendMode blend, SDL_ScaleMode scaleMode)
+{
+    SDL_Surface *converted = NULL;
+    SDL_Surface *span;
+    TriangleTexture sampler;
+    int i, retval = 0;
+
+    if (!dst) {
+        return SDL_InvalidParamError("SDL_FillTriangles(): dst");
+    }
+    if (SDL_RectEmpty(&dst->clip_rect)) {
+        return 0;
+    }
+
+    if (texture) {
+        const SDL_PixelFormat *fmt = texture->format;
+
+        /* ARGB8888 and RGB888 are sampled in place, anything else from a copy */
+        if (fmt->BytesPerPixel != 4 ||
+            fmt->Rmask != 0x00FF0000 || fmt->Gmask != 0x0000FF00 || fmt->Bmask != 0x000000FF ||
+            (fmt->Amask != 0xFF000000 && fmt->Amask != 0)) {
+            converted = SDL_ConvertSurfaceFormat(texture, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (!converted) {
+                return -1;
+            }
+            texture = converted;
+        }
+        if (SDL_LockSurface(texture) < 0) {
+            SDL_FreeSurface(converted);
+            return -1;
+        }
+        sampler.pixels = (const Uint8 *) texture->pixels;
+        sampler.pitch = texture->pitch;
+        sampler.max_u = (float) (texture->w - 1);
+        sampler.max_v = (float) (texture->h - 1);
+        sampler.alpha = texture->format->Amask ? 0 : 0xFF000000;
+        sampler.linear = (scaleMode != SDL_ScaleModeNearest) ? SDL_TRUE : SDL_FALSE;
+    }
+
+    /* Each span is shaded into one row of ARGB8888 pixels, which the
+       regular blitters then blend onto the destination */
+    span = SDL_CreateRGBSurfaceWithFormat(0, dst->clip_rect.x + dst->clip_rect.w, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!span || SDL_SetSurfaceBlendMode(span, blend) < 0) {
+        retval = -1;
+    } else {
+        for (i = 0; i + 3 <= count; i += 3) {
+            if (FillTriangle(dst, span, &vertices[i], texture ? &sampler : NULL) < 0) {
+                retval = -1;
+                break;
+            }
+        }
+    }
+    SDL_FreeSurface(span);
+
+    if (texture) {
+        SDL_UnlockSurface(texture);
+        SDL_FreeSurface(converted);
+    }
+    return retval;
+}
+
+#endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,38 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_triangle_h_
+#define SDL_triangle_h_
+
+#include "../../SDL_internal.h"
+
+#include "SDL_render.h"
+
+/* Fill a list of triangles, every three vertices making one, into dst.
+   Positions are in pixels of dst, texture coordinates in texels of
+   texture, and pixels outside the clip rect of dst are left alone.
+   The texture is sampled with bilinear filtering unless scaleMode is nearest. */
+extern int SDL_FillTriangles(SDL_Surface * dst, const SDL_Vertex * vertices, int count,
+                             SDL_Surface * texture, SDL_BlendMode blend, SDL_ScaleMode scaleMode);
+
+#endif /* SDL_triangle_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
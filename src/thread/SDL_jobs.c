@@ -0,0 +1,633 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* A work-stealing job system built on the SDL thread primitives */
+
+#include "SDL_cpuinfo.h"
+#include "SDL_jobs.h"
+#include "SDL_jobs_c.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_systhread.h"
+
+/* The number of jobs each worker can hold before spilling into the shared queue */
+#define SDL_JOB_DEQUE_SIZE  4096
+#define SDL_JOB_DEQUE_MASK  (SDL_JOB_DEQUE_SIZE - 1)
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction func;
+    void *data;
+    SDL_atomic_t *counter;
+    SDL_atomic_t *dependency;
+    struct SDL_Job *next;
+} SDL_Job;
+
+/* A Chase-Lev deque: the owning worker pushes and pops at the bottom,
+   other threads steal from the top. */
+typedef struct
+{
+    SDL_atomic_t top;
+    char cache_pad1[SDL_CACHELINE_SIZE - sizeof(SDL_atomic_t)];
+    SDL_atomic_t bottom;
+    char cache_pad2[SDL_CACHELINE_SIZE - sizeof(SDL_atomic_t)];
+    SDL_Job *volatile jobs[SDL_JOB_DEQUE_SIZE];
+} SDL_JobDeque;
+
+typedef struct
+{
+    SDL_JobSystem *system;
+    SDL_Thread *thread;
+    SDL_JobDeque deque;
+} SDL_JobWorker;
+
+struct SDL_JobSystem
+{
+    SDL_atomic_t active;
+    int num_workers;
+    SDL_JobWorker *workers;
+
+    /* Jobs that have been queued but haven't started yet */
+    SDL_atomic_t pending;
+
+    /* Jobs submitted from outside the worker threads */
+    SDL_mutex *queue_lock;
+    SDL_Job *queue_head;
+    SDL_Job *queue_tail;
+    SDL_atomic_t queue_count;
+
+    /* Jobs waiting for their dependency to reach zero */
+    SDL_mutex *deferred_lock;
+    SDL_Job *deferred;
+    SDL_atomic_t deferred_count;
+
+    /* Idle workers and waiting threads sleep here */
+    SDL_mutex *wait_lock;
+    SDL_cond *wait_cond;
+    SDL_atomic_t sleepers;
+
+    /* Recycled job structures */
+    SDL_SpinLock freelist_lock;
+    SDL_Job *freelist;
+};
+
+/* The worker running on the current thread, if any */
+static SDL_SpinLock SDL_job_worker_tls_lock;
+static SDL_TLSID SDL_job_worker_tls;
+
+/* The job system used by SDL itself, see SDL_GetInternalJobSystem() */
+static SDL_SpinLock SDL_internal_jobs_lock;
+static SDL_JobSystem *SDL_internal_jobs;
+static SDL_bool SDL_internal_jobs_failed;
+
+static SDL_TLSID
+SDL_GetJobWorkerTLS(void)
+{
+    if (!SDL_job_worker_tls) {
+        SDL_AtomicLock(&SDL_job_worker_tls_lock);
+        if (!SDL_job_worker_tls) {
+            SDL_TLSID slot = SDL_TLSCreate();
+            SDL_MemoryBarrierRelease();
+            SDL_job_worker_tls = slot;
+        }
+        SDL_AtomicUnlock(&SDL_job_worker_tls_lock);
+    }
+    SDL_MemoryBarrierAcquire();
+    return SDL_job_worker_tls;
+}
+
+static SDL_JobWorker *
+SDL_GetCurrentJobWorker(SDL_JobSystem *jobs)
+{
+    SDL_JobWorker *worker;
+
+    if (jobs->num_workers == 0) {
+        return NULL;
+    }
+    worker = (SDL_JobWorker *)SDL_TLSGet(SDL_GetJobWorkerTLS());
+    if (worker && worker->system == jobs) {
+        return worker;
+    }
+    return NULL;
+}
+
+static SDL_bool
+SDL_PushJobDeque(SDL_JobDeque *deque, SDL_Job *job)
+{
+    const Uint32 bottom = (Uint32)SDL_AtomicGet(&deque->bottom);
+    const Uint32 top = (Uint32)SDL_AtomicGet(&deque->top);
+
+    if ((int)(bottom - top) >= SDL_JOB_DEQUE_SIZE) {
+        return SDL_FALSE;
+    }
+    deque->jobs[bottom & SDL_JOB_DEQUE_MASK] = job;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&deque->bottom, (int)(bottom + 1));
+    return SDL_TRUE;
+}
+
+static SDL_Job *
+SDL_PopJobDeque(SDL_JobDeque *deque)
+{
+    /* The atomic add is a full barrier, so thieves see the new bottom before we look at the top */
+    const Uint32 bottom = (Uint32)SDL_AtomicAdd(&deque->bottom, -1) - 1;
+    const Uint32 top = (Uint32)SDL_AtomicGet(&deque->top);
+    SDL_Job *job;
+
+    if ((int)(bottom - top) < 0) {
+        /* The deque was empty */
+        SDL_AtomicSet(&deque->bottom, (int)top);
+        return NULL;
+    }
+
+    job = deque->jobs[bottom & SDL_JOB_DEQUE_MASK];
+    if (bottom == top) {
+        /* This is the last job, race the thieves for it */
+        if (!SDL_AtomicCAS(&deque->top, (int)top, (int)(top + 1))) {
+            job = NULL;
+        }
+        SDL_AtomicSet(&deque->bottom, (int)(top + 1));
+    }
+    return job;
+}
+
+static SDL_Job *
+SDL_StealJobDeque(SDL_JobDeque *deque)
+{
+    const Uint32 top = (Uint32)SDL_AtomicGet(&deque->top);
+    const Uint32 bottom = (Uint32)SDL_AtomicGet(&deque->bottom);
+    SDL_Job *job;
+
+    if ((int)(bottom - top) <= 0) {
+        return NULL;
+    }
+
+    job = deque->jobs[top & SDL_JOB_DEQUE_MASK];
+    SDL_MemoryBarrierAcquire();
+    if (!SDL_AtomicCAS(&deque->top, (int)top, (int)(top + 1))) {
+        /* Somebody else got it first */
+        return NULL;
+    }
+    return job;
+}
+
+static SDL_Job *
+SDL_AllocJob(SDL_JobSystem *jobs)
+{
+    SDL_Job *job;
+
+    SDL_AtomicLock(&jobs->freelist_lock);
+    job = jobs->freelist;
+    if (job) {
+        jobs->freelist = job->next;
+    }
+    SDL_AtomicUnlock(&jobs->freelist_lock);
+
+    if (!job) {
+        job = (SDL_Job *)SDL_malloc(sizeof(*job));
+        if (!job) {
+            SDL_OutOfMemory();
+        }
+    }
+    return job;
+}
+
+static void
+SDL_FreeJob(SDL_JobSystem *jobs, SDL_Job *job)
+{
+    SDL_AtomicLock(&jobs->freelist_lock);
+    job->next = jobs->freelist;
+    jobs->freelist = job;
+    SDL_AtomicUnlock(&jobs->freelist_lock);
+}
+
+static void
+SDL_WakeJobSleepers(SDL_JobSystem *jobs, SDL_bool all)
+{
+    /* Sleepers register before they check for work, so this can't miss one */
+    if (SDL_AtomicGet(&jobs->sleepers) > 0) {
+        SDL_LockMutex(jobs->wait_lock);
+        if (all) {
+            SDL_CondBroadcast(jobs->wait_cond);
+        } else {
+            SDL_CondSignal(jobs->wait_cond);
+        }
+        SDL_UnlockMutex(jobs->wait_lock);
+    }
+}
+
+/* Queue a job that is ready to run */
+static void
+SDL_ScheduleJob(SDL_JobSystem *jobs, SDL_Job *job)
+{
+    SDL_JobWorker *worker = SDL_GetCurrentJobWorker(jobs);
+
+    SDL_AtomicIncRef(&jobs->pending);
+
+    if (!worker || !SDL_PushJobDeque(&worker->deque, job)) {
+        job->next = NULL;
+        SDL_LockMutex(jobs->queue_lock);
+        if (jobs->queue_tail) {
+            jobs->queue_tail->next = job;
+        } else {
+            jobs->queue_head = job;
+        }
+        jobs->queue_tail = job;
+        SDL_AtomicIncRef(&jobs->queue_count);
+        SDL_UnlockMutex(jobs->queue_lock);
+    }
+
+    SDL_WakeJobSleepers(jobs, SDL_FALSE);
+}
+
+/* Move any deferred jobs whose dependency has been met into the queues */
+static void
+SDL_ScheduleDeferredJobs(SDL_JobSystem *jobs)
+{
+    SDL_Job *ready = NULL;
+    SDL_Job *job, *prev, *next;
+
+    if (SDL_AtomicGet(&jobs->deferred_count) == 0) {
+        return;
+    }
+
+    SDL_LockMutex(jobs->deferred_lock);
+    prev = NULL;
+    for (job = jobs->deferred; job; job = next) {
+        next = job->next;
+        if (SDL_AtomicGet(job->dependency) <= 0) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                jobs->deferred = next;
+            }
+            SDL_AtomicAdd(&jobs->deferred_count, -1);
+            job->next = ready;
+            ready = job;
+        } else {
+            prev = job;
+        }
+    }
+    SDL_UnlockMutex(jobs->deferred_lock);
+
+    for (job = ready; job; job = next) {
+        next = job->next;
+        SDL_ScheduleJob(jobs, job);
+    }
+}
+
+static SDL_Job *
+SDL_GetNextJob(SDL_JobSystem *jobs, SDL_JobWorker *worker)
+{
+    SDL_Job *job = NULL;
+    int i;
+
+    if (SDL_AtomicGet(&jobs->pending) == 0) {
+        return NULL;
+    }
+
+    /* Our own jobs first, they're most likely to be in cache */
+    if (worker) {
+        job = SDL_PopJobDeque(&worker->deque);
+    }
+
+    /* Then jobs from outside the pool */
+    if (!job && SDL_AtomicGet(&jobs->queue_count) > 0) {
+        SDL_LockMutex(jobs->queue_lock);
+        job = jobs->queue_head;
+        if (job) {
+            jobs->queue_head = job->next;
+            if (!jobs->queue_head) {
+                jobs->queue_tail = NULL;
+            }
+            SDL_AtomicAdd(&jobs->queue_count, -1);
+        }
+        SDL_UnlockMutex(jobs->queue_lock);
+    }
+
+    /* Then steal from the other workers, starting after ourselves to spread the load */
+    if (!job) {
+        const int start = worker ? (int)(worker - jobs->workers) + 1 : 0;
+        for (i = 0; i < jobs->num_workers && !job; ++i) {
+            SDL_JobWorker *victim = &jobs->workers[(start + i) % jobs->num_workers];
+            if (victim != worker) {
+                job = SDL_StealJobDeque(&victim->deque);
+            }
+        }
+    }
+
+    if (job) {
+        SDL_AtomicAdd(&jobs->pending, -1);
+    }
+    return job;
+}
+
+static void
+SDL_RunJob(SDL_JobSystem *jobs, SDL_Job *job)
+{
+    SDL_atomic_t *counter = job->counter;
+
+    job->func(job->data);
+    SDL_FreeJob(jobs, job);
+
+    if (counter && SDL_AtomicDecRef(counter)) {
+        /* This was the last job on the counter, release anything waiting for it */
+        SDL_ScheduleDeferredJobs(jobs);
+        SDL_WakeJobSleepers(jobs, SDL_TRUE);
+    }
+}
+
+static int SDLCALL
+SDL_JobWorkerThread(void *data)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)data;
+    SDL_JobSystem *jobs = worker->system;
+    SDL_Job *job;
+
+    SDL_TLSSet(SDL_GetJobWorkerTLS(), worker, NULL);
+
+    for ( ; ; ) {
+        job = SDL_GetNextJob(jobs, worker);
+        if (job) {
+            SDL_RunJob(jobs, job);
+            continue;
+        }
+
+        SDL_LockMutex(jobs->wait_lock);
+        SDL_AtomicIncRef(&jobs->sleepers);
+        if (!SDL_AtomicGet(&jobs->active)) {
+            SDL_AtomicAdd(&jobs->sleepers, -1);
+            SDL_UnlockMutex(jobs->wait_lock);
+            break;
+        }
+        if (SDL_AtomicGet(&jobs->pending) == 0) {
+            SDL_CondWait(jobs->wait_cond, jobs->wait_lock);
+        }
+        SDL_AtomicAdd(&jobs->sleepers, -1);
+        SDL_UnlockMutex(jobs->wait_lock);
+    }
+
+    SDL_TLSSet(SDL_GetJobWorkerTLS(), NULL, NULL);
+    return 0;
+}
+
+SDL_JobSystem *
+SDL_CreateJobSystem(int num_threads)
+{
+    SDL_JobSystem *jobs;
+    int i;
+
+    if (num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_max(SDL_GetCPUCount() - 1, 1);
+    }
+
+    jobs = (SDL_JobSystem *)SDL_calloc(1, sizeof(*jobs));
+    if (!jobs) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    jobs->workers = (SDL_JobWorker *)SDL_calloc(num_threads, sizeof(*jobs->workers));
+    if (!jobs->workers) {
+        SDL_free(jobs);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    jobs->queue_lock = SDL_CreateMutex();
+    jobs->deferred_lock = SDL_CreateMutex();
+    jobs->wait_lock = SDL_CreateMutex();
+    jobs->wait_cond = SDL_CreateCond();
+    if (!jobs->queue_lock || !jobs->deferred_lock || !jobs->wait_lock || !jobs->wait_cond) {
+        SDL_DestroyJobSystem(jobs);
+        return NULL;
+    }
+
+    SDL_AtomicSet(&jobs->active, 1);
+
+    /* Workers look at each other as soon as they start, so set this up front */
+    jobs->num_workers = num_threads;
+    for (i = 0; i < num_threads; ++i) {
+        char name[32];
+        SDL_JobWorker *worker = &jobs->workers[i];
+
+        worker->system = jobs;
+        SDL_snprintf(name, sizeof(name), "SDLJobWorker%d", i);
+
+        /* Jobs run application code, so we can't set a limited stack size here. */
+        worker->thread = SDL_CreateThreadInternal(SDL_JobWorkerThread, name, 0, worker);
+        if (!worker->thread) {
+            SDL_DestroyJobSystem(jobs);
+            return NULL;
+        }
+    }
+
+    return jobs;
+}
+
+int
+SDL_GetJobSystemThreadCount(SDL_JobSystem *jobs)
+{
+    if (!jobs) {
+        return SDL_InvalidParamError("jobs");
+    }
+    return jobs->num_workers;
+}
+
+static int
+SDL_SubmitJobInternal(SDL_JobSystem *jobs, SDL_atomic_t *dependency,
+                      SDL_JobFunction func, void *data, SDL_atomic_t *counter)
+{
+    SDL_Job *job;
+
+    if (!jobs) {
+        return SDL_InvalidParamError("jobs");
+    }
+    if (!func) {
+        return SDL_InvalidParamError("func");
+    }
+
+    job = SDL_AllocJob(jobs);
+    if (!job) {
+        return -1;
+    }
+    job->func = func;
+    job->data = data;
+    job->counter = counter;
+    job->dependency = dependency;
+    job->next = NULL;
+
+    if (counter) {
+        SDL_AtomicIncRef(counter);
+    }
+
+    if (dependency && SDL_AtomicGet(dependency) > 0) {
+        SDL_LockMutex(jobs->deferred_lock);
+        job->next = jobs->deferred;
+        jobs->deferred = job;
+        SDL_AtomicIncRef(&jobs->deferred_count);
+        SDL_UnlockMutex(jobs->deferred_lock);
+
+        /* The dependency may have completed before we got the job into the list */
+        if (SDL_AtomicGet(dependency) <= 0) {
+            SDL_ScheduleDeferredJobs(jobs);
+        }
+    } else {
+        SDL_ScheduleJob(jobs, job);
+    }
+
+    /* Also catch dependencies the application released itself */
+    SDL_ScheduleDeferredJobs(jobs);
+    return 0;
+}
+
+int
+SDL_SubmitJob(SDL_JobSystem *jobs, SDL_JobFunction func, void *data, SDL_atomic_t *counter)
+{
+    return SDL_SubmitJobInternal(jobs, NULL, func, data, counter);
+}
+
+int
+SDL_SubmitJobAfter(SDL_JobSystem *jobs, SDL_atomic_t *dependency,
+                   SDL_JobFunction func, void *data, SDL_atomic_t *counter)
+{
+    if (!dependency) {
+        return SDL_InvalidParamError("dependency");
+    }
+    return SDL_SubmitJobInternal(jobs, dependency, func, data, counter);
+}
+
+void
+SDL_WaitJobs(SDL_JobSystem *jobs, SDL_atomic_t *counter)
+{
+    SDL_JobWorker *worker;
+    SDL_Job *job;
+
+    if (!jobs || !counter) {
+        return;
+    }
+
+    worker = SDL_GetCurrentJobWorker(jobs);
+    while (SDL_AtomicGet(counter) > 0) {
+        /* Pick up deferred jobs whose dependency was released by something other than a job */
+        SDL_ScheduleDeferredJobs(jobs);
+
+        /* Help out instead of blocking */
+        job = SDL_GetNextJob(jobs, worker);
+        if (job) {
+            SDL_RunJob(jobs, job);
+            continue;
+        }
+
+        /* Everything we're waiting on is running on other threads */
+        SDL_LockMutex(jobs->wait_lock);
+        SDL_AtomicIncRef(&jobs->sleepers);
+        if (SDL_AtomicGet(counter) > 0 && SDL_AtomicGet(&jobs->pending) == 0) {
+            /* The timeout covers counters that are finished by something other than a job */
+            SDL_CondWaitTimeout(jobs->wait_cond, jobs->wait_lock, 1);
+        }
+        SDL_AtomicAdd(&jobs->sleepers, -1);
+        SDL_UnlockMutex(jobs->wait_lock);
+    }
+}
+
+void
+SDL_DestroyJobSystem(SDL_JobSystem *jobs)
+{
+    SDL_Job *job, *next;
+    int i;
+
+    if (!jobs) {
+        return;
+    }
+
+    if (jobs->num_workers > 0) {
+        /* Let the workers finish everything that's queued, then shut them down */
+        SDL_LockMutex(jobs->wait_lock);
+        SDL_AtomicSet(&jobs->active, 0);
+        SDL_CondBroadcast(jobs->wait_cond);
+        SDL_UnlockMutex(jobs->wait_lock);
+
+        for (i = 0; i < jobs->num_workers; ++i) {
+            SDL_WaitThread(jobs->workers[i].thread, NULL);
+        }
+    }
+
+    /* Run anything left over if there were no workers to do it */
+    while ((job = SDL_GetNextJob(jobs, NULL)) != NULL) {
+        SDL_RunJob(jobs, job);
+    }
+
+    for (job = jobs->deferred; job; job = next) {
+        next = job->next;
+        SDL_free(job);
+    }
+    for (job = jobs->freelist; job; job = next) {
+        next = job->next;
+        SDL_free(job);
+    }
+
+    SDL_DestroyCond(jobs->wait_cond);
+    SDL_DestroyMutex(jobs->wait_lock);
+    SDL_DestroyMutex(jobs->deferred_lock);
+    SDL_DestroyMutex(jobs->queue_lock);
+    SDL_free(jobs->workers);
+    SDL_free(jobs);
+}
+
+SDL_JobSystem *
+SDL_GetInternalJobSystem(void)
+{
+    SDL_JobSystem *jobs;
+
+    SDL_AtomicLock(&SDL_internal_jobs_lock);
+    if (!SDL_internal_jobs && !SDL_internal_jobs_failed) {
+        SDL_internal_jobs = SDL_CreateJobSystem(0);
+        if (!SDL_internal_jobs) {
+            /* Don't keep trying to start threads on every call */
+            SDL_internal_jobs_failed = SDL_TRUE;
+        }
+    }
+    jobs = SDL_internal_jobs;
+    SDL_AtomicUnlock(&SDL_internal_jobs_lock);
+
+    return jobs;
+}
+
+void
+SDL_QuitInternalJobSystem(void)
+{
+    SDL_JobSystem *jobs;
+
+    SDL_AtomicLock(&SDL_internal_jobs_lock);
+    jobs = SDL_internal_jobs;
+    SDL_internal_jobs = NULL;
+    SDL_internal_jobs_failed = SDL_FALSE;
+    SDL_AtomicUnlock(&SDL_internal_jobs_lock);
+
+    SDL_DestroyJobSystem(jobs);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
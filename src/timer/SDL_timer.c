@@ -32,9 +32,12 @@ typedef struct _SDL_Timer
 {
     int timerID;
     SDL_TimerCallback callback;
+    SDL_TimerCallbackNS callback_ns;
     void *param;
     Uint32 interval;
     Uint32 scheduled;
+    Uint64 interval_ns;
+    Uint64 scheduled_ns;
     SDL_atomic_t canceled;
     struct _SDL_Timer *next;
 } SDL_Timer;
@@ -46,12 +49,37 @@ typedef struct _SDL_TimerMap
     struct _SDL_TimerMap *next;
 } SDL_TimerMap;
 
-/* The timers are kept in a sorted list */
+/* Timer IDs are handed out sequentially, so they hash perfectly by their low bits */
+#define SDL_TIMERMAP_BUCKETS    1024
+
+/* The timer wheel has 256 slots of one tick each, followed by 4 coarser
+   levels of 64 slots, which together cover the whole 32-bit tick range. */
+#define SDL_TIMER_WHEEL_BITS    8
+#define SDL_TIMER_WHEEL_SIZE    (1 << SDL_TIMER_WHEEL_BITS)
+#define SDL_TIMER_WHEEL_MASK    (SDL_TIMER_WHEEL_SIZE - 1)
+#define SDL_TIMER_LEVEL_BITS    6
+#define SDL_TIMER_LEVEL_SIZE    (1 << SDL_TIMER_LEVEL_BITS)
+#define SDL_TIMER_LEVEL_MASK    (SDL_TIMER_LEVEL_SIZE - 1)
+#define SDL_TIMER_LEVELS        4
+
+#define SDL_TIMER_LEVEL_SHIFT(level)    (SDL_TIMER_WHEEL_BITS + (level) * SDL_TIMER_LEVEL_BITS)
+
+/* The semaphore only waits in milliseconds, so when a nanosecond timer is due
+   sooner than this the timer thread sleeps right up to its deadline instead */
+#define SDL_TIMER_PRECISE_WAIT_NS   2000000
+
+typedef struct
+{
+    SDL_Timer *head;
+    SDL_Timer *tail;
+} SDL_TimerSlot;
+
+/* The timers are kept in a hierarchical timer wheel */
 typedef struct {
     /* Data used by the main thread */
     SDL_Thread *thread;
     SDL_atomic_t nextID;
-    SDL_TimerMap *timermap;
+    SDL_TimerMap *timermap[SDL_TIMERMAP_BUCKETS];
     SDL_mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -64,37 +92,112 @@ typedef struct {
     SDL_Timer *freelist;
     SDL_atomic_t active;
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Timer wheel - this is only touched by the timer thread */
+    Uint32 wheel_time;
+    int num_timers;
+    SDL_TimerSlot wheel[SDL_TIMER_WHEEL_SIZE];
+    SDL_TimerSlot levels[SDL_TIMER_LEVELS][SDL_TIMER_LEVEL_SIZE];
+
+    /* Timers from SDL_AddTimerNS(), sorted by deadline - also only touched by the timer thread */
+    SDL_Timer *precise;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
 
 /* The idea here is that any thread might add a timer, but a single
- * thread manages the active timer queue, sorted by scheduling time.
+ * thread manages the timer wheel, which is indexed by scheduling time.
  *
  * Timers are removed by simply setting a canceled flag
  */
 
+static void
+SDL_AppendTimer(SDL_TimerSlot *slot, SDL_Timer *timer)
+{
+    timer->next = NULL;
+    if (slot->tail) {
+        slot->tail->next = timer;
+    } else {
+        slot->head = timer;
+    }
+    slot->tail = timer;
+}
+
 static void
 SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    Uint32 expires = timer->scheduled;
+    Sint32 delta = (Sint32)(expires - data->wheel_time);
+    int level;
+
+    if (delta < 0) {
+        /* Already due, run it on the next tick we process */
+        expires = data->wheel_time;
+        delta = 0;
+    }
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if ((Sint32)(timer->scheduled-curr->scheduled) < 0) {
-            break;
+    if (delta < SDL_TIMER_WHEEL_SIZE) {
+        SDL_AppendTimer(&data->wheel[expires & SDL_TIMER_WHEEL_MASK], timer);
+    } else {
+        for (level = 0; level < SDL_TIMER_LEVELS - 1; ++level) {
+            if ((Uint32)delta < (1u << SDL_TIMER_LEVEL_SHIFT(level + 1))) {
+                break;
+            }
         }
+        SDL_AppendTimer(&data->levels[level][(expires >> SDL_TIMER_LEVEL_SHIFT(level)) & SDL_TIMER_LEVEL_MASK], timer);
     }
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
-    } else {
-        data->timers = timer;
+/* Move the timers in the current slot of a level down to finer slots,
+   returns the index of that slot so the caller knows when to cascade the next level */
+static int
+SDL_CascadeTimers(SDL_TimerData *data, int level)
+{
+    const int index = (data->wheel_time >> SDL_TIMER_LEVEL_SHIFT(level)) & SDL_TIMER_LEVEL_MASK;
+    SDL_Timer *timer = data->levels[level][index].head;
+
+    data->levels[level][index].head = NULL;
+    data->levels[level][index].tail = NULL;
+
+    while (timer) {
+        SDL_Timer *next = timer->next;
+        SDL_AddTimerInternal(data, timer);
+        timer = next;
+    }
+    return index;
+}
+
+static void
+SDL_AddPreciseTimer(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_Timer **prev = &data->precise;
+
+    while (*prev && (*prev)->scheduled_ns <= timer->scheduled_ns) {
+        prev = &(*prev)->next;
     }
-    timer->next = curr;
+    timer->next = *prev;
+    *prev = timer;
+}
+
+/* Get the number of ticks from the last processed tick until the timer
+   thread needs to look at the wheel again */
+static Uint32
+SDL_GetTimerDelay(SDL_TimerData *data)
+{
+    const Uint32 index = data->wheel_time & SDL_TIMER_WHEEL_MASK;
+    Uint32 delay;
+
+    if (data->num_timers == 0) {
+        return SDL_MUTEX_MAXWAIT;
+    }
+
+    for (delay = 0; delay < SDL_TIMER_WHEEL_SIZE - index; ++delay) {
+        if (data->wheel[index + delay].head) {
+            return delay + 1;
+        }
+    }
+
+    /* Nothing more in this turn of the wheel, wake up in time to cascade the next level */
+    return delay;
 }
 
 static int SDLCALL
@@ -106,6 +209,9 @@ SDL_TimerThread(void *_data)
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
     Uint32 tick, now, interval, delay;
+    Uint64 tick_ns, interval_ns;
+
+    data->wheel_time = SDL_GetTicks();
 
     /* Threaded timer loop:
      *  1. Queue timers added by other threads
@@ -128,11 +234,23 @@ SDL_TimerThread(void *_data)
         }
         SDL_AtomicUnlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        tick = SDL_GetTicks();
+
+        /* An empty wheel doesn't need to catch up on the ticks it slept through */
+        if (data->num_timers == 0) {
+            data->wheel_time = tick;
+        }
+
+        /* Put the pending timers into the wheel */
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (current->callback_ns) {
+                SDL_AddPreciseTimer(data, current);
+            } else {
+                SDL_AddTimerInternal(data, current);
+                ++data->num_timers;
+            }
         }
         freelist_head = NULL;
         freelist_tail = NULL;
@@ -142,36 +260,80 @@ SDL_TimerThread(void *_data)
             break;
         }
 
-        /* Initial delay if there are no timers */
-        delay = SDL_MUTEX_MAXWAIT;
+        /* Process all the timers up to and including this tick */
+        while ((Sint32)(tick - data->wheel_time) >= 0) {
+            const int index = data->wheel_time & SDL_TIMER_WHEEL_MASK;
+            SDL_Timer *next;
+            int level;
+
+            current = data->wheel[index].head;
+            data->wheel[index].head = NULL;
+            data->wheel[index].tail = NULL;
+
+            /* Advance first so rescheduled timers land in a later slot */
+            ++data->wheel_time;
+            if ((data->wheel_time & SDL_TIMER_WHEEL_MASK) == 0) {
+                /* Starting a new turn of the wheel, pull in the timers for it */
+                for (level = 0; level < SDL_TIMER_LEVELS; ++level) {
+                    if (SDL_CascadeTimers(data, level) != 0) {
+                        break;
+                    }
+                }
+            }
 
-        tick = SDL_GetTicks();
+            for ( ; current; current = next) {
+                next = current->next;
 
-        /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+                if (SDL_AtomicGet(&current->canceled)) {
+                    interval = 0;
+                } else {
+                    interval = current->callback(current->interval, current->param);
+                }
 
-            if ((Sint32)(tick-current->scheduled) < 0) {
-                /* Scheduled for the future, wait a bit */
-                delay = (current->scheduled - tick);
-                break;
+                if (interval > 0) {
+                    /* Reschedule this timer */
+                    current->interval = interval;
+                    current->scheduled = tick + interval;
+                    SDL_AddTimerInternal(data, current);
+                } else {
+                    current->next = NULL;
+                    if (!freelist_head) {
+                        freelist_head = current;
+                    }
+                    if (freelist_tail) {
+                        freelist_tail->next = current;
+                    }
+                    freelist_tail = current;
+                    --data->num_timers;
+
+                    SDL_AtomicSet(&current->canceled, 1);
+                }
             }
+        }
 
-            /* We're going to do something with this timer */
-            data->timers = current->next;
+        /* Process the nanosecond timers that are due */
+        tick_ns = SDL_GetTicksNS();
+        while (data->precise && data->precise->scheduled_ns <= tick_ns) {
+            current = data->precise;
+            data->precise = current->next;
 
             if (SDL_AtomicGet(&current->canceled)) {
-                interval = 0;
+                interval_ns = 0;
             } else {
-                interval = current->callback(current->interval, current->param);
+                interval_ns = current->callback_ns(current->interval_ns, current->param);
             }
 
-            if (interval > 0) {
-                /* Reschedule this timer */
-                current->interval = interval;
-                current->scheduled = tick + interval;
-                SDL_AddTimerInternal(data, current);
+            if (interval_ns > 0) {
+                /* Reschedule from the last deadline so the period doesn't
+                   drift, but skip any periods that were missed entirely */
+                current->interval_ns = interval_ns;
+                current->scheduled_ns += interval_ns;
+                if (current->scheduled_ns <= tick_ns) {
+                    current->scheduled_ns = tick_ns + interval_ns;
+                }
+                SDL_AddPreciseTimer(data, current);
             } else {
+                current->next = NULL;
                 if (!freelist_head) {
                     freelist_head = current;
                 }
@@ -184,6 +346,8 @@ SDL_TimerThread(void *_data)
             }
         }
 
+        delay = SDL_GetTimerDelay(data);
+
         /* Adjust the delay based on processing time */
         now = SDL_GetTicks();
         interval = (now - tick);
@@ -193,6 +357,22 @@ SDL_TimerThread(void *_data)
             delay -= interval;
         }
 
+        if (data->precise) {
+            const Uint64 deadline = data->precise->scheduled_ns;
+            const Uint64 now_ns = SDL_GetTicksNS();
+            const Uint64 remaining = (deadline > now_ns) ? (deadline - now_ns) : 0;
+
+            if (remaining < (Uint64)delay * 1000000) {
+                if (remaining <= SDL_TIMER_PRECISE_WAIT_NS) {
+                    /* New timers wait until this returns, which is soon */
+                    SDL_DelayUntilNS(deadline);
+                    continue;
+                }
+                /* Wake up early enough to sleep the rest of the way precisely */
+                delay = (Uint32)((remaining - SDL_TIMER_PRECISE_WAIT_NS / 2) / 1000000);
+            }
+        }
+
         /* Note that each time a timer is added, this will return
            immediately, but we process the timers added all at once.
            That's okay, it just means we run through the loop a few
@@ -235,12 +415,24 @@ SDL_TimerInit(void)
     return 0;
 }
 
+static void
+SDL_FreeTimerSlot(SDL_TimerSlot *slot)
+{
+    while (slot->head) {
+        SDL_Timer *timer = slot->head;
+        slot->head = timer->next;
+        SDL_free(timer);
+    }
+    slot->tail = NULL;
+}
+
 void
 SDL_TimerQuit(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
     SDL_TimerMap *entry;
+    int i, level;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) {  /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -254,9 +446,18 @@ SDL_TimerQuit(void)
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
+        for (i = 0; i < SDL_TIMER_WHEEL_SIZE; ++i) {
+            SDL_FreeTimerSlot(&data->wheel[i]);
+        }
+        for (level = 0; level < SDL_TIMER_LEVELS; ++level) {
+            for (i = 0; i < SDL_TIMER_LEVEL_SIZE; ++i) {
+                SDL_FreeTimerSlot(&data->levels[level][i]);
+            }
+        }
+        data->num_timers = 0;
+        while (data->precise) {
+            timer = data->precise;
+            data->precise = timer->next;
             SDL_free(timer);
         }
         while (data->freelist) {
@@ -264,10 +465,12 @@ SDL_TimerQuit(void)
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
+        for (i = 0; i < SDL_TIMERMAP_BUCKETS; ++i) {
+            while (data->timermap[i]) {
+                entry = data->timermap[i];
+                data->timermap[i] = entry->next;
+                SDL_free(entry);
+            }
         }
 
         SDL_DestroyMutex(data->timermap_lock);
@@ -275,12 +478,13 @@ SDL_TimerQuit(void)
     }
 }
 
-SDL_TimerID
-SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID
+SDL_CreateTimer(Uint32 interval, SDL_TimerCallback callback,
+                Uint64 interval_ns, SDL_TimerCallbackNS callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_TimerMap *entry, **bucket;
 
     SDL_AtomicLock(&data->lock);
     if (!SDL_AtomicGet(&data->active)) {
@@ -307,9 +511,12 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     }
     timer->timerID = SDL_AtomicIncRef(&data->nextID);
     timer->callback = callback;
+    timer->callback_ns = callback_ns;
     timer->param = param;
     timer->interval = interval;
     timer->scheduled = SDL_GetTicks() + interval;
+    timer->interval_ns = interval_ns;
+    timer->scheduled_ns = callback_ns ? (SDL_GetTicksNS() + interval_ns) : 0;
     SDL_AtomicSet(&timer->canceled, 0);
 
     entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
@@ -321,9 +528,10 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     entry->timer = timer;
     entry->timerID = timer->timerID;
 
+    bucket = &data->timermap[entry->timerID & (SDL_TIMERMAP_BUCKETS - 1)];
     SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
+    entry->next = *bucket;
+    *bucket = entry;
     SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
@@ -338,22 +546,39 @@ SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
     return entry->timerID;
 }
 
+SDL_TimerID
+SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, callback, 0, NULL, param);
+}
+
+SDL_TimerID
+SDL_AddTimerNS(Uint64 interval, SDL_TimerCallbackNS callback, void *param)
+{
+    if (!callback) {
+        SDL_InvalidParamError("callback");
+        return 0;
+    }
+    return SDL_CreateTimer(0, NULL, interval, callback, param);
+}
+
 SDL_bool
 SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_TimerMap *prev, *entry, **bucket;
     SDL_bool canceled = SDL_FALSE;
 
     /* Find the timer */
+    bucket = &data->timermap[id & (SDL_TIMERMAP_BUCKETS - 1)];
     SDL_LockMutex(data->timermap_lock);
     prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
+    for (entry = *bucket; entry; prev = entry, entry = entry->next) {
         if (entry->timerID == id) {
             if (prev) {
                 prev->next = entry->next;
             } else {
-                data->timermap = entry->next;
+                *bucket = entry->next;
             }
             break;
         }
@@ -370,4 +595,55 @@ SDL_RemoveTimer(SDL_TimerID id)
     return canceled;
 }
 
+/* How close to a deadline SDL_DelayUntilNS() stops sleeping and starts
+   spinning, where it can't sleep until an absolute time. This needs to cover
+   the usual oversleep of the platform */
+#if defined(__WIN32__) || defined(__OS2__)
+#define SDL_DELAY_SPIN_NS   2000000
+#else
+#define SDL_DELAY_SPIN_NS   200000
+#endif
+
+Uint64
+SDL_GetTicksNS(void)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 counter = SDL_GetPerformanceCounter();
+
+    if (freq == 1000000000) {
+        return counter;
+    }
+
+    /* Split the conversion so it doesn't overflow */
+    return (counter / freq) * 1000000000 + ((counter % freq) * 1000000000) / freq;
+}
+
+void
+SDL_DelayUntilNS(Uint64 ns)
+{
+#if defined(SDL_TIMER_DUMMY) || defined(SDL_TIMERS_DISABLED)
+    /* There's no clock to wait on */
+    SDL_Unsupported();
+#else
+#if defined(SDL_TIMER_UNIX) && HAVE_CLOCK_NANOSLEEP
+    if (SDL_SYS_DelayUntilNS(ns)) {
+        return;
+    }
+#endif
+    for ( ; ; ) {
+        const Uint64 now = SDL_GetTicksNS();
+        Uint64 remaining;
+
+        if (now >= ns) {
+            break;
+        }
+
+        remaining = ns - now;
+        if (remaining > SDL_DELAY_SPIN_NS) {
+            SDL_DelayNS(remaining - SDL_DELAY_SPIN_NS);
+        }
+    }
+#endif
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -35,6 +35,11 @@ extern void SDL_TicksQuit(void);
 extern int SDL_TimerInit(void);
 extern void SDL_TimerQuit(void);
 
+#if defined(SDL_TIMER_UNIX) && HAVE_CLOCK_NANOSLEEP
+/* Sleeps until an SDL_GetTicksNS() deadline, returns SDL_FALSE if it couldn't */
+extern SDL_bool SDL_SYS_DelayUntilNS(Uint64 ns);
+#endif
+
 #endif /* SDL_timer_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -168,6 +168,15 @@ SDL_Delay(Uint32 ms)
     DosCloseEventSem(hevTimer);
 }
 
+void
+SDL_DelayNS(Uint64 ns)
+{
+    /* The OS/2 timers only have millisecond resolution, round up so we never return early */
+    const Uint64 ms = (ns + 999999) / 1000000;
+
+    SDL_Delay((ms > 0xFFFFFFFF) ? 0xFFFFFFFF : (Uint32)ms);
+}
+
 #endif /* SDL_TIMER_OS2 */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -46,7 +46,7 @@
    Also added OS X Monotonic clock support
    Based on work in https://github.com/ThomasHabets/monotonic_clock
  */
-#if HAVE_NANOSLEEP || HAVE_CLOCK_GETTIME
+#if HAVE_NANOSLEEP || HAVE_CLOCK_GETTIME || HAVE_CLOCK_NANOSLEEP
 #include <time.h>
 #endif
 #ifdef __APPLE__
@@ -237,6 +237,96 @@ SDL_Delay(Uint32 ms)
     } while (was_error && (errno == EINTR));
 }
 
+void
+SDL_DelayNS(Uint64 ns)
+{
+#ifdef __EMSCRIPTEN__
+    if (emscripten_has_asyncify() && SDL_GetHintBoolean(SDL_HINT_EMSCRIPTEN_ASYNCIFY, SDL_TRUE)) {
+        /* pseudo-synchronous pause, it only has millisecond resolution */
+        emscripten_sleep((unsigned int)((ns + 999999) / 1000000));
+        return;
+    }
+#endif
+    int was_error;
+
+#if HAVE_NANOSLEEP
+    struct timespec elapsed, tv;
+#else
+    struct timeval tv;
+    Uint64 then, now, elapsed;
+#endif
+
+    /* Set the timeout interval */
+#if HAVE_NANOSLEEP
+    elapsed.tv_sec = (time_t)(ns / 1000000000);
+    elapsed.tv_nsec = (long)(ns % 1000000000);
+#else
+    then = SDL_GetTicksNS();
+#endif
+    do {
+        errno = 0;
+
+#if HAVE_NANOSLEEP
+        tv.tv_sec = elapsed.tv_sec;
+        tv.tv_nsec = elapsed.tv_nsec;
+        was_error = nanosleep(&tv, &elapsed);
+#else
+        /* Calculate the time interval left (in case of interrupt) */
+        now = SDL_GetTicksNS();
+        elapsed = (now - then);
+        then = now;
+        if (elapsed >= ns) {
+            break;
+        }
+        ns -= elapsed;
+        /* round up to whole microseconds, which may carry into the seconds */
+        tv.tv_sec = (long)(((ns + 999) / 1000) / 1000000);
+        tv.tv_usec = (long)(((ns + 999) / 1000) % 1000000);
+
+        was_error = select(0, NULL, NULL, NULL, &tv);
+#endif /* HAVE_NANOSLEEP */
+    } while (was_error && (errno == EINTR));
+}
+
+#if HAVE_CLOCK_NANOSLEEP
+SDL_bool
+SDL_SYS_DelayUntilNS(Uint64 ns)
+{
+#ifdef __EMSCRIPTEN__
+    if (emscripten_has_asyncify() && SDL_GetHintBoolean(SDL_HINT_EMSCRIPTEN_ASYNCIFY, SDL_TRUE)) {
+        return SDL_FALSE;
+    }
+#endif
+    for ( ; ; ) {
+        const Uint64 now = SDL_GetTicksNS();
+        struct timespec deadline;
+        Uint64 nsec;
+        int result;
+
+        if (now >= ns) {
+            return SDL_TRUE;
+        }
+
+        /* SDL_GetTicksNS() might not count on CLOCK_MONOTONIC, so sleep until
+           the time left has passed on that clock, and check again after. */
+        if (clock_gettime(CLOCK_MONOTONIC, &deadline) != 0) {
+            return SDL_FALSE;
+        }
+        nsec = (Uint64)deadline.tv_nsec + (ns - now);
+        deadline.tv_sec += (time_t)(nsec / 1000000000);
+        deadline.tv_nsec = (long)(nsec % 1000000000);
+
+        do {
+            result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        } while (result == EINTR);
+
+        if (result != 0) {
+            return SDL_FALSE;
+        }
+    }
+}
+#endif /* HAVE_CLOCK_NANOSLEEP */
+
 #endif /* SDL_TIMER_UNIX */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -195,6 +195,15 @@ SDL_Delay(Uint32 ms)
 #endif
 }
 
+void
+SDL_DelayNS(Uint64 ns)
+{
+    /* Sleep() only has millisecond resolution, round up so we never return early */
+    const Uint64 ms = (ns + 999999) / 1000000;
+
+    SDL_Delay((ms > 0xFFFFFFFE) ? 0xFFFFFFFE : (Uint32)ms);
+}
+
 #endif /* SDL_TIMER_WINDOWS */
 
 /* vi: set ts=4 sw=4 expandtab: */
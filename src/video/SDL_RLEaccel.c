@@ -1445,13 +1445,13 @@ SDL_RLESurface(SDL_Surface * surface)
         if (RLEColorkeySurface(surface) < 0) {
             return -1;
         }
-        surface->map->blit = SDL_RLEBlit;
+        surface->map->blit = SDL_NAMED_BLIT(surface, SDL_RLEBlit);
         surface->map->info.flags |= SDL_COPY_RLE_COLORKEY;
     } else {
         if (RLEAlphaSurface(surface) < 0) {
             return -1;
         }
-        surface->map->blit = SDL_RLEAlphaBlit;
+        surface->map->blit = SDL_NAMED_BLIT(surface, SDL_RLEAlphaBlit);
         surface->map->info.flags |= SDL_COPY_RLE_ALPHAKEY;
     }
 
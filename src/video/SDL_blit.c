@@ -28,11 +28,64 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../thread/SDL_jobs_c.h"
+
+/* The largest number of bands a threaded blit is split into */
+#define SDL_MAX_BLIT_BANDS  64
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    SDL_BlitInfo info;
+} SDL_BlitBand;
+
+static void SDLCALL
+SDL_RunBlitBand(void *data)
+{
+    SDL_BlitBand *band = (SDL_BlitBand *) data;
+
+    band->blit(&band->info);
+}
+
+/* Split an unscaled blit into bands of rows and run them in parallel */
+static void
+SDL_RunBlitBands(SDL_BlitFunc RunBlit, SDL_BlitInfo * info, int num_bands)
+{
+    SDL_JobSystem *jobs = SDL_GetInternalJobSystem();
+    SDL_BlitBand bands[SDL_MAX_BLIT_BANDS];
+    SDL_atomic_t counter;
+    int i, y, h;
+
+    if (!jobs) {
+        RunBlit(info);
+        return;
+    }
+
+    SDL_AtomicSet(&counter, 0);
+    for (i = 0, y = 0; i < num_bands; ++i, y += h) {
+        SDL_BlitBand *band = &bands[i];
+
+        h = (info->dst_h * (i + 1)) / num_bands - y;
+        band->blit = RunBlit;
+        band->info = *info;
+        band->info.src = info->src + y * info->src_pitch;
+        band->info.src_h = h;
+        band->info.dst = info->dst + y * info->dst_pitch;
+        band->info.dst_h = h;
+
+        /* The calling thread converts the last band itself */
+        if (i == num_bands - 1 ||
+            SDL_SubmitJob(jobs, SDL_RunBlitBand, band, &counter) < 0) {
+            RunBlit(&band->info);
+        }
+    }
+    SDL_WaitJobs(jobs, &counter);
+}
 
 /* The general purpose software blit routine */
-static int SDLCALL
-SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
-             SDL_Surface * dst, SDL_Rect * dstrect)
+static int
+SDL_SoftBlitBands(SDL_Surface * src, SDL_Rect * srcrect,
+                  SDL_Surface * dst, SDL_Rect * dstrect, int num_bands)
 {
     int okay;
     int src_locked;
@@ -85,7 +138,14 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        num_bands = SDL_min(num_bands, SDL_MAX_BLIT_BANDS);
+        num_bands = SDL_min(num_bands, info->dst_h);
+        if (num_bands > 1 &&
+            info->src_w == info->dst_w && info->src_h == info->dst_h) {
+            SDL_RunBlitBands(RunBlit, info, num_bands);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -99,6 +159,24 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
     return (okay ? 0 : -1);
 }
 
+static int SDLCALL
+SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
+             SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_SoftBlitBands(src, srcrect, dst, dstrect, 1);
+}
+
+int
+SDL_SoftBlitThreaded(SDL_Surface * src, SDL_Rect * srcrect,
+                     SDL_Surface * dst, SDL_Rect * dstrect, int num_bands)
+{
+    /* RLE and other special blitters can't be split up */
+    if (src->map->blit != SDL_SoftBlit) {
+        return src->map->blit(src, srcrect, dst, dstrect);
+    }
+    return SDL_SoftBlitBands(src, srcrect, dst, dstrect, num_bands);
+}
+
 #if SDL_HAVE_BLIT_AUTO
 
 #ifdef __MACOSX__
@@ -126,7 +204,7 @@ SDL_UseAltivecPrefetch()
 }
 #endif /* __MACOSX__ */
 
-static SDL_BlitFunc
+static const SDL_BlitFuncEntry *
 SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
                    SDL_BlitFuncEntry * entries)
 {
@@ -155,6 +233,12 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
             if (SDL_HasSSE2()) {
                 features |= SDL_CPU_SSE2;
             }
+            if (SDL_HasSSE41()) {
+                features |= SDL_CPU_SSE41;
+            }
+            if (SDL_HasAVX2()) {
+                features |= SDL_CPU_AVX2;
+            }
             if (SDL_HasAltiVec()) {
                 if (SDL_UseAltivecPrefetch()) {
                     features |= SDL_CPU_ALTIVEC_PREFETCH;
@@ -185,17 +269,46 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
         }
 
         /* We found the best one! */
-        return entries[i].func;
+        return &entries[i];
     }
     return NULL;
 }
 #endif /* SDL_HAVE_BLIT_AUTO */
 
+/* Let benchmarks and debugging sessions see which blitter got picked.
+   The generated blitters are named after their table entry, the way sdlgenblit.pl names them. */
+static void
+SDL_LogBlitFunc(SDL_Surface * surface, const char *blitter, const SDL_BlitFuncEntry * entry)
+{
+    if (SDL_LogGetPriority(SDL_LOG_CATEGORY_VIDEO) <= SDL_LOG_PRIORITY_DEBUG) {
+        const char *name = surface->map->blit_name;
+        char generated_name[128];
+
+        if (entry) {
+            /* Skip the "SDL_PIXELFORMAT_" prefix */
+            SDL_snprintf(generated_name, sizeof(generated_name), "SDL_Blit_%s_%s%s%s%s%s",
+                         SDL_GetPixelFormatName(entry->src_format) + 16,
+                         SDL_GetPixelFormatName(entry->dst_format) + 16,
+                         (entry->flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) ? "_Modulate" : "",
+                         (entry->flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) ? "_Blend" : "",
+                         (entry->flags & SDL_COPY_NEAREST) ? "_Scale" : "",
+                         (entry->cpu == SDL_CPU_AVX2) ? "_AVX2" : (entry->cpu == SDL_CPU_SSE41) ? "_SSE41" : "");
+            name = generated_name;
+        }
+        SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "blit: %s -> %s, flags 0x%.8x: %s %s",
+                     SDL_GetPixelFormatName(surface->format->format),
+                     SDL_GetPixelFormatName(surface->map->dst->format->format),
+                     surface->map->info.flags, blitter, name ? name : "unknown");
+    }
+}
+
 /* Figure out which of many blit routines to set up on a surface */
 int
 SDL_CalculateBlit(SDL_Surface * surface)
 {
     SDL_BlitFunc blit = NULL;
+    const char *blitter = NULL;
+    const SDL_BlitFuncEntry *entry = NULL;
     SDL_BlitMap *map = surface->map;
     SDL_Surface *dst = map->dst;
 
@@ -213,6 +326,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
 #endif
 
     map->blit = SDL_SoftBlit;
+    map->blit_name = NULL;
     map->info.src_fmt = surface->format;
     map->info.src_pitch = surface->pitch;
     map->info.dst_fmt = dst->format;
@@ -222,6 +336,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     /* See if we can do RLE acceleration */
     if (map->info.flags & SDL_COPY_RLE_DESIRED) {
         if (SDL_RLESurface(surface) == 0) {
+            SDL_LogBlitFunc(surface, "SDL_RLESurface", NULL);
             return 0;
         }
     }
@@ -229,7 +344,8 @@ SDL_CalculateBlit(SDL_Surface * surface)
 
     /* Choose a standard blit function */
     if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
-        blit = SDL_BlitCopy;
+        blit = SDL_NAMED_BLIT(surface, SDL_BlitCopy);
+        blitter = "SDL_BlitCopy";
     } else if (surface->format->Rloss > 8 || dst->format->Rloss > 8) {
         /* Greater than 8 bits per channel not supported yet */
         SDL_InvalidateMap(map);
@@ -239,22 +355,26 @@ SDL_CalculateBlit(SDL_Surface * surface)
     else if (surface->format->BitsPerPixel < 8 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit0(surface);
+        blitter = "SDL_CalculateBlit0";
     }
 #endif
 #if SDL_HAVE_BLIT_1
     else if (surface->format->BytesPerPixel == 1 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit1(surface);
+        blitter = "SDL_CalculateBlit1";
     }
 #endif
 #if SDL_HAVE_BLIT_A
     else if (map->info.flags & SDL_COPY_BLEND) {
         blit = SDL_CalculateBlitA(surface);
+        blitter = "SDL_CalculateBlitA";
     }
 #endif
 #if SDL_HAVE_BLIT_N
     else {
         blit = SDL_CalculateBlitN(surface);
+        blitter = "SDL_CalculateBlitN";
     }
 #endif
 #if SDL_HAVE_BLIT_AUTO
@@ -262,9 +382,13 @@ SDL_CalculateBlit(SDL_Surface * surface)
         Uint32 src_format = surface->format->format;
         Uint32 dst_format = dst->format->format;
 
-        blit =
+        entry =
             SDL_ChooseBlitFunc(src_format, dst_format, map->info.flags,
                                SDL_GeneratedBlitFuncTable);
+        if (entry) {
+            blit = entry->func;
+        }
+        blitter = "SDL_GeneratedBlitFuncTable";
     }
 #endif
 
@@ -279,7 +403,9 @@ SDL_CalculateBlit(SDL_Surface * surface)
             !SDL_ISPIXELFORMAT_FOURCC(src_format) &&
             !SDL_ISPIXELFORMAT_INDEXED(dst_format) &&
             !SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-            blit = SDL_Blit_Slow;
+            blit = SDL_NAMED_BLIT(surface, SDL_Blit_Slow);
+            blitter = "SDL_Blit_Slow";
+            entry = NULL;
         }
     }
     map->data = blit;
@@ -290,6 +416,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
         return SDL_SetError("Blit combination not supported");
     }
 
+    SDL_LogBlitFunc(surface, blitter, entry);
     return 0;
 }
 
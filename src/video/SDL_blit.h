@@ -52,6 +52,24 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_CPU_SSE2                0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH    0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH  0x00000020
+#define SDL_CPU_SSE41               0x00000040
+#define SDL_CPU_AVX2                0x00000080
+
+/* Blitters for instruction sets beyond what the compiler targets by default
+   are built with per-function target attributes, and only get picked when
+   SDL_ChooseBlitFunc() finds the CPU supports them.
+ */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))) && \
+    defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#define SDL_TARGETING(x) __attribute__((target(x)))
+#define SDL_HAVE_BLIT_SSE41 1
+#define SDL_HAVE_BLIT_AVX2 1
+#elif (defined(_M_IX86) || defined(_M_X64)) && defined(_MSC_VER) && (_MSC_VER >= 1800) && !defined(__clang__)
+#define SDL_TARGETING(x)
+#define SDL_HAVE_BLIT_SSE41 1
+#define SDL_HAVE_BLIT_AVX2 1
+#endif
 
 typedef struct
 {
@@ -91,6 +109,7 @@ typedef struct SDL_BlitMap
     SDL_blit blit;
     void *data;
     SDL_BlitInfo info;
+    const char *blit_name;      /* for the debug log in SDL_CalculateBlit() */
 
     /* the version count matches the destination; mismatch indicates
        an invalid mapping */
@@ -98,9 +117,18 @@ typedef struct SDL_BlitMap
     Uint32 src_palette_version;
 } SDL_BlitMap;
 
+/* Evaluates to a blit function, remembering its name for SDL_CalculateBlit() to log */
+#define SDL_NAMED_BLIT(surface, func) ((surface)->map->blit_name = #func, (func))
+
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
 
+/* Blit with an up to date blit map, splitting unscaled software blits into
+   num_bands bands of rows that run in parallel on SDL's worker threads. */
+extern int SDL_SoftBlitThreaded(SDL_Surface * src, SDL_Rect * srcrect,
+                                SDL_Surface * dst, SDL_Rect * dstrect,
+                                int num_bands);
+
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface * surface);
@@ -452,6 +452,14 @@ static const SDL_BlitFunc colorkey_blit[] = {
     (SDL_BlitFunc) NULL, BlitBto1Key, BlitBto2Key, BlitBto3Key, BlitBto4Key
 };
 
+static const char *const bitmap_blit_names[] = {
+    NULL, "BlitBto1", "BlitBto2", "BlitBto3", "BlitBto4"
+};
+
+static const char *const colorkey_blit_names[] = {
+    NULL, "BlitBto1Key", "BlitBto2Key", "BlitBto3Key", "BlitBto4Key"
+};
+
 SDL_BlitFunc
 SDL_CalculateBlit0(SDL_Surface * surface)
 {
@@ -468,16 +476,18 @@ SDL_CalculateBlit0(SDL_Surface * surface)
     }
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
+        surface->map->blit_name = bitmap_blit_names[which];
         return bitmap_blit[which];
 
     case SDL_COPY_COLORKEY:
+        surface->map->blit_name = colorkey_blit_names[which];
         return colorkey_blit[which];
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-        return which >= 2 ? BlitBtoNAlpha : (SDL_BlitFunc) NULL;
+        return which >= 2 ? SDL_NAMED_BLIT(surface, BlitBtoNAlpha) : (SDL_BlitFunc) NULL;
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-        return which >= 2 ? BlitBtoNAlphaKey : (SDL_BlitFunc) NULL;
+        return which >= 2 ? SDL_NAMED_BLIT(surface, BlitBtoNAlphaKey) : (SDL_BlitFunc) NULL;
     }
     return (SDL_BlitFunc) NULL;
 }
@@ -520,6 +520,14 @@ static const SDL_BlitFunc one_blitkey[] = {
     (SDL_BlitFunc) NULL, Blit1to1Key, Blit1to2Key, Blit1to3Key, Blit1to4Key
 };
 
+static const char *const one_blit_names[] = {
+    NULL, "Blit1to1", "Blit1to2", "Blit1to3", "Blit1to4"
+};
+
+static const char *const one_blitkey_names[] = {
+    NULL, "Blit1to1Key", "Blit1to2Key", "Blit1to3Key", "Blit1to4Key"
+};
+
 SDL_BlitFunc
 SDL_CalculateBlit1(SDL_Surface * surface)
 {
@@ -534,19 +542,21 @@ SDL_CalculateBlit1(SDL_Surface * surface)
     }
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
+        surface->map->blit_name = one_blit_names[which];
         return one_blit[which];
 
     case SDL_COPY_COLORKEY:
+        surface->map->blit_name = one_blitkey_names[which];
         return one_blitkey[which];
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         /* Supporting 8bpp->8bpp alpha is doable but requires lots of
            tables which consume space and takes time to precompute,
            so is better left to the user */
-        return which >= 2 ? Blit1toNAlpha : (SDL_BlitFunc) NULL;
+        return which >= 2 ? SDL_NAMED_BLIT(surface, Blit1toNAlpha) : (SDL_BlitFunc) NULL;
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
-        return which >= 2 ? Blit1toNAlphaKey : (SDL_BlitFunc) NULL;
+        return which >= 2 ? SDL_NAMED_BLIT(surface, Blit1toNAlphaKey) : (SDL_BlitFunc) NULL;
     }
     return (SDL_BlitFunc) NULL;
 }
@@ -391,6 +391,487 @@ BlitRGBtoRGBPixelAlphaMMX(SDL_BlitInfo * info)
 
 #endif /* __MMX__ */
 
+#if defined(__SSE2__) || SDL_HAVE_BLIT_AVX2
+/* The 16-bit weights for blending one unpacked pixel with surface alpha, two per Uint32.
+   The color channels get alpha and 256 - alpha, the remaining byte 0 and 256 so it keeps dst. */
+static void
+SDL_GetSurfaceAlphaWeights(unsigned alpha, Uint32 chanmask, Uint32 sweight[2], Uint32 dweight[2])
+{
+    int i;
+
+    sweight[0] = sweight[1] = 0;
+    dweight[0] = dweight[1] = 0;
+    for (i = 0; i < 4; ++i) {
+        const int shift = (i & 1) * 16;
+        if (chanmask & (0xffu << (i * 8))) {
+            sweight[i / 2] |= alpha << shift;
+            dweight[i / 2] |= (256 - alpha) << shift;
+        } else {
+            dweight[i / 2] |= 256u << shift;
+        }
+    }
+}
+#endif
+
+#ifdef __SSE2__
+
+/* (src * sweight + dst * dweight) >> 8 on unpacked pixels.
+   With dweight = 256 - sweight this is d + ((s - d) * alpha >> 8), like the C blitters. */
+static SDL_INLINE __m128i
+SDL_BlendPixels_SSE2(__m128i src, __m128i sweight, __m128i dst, __m128i dweight)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(src, sweight),
+                                        _mm_mullo_epi16(dst, dweight)), 8);
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha */
+static void
+BlitRGBtoRGBSurfaceAlphaSSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    Uint32 chanmask = (0xff << df->Rshift) | (0xff << df->Gshift) | (0xff << df->Bshift);
+    const __m128i zero = _mm_setzero_si128();
+    Uint32 sw[2], dw[2];
+    __m128i sweight, dweight;
+    /* the remaining byte is set, like the C version does with 0xff000000 */
+    const __m128i dsta = _mm_set1_epi32((int)~chanmask);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    SDL_GetSurfaceAlphaWeights(info->a, chanmask, sw, dw);
+    sweight = _mm_set_epi32((int)sw[1], (int)sw[0], (int)sw[1], (int)sw[0]);
+    dweight = _mm_set_epi32((int)dw[1], (int)dw[0], (int)dw[1], (int)dw[0]);
+
+    while (height--) {
+        int n = width;
+        while (n > 0) {
+            Uint32 *s = srcp;
+            Uint32 *d = dstp;
+            __m128i src, dst, lo, hi;
+
+            if (n < 4) {
+                /* finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, srcp, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dstp, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            src = _mm_loadu_si128((__m128i *) s);
+            dst = _mm_loadu_si128((__m128i *) d);
+            lo = SDL_BlendPixels_SSE2(_mm_unpacklo_epi8(src, zero), sweight, _mm_unpacklo_epi8(dst, zero), dweight);
+            hi = SDL_BlendPixels_SSE2(_mm_unpackhi_epi8(src, zero), sweight, _mm_unpackhi_epi8(dst, zero), dweight);
+            _mm_storeu_si128((__m128i *) d, _mm_or_si128(_mm_packus_epi16(lo, hi), dsta));
+
+            if (n < 4) {
+                SDL_memcpy(dstp, dstbuf, n * sizeof(Uint32));
+                srcp += n;
+                dstp += n;
+                break;
+            }
+            srcp += 4;
+            dstp += 4;
+            n -= 4;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+static void
+BlitRGBtoRGBPixelAlphaSSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32((int)0xff000000);
+    /* the alpha channel is blended as 256 with weights A and 255 - A, which gives
+       A + (dA * (255 - A) >> 8) like the C version, the colors get A and 256 - A */
+    const __m128i colors = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alpha_256 = _mm_set_epi16(256, 0, 0, 0, 256, 0, 0, 0);
+    const __m128i dweight_base = _mm_set_epi16(255, 256, 256, 256, 255, 256, 256, 256);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (height--) {
+        int n = width;
+        while (n > 0) {
+            Uint32 *s = srcp;
+            Uint32 *d = dstp;
+            __m128i src, dst, alpha, transparent, opaque, lo, hi;
+
+            if (n < 4) {
+                /* finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, srcp, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dstp, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            src = _mm_loadu_si128((__m128i *) s);
+            alpha = _mm_and_si128(src, amask);
+            transparent = _mm_cmpeq_epi32(alpha, zero);
+            opaque = _mm_cmpeq_epi32(alpha, amask);
+            if (_mm_movemask_epi8(transparent) == 0xFFFF) {
+                /* all transparent, nothing to do */
+            } else if (_mm_movemask_epi8(opaque) == 0xFFFF) {
+                _mm_storeu_si128((__m128i *) d, src);
+            } else {
+                dst = _mm_loadu_si128((__m128i *) d);
+                lo = _mm_unpacklo_epi8(src, zero);
+                alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+                lo = SDL_BlendPixels_SSE2(_mm_or_si128(_mm_and_si128(lo, colors), alpha_256), alpha,
+                                          _mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(dweight_base, alpha));
+                hi = _mm_unpackhi_epi8(src, zero);
+                alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+                hi = SDL_BlendPixels_SSE2(_mm_or_si128(_mm_and_si128(hi, colors), alpha_256), alpha,
+                                          _mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(dweight_base, alpha));
+                lo = _mm_packus_epi16(lo, hi);
+
+                /* like the C version, opaque pixels are copied and transparent ones left alone */
+                lo = _mm_or_si128(_mm_and_si128(opaque, src), _mm_andnot_si128(opaque, lo));
+                lo = _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, lo));
+                _mm_storeu_si128((__m128i *) d, lo);
+            }
+
+            if (n < 4) {
+                SDL_memcpy(dstp, dstbuf, n * sizeof(Uint32));
+                srcp += n;
+                dstp += n;
+                break;
+            }
+            srcp += 4;
+            dstp += 4;
+            n -= 4;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast ARGB8888->RGB565 blending with pixel alpha */
+static void
+BlitARGBto565PixelAlphaSSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint16 *dstp = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask5 = _mm_set1_epi32(0x1f);
+    const __m128i mask6 = _mm_set1_epi32(0x3f);
+    const __m128i opaque = _mm_set1_epi16(SDL_ALPHA_OPAQUE >> 3);
+    Uint32 srcbuf[8] = { 0 };
+    Uint16 dstbuf[8] = { 0 };
+
+    while (height--) {
+        int n = width;
+        while (n > 0) {
+            Uint32 *s = srcp;
+            Uint16 *d = dstp;
+            __m128i src0, src1, alpha, hi, mid, lo, dst, dhi, dmid, dlo, mask;
+
+            if (n < 8) {
+                /* finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, srcp, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dstp, n * sizeof(Uint16));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            src0 = _mm_loadu_si128((__m128i *) s);
+            src1 = _mm_loadu_si128((__m128i *) (s + 4));
+
+            /* downscale alpha to 5 bits, like the C version */
+            alpha = _mm_packs_epi32(_mm_srli_epi32(src0, 27), _mm_srli_epi32(src1, 27));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(alpha, zero)) != 0xFFFF) {
+                /* the source channels reduced to 565, one per 16-bit lane */
+                hi = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(src0, 19), mask5),
+                                     _mm_and_si128(_mm_srli_epi32(src1, 19), mask5));
+                mid = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(src0, 10), mask6),
+                                      _mm_and_si128(_mm_srli_epi32(src1, 10), mask6));
+                lo = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(src0, 3), mask5),
+                                     _mm_and_si128(_mm_srli_epi32(src1, 3), mask5));
+
+                dst = _mm_loadu_si128((__m128i *) d);
+                dhi = _mm_srli_epi16(dst, 11);
+                dmid = _mm_and_si128(_mm_srli_epi16(dst, 5), _mm_set1_epi16(0x3f));
+                dlo = _mm_and_si128(dst, _mm_set1_epi16(0x1f));
+
+                /* d += (s - d) * alpha >> 5 */
+                dhi = _mm_add_epi16(dhi, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(hi, dhi), alpha), 5));
+                dmid = _mm_add_epi16(dmid, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(mid, dmid), alpha), 5));
+                dlo = _mm_add_epi16(dlo, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(lo, dlo), alpha), 5));
+                dst = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(dhi, 11), _mm_slli_epi16(dmid, 5)), dlo);
+
+                /* opaque pixels are copied */
+                mask = _mm_cmpeq_epi16(alpha, opaque);
+                hi = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(hi, 11), _mm_slli_epi16(mid, 5)), lo);
+                dst = _mm_or_si128(_mm_and_si128(mask, hi), _mm_andnot_si128(mask, dst));
+                _mm_storeu_si128((__m128i *) d, dst);
+            }
+
+            if (n < 8) {
+                SDL_memcpy(dstp, dstbuf, n * sizeof(Uint16));
+                srcp += n;
+                dstp += n;
+                break;
+            }
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+#endif /* __SSE2__ */
+
+#if SDL_HAVE_BLIT_AVX2
+
+/* (src * sweight + dst * dweight) >> 8 on unpacked pixels, see SDL_BlendPixels_SSE2() */
+static SDL_INLINE __m256i SDL_TARGETING("avx2")
+SDL_BlendPixels_AVX2(__m256i src, __m256i sweight, __m256i dst, __m256i dweight)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(src, sweight),
+                                              _mm256_mullo_epi16(dst, dweight)), 8);
+}
+
+/* Pack two vectors of 32-bit values below 0x8000 into 16-bit values, in order */
+static SDL_INLINE __m256i SDL_TARGETING("avx2")
+SDL_Pack32to16_AVX2(__m256i a, __m256i b)
+{
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha */
+static void SDL_TARGETING("avx2")
+BlitRGBtoRGBSurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    Uint32 chanmask = (0xff << df->Rshift) | (0xff << df->Gshift) | (0xff << df->Bshift);
+    const __m256i zero = _mm256_setzero_si256();
+    Uint32 sw[2], dw[2];
+    __m256i sweight, dweight;
+    /* the remaining byte is set, like the C version does with 0xff000000 */
+    const __m256i dsta = _mm256_set1_epi32((int)~chanmask);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    SDL_GetSurfaceAlphaWeights(info->a, chanmask, sw, dw);
+    sweight = _mm256_set_epi32((int)sw[1], (int)sw[0], (int)sw[1], (int)sw[0],
+                               (int)sw[1], (int)sw[0], (int)sw[1], (int)sw[0]);
+    dweight = _mm256_set_epi32((int)dw[1], (int)dw[0], (int)dw[1], (int)dw[0],
+                               (int)dw[1], (int)dw[0], (int)dw[1], (int)dw[0]);
+
+    while (height--) {
+        int n = width;
+        while (n > 0) {
+            Uint32 *s = srcp;
+            Uint32 *d = dstp;
+            __m256i src, dst, lo, hi;
+
+            if (n < 8) {
+                /* finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, srcp, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dstp, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            src = _mm256_loadu_si256((__m256i *) s);
+            dst = _mm256_loadu_si256((__m256i *) d);
+            lo = SDL_BlendPixels_AVX2(_mm256_unpacklo_epi8(src, zero), sweight, _mm256_unpacklo_epi8(dst, zero), dweight);
+            hi = SDL_BlendPixels_AVX2(_mm256_unpackhi_epi8(src, zero), sweight, _mm256_unpackhi_epi8(dst, zero), dweight);
+            _mm256_storeu_si256((__m256i *) d, _mm256_or_si256(_mm256_packus_epi16(lo, hi), dsta));
+
+            if (n < 8) {
+                SDL_memcpy(dstp, dstbuf, n * sizeof(Uint32));
+                srcp += n;
+                dstp += n;
+                break;
+            }
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+static void SDL_TARGETING("avx2")
+BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amask = _mm256_set1_epi32((int)0xff000000);
+    /* the same weights as BlitRGBtoRGBPixelAlphaSSE2() */
+    const __m256i colors = _mm256_set1_epi64x(0x0000FFFFFFFFFFFF);
+    const __m256i alpha_256 = _mm256_set1_epi64x(0x0100000000000000);
+    const __m256i dweight_base = _mm256_set1_epi64x(0x00FF010001000100);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (height--) {
+        int n = width;
+        while (n > 0) {
+            Uint32 *s = srcp;
+            Uint32 *d = dstp;
+            __m256i src, dst, alpha, transparent, opaque, lo, hi;
+
+            if (n < 8) {
+                /* finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, srcp, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dstp, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            src = _mm256_loadu_si256((__m256i *) s);
+            alpha = _mm256_and_si256(src, amask);
+            transparent = _mm256_cmpeq_epi32(alpha, zero);
+            opaque = _mm256_cmpeq_epi32(alpha, amask);
+            if (_mm256_movemask_epi8(transparent) == -1) {
+                /* all transparent, nothing to do */
+            } else if (_mm256_movemask_epi8(opaque) == -1) {
+                _mm256_storeu_si256((__m256i *) d, src);
+            } else {
+                dst = _mm256_loadu_si256((__m256i *) d);
+                lo = _mm256_unpacklo_epi8(src, zero);
+                alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF);
+                lo = SDL_BlendPixels_AVX2(_mm256_or_si256(_mm256_and_si256(lo, colors), alpha_256), alpha,
+                                          _mm256_unpacklo_epi8(dst, zero), _mm256_sub_epi16(dweight_base, alpha));
+                hi = _mm256_unpackhi_epi8(src, zero);
+                alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF);
+                hi = SDL_BlendPixels_AVX2(_mm256_or_si256(_mm256_and_si256(hi, colors), alpha_256), alpha,
+                                          _mm256_unpackhi_epi8(dst, zero), _mm256_sub_epi16(dweight_base, alpha));
+                lo = _mm256_packus_epi16(lo, hi);
+
+                /* like the C version, opaque pixels are copied and transparent ones left alone */
+                lo = _mm256_blendv_epi8(lo, src, opaque);
+                lo = _mm256_blendv_epi8(lo, dst, transparent);
+                _mm256_storeu_si256((__m256i *) d, lo);
+            }
+
+            if (n < 8) {
+                SDL_memcpy(dstp, dstbuf, n * sizeof(Uint32));
+                srcp += n;
+                dstp += n;
+                break;
+            }
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast ARGB8888->RGB565 blending with pixel alpha */
+static void SDL_TARGETING("avx2")
+BlitARGBto565PixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint16 *dstp = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask5 = _mm256_set1_epi32(0x1f);
+    const __m256i mask6 = _mm256_set1_epi32(0x3f);
+    const __m256i opaque = _mm256_set1_epi16(SDL_ALPHA_OPAQUE >> 3);
+    Uint32 srcbuf[16] = { 0 };
+    Uint16 dstbuf[16] = { 0 };
+
+    while (height--) {
+        int n = width;
+        while (n > 0) {
+            Uint32 *s = srcp;
+            Uint16 *d = dstp;
+            __m256i src0, src1, alpha, hi, mid, lo, dst, dhi, dmid, dlo, mask;
+
+            if (n < 16) {
+                /* finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, srcp, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dstp, n * sizeof(Uint16));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            src0 = _mm256_loadu_si256((__m256i *) s);
+            src1 = _mm256_loadu_si256((__m256i *) (s + 8));
+
+            /* downscale alpha to 5 bits, like the C version */
+            alpha = SDL_Pack32to16_AVX2(_mm256_srli_epi32(src0, 27), _mm256_srli_epi32(src1, 27));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(alpha, zero)) != -1) {
+                /* the source channels reduced to 565, one per 16-bit lane */
+                hi = SDL_Pack32to16_AVX2(_mm256_and_si256(_mm256_srli_epi32(src0, 19), mask5),
+                                         _mm256_and_si256(_mm256_srli_epi32(src1, 19), mask5));
+                mid = SDL_Pack32to16_AVX2(_mm256_and_si256(_mm256_srli_epi32(src0, 10), mask6),
+                                          _mm256_and_si256(_mm256_srli_epi32(src1, 10), mask6));
+                lo = SDL_Pack32to16_AVX2(_mm256_and_si256(_mm256_srli_epi32(src0, 3), mask5),
+                                         _mm256_and_si256(_mm256_srli_epi32(src1, 3), mask5));
+
+                dst = _mm256_loadu_si256((__m256i *) d);
+                dhi = _mm256_srli_epi16(dst, 11);
+                dmid = _mm256_and_si256(_mm256_srli_epi16(dst, 5), _mm256_set1_epi16(0x3f));
+                dlo = _mm256_and_si256(dst, _mm256_set1_epi16(0x1f));
+
+                /* d += (s - d) * alpha >> 5 */
+                dhi = _mm256_add_epi16(dhi, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(hi, dhi), alpha), 5));
+                dmid = _mm256_add_epi16(dmid, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(mid, dmid), alpha), 5));
+                dlo = _mm256_add_epi16(dlo, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(lo, dlo), alpha), 5));
+                dst = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(dhi, 11), _mm256_slli_epi16(dmid, 5)), dlo);
+
+                /* opaque pixels are copied */
+                mask = _mm256_cmpeq_epi16(alpha, opaque);
+                hi = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(hi, 11), _mm256_slli_epi16(mid, 5)), lo);
+                dst = _mm256_blendv_epi8(dst, hi, mask);
+                _mm256_storeu_si256((__m256i *) d, dst);
+            }
+
+            if (n < 16) {
+                SDL_memcpy(dstp, dstbuf, n * sizeof(Uint16));
+                srcp += n;
+                dstp += n;
+                break;
+            }
+            srcp += 16;
+            dstp += 16;
+            n -= 16;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+#endif /* SDL_HAVE_BLIT_AVX2 */
+
 #if SDL_ARM_SIMD_BLITTERS
 void BlitARGBto565PixelAlphaARMSIMDAsm(int32_t w, int32_t h, uint16_t *dst, int32_t dst_stride, uint32_t *src, int32_t src_stride);
 
@@ -1343,13 +1824,29 @@ SDL_CalculateBlitA(SDL_Surface * surface)
         switch (df->BytesPerPixel) {
         case 1:
             if (df->palette != NULL) {
-                return BlitNto1PixelAlpha;
+                return SDL_NAMED_BLIT(surface, BlitNto1PixelAlpha);
             } else {
                 /* RGB332 has no palette ! */
-                return BlitNtoNPixelAlpha;
+                return SDL_NAMED_BLIT(surface, BlitNtoNPixelAlpha);
             }
 
         case 2:
+#if defined(__SSE2__) || SDL_HAVE_BLIT_AVX2
+                if (sf->BytesPerPixel == 4 && sf->Amask == 0xff000000
+                    && sf->Gmask == 0xff00 && df->Gmask == 0x7e0
+                    && ((sf->Rmask == 0xff && df->Rmask == 0x1f)
+                    || (sf->Bmask == 0xff && df->Bmask == 0x1f)))
+                {
+#if SDL_HAVE_BLIT_AVX2
+                    if (SDL_HasAVX2())
+                        return SDL_NAMED_BLIT(surface, BlitARGBto565PixelAlphaAVX2);
+#endif
+#ifdef __SSE2__
+                    if (SDL_HasSSE2())
+                        return SDL_NAMED_BLIT(surface, BlitARGBto565PixelAlphaSSE2);
+#endif
+                }
+#endif
 #if SDL_ARM_NEON_BLITTERS || SDL_ARM_SIMD_BLITTERS
                 if (sf->BytesPerPixel == 4 && sf->Amask == 0xff000000
                     && sf->Gmask == 0xff00 && df->Gmask == 0x7e0
@@ -1358,11 +1855,11 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                 {
 #if SDL_ARM_NEON_BLITTERS
                     if (SDL_HasNEON())
-                        return BlitARGBto565PixelAlphaARMNEON;
+                        return SDL_NAMED_BLIT(surface, BlitARGBto565PixelAlphaARMNEON);
 #endif
 #if SDL_ARM_SIMD_BLITTERS
                     if (SDL_HasARMSIMD())
-                        return BlitARGBto565PixelAlphaARMSIMD;
+                        return SDL_NAMED_BLIT(surface, BlitARGBto565PixelAlphaARMSIMD);
 #endif
                 }
 #endif
@@ -1371,16 +1868,28 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     && ((sf->Rmask == 0xff && df->Rmask == 0x1f)
                         || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
                 if (df->Gmask == 0x7e0)
-                    return BlitARGBto565PixelAlpha;
+                    return SDL_NAMED_BLIT(surface, BlitARGBto565PixelAlpha);
                 else if (df->Gmask == 0x3e0)
-                    return BlitARGBto555PixelAlpha;
+                    return SDL_NAMED_BLIT(surface, BlitARGBto555PixelAlpha);
             }
-            return BlitNtoNPixelAlpha;
+            return SDL_NAMED_BLIT(surface, BlitNtoNPixelAlpha);
 
         case 4:
             if (sf->Rmask == df->Rmask
                 && sf->Gmask == df->Gmask
                 && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+#if defined(__SSE2__) || SDL_HAVE_BLIT_AVX2
+                if (sf->Amask == 0xff000000) {
+#if SDL_HAVE_BLIT_AVX2
+                    if (SDL_HasAVX2())
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlphaAVX2);
+#endif
+#ifdef __SSE2__
+                    if (SDL_HasSSE2())
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlphaSSE2);
+#endif
+                }
+#endif
 #if defined(__MMX__) || defined(__3dNOW__)
                 if (sf->Rshift % 8 == 0
                     && sf->Gshift % 8 == 0
@@ -1388,33 +1897,33 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
 #ifdef __3dNOW__
                     if (SDL_Has3DNow())
-                        return BlitRGBtoRGBPixelAlphaMMX3DNOW;
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlphaMMX3DNOW);
 #endif
 #ifdef __MMX__
                     if (SDL_HasMMX())
-                        return BlitRGBtoRGBPixelAlphaMMX;
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlphaMMX);
 #endif
                 }
 #endif /* __MMX__ || __3dNOW__ */
                 if (sf->Amask == 0xff000000) {
 #if SDL_ARM_NEON_BLITTERS
                     if (SDL_HasNEON())
-                        return BlitRGBtoRGBPixelAlphaARMNEON;
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlphaARMNEON);
 #endif
 #if SDL_ARM_SIMD_BLITTERS
                     if (SDL_HasARMSIMD())
-                        return BlitRGBtoRGBPixelAlphaARMSIMD;
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlphaARMSIMD);
 #endif
-                    return BlitRGBtoRGBPixelAlpha;
+                    return SDL_NAMED_BLIT(surface, BlitRGBtoRGBPixelAlpha);
                 }
             }
-            return BlitNtoNPixelAlpha;
+            return SDL_NAMED_BLIT(surface, BlitNtoNPixelAlpha);
 
         case 3:
         default:
             break;
         }
-        return BlitNtoNPixelAlpha;
+        return SDL_NAMED_BLIT(surface, BlitNtoNPixelAlpha);
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         if (sf->Amask == 0) {
@@ -1422,10 +1931,10 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             switch (df->BytesPerPixel) {
             case 1:
                 if (df->palette != NULL) {
-                    return BlitNto1SurfaceAlpha;
+                    return SDL_NAMED_BLIT(surface, BlitNto1SurfaceAlpha);
                 } else {
                     /* RGB332 has no palette ! */
-                    return BlitNtoNSurfaceAlpha;
+                    return SDL_NAMED_BLIT(surface, BlitNtoNSurfaceAlpha);
                 }
 
             case 2:
@@ -1433,40 +1942,54 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     if (df->Gmask == 0x7e0) {
 #ifdef __MMX__
                         if (SDL_HasMMX())
-                            return Blit565to565SurfaceAlphaMMX;
+                            return SDL_NAMED_BLIT(surface, Blit565to565SurfaceAlphaMMX);
                         else
 #endif
-                            return Blit565to565SurfaceAlpha;
+                            return SDL_NAMED_BLIT(surface, Blit565to565SurfaceAlpha);
                     } else if (df->Gmask == 0x3e0) {
 #ifdef __MMX__
                         if (SDL_HasMMX())
-                            return Blit555to555SurfaceAlphaMMX;
+                            return SDL_NAMED_BLIT(surface, Blit555to555SurfaceAlphaMMX);
                         else
 #endif
-                            return Blit555to555SurfaceAlpha;
+                            return SDL_NAMED_BLIT(surface, Blit555to555SurfaceAlpha);
                     }
                 }
-                return BlitNtoNSurfaceAlpha;
+                return SDL_NAMED_BLIT(surface, BlitNtoNSurfaceAlpha);
 
             case 4:
                 if (sf->Rmask == df->Rmask
                     && sf->Gmask == df->Gmask
                     && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+#if defined(__SSE2__) || SDL_HAVE_BLIT_AVX2
+                    if (sf->Rshift % 8 == 0
+                        && sf->Gshift % 8 == 0
+                        && sf->Bshift % 8 == 0) {
+#if SDL_HAVE_BLIT_AVX2
+                        if (SDL_HasAVX2())
+                            return SDL_NAMED_BLIT(surface, BlitRGBtoRGBSurfaceAlphaAVX2);
+#endif
+#ifdef __SSE2__
+                        if (SDL_HasSSE2())
+                            return SDL_NAMED_BLIT(surface, BlitRGBtoRGBSurfaceAlphaSSE2);
+#endif
+                    }
+#endif
 #ifdef __MMX__
                     if (sf->Rshift % 8 == 0
                         && sf->Gshift % 8 == 0
                         && sf->Bshift % 8 == 0 && SDL_HasMMX())
-                        return BlitRGBtoRGBSurfaceAlphaMMX;
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBSurfaceAlphaMMX);
 #endif
                     if ((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
-                        return BlitRGBtoRGBSurfaceAlpha;
+                        return SDL_NAMED_BLIT(surface, BlitRGBtoRGBSurfaceAlpha);
                     }
                 }
-                return BlitNtoNSurfaceAlpha;
+                return SDL_NAMED_BLIT(surface, BlitNtoNSurfaceAlpha);
 
             case 3:
             default:
-                return BlitNtoNSurfaceAlpha;
+                return SDL_NAMED_BLIT(surface, BlitNtoNSurfaceAlpha);
             }
         }
         break;
@@ -1476,13 +1999,13 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             if (df->BytesPerPixel == 1) {
 
                 if (df->palette != NULL) {
-                    return BlitNto1SurfaceAlphaKey;
+                    return SDL_NAMED_BLIT(surface, BlitNto1SurfaceAlphaKey);
                 } else {
                     /* RGB332 has no palette ! */
-                    return BlitNtoNSurfaceAlphaKey;
+                    return SDL_NAMED_BLIT(surface, BlitNtoNSurfaceAlphaKey);
                 }
             } else {
-                return BlitNtoNSurfaceAlphaKey;
+                return SDL_NAMED_BLIT(surface, BlitNtoNSurfaceAlphaKey);
             }
         }
         break;
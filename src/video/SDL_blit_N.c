@@ -3230,122 +3230,123 @@ struct blit_table
     Uint32 dstR, dstG, dstB;
     enum blit_features blit_features;
     SDL_BlitFunc blitfunc;
+    const char *blitname;
     Uint32 alpha;  /* bitwise NO_ALPHA, SET_ALPHA, COPY_ALPHA */
 };
 static const struct blit_table normal_blit_1[] = {
     /* Default for 8-bit RGB source, never optimized */
-    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0}
+    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, "BlitNtoN", 0}
 };
 
 static const struct blit_table normal_blit_2[] = {
 #if SDL_ALTIVEC_BLITTERS
     /* has-altivec */
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00000000, 0x00000000, 0x00000000,
-     BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB565_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB565_32Altivec, "Blit_RGB565_32Altivec", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x00007C00, 0x000003E0, 0x0000001F, 4, 0x00000000, 0x00000000, 0x00000000,
-     BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB555_32Altivec, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB555_32Altivec, "Blit_RGB555_32Altivec", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
 #endif
 #if SDL_ARM_SIMD_BLITTERS
     {0x00000F00, 0x000000F0, 0x0000000F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     BLIT_FEATURE_HAS_ARM_SIMD, Blit_RGB444_RGB888ARMSIMD, NO_ALPHA | COPY_ALPHA},
+     BLIT_FEATURE_HAS_ARM_SIMD, Blit_RGB444_RGB888ARMSIMD, "Blit_RGB444_RGB888ARMSIMD", NO_ALPHA | COPY_ALPHA},
 #endif
 #if SDL_HAVE_BLIT_N_RGB565
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_RGB565_ARGB8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     0, Blit_RGB565_ARGB8888, "Blit_RGB565_ARGB8888", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_RGB565_ABGR8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     0, Blit_RGB565_ABGR8888, "Blit_RGB565_ABGR8888", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0xFF000000, 0x00FF0000, 0x0000FF00,
-     0, Blit_RGB565_RGBA8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     0, Blit_RGB565_RGBA8888, "Blit_RGB565_RGBA8888", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     {0x0000F800, 0x000007E0, 0x0000001F, 4, 0x0000FF00, 0x00FF0000, 0xFF000000,
-     0, Blit_RGB565_BGRA8888, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     0, Blit_RGB565_BGRA8888, "Blit_RGB565_BGRA8888", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
 #endif
 
     /* Default for 16-bit RGB source, used if no other blitter matches */
-    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0}
+    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, "BlitNtoN", 0}
 };
 
 static const struct blit_table normal_blit_3[] = {
     /* 3->4 with same rgb triplet */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_3or4_to_3or4__same_rgb,
+     0, Blit_3or4_to_3or4__same_rgb, "Blit_3or4_to_3or4__same_rgb",
 #if HAVE_FAST_WRITE_INT8
         NO_ALPHA |
 #endif
         SET_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_3or4_to_3or4__same_rgb,
+     0, Blit_3or4_to_3or4__same_rgb, "Blit_3or4_to_3or4__same_rgb",
 #if HAVE_FAST_WRITE_INT8
         NO_ALPHA |
 #endif
         SET_ALPHA},
     /* 3->4 with inversed rgb triplet */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_3or4_to_3or4__inversed_rgb,
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb",
 #if HAVE_FAST_WRITE_INT8
         NO_ALPHA |
 #endif
         SET_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_3or4_to_3or4__inversed_rgb,
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb",
 #if HAVE_FAST_WRITE_INT8
         NO_ALPHA |
 #endif
         SET_ALPHA},
     /* 3->3 to switch RGB 24 <-> BGR 24 */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA },
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb", NO_ALPHA },
     {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA },
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb", NO_ALPHA },
     /* Default for 24-bit RGB source, never optimized */
-    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0}
+    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, "BlitNtoN", 0}
 };
 
 static const struct blit_table normal_blit_4[] = {
 #if SDL_ALTIVEC_BLITTERS
     /* has-altivec | dont-use-prefetch */
     {0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
-     BLIT_FEATURE_HAS_ALTIVEC | BLIT_FEATURE_ALTIVEC_DONT_USE_PREFETCH, ConvertAltivec32to32_noprefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     BLIT_FEATURE_HAS_ALTIVEC | BLIT_FEATURE_ALTIVEC_DONT_USE_PREFETCH, ConvertAltivec32to32_noprefetch, "ConvertAltivec32to32_noprefetch", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     /* has-altivec */
     {0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
-     BLIT_FEATURE_HAS_ALTIVEC, ConvertAltivec32to32_prefetch, NO_ALPHA | COPY_ALPHA | SET_ALPHA},
+     BLIT_FEATURE_HAS_ALTIVEC, ConvertAltivec32to32_prefetch, "ConvertAltivec32to32_prefetch", NO_ALPHA | COPY_ALPHA | SET_ALPHA},
     /* has-altivec */
     {0x00000000, 0x00000000, 0x00000000, 2, 0x0000F800, 0x000007E0, 0x0000001F,
-     BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB888_RGB565Altivec, NO_ALPHA},
+     BLIT_FEATURE_HAS_ALTIVEC, Blit_RGB888_RGB565Altivec, "Blit_RGB888_RGB565Altivec", NO_ALPHA},
 #endif
 #if SDL_ARM_SIMD_BLITTERS
     {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     BLIT_FEATURE_HAS_ARM_SIMD, Blit_BGR888_RGB888ARMSIMD, NO_ALPHA | COPY_ALPHA },
+     BLIT_FEATURE_HAS_ARM_SIMD, Blit_BGR888_RGB888ARMSIMD, "Blit_BGR888_RGB888ARMSIMD", NO_ALPHA | COPY_ALPHA },
 #endif
     /* 4->3 with same rgb triplet */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_3or4_to_3or4__same_rgb, NO_ALPHA | SET_ALPHA},
+     0, Blit_3or4_to_3or4__same_rgb, "Blit_3or4_to_3or4__same_rgb", NO_ALPHA | SET_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_3or4_to_3or4__same_rgb, NO_ALPHA | SET_ALPHA},
+     0, Blit_3or4_to_3or4__same_rgb, "Blit_3or4_to_3or4__same_rgb", NO_ALPHA | SET_ALPHA},
     /* 4->3 with inversed rgb triplet */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 3, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA | SET_ALPHA},
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb", NO_ALPHA | SET_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 3, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_3or4_to_3or4__inversed_rgb, NO_ALPHA | SET_ALPHA},
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb", NO_ALPHA | SET_ALPHA},
     /* 4->4 with inversed rgb triplet, and COPY_ALPHA to switch ABGR8888 <-> ARGB8888 */
     {0x000000FF, 0x0000FF00, 0x00FF0000, 4, 0x00FF0000, 0x0000FF00, 0x000000FF,
-     0, Blit_3or4_to_3or4__inversed_rgb,
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb",
 #if HAVE_FAST_WRITE_INT8
         NO_ALPHA |
 #endif
         SET_ALPHA | COPY_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 4, 0x000000FF, 0x0000FF00, 0x00FF0000,
-     0, Blit_3or4_to_3or4__inversed_rgb,
+     0, Blit_3or4_to_3or4__inversed_rgb, "Blit_3or4_to_3or4__inversed_rgb",
 #if HAVE_FAST_WRITE_INT8
         NO_ALPHA |
 #endif
         SET_ALPHA | COPY_ALPHA},
     /* RGB 888 and RGB 565 */
     {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x0000F800, 0x000007E0, 0x0000001F,
-     0, Blit_RGB888_RGB565, NO_ALPHA},
+     0, Blit_RGB888_RGB565, "Blit_RGB888_RGB565", NO_ALPHA},
     {0x00FF0000, 0x0000FF00, 0x000000FF, 2, 0x00007C00, 0x000003E0, 0x0000001F,
-     0, Blit_RGB888_RGB555, NO_ALPHA},
+     0, Blit_RGB888_RGB555, "Blit_RGB888_RGB555", NO_ALPHA},
     /* Default for 32-bit RGB source, used if no other blitter matches */
-    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, 0}
+    {0, 0, 0, 0, 0, 0, 0, 0, BlitNtoN, "BlitNtoN", 0}
 };
 
 static const struct blit_table *const normal_blit[] = {
@@ -3381,14 +3382,14 @@ SDL_CalculateBlitN(SDL_Surface * surface)
                 (srcfmt->Rmask == 0x00FF0000) &&
                 (srcfmt->Gmask == 0x0000FF00) &&
                 (srcfmt->Bmask == 0x000000FF)) {
-                blitfun = Blit_RGB888_index8;
+                blitfun = SDL_NAMED_BLIT(surface, Blit_RGB888_index8);
             } else if ((srcfmt->BytesPerPixel == 4) &&
                 (srcfmt->Rmask == 0x3FF00000) &&
                 (srcfmt->Gmask == 0x000FFC00) &&
                 (srcfmt->Bmask == 0x000003FF)) {
-                blitfun = Blit_RGB101010_index8;
+                blitfun = SDL_NAMED_BLIT(surface, Blit_RGB101010_index8);
             } else {
-                blitfun = BlitNto1;
+                blitfun = SDL_NAMED_BLIT(surface, BlitNto1);
             }
         } else {
             /* Now the meat, choose the blitter we want */
@@ -3410,12 +3411,13 @@ SDL_CalculateBlitN(SDL_Surface * surface)
                     break;
             }
             blitfun = table[which].blitfunc;
+            surface->map->blit_name = table[which].blitname;
 
             if (blitfun == BlitNtoN) {  /* default C fallback catch-all. Slow! */
                 if (srcfmt->format == SDL_PIXELFORMAT_ARGB2101010) {
-                    blitfun = Blit2101010toN;
+                    blitfun = SDL_NAMED_BLIT(surface, Blit2101010toN);
                 } else if (dstfmt->format == SDL_PIXELFORMAT_ARGB2101010) {
-                    blitfun = BlitNto2101010;
+                    blitfun = SDL_NAMED_BLIT(surface, BlitNto2101010);
                 } else if (srcfmt->BytesPerPixel == 4 &&
                             dstfmt->BytesPerPixel == 4 &&
                             srcfmt->Rmask == dstfmt->Rmask &&
@@ -3424,16 +3426,16 @@ SDL_CalculateBlitN(SDL_Surface * surface)
                     if (a_need == COPY_ALPHA) {
                         if (srcfmt->Amask == dstfmt->Amask) {
                             /* Fastpath C fallback: 32bit RGBA<->RGBA blit with matching RGBA */
-                            blitfun = Blit4to4CopyAlpha;
+                            blitfun = SDL_NAMED_BLIT(surface, Blit4to4CopyAlpha);
                         } else {
-                            blitfun = BlitNtoNCopyAlpha;
+                            blitfun = SDL_NAMED_BLIT(surface, BlitNtoNCopyAlpha);
                         }
                     } else {
                         /* Fastpath C fallback: 32bit RGB<->RGBA blit with matching RGB */
-                        blitfun = Blit4to4MaskAlpha;
+                        blitfun = SDL_NAMED_BLIT(surface, Blit4to4MaskAlpha);
                     }
                 } else if (a_need == COPY_ALPHA) {
-                    blitfun = BlitNtoNCopyAlpha;
+                    blitfun = SDL_NAMED_BLIT(surface, BlitNtoNCopyAlpha);
                 }
             }
         }
@@ -3445,20 +3447,20 @@ SDL_CalculateBlitN(SDL_Surface * surface)
            If a particular case turns out to be useful we'll add it. */
 
         if (srcfmt->BytesPerPixel == 2 && surface->map->identity)
-            return Blit2to2Key;
+            return SDL_NAMED_BLIT(surface, Blit2to2Key);
         else if (dstfmt->BytesPerPixel == 1)
-            return BlitNto1Key;
+            return SDL_NAMED_BLIT(surface, BlitNto1Key);
         else {
 #if SDL_ALTIVEC_BLITTERS
             if ((srcfmt->BytesPerPixel == 4) && (dstfmt->BytesPerPixel == 4)
                 && SDL_HasAltiVec()) {
-                return Blit32to32KeyAltivec;
+                return SDL_NAMED_BLIT(surface, Blit32to32KeyAltivec);
             } else
 #endif
             if (srcfmt->Amask && dstfmt->Amask) {
-                return BlitNtoNKeyCopyAlpha;
+                return SDL_NAMED_BLIT(surface, BlitNtoNKeyCopyAlpha);
             } else {
-                return BlitNtoNKey;
+                return SDL_NAMED_BLIT(surface, BlitNtoNKey);
             }
         }
     }
@@ -6896,7 +6896,8167 @@ static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#if SDL_HAVE_BLIT_AVX2
+
+/* Divide 16-bit values up to 255 * 255 by 255, rounding down like the C blitters */
+static SDL_INLINE __m256i SDL_TARGETING("avx2")
+SDL_Div255_AVX2(__m256i x)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+}
+
+/* Copy the alpha of each unpacked pixel into all four of its channels */
+static SDL_INLINE __m256i SDL_TARGETING("avx2")
+SDL_SplatAlpha_AVX2(__m256i x)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                dstlo = _mm256_blend_epi16(dstlo, ff, 0x88);
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                dsthi = _mm256_blend_epi16(dsthi, ff, 0x88);
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                dstlo = _mm256_blend_epi16(dstlo, ff, 0x88);
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                dsthi = _mm256_blend_epi16(dsthi, ff, 0x88);
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i src_alpha = _mm256_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm256_or_si256(pixels, src_alpha);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1, 0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i dst_shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i out_shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            pixels = _mm256_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            pixels = _mm256_shuffle_epi8(pixels, out_shuffle);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            pixels = _mm256_packus_epi16(srclo, srchi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ff = _mm256_set1_epi16(0xFF);
+    const __m256i src_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[8] = { 0 }, dstbuf[8] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels, srclo, srchi;
+            __m256i dstlo, dsthi, alpha;
+
+            if (n < 8) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = _mm256_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm256_unpacklo_epi8(pixels, zero);
+            srchi = _mm256_unpackhi_epi8(pixels, zero);
+            pixels = _mm256_loadu_si256((const __m256i *)d);
+            dstlo = _mm256_unpacklo_epi8(pixels, zero);
+            dsthi = _mm256_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(srclo, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(srchi, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_AVX2(srclo);
+                srclo = SDL_Div255_AVX2(_mm256_mullo_epi16(srclo, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm256_add_epi16(dstlo, _mm256_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_AVX2(srchi);
+                srchi = SDL_Div255_AVX2(_mm256_mullo_epi16(srchi, _mm256_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm256_add_epi16(dsthi, _mm256_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm256_add_epi16(srclo, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srclo)));
+                dstlo = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dstlo, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                alpha = _mm256_add_epi16(srchi, _mm256_sub_epi16(ff, SDL_SplatAlpha_AVX2(srchi)));
+                dsthi = _mm256_add_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_min_epi16(alpha, ff))),
+                                    SDL_Div255_AVX2(_mm256_mullo_epi16(dsthi, _mm256_sub_epi16(alpha, _mm256_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm256_packus_epi16(dstlo, dsthi);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#endif /* SDL_HAVE_BLIT_AVX2 */
+
+#if SDL_HAVE_BLIT_SSE41
+
+/* Divide 16-bit values up to 255 * 255 by 255, rounding down like the C blitters */
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1")
+SDL_Div255_SSE41(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Copy the alpha of each unpacked pixel into all four of its channels */
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1")
+SDL_SplatAlpha_SSE41(__m128i x)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF);
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                dstlo = _mm_blend_epi16(dstlo, ff, 0x88);
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                dsthi = _mm_blend_epi16(dsthi, ff, 0x88);
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                dstlo = _mm_blend_epi16(dstlo, ff, 0x88);
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                dsthi = _mm_blend_epi16(dsthi, ff, 0x88);
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i src_alpha = _mm_set1_epi32((int)0xFF000000);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            pixels = _mm_or_si128(pixels, src_alpha);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_RGB888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_RGB888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_BGR888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_BGR888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i dst_shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i out_shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            pixels = _mm_shuffle_epi8(pixels, dst_shuffle);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            pixels = _mm_shuffle_epi8(pixels, out_shuffle);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_ARGB8888_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            pixels = _mm_packus_epi16(srclo, srchi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xFF);
+    const __m128i src_shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_setr_epi16(modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA);
+    Uint32 srcbuf[4] = { 0 }, dstbuf[4] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels, srclo, srchi;
+            __m128i dstlo, dsthi, alpha;
+
+            if (n < 4) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = _mm_shuffle_epi8(pixels, src_shuffle);
+            srclo = _mm_unpacklo_epi8(pixels, zero);
+            srchi = _mm_unpackhi_epi8(pixels, zero);
+            pixels = _mm_loadu_si128((const __m128i *)d);
+            dstlo = _mm_unpacklo_epi8(pixels, zero);
+            dsthi = _mm_unpackhi_epi8(pixels, zero);
+            srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, modulate));
+            srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, modulate));
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(srclo, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dstlo)));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(srchi, SDL_Div255_SSE41(_mm_mullo_epi16(_mm_sub_epi16(ff, alpha), dsthi)));
+                break;
+            case SDL_COPY_ADD:
+                alpha = SDL_SplatAlpha_SSE41(srclo);
+                srclo = SDL_Div255_SSE41(_mm_mullo_epi16(srclo, _mm_blend_epi16(alpha, ff, 0x88)));
+                dstlo = _mm_add_epi16(dstlo, _mm_blend_epi16(srclo, zero, 0x88));
+                alpha = SDL_SplatAlpha_SSE41(srchi);
+                srchi = SDL_Div255_SSE41(_mm_mullo_epi16(srchi, _mm_blend_epi16(alpha, ff, 0x88)));
+                dsthi = _mm_add_epi16(dsthi, _mm_blend_epi16(srchi, zero, 0x88));
+                break;
+            case SDL_COPY_MOD:
+                dstlo = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srclo, ff, 0x88), dstlo));
+                dsthi = SDL_Div255_SSE41(_mm_mullo_epi16(_mm_blend_epi16(srchi, ff, 0x88), dsthi));
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+                alpha = _mm_add_epi16(srclo, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srclo)));
+                dstlo = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dstlo, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                alpha = _mm_add_epi16(srchi, _mm_sub_epi16(ff, SDL_SplatAlpha_SSE41(srchi)));
+                dsthi = _mm_add_epi16(SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_min_epi16(alpha, ff))),
+                                    SDL_Div255_SSE41(_mm_mullo_epi16(dsthi, _mm_sub_epi16(alpha, _mm_min_epi16(alpha, ff)))));
+                break;
+            }
+            pixels = _mm_packus_epi16(dstlo, dsthi);
+            _mm_storeu_si128((__m128i *)d, pixels);
+
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#endif /* SDL_HAVE_BLIT_SSE41 */
+
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+#if SDL_HAVE_BLIT_AVX2
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif /* SDL_HAVE_BLIT_AVX2 */
+#if SDL_HAVE_BLIT_SSE41
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGB888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGB888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGB888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGB888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGB888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGB888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGR888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGR888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGR888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGR888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGR888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGR888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ARGB8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ARGB8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ARGB8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ARGB8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ARGB8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGBA8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGBA8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGBA8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGBA8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGBA8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ABGR8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ABGR8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ABGR8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ABGR8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ABGR8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGRA8888_RGB888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGRA8888_RGB888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGRA8888_BGR888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGRA8888_BGR888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGRA8888_ARGB8888_Blend_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE41, SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE41 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_SSE41, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif /* SDL_HAVE_BLIT_SSE41 */
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Scale },
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend },
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend_Scale },
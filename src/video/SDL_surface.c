@@ -20,6 +20,7 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_hints.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
@@ -614,9 +615,8 @@ SDL_GetClipRect(SDL_Surface * surface, SDL_Rect * rect)
  * you know exactly what you are doing, you can optimize your code
  * by calling the one(s) you need.
  */
-int
-SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
-              SDL_Surface * dst, SDL_Rect * dstrect)
+static int
+SDL_ValidateBlitMap(SDL_Surface * src, SDL_Surface * dst)
 {
     /* Check to make sure the blit mapping is valid */
     if ((src->map->dst != dst) ||
@@ -633,6 +633,16 @@ SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
 /*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
 /*              dst->map->info.flags, src->map->blit); */
     }
+    return 0;
+}
+
+int
+SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
+              SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    if (SDL_ValidateBlitMap(src, dst) < 0) {
+        return (-1);
+    }
     return (src->map->blit(src, srcrect, dst, dstrect));
 }
 
@@ -1076,6 +1086,35 @@ SDL_DuplicateSurface(SDL_Surface * surface)
     return SDL_ConvertSurface(surface, surface->format, surface->flags);
 }
 
+/* Conversions with fewer pixels than this per band aren't worth splitting up */
+#define SDL_CONVERT_BAND_MIN_PIXELS (64 * 1024)
+
+/*
+ * Blit a whole surface for a format conversion, spreading large images
+ * over worker threads if SDL_HINT_SURFACE_CONVERSION_THREADS allows it.
+ */
+static int
+SDL_ConvertBlit(SDL_Surface * src, SDL_Rect * rect, SDL_Surface * dst)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_CONVERSION_THREADS);
+    int num_bands = hint ? SDL_atoi(hint) : 0;
+
+    if (num_bands > 1) {
+        const Sint64 pixels = (Sint64) rect->w * rect->h;
+
+        if (pixels / SDL_CONVERT_BAND_MIN_PIXELS < num_bands) {
+            num_bands = (int) (pixels / SDL_CONVERT_BAND_MIN_PIXELS);
+        }
+    }
+    if (num_bands > 1) {
+        if (SDL_ValidateBlitMap(src, dst) < 0) {
+            return -1;
+        }
+        return SDL_SoftBlitThreaded(src, rect, dst, rect, num_bands);
+    }
+    return SDL_LowerBlit(src, rect, dst, rect);
+}
+
 /*
  * Convert a surface into the specified pixel format.
  */
@@ -1191,7 +1230,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
         }
     }
 
-    ret = SDL_LowerBlit(surface, &bounds, convert, &bounds);
+    ret = SDL_ConvertBlit(surface, &bounds, convert);
 
     /* Restore colorkey alpha value */
     if (palette_ck_transform) {
@@ -1430,7 +1469,7 @@ int SDL_ConvertPixels(int width, int height,
     rect.y = 0;
     rect.w = width;
     rect.h = height;
-    ret = SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
+    ret = SDL_ConvertBlit(&src_surface, &rect, &dst_surface);
 
     /* Free blitmap reference, after blitting between stack'ed surfaces */
     SDL_InvalidateMap(src_surface.map);
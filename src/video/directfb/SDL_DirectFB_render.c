@@ -815,6 +815,7 @@ DirectFB_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *
             }
 
             case SDL_RENDERCMD_COPY_EX:
+            case SDL_RENDERCMD_GEOMETRY:
                 break;  /* unsupported */
 
             case SDL_RENDERCMD_NO_OP:
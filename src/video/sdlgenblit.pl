@@ -85,6 +85,46 @@ my %set_rgba_string = (
     "BGRA8888" => "_pixel = (_B << 24) | (_G << 16) | (_R << 8) | _A;",
 );
 
+# The byte each channel is stored in, for the SIMD blitters
+my %format_channels = (
+    "RGB888" => { "B" => 0, "G" => 1, "R" => 2 },
+    "BGR888" => { "R" => 0, "G" => 1, "B" => 2 },
+    "ARGB8888" => { "B" => 0, "G" => 1, "R" => 2, "A" => 3 },
+    "RGBA8888" => { "A" => 0, "B" => 1, "G" => 2, "R" => 3 },
+    "ABGR8888" => { "R" => 0, "G" => 1, "B" => 2, "A" => 3 },
+    "BGRA8888" => { "A" => 0, "R" => 1, "G" => 2, "B" => 3 },
+);
+
+# The SIMD blitters work on pixels shuffled into ARGB8888 byte order
+my @simd_channels = ( "B", "G", "R", "A" );
+
+# The instruction sets we're creating SIMD blitters for, best first
+my @simd_isas = (
+    "AVX2",
+    "SSE41",
+);
+
+my %simd_isa = (
+    "AVX2" => {
+        "define" => "SDL_HAVE_BLIT_AVX2",
+        "target" => "avx2",
+        "cpu" => "SDL_CPU_AVX2",
+        "type" => "__m256i",
+        "prefix" => "_mm256",
+        "si" => "si256",
+        "width" => 8,
+    },
+    "SSE41" => {
+        "define" => "SDL_HAVE_BLIT_SSE41",
+        "target" => "sse4.1",
+        "cpu" => "SDL_CPU_SSE41",
+        "type" => "__m128i",
+        "prefix" => "_mm",
+        "si" => "si128",
+        "width" => 4,
+    },
+);
+
 sub open_file {
     my $name = shift;
     open(FILE, ">$name.new") || die "Cant' open $name.new: $!";
@@ -153,6 +193,7 @@ sub output_copyfuncname
     my $scale = shift;
     my $args = shift;
     my $suffix = shift;
+    my $isa = shift;
 
     print FILE "$prefix SDL_Blit_${src}_${dst}";
     if ( $modulate ) {
@@ -164,6 +205,9 @@ sub output_copyfuncname
     if ( $scale ) {
         print FILE "_Scale";
     }
+    if ( $isa ) {
+        print FILE "_$isa";
+    }
     if ( $args ) {
         print FILE "(SDL_BlitInfo *info)";
     }
@@ -509,6 +553,383 @@ __EOF__
 __EOF__
 }
 
+sub get_shuffle_mask
+{
+    my $isa = shift;
+    my $from = shift;
+    my $to = shift;
+    my $identity = 1;
+    my @mask;
+
+    # Build the byte shuffle that moves the channels of $from to where $to
+    # keeps them. A missing alpha byte is zeroed when writing pixels out, and
+    # left alone when reading them in, since it is replaced or ignored.
+    for (my $i = 0; $i < $simd_isa{$isa}{"width"}; ++$i) {
+        my $pixel = ($i % 4) * 4;
+        for (my $byte = 0; $byte < 4; ++$byte) {
+            my $index = -1;
+            foreach my $channel (keys %{$format_channels{$to}}) {
+                if ( $format_channels{$to}{$channel} == $byte ) {
+                    if ( exists $format_channels{$from}{$channel} ) {
+                        $index = $pixel + $format_channels{$from}{$channel};
+                    }
+                }
+            }
+            if ( $index == -1 && $to eq "ARGB8888" ) {
+                $index = $pixel + $byte;
+            }
+            if ( $index != $pixel + $byte ) {
+                $identity = 0;
+            }
+            push(@mask, $index);
+        }
+    }
+    if ( $identity ) {
+        return "";
+    }
+    return join(", ", @mask);
+}
+
+sub output_simdhelpers
+{
+    my $isa = shift;
+    my $target = $simd_isa{$isa}{"target"};
+    my $type = $simd_isa{$isa}{"type"};
+    my $p = $simd_isa{$isa}{"prefix"};
+
+    print FILE <<__EOF__;
+/* Divide 16-bit values up to 255 * 255 by 255, rounding down like the C blitters */
+static SDL_INLINE $type SDL_TARGETING("$target")
+SDL_Div255_$isa($type x)
+{
+    return ${p}_srli_epi16(${p}_add_epi16(${p}_add_epi16(x, ${p}_set1_epi16(1)), ${p}_srli_epi16(x, 8)), 8);
+}
+
+/* Copy the alpha of each unpacked pixel into all four of its channels */
+static SDL_INLINE $type SDL_TARGETING("$target")
+SDL_SplatAlpha_$isa($type x)
+{
+    return ${p}_shufflehi_epi16(${p}_shufflelo_epi16(x, 0xFF), 0xFF);
+}
+
+__EOF__
+}
+
+sub output_simdcore
+{
+    my $isa = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $mul_A_is_const_FF = shift;
+    my $p = $simd_isa{$isa}{"prefix"};
+
+    if ( $modulate ) {
+        foreach my $half ("lo", "hi") {
+            print FILE <<__EOF__;
+            src$half = SDL_Div255_$isa(${p}_mullo_epi16(src$half, modulate));
+__EOF__
+        }
+    }
+    if ( !$blend ) {
+        return;
+    }
+    print FILE <<__EOF__;
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            case SDL_COPY_BLEND:
+__EOF__
+    foreach my $half ("lo", "hi") {
+        print FILE <<__EOF__;
+                alpha = SDL_SplatAlpha_$isa(src$half);
+                src$half = SDL_Div255_$isa(${p}_mullo_epi16(src$half, ${p}_blend_epi16(alpha, ff, 0x88)));
+                dst$half = ${p}_add_epi16(src$half, SDL_Div255_$isa(${p}_mullo_epi16(${p}_sub_epi16(ff, alpha), dst$half)));
+__EOF__
+    }
+    print FILE <<__EOF__;
+                break;
+            case SDL_COPY_ADD:
+__EOF__
+    foreach my $half ("lo", "hi") {
+        print FILE <<__EOF__;
+                alpha = SDL_SplatAlpha_$isa(src$half);
+                src$half = SDL_Div255_$isa(${p}_mullo_epi16(src$half, ${p}_blend_epi16(alpha, ff, 0x88)));
+                dst$half = ${p}_add_epi16(dst$half, ${p}_blend_epi16(src$half, zero, 0x88));
+__EOF__
+    }
+    print FILE <<__EOF__;
+                break;
+            case SDL_COPY_MOD:
+__EOF__
+    foreach my $half ("lo", "hi") {
+        print FILE <<__EOF__;
+                dst$half = SDL_Div255_$isa(${p}_mullo_epi16(${p}_blend_epi16(src$half, ff, 0x88), dst$half));
+__EOF__
+    }
+    print FILE <<__EOF__;
+                break;
+            case SDL_COPY_MUL:
+                /* dst * (src + 255 - srcA) / 255, split so the products fit in 16 bits */
+__EOF__
+    foreach my $half ("lo", "hi") {
+        print FILE <<__EOF__;
+                alpha = ${p}_add_epi16(src$half, ${p}_sub_epi16(ff, SDL_SplatAlpha_$isa(src$half)));
+                dst$half = ${p}_add_epi16(SDL_Div255_$isa(${p}_mullo_epi16(dst$half, ${p}_min_epi16(alpha, ff))),
+                                    SDL_Div255_$isa(${p}_mullo_epi16(dst$half, ${p}_sub_epi16(alpha, ${p}_min_epi16(alpha, ff)))));
+__EOF__
+        if ( $mul_A_is_const_FF ) {
+            print FILE <<__EOF__;
+                dst$half = ${p}_blend_epi16(dst$half, ff, 0x88);
+__EOF__
+        }
+    }
+    print FILE <<__EOF__;
+                break;
+            }
+__EOF__
+}
+
+sub output_simdfunc
+{
+    my $isa = shift;
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $target = $simd_isa{$isa}{"target"};
+    my $type = $simd_isa{$isa}{"type"};
+    my $p = $simd_isa{$isa}{"prefix"};
+    my $si = $simd_isa{$isa}{"si"};
+    my $width = $simd_isa{$isa}{"width"};
+
+    my $src_has_alpha = ($src =~ /A/) ? 1 : 0;
+    my $dst_has_alpha = ($dst =~ /A/) ? 1 : 0;
+    my $src_shuffle = get_shuffle_mask($isa, $src, "ARGB8888");
+    my $dst_shuffle = get_shuffle_mask($isa, $dst, "ARGB8888");
+    my $out_shuffle = get_shuffle_mask($isa, "ARGB8888", $dst);
+
+    # The C blitters force the destination alpha opaque for SDL_COPY_MUL when
+    # the source alpha can only be 0xFF
+    my $mul_A_is_const_FF = ($dst_has_alpha && !$src_has_alpha && !$modulate);
+
+    output_copyfuncname("static void SDL_TARGETING(\"$target\")", $src, $dst, $modulate, $blend, 0, 1, "\n", $isa);
+    print FILE <<__EOF__;
+{
+    const int flags = info->flags;
+    const $type zero = ${p}_setzero_$si();
+__EOF__
+    if ( $blend ) {
+        print FILE <<__EOF__;
+    const $type ff = ${p}_set1_epi16(0xFF);
+__EOF__
+    }
+    if ( $src_shuffle ne "" ) {
+        print FILE <<__EOF__;
+    const $type src_shuffle = ${p}_setr_epi8($src_shuffle);
+__EOF__
+    }
+    if ( !$src_has_alpha ) {
+        print FILE <<__EOF__;
+    const $type src_alpha = ${p}_set1_epi32((int)0xFF000000);
+__EOF__
+    }
+    if ( $blend && $dst_shuffle ne "" ) {
+        print FILE <<__EOF__;
+    const $type dst_shuffle = ${p}_setr_epi8($dst_shuffle);
+__EOF__
+    }
+    if ( $out_shuffle ne "" ) {
+        print FILE <<__EOF__;
+    const $type out_shuffle = ${p}_setr_epi8($out_shuffle);
+__EOF__
+    }
+    if ( $modulate ) {
+        my @modulate;
+        for (my $i = 0; $i < $width / 2; ++$i) {
+            push(@modulate, "modulateB", "modulateG", "modulateR", "modulateA");
+        }
+        my $modulate_args = join(", ", @modulate);
+        print FILE <<__EOF__;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const $type modulate = ${p}_setr_epi16($modulate_args);
+__EOF__
+    }
+    print FILE <<__EOF__;
+    Uint32 srcbuf[$width] = { 0 }, dstbuf[$width] = { 0 };
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            $type pixels, srclo, srchi;
+__EOF__
+    if ( $blend ) {
+        print FILE <<__EOF__;
+            $type dstlo, dsthi, alpha;
+__EOF__
+    }
+    print FILE <<__EOF__;
+
+            if (n < $width) {
+                /* Finish the row through a buffer so we don't touch memory past its end */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+__EOF__
+    if ( $blend ) {
+        print FILE <<__EOF__;
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+__EOF__
+    }
+    print FILE <<__EOF__;
+                s = srcbuf;
+                d = dstbuf;
+            }
+
+            pixels = ${p}_loadu_$si((const $type *)s);
+__EOF__
+    if ( $src_shuffle ne "" ) {
+        print FILE <<__EOF__;
+            pixels = ${p}_shuffle_epi8(pixels, src_shuffle);
+__EOF__
+    }
+    if ( !$src_has_alpha ) {
+        print FILE <<__EOF__;
+            pixels = ${p}_or_$si(pixels, src_alpha);
+__EOF__
+    }
+    print FILE <<__EOF__;
+            srclo = ${p}_unpacklo_epi8(pixels, zero);
+            srchi = ${p}_unpackhi_epi8(pixels, zero);
+__EOF__
+    if ( $blend ) {
+        print FILE <<__EOF__;
+            pixels = ${p}_loadu_$si((const $type *)d);
+__EOF__
+        if ( $dst_shuffle ne "" ) {
+            print FILE <<__EOF__;
+            pixels = ${p}_shuffle_epi8(pixels, dst_shuffle);
+__EOF__
+        }
+        print FILE <<__EOF__;
+            dstlo = ${p}_unpacklo_epi8(pixels, zero);
+            dsthi = ${p}_unpackhi_epi8(pixels, zero);
+__EOF__
+    }
+    output_simdcore($isa, $modulate, $blend, $mul_A_is_const_FF);
+    if ( $blend ) {
+        print FILE <<__EOF__;
+            pixels = ${p}_packus_epi16(dstlo, dsthi);
+__EOF__
+    } else {
+        print FILE <<__EOF__;
+            pixels = ${p}_packus_epi16(srclo, srchi);
+__EOF__
+    }
+    if ( $out_shuffle ne "" ) {
+        print FILE <<__EOF__;
+            pixels = ${p}_shuffle_epi8(pixels, out_shuffle);
+__EOF__
+    }
+    print FILE <<__EOF__;
+            ${p}_storeu_$si(($type *)d, pixels);
+
+            if (n < $width) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += $width;
+            dst += $width;
+            n -= $width;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+__EOF__
+}
+
+sub output_simdfuncs
+{
+    my $isa = shift;
+    my $define = $simd_isa{$isa}{"define"};
+
+    print FILE <<__EOF__;
+#if $define
+
+__EOF__
+    output_simdhelpers($isa);
+    for (my $i = 0; $i <= $#src_formats; ++$i) {
+        for (my $j = 0; $j <= $#dst_formats; ++$j) {
+            for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+                for (my $blend = 0; $blend <= 1; ++$blend) {
+                    if ( $modulate || $blend ) {
+                        output_simdfunc($isa, $src_formats[$i], $dst_formats[$j], $modulate, $blend);
+                    }
+                }
+            }
+        }
+    }
+    print FILE <<__EOF__;
+#endif /* $define */
+
+__EOF__
+}
+
+sub get_copyflags
+{
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+    my @flags;
+
+    if ( $modulate ) {
+        push(@flags, "SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA");
+    }
+    if ( $blend ) {
+        push(@flags, "SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL");
+    }
+    if ( $scale ) {
+        push(@flags, "SDL_COPY_NEAREST");
+    }
+    if ( !@flags ) {
+        return "0";
+    }
+    return join(" | ", @flags);
+}
+
+sub output_simdfunctable
+{
+    my $isa = shift;
+    my $define = $simd_isa{$isa}{"define"};
+    my $cpu = $simd_isa{$isa}{"cpu"};
+
+    print FILE <<__EOF__;
+#if $define
+__EOF__
+    for (my $i = 0; $i <= $#src_formats; ++$i) {
+        my $src = $src_formats[$i];
+        for (my $j = 0; $j <= $#dst_formats; ++$j) {
+            my $dst = $dst_formats[$j];
+            for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+                for (my $blend = 0; $blend <= 1; ++$blend) {
+                    if ( $modulate || $blend ) {
+                        my $flags = get_copyflags($modulate, $blend, 0);
+                        print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ($flags), $cpu,";
+                        output_copyfuncname("", $src, $dst, $modulate, $blend, 0, 0, " },\n", $isa);
+                    }
+                }
+            }
+        }
+    }
+    print FILE <<__EOF__;
+#endif /* $define */
+__EOF__
+}
+
 sub output_copyfunc_h
 {
 }
@@ -528,6 +949,9 @@ sub output_copyfunctable
     print FILE <<__EOF__;
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
 __EOF__
+    foreach my $isa (@simd_isas) {
+        output_simdfunctable($isa);
+    }
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
@@ -537,35 +961,7 @@ __EOF__
                     for (my $scale = 0; $scale <= 1; ++$scale) {
                         if ( $modulate || $blend || $scale ) {
                             print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ";
-                            my $flags = "";
-                            my $flag = "";
-                            if ( $modulate ) {
-                                $flag = "SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA";
-                                if ( $flags eq "" ) {
-                                    $flags = $flag;
-                                } else {
-                                    $flags = "$flags | $flag";
-                                }
-                            }
-                            if ( $blend ) {
-                                $flag = "SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL";
-                                if ( $flags eq "" ) {
-                                    $flags = $flag;
-                                } else {
-                                    $flags = "$flags | $flag";
-                                }
-                            }
-                            if ( $scale ) {
-                                $flag = "SDL_COPY_NEAREST";
-                                if ( $flags eq "" ) {
-                                    $flags = $flag;
-                                } else {
-                                    $flags = "$flags | $flag";
-                                }
-                            }
-                            if ( $flags eq "" ) {
-                                $flags = "0";
-                            }
+                            my $flags = get_copyflags($modulate, $blend, $scale);
                             print FILE "($flags), SDL_CPU_ANY,";
                             output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
                         }
@@ -614,5 +1010,8 @@ for (my $i = 0; $i <= $#src_formats; ++$i) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
     }
 }
+foreach my $isa (@simd_isas) {
+    output_simdfuncs($isa);
+}
 output_copyfunctable();
 close_file("SDL_blit_auto.c");
@@ -22,6 +22,12 @@ _audioSetUp(void *arg)
     /* Start SDL audio subsystem */
     int ret = SDL_InitSubSystem( SDL_INIT_AUDIO );
         SDLTest_AssertPass("Call to SDL_InitSubSystem(SDL_INIT_AUDIO)");
+    /* Some tests call SDL_AudioQuit() directly, which leaves the subsystem
+       counted as initialized without a driver. Bring one back up. */
+    if (ret == 0 && SDL_GetCurrentAudioDriver() == NULL) {
+        ret = SDL_AudioInit(NULL);
+        SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+    }
     SDLTest_AssertCheck(ret==0, "Check result from SDL_InitSubSystem(SDL_INIT_AUDIO)");
     if (ret != 0) {
            SDLTest_LogError("%s", SDL_GetError());
@@ -967,6 +973,511 @@ int audio_openCloseAudioDeviceConnected()
    return TEST_COMPLETED;
 }
 
+/**
+ * \brief Resamples a sine wave through an audio stream in uneven pieces, and through SDL_ConvertAudio, and checks the signal-to-noise ratio.
+ *
+ * \sa https://wiki.libsdl.org/SDL_NewAudioStream
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_resampleLoss()
+{
+  const struct {
+    const char *mode;
+    int rate_in;
+    int rate_out;
+    double min_snr;  /* in dB */
+  } test_specs[] = {
+    { "default", 44100, 48000, 75.0 },
+    { "default", 48000, 44100, 75.0 },
+    { "default", 22050, 96000, 75.0 },
+    { "medium", 44100, 48000, 100.0 },
+    { "best", 48000, 44100, 120.0 },
+    { "best", 44100, 44101, 120.0 },
+  };
+  const double frequency = 1000.0;
+  const double amplitude = 0.5;
+  const int num_frames = 22050;
+  const int chunk_frames = 941;
+  const int margin = 256;  /* the start and end are filtered against silence, skip them. */
+  int i, j, k;
+
+  for (i = 0; i < (int) SDL_arraysize(test_specs); i++) {
+    const int rate_in = test_specs[i].rate_in;
+    const int rate_out = test_specs[i].rate_out;
+    const int max_out = (int) (((Sint64) num_frames * rate_out) / rate_in) + 16;
+    float *buf_in = (float *) SDL_malloc(num_frames * 2 * sizeof (float));
+    float *buf_out = (float *) SDL_malloc(max_out * 2 * sizeof (float));
+    SDL_AudioStream *stream;
+    SDL_AudioCVT cvt;
+    int frames_out, pass;
+
+    SDLTest_AssertCheck(buf_in != NULL && buf_out != NULL, "Allocate test buffers");
+    if (buf_in == NULL || buf_out == NULL) {
+      SDL_free(buf_in);
+      SDL_free(buf_out);
+      return TEST_ABORTED;
+    }
+
+    for (j = 0; j < num_frames; j++) {
+      buf_in[j * 2] = buf_in[(j * 2) + 1] = (float) (amplitude * SDL_sin(2.0 * M_PI * frequency * j / rate_in));
+    }
+
+    SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, test_specs[i].mode);
+
+    for (pass = 0; pass < 2; pass++) {
+      double signal = 0.0;
+      double noise = 0.0;
+      double snr;
+
+      if (pass == 0) {
+        stream = SDL_NewAudioStream(AUDIO_F32SYS, 2, rate_in, AUDIO_F32SYS, 2, rate_out);
+        SDLTest_AssertPass("Call to SDL_NewAudioStream(AUDIO_F32SYS, 2, %i, AUDIO_F32SYS, 2, %i)", rate_in, rate_out);
+        SDLTest_AssertCheck(stream != NULL, "Expected SDL_NewAudioStream to succeed.");
+        if (stream == NULL) {
+          continue;
+        }
+        for (j = 0; j < num_frames; j += chunk_frames) {
+          const int frames = SDL_min(chunk_frames, num_frames - j);
+          SDL_AudioStreamPut(stream, buf_in + (j * 2), frames * 2 * sizeof (float));
+        }
+        frames_out = SDL_AudioStreamGet(stream, buf_out, max_out * 2 * sizeof (float)) / (2 * sizeof (float));
+        SDL_FreeAudioStream(stream);
+      } else {
+        SDLTest_AssertCheck(SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 2, rate_in, AUDIO_F32SYS, 2, rate_out) == 1,
+                            "Call to SDL_BuildAudioCVT(AUDIO_F32SYS, 2, %i, AUDIO_F32SYS, 2, %i)", rate_in, rate_out);
+        cvt.len = num_frames * 2 * sizeof (float);
+        cvt.buf = (Uint8 *) SDL_malloc(cvt.len * cvt.len_mult);
+        SDLTest_AssertCheck(cvt.buf != NULL, "Allocate conversion buffer");
+        if (cvt.buf == NULL) {
+          continue;
+        }
+        SDL_memcpy(cvt.buf, buf_in, cvt.len);
+        SDLTest_AssertCheck(SDL_ConvertAudio(&cvt) == 0, "Call to SDL_ConvertAudio()");
+        frames_out = SDL_min(cvt.len_cvt / (int) (2 * sizeof (float)), max_out);
+        SDL_memcpy(buf_out, cvt.buf, frames_out * 2 * sizeof (float));
+        SDL_free(cvt.buf);
+      }
+
+      SDLTest_AssertCheck(frames_out > 2 * margin, "Expected more than %i frames of output, got %i.", 2 * margin, frames_out);
+      if (frames_out <= 2 * margin) {
+        continue;
+      }
+
+      /* output frame k lines up with input time k * rate_in / rate_out */
+      for (k = margin; k < frames_out - margin; k++) {
+        const double expected = amplitude * SDL_sin(2.0 * M_PI * frequency * k / rate_out);
+        signal += expected * expected;
+        noise += (buf_out[k * 2] - expected) * (buf_out[k * 2] - expected);
+        noise += (buf_out[(k * 2) + 1] - expected) * (buf_out[(k * 2) + 1] - expected);
+      }
+      snr = (noise > 0.0) ? 10.0 * SDL_log10((2.0 * signal) / noise) : 999.0;
+      SDLTest_AssertCheck(snr >= test_specs[i].min_snr, "%s resampling %i -> %i with mode \"%s\": expected SNR >= %f dB, got %f dB.",
+                          pass ? "SDL_ConvertAudio" : "SDL_AudioStream", rate_in, rate_out, test_specs[i].mode, test_specs[i].min_snr, snr);
+    }
+
+    SDL_free(buf_in);
+    SDL_free(buf_out);
+  }
+
+  SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, NULL);
+
+  return TEST_COMPLETED;
+}
+
+/* Resamples frames of a test tone with SDL_ConvertAudio(), returns the output length in bytes or -1 */
+static int
+_audio_resampleTone(int rate_in, int rate_out, int frames, float *out)
+{
+  SDL_AudioCVT cvt;
+  int len, j;
+
+  if (SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 1, rate_in, AUDIO_F32SYS, 1, rate_out) != 1) {
+    return -1;
+  }
+  cvt.len = frames * sizeof (float);
+  cvt.buf = (Uint8 *) SDL_malloc(cvt.len * cvt.len_mult);
+  if (cvt.buf == NULL) {
+    return -1;
+  }
+  for (j = 0; j < frames; j++) {
+    ((float *) cvt.buf)[j] = (float) (0.5 * SDL_sin(j * 0.1));
+  }
+  len = (SDL_ConvertAudio(&cvt) == 0) ? cvt.len_cvt : -1;
+  if (len > 0) {
+    SDL_memcpy(out, cvt.buf, len);
+  }
+  SDL_free(cvt.buf);
+  return len;
+}
+
+/**
+ * \brief Repeats SDL_ConvertAudio() resampling across more rate pairs than it keeps filters for, and checks the output never changes.
+ *
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertAudioRepeated()
+{
+  const int rates[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 22050, 96000 }, { 96000, 8000 }, { 8000, 11025 }, { 44100, 44101 } };
+  const int frame_counts[] = { 512, 3 };
+  float first[4096], again[4096];
+  int first_len, again_len;
+  int i, j, pass;
+
+  for (i = 0; i < (int) SDL_arraysize(frame_counts); i++) {
+    for (j = 0; j < (int) SDL_arraysize(rates); j++) {
+      first_len = _audio_resampleTone(rates[j][0], rates[j][1], frame_counts[i], first);
+      SDLTest_AssertCheck(first_len >= 0, "Resample %i frames %i -> %i; expected: >=0 bytes got: %i", frame_counts[i], rates[j][0], rates[j][1], first_len);
+
+      /* the same rates again right away, and after every other pair has been through */
+      for (pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+          int k;
+          for (k = 0; k < (int) SDL_arraysize(rates); k++) {
+            _audio_resampleTone(rates[k][0], rates[k][1], frame_counts[i], again);
+          }
+        }
+        again_len = _audio_resampleTone(rates[j][0], rates[j][1], frame_counts[i], again);
+        SDLTest_AssertCheck(again_len == first_len && (first_len <= 0 || SDL_memcmp(first, again, first_len) == 0),
+                            "Validate resampling %i -> %i again gives the same %i bytes, got: %i", rates[j][0], rates[j][1], first_len, again_len);
+      }
+    }
+  }
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Mixes native byte order S16, S32 and F32 audio, and checks volume scaling and clipping against per-sample math.
+ *
+ * \sa https://wiki.libsdl.org/SDL_MixAudioFormat
+ */
+int audio_mixAudioFormat()
+{
+  const int volumes[] = { 1, 37, SDL_MIX_MAXVOLUME / 2, SDL_MIX_MAXVOLUME - 1, SDL_MIX_MAXVOLUME };
+  const int num_samples = 67;  /* not a multiple of any SIMD width. */
+  Sint16 src16[67], dst16[67];
+  Sint32 src32[67], dst32[67];
+  float srcf[67], dstf[67];
+  int i, v, errors;
+
+  for (v = 0; v < (int) SDL_arraysize(volumes); v++) {
+    const int volume = volumes[v];
+
+    for (i = 0; i < num_samples; i++) {
+      src16[i] = (Sint16) SDLTest_RandomSint16();
+      dst16[i] = (Sint16) SDLTest_RandomSint16();
+      src32[i] = SDLTest_RandomSint32();
+      dst32[i] = SDLTest_RandomSint32();
+      srcf[i] = SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+      dstf[i] = SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+    }
+    srcf[3] = dstf[3] = 3.0e38f;  /* overflows, so should clip */
+
+    {
+      Sint16 mixed[67];
+      SDL_memcpy(mixed, dst16, sizeof (mixed));
+      SDL_MixAudioFormat((Uint8 *) mixed, (const Uint8 *) src16, AUDIO_S16SYS, sizeof (mixed), volume);
+      SDLTest_AssertPass("Call to SDL_MixAudioFormat(AUDIO_S16SYS, volume=%i)", volume);
+      for (i = 0, errors = 0; i < num_samples; i++) {
+        const int expected = SDL_max(SDL_MIN_SINT16, SDL_min(SDL_MAX_SINT16, ((src16[i] * volume) / SDL_MIX_MAXVOLUME) + dst16[i]));
+        errors += (mixed[i] != expected);
+      }
+      SDLTest_AssertCheck(errors == 0, "Verify mixed S16 samples; expected: 0 mismatches, got: %i", errors);
+    }
+
+    {
+      Sint32 mixed[67];
+      SDL_memcpy(mixed, dst32, sizeof (mixed));
+      SDL_MixAudioFormat((Uint8 *) mixed, (const Uint8 *) src32, AUDIO_S32SYS, sizeof (mixed), volume);
+      SDLTest_AssertPass("Call to SDL_MixAudioFormat(AUDIO_S32SYS, volume=%i)", volume);
+      for (i = 0, errors = 0; i < num_samples; i++) {
+        const Sint64 expected = SDL_max(SDL_MIN_SINT32, SDL_min(SDL_MAX_SINT32, ((((Sint64) src32[i]) * volume) / SDL_MIX_MAXVOLUME) + dst32[i]));
+        errors += (mixed[i] != expected);
+      }
+      SDLTest_AssertCheck(errors == 0, "Verify mixed S32 samples; expected: 0 mismatches, got: %i", errors);
+    }
+
+    {
+      float mixed[67];
+      SDL_memcpy(mixed, dstf, sizeof (mixed));
+      SDL_MixAudioFormat((Uint8 *) mixed, (const Uint8 *) srcf, AUDIO_F32SYS, sizeof (mixed), volume);
+      SDLTest_AssertPass("Call to SDL_MixAudioFormat(AUDIO_F32SYS, volume=%i)", volume);
+      for (i = 0, errors = 0; i < num_samples; i++) {
+        const double expected = SDL_min(3.402823466e+38F, ((double) ((srcf[i] * (float) volume) * (1.0f / SDL_MIX_MAXVOLUME))) + dstf[i]);
+        errors += (mixed[i] != (float) expected);
+      }
+      SDLTest_AssertCheck(errors == 0, "Verify mixed F32 samples; expected: 0 mismatches, got: %i", errors);
+    }
+  }
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Adds, queues, plays and removes voices on an audio mixer, and checks that stale voice IDs are rejected.
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenAudioMixer
+ */
+int audio_audioMixer()
+{
+  SDL_AudioSpec desired, obtained;
+  SDL_AudioMixer *mixer;
+  SDL_AudioVoiceID voice, other;
+  Sint16 data[1024 * 2];
+  int result;
+  int i;
+
+  SDL_zero(desired);
+  desired.freq = 22050;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 512;
+
+  mixer = SDL_OpenAudioMixer(NULL, &desired, &obtained, 0, 2);
+  SDLTest_AssertPass("Call to SDL_OpenAudioMixer(NULL, desired, obtained, 0, 2)");
+  if (mixer == NULL) {
+    SDLTest_Log("No audio device available to mix into, skipping: %s", SDL_GetError());
+    return TEST_SKIPPED;
+  }
+  SDLTest_AssertCheck(obtained.format == AUDIO_F32SYS, "Validate mixer format; expected: AUDIO_F32SYS got: 0x%.4x", obtained.format);
+  SDLTest_AssertCheck(SDL_GetAudioMixerDevice(mixer) != 0, "Validate mixer has an audio device");
+
+  voice = SDL_AddAudioMixerVoice(mixer, AUDIO_S16SYS, 2, 44100);
+  SDLTest_AssertCheck(voice != 0, "Call to SDL_AddAudioMixerVoice(AUDIO_S16SYS, 2, 44100)");
+  other = SDL_AddAudioMixerVoice(mixer, AUDIO_F32SYS, 1, 48000);
+  SDLTest_AssertCheck(other != 0 && other != voice, "Call to SDL_AddAudioMixerVoice(AUDIO_F32SYS, 1, 48000)");
+  SDLTest_AssertCheck(SDL_AddAudioMixerVoice(mixer, AUDIO_U8, 1, 8000) == 0, "Validate adding more than max_voices fails");
+
+  for (i = 0; i < (int) SDL_arraysize(data); i++) {
+    data[i] = (Sint16) SDLTest_RandomSint16();
+  }
+  result = SDL_QueueAudioMixerVoice(mixer, voice, data, sizeof (data));
+  SDLTest_AssertCheck(result == 0, "Call to SDL_QueueAudioMixerVoice(); expected: 0 got: %i", result);
+  result = SDL_GetAudioMixerVoiceLatency(mixer, voice);
+  SDLTest_AssertCheck(result > 0, "Call to SDL_GetAudioMixerVoiceLatency(); expected: > 0 got: %i", result);
+
+  /* more commands than the queue holds, while the device is still paused */
+  for (i = 0; i < 1000; i++) {
+    result = SDL_SetAudioMixerVoiceGain(mixer, voice, 0.5f, -0.5f);
+    if (result != 0) {
+      break;
+    }
+  }
+  SDLTest_AssertCheck(result == 0, "Call to SDL_SetAudioMixerVoiceGain() while paused; expected: 0 got: %i", result);
+  result = SDL_PlayAudioMixerVoice(mixer, voice);
+  SDLTest_AssertCheck(result == 0, "Call to SDL_PlayAudioMixerVoice(); expected: 0 got: %i", result);
+  result = SDL_PlayAudioMixerVoice(mixer, other);
+  SDLTest_AssertCheck(result == 0, "Call to SDL_PlayAudioMixerVoice(); expected: 0 got: %i", result);
+
+  SDL_PauseAudioDevice(SDL_GetAudioMixerDevice(mixer), 0);
+  SDL_Delay(50);
+
+  result = SDL_StopAudioMixerVoice(mixer, other);
+  SDLTest_AssertCheck(result == 0, "Call to SDL_StopAudioMixerVoice(); expected: 0 got: %i", result);
+  SDL_RemoveAudioMixerVoice(mixer, other);
+  SDLTest_AssertPass("Call to SDL_RemoveAudioMixerVoice()");
+
+  result = SDL_PlayAudioMixerVoice(mixer, other);
+  SDLTest_AssertCheck(result == -1, "Validate playing a removed voice fails; expected: -1 got: %i", result);
+  result = SDL_QueueAudioMixerVoice(mixer, other, data, sizeof (data));
+  SDLTest_AssertCheck(result == -1, "Validate queueing to a removed voice fails; expected: -1 got: %i", result);
+
+  /* the slot gets reused, but the old ID must not reach the new voice */
+  voice = SDL_AddAudioMixerVoice(mixer, AUDIO_S16SYS, 2, 22050);
+  SDLTest_AssertCheck(voice != 0 && voice != other, "Validate a reused voice slot gets a new ID");
+  result = SDL_GetAudioMixerVoiceLatency(mixer, other);
+  SDLTest_AssertCheck(result == -1, "Validate the removed voice ID stays invalid; expected: -1 got: %i", result);
+
+  SDL_CloseAudioMixer(mixer);
+  SDLTest_AssertPass("Call to SDL_CloseAudioMixer()");
+
+  return TEST_COMPLETED;
+}
+
+
+/**
+ * \brief Queues audio through the fixed-size ring buffer picked with SDL_HINT_AUDIO_QUEUE_CAPACITY.
+ *
+ * \sa https://wiki.libsdl.org/SDL_QueueAudio
+ */
+int audio_queueAudioRingBuffer()
+{
+  SDL_AudioSpec desired, obtained;
+  SDL_AudioDeviceID id;
+  Uint8 data[4096];
+  Uint8 *big;
+  Uint32 queued;
+  int result;
+  int i;
+
+  SDL_SetHint(SDL_HINT_AUDIO_QUEUE_CAPACITY, "1024");
+  SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_AUDIO_QUEUE_CAPACITY, \"1024\")");
+
+  SDL_zero(desired);
+  desired.freq = 22050;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 512;
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, desired, obtained, 0)");
+  SDL_SetHint(SDL_HINT_AUDIO_QUEUE_CAPACITY, NULL);
+  if (id == 0) {
+    SDLTest_Log("No audio device available to queue to, skipping: %s", SDL_GetError());
+    return TEST_SKIPPED;
+  }
+
+  for (i = 0; i < (int) sizeof (data); i++) {
+    data[i] = (Uint8) i;
+  }
+
+  /* 1024 stereo S16 frames */
+  result = SDL_QueueAudio(id, data, sizeof (data));
+  SDLTest_AssertCheck(result == 0, "Call to SDL_QueueAudio(4096 bytes); expected: 0 got: %i", result);
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued == sizeof (data), "Call to SDL_GetQueuedAudioSize(); expected: %i got: %i", (int) sizeof (data), (int) queued);
+
+  /* way past the capacity, so nothing should be queued */
+  big = (Uint8 *) SDL_calloc(1, 1024 * 1024);
+  SDLTest_AssertCheck(big != NULL, "Allocate 1MB buffer");
+  if (big != NULL) {
+    result = SDL_QueueAudio(id, big, 1024 * 1024);
+    SDLTest_AssertCheck(result == -1, "Validate queueing past the capacity fails; expected: -1 got: %i", result);
+    queued = SDL_GetQueuedAudioSize(id);
+    SDLTest_AssertCheck(queued == sizeof (data), "Validate nothing was queued; expected: %i got: %i", (int) sizeof (data), (int) queued);
+    SDL_free(big);
+  }
+
+  SDL_ClearQueuedAudio(id);
+  SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued == 0, "Validate the queue is empty; expected: 0 got: %i", (int) queued);
+
+  /* wrap around the end of the ring a few times while the device drains it */
+  SDL_PauseAudioDevice(id, 0);
+  for (i = 0; i < 16; i++) {
+    const Uint32 timeout = SDL_GetTicks() + 1000;
+    while ((SDL_GetQueuedAudioSize(id) > (sizeof (data) - 1000)) && !SDL_TICKS_PASSED(SDL_GetTicks(), timeout)) {
+      SDL_Delay(1);
+    }
+    if (SDL_GetQueuedAudioSize(id) > (sizeof (data) - 1000)) {
+      SDLTest_Log("Audio device isn't playing, not testing wrap-around");
+      break;
+    }
+    result = SDL_QueueAudio(id, data, 1000);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_QueueAudio(1000 bytes); expected: 0 got: %i", result);
+  }
+
+  SDL_CloseAudioDevice(id);
+  SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+  return TEST_COMPLETED;
+}
+
+
+/* Counts up one per sample, skipping 0 so silence stands out */
+void SDLCALL _audio_rampCallback(void *userdata, Uint8 *stream, int len)
+{
+   Sint16 *next = (Sint16 *) userdata;
+   Sint16 *dst = (Sint16 *) stream;
+   int i;
+
+   for (i = 0; i < len / (int) sizeof (Sint16); i++) {
+      dst[i] = *next;
+      *next = (*next == SDL_MAX_SINT16) ? 1 : (*next + 1);
+   }
+   _audio_testCallbackCounter++;
+}
+
+/**
+ * \brief Plays through a device whose buffer size differs from the callback's.
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenAudioDevice
+ */
+int audio_rebufferedPlayback()
+{
+  const int deviceSamples[] = { 100, 1000 };
+  SDL_AudioSpec desired, obtained;
+  SDL_AudioDeviceID id;
+  SDL_RWops *rw;
+  Sint16 next, expected, sample;
+  Uint32 timeout;
+  int result;
+  int played;
+  int gaps;
+  int i;
+
+  for (i = 0; i < (int) SDL_arraysize(deviceSamples); i++) {
+    char samples[16];
+
+    /* the disk driver writes every device buffer to a file we can check */
+    SDL_AudioQuit();
+    SDL_snprintf(samples, sizeof (samples), "%d", deviceSamples[i]);
+    SDL_setenv("SDL_DISKAUDIOSAMPLES", samples, 1);
+    SDL_setenv("SDL_DISKAUDIODELAY", "0", 1);
+    SDL_setenv("SDL_DISKAUDIOFILE", "sdlaudio.raw", 1);
+    result = SDL_AudioInit("disk");
+    SDLTest_AssertPass("Call to SDL_AudioInit(\"disk\")");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+    if (result != 0) {
+      break;
+    }
+
+    SDL_zero(desired);
+    desired.freq = 22050;
+    desired.format = AUDIO_S16SYS;
+    desired.channels = 1;
+    desired.samples = 256;
+    desired.callback = _audio_rampCallback;
+    desired.userdata = &next;
+    next = 1;
+    _audio_testCallbackCounter = 0;
+    id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice() with %d sample device buffers", deviceSamples[i]);
+    SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0 got: %d", (int) id);
+    if (id == 0) {
+      break;
+    }
+    SDLTest_AssertCheck(obtained.samples == desired.samples, "Validate callback samples; expected: %d got: %d", (int) desired.samples, (int) obtained.samples);
+
+    SDL_PauseAudioDevice(id, 0);
+    timeout = SDL_GetTicks() + 5000;
+    while ((_audio_testCallbackCounter < 100) && !SDL_TICKS_PASSED(SDL_GetTicks(), timeout)) {
+      SDL_Delay(1);
+    }
+    SDL_CloseAudioDevice(id);
+    SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+    SDLTest_AssertCheck(_audio_testCallbackCounter >= 100, "Validate callback counter; expected: >=100 got: %d", _audio_testCallbackCounter);
+
+    /* after the silence played while paused, the ramp must have no gaps */
+    rw = SDL_RWFromFile("sdlaudio.raw", "rb");
+    SDLTest_AssertCheck(rw != NULL, "Validate the disk driver wrote its output file");
+    if (rw == NULL) {
+      break;
+    }
+    expected = 1;
+    played = 0;
+    gaps = 0;
+    while (SDL_RWread(rw, &sample, sizeof (sample), 1) == 1) {
+      if ((played == 0) && (sample == 0)) {
+        continue;
+      }
+      if (sample != expected) {
+        gaps++;
+      }
+      expected = (sample == SDL_MAX_SINT16) ? 1 : (sample + 1);
+      played++;
+    }
+    SDL_RWclose(rw);
+    SDLTest_AssertCheck(played >= 50 * desired.samples, "Validate played samples; expected: >=%d got: %d", 50 * desired.samples, played);
+    SDLTest_AssertCheck(gaps == 0, "Validate the output is continuous; expected: 0 gaps got: %d", gaps);
+  }
+
+  SDL_setenv("SDL_DISKAUDIOSAMPLES", "0", 1);
+  SDL_AudioQuit();
+  SDLTest_AssertPass("Call to SDL_AudioQuit()");
+
+  return TEST_COMPLETED;
+}
 
 
 /* ================= Test Case References ================== */
@@ -1022,11 +1533,30 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_resampleLoss, "audio_resampleLoss", "Check signal-to-noise ratio of resampling.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_mixAudioFormat, "audio_mixAudioFormat", "Mixes audio with volume scaling and clipping.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_audioMixer, "audio_audioMixer", "Plays several voices through an audio mixer.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_queueAudioRingBuffer, "audio_queueAudioRingBuffer", "Queues audio through a fixed-size ring buffer.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest20 =
+        { (SDLTest_TestCaseFp)audio_rebufferedPlayback, "audio_rebufferedPlayback", "Plays through a device whose buffer size differs from the callback's.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest21 =
+        { (SDLTest_TestCaseFp)audio_convertAudioRepeated, "audio_convertAudioRepeated", "Repeats SDL_ConvertAudio() resampling with the same and different rates.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, NULL
 };
 
 /* Audio test suite (global) */
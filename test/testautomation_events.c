@@ -174,6 +174,314 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/* Number of producer threads and events each of them pushes */
+#define _EVENTS_NUM_PRODUCERS 4
+#define _EVENTS_PER_PRODUCER 1000
+
+/* Pushes a sequence of numbered user events, tagged with the producer index */
+int SDLCALL _events_producerThread(void *data)
+{
+   int producer = (int)(intptr_t)data;
+   SDL_Event event;
+   int i;
+
+   for (i = 0; i < _EVENTS_PER_PRODUCER; ++i) {
+      SDL_zero(event);
+      event.type = SDL_USEREVENT;
+      event.user.code = i;
+      event.user.data1 = (void *)(intptr_t)producer;
+      while (SDL_PushEvent(&event) <= 0) {
+         SDL_Delay(1);
+      }
+   }
+   return 0;
+}
+
+/**
+ * @brief Pushes user events from several threads at once and checks that all
+ *        of them arrive, in order for each producer.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_pushFromMultipleThreads(void *arg)
+{
+   SDL_Thread *threads[_EVENTS_NUM_PRODUCERS];
+   int next[_EVENTS_NUM_PRODUCERS];
+   SDL_Event event;
+   int i, received = 0, outOfOrder = 0;
+
+   SDL_FlushEvents(SDL_USEREVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   for (i = 0; i < _EVENTS_NUM_PRODUCERS; ++i) {
+      next[i] = 0;
+      threads[i] = SDL_CreateThread(_events_producerThread, "EventProducer", (void *)(intptr_t)i);
+      SDLTest_AssertCheck(threads[i] != NULL, "Check that producer thread %d was created", i);
+   }
+
+   while (received < _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER) {
+      int result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+      if (result < 0) {
+         break;
+      }
+      if (result == 0) {
+         SDL_Delay(1);
+         continue;
+      }
+      i = (int)(intptr_t)event.user.data1;
+      if (i < 0 || i >= _EVENTS_NUM_PRODUCERS || event.user.code != next[i]) {
+         ++outOfOrder;
+      } else {
+         ++next[i];
+      }
+      ++received;
+   }
+
+   for (i = 0; i < _EVENTS_NUM_PRODUCERS; ++i) {
+      SDL_WaitThread(threads[i], NULL);
+   }
+   SDLTest_AssertCheck(received == _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER, "Check number of received events, expected: %d, got: %d", _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER, received);
+   SDLTest_AssertCheck(outOfOrder == 0, "Check that events arrived in order, got %d out of order", outOfOrder);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Removes events from the middle of the queue and checks the rest are kept in order.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_FlushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_flushFromMiddleOfQueue(void *arg)
+{
+   SDL_Event event;
+   int i, result;
+
+   SDL_FlushEvents(SDL_USEREVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Interleave two user event types */
+   for (i = 0; i < 10; ++i) {
+      SDL_zero(event);
+      event.type = SDL_USEREVENT + (i % 2);
+      event.user.code = i;
+      SDL_PushEvent(&event);
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent()");
+
+   SDL_FlushEvent(SDL_USEREVENT + 1);
+   SDLTest_AssertPass("Call to SDL_FlushEvent()");
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_USEREVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 5, "Check number of queued events, expected: 5, got: %d", result);
+
+   for (i = 0; i < 10; i += 2) {
+      result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_LASTEVENT);
+      SDLTest_AssertCheck(result == 1, "Check result from SDL_PeepEvents, expected: 1, got: %d", result);
+      SDLTest_AssertCheck(event.type == SDL_USEREVENT && event.user.code == i, "Check event, expected: code %d, got: code %d", i, event.user.code);
+   }
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_USEREVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 0, "Check that the queue is empty, got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Pushes several user events and retrieves them in batches.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PollEvents
+ */
+int
+events_pollMultipleEvents(void *arg)
+{
+   SDL_Event events[4];
+   SDL_Event event;
+   int i, result, received = 0, outOfOrder = 0;
+
+   SDL_FlushEvents(SDL_USEREVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   for (i = 0; i < 10; ++i) {
+      SDL_zero(event);
+      event.type = SDL_USEREVENT;
+      event.user.code = i;
+      SDL_PushEvent(&event);
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent()");
+
+   do {
+      result = SDL_PollEvents(events, SDL_arraysize(events));
+      SDLTest_AssertCheck(result >= 0 && result <= (int)SDL_arraysize(events), "Check result from SDL_PollEvents, expected: 0-%d, got: %d", (int)SDL_arraysize(events), result);
+      for (i = 0; i < result; ++i) {
+         if (events[i].type == SDL_USEREVENT) {
+            if (events[i].user.code != received) {
+               ++outOfOrder;
+            }
+            ++received;
+         }
+      }
+   } while (result > 0);
+
+   SDLTest_AssertCheck(received == 10, "Check number of received user events, expected: 10, got: %d", received);
+   SDLTest_AssertCheck(outOfOrder == 0, "Check that events arrived in order, got %d out of order", outOfOrder);
+
+   result = SDL_PollEvents(NULL, 1);
+   SDLTest_AssertCheck(result == -1, "Check result from SDL_PollEvents with NULL array, expected: -1, got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Checks that motion events are merged while queued when coalescing is enabled.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_COALESCING
+ */
+int
+events_coalesceMotionEvents(void *arg)
+{
+   SDL_Event event;
+   int i, result;
+
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "1");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"1\")");
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* Three motion events from the same mouse become one */
+   for (i = 1; i <= 3; ++i) {
+      SDL_zero(event);
+      event.type = SDL_MOUSEMOTION;
+      event.motion.which = 1;
+      event.motion.x = i * 10;
+      event.motion.y = i * 20;
+      event.motion.xrel = i;
+      event.motion.yrel = -i;
+      SDL_PushEvent(&event);
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent()");
+
+   /* A different mouse isn't merged */
+   event.motion.which = 2;
+   SDL_PushEvent(&event);
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 2, "Check number of queued motion events, expected: 2, got: %d", result);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 1, "Check result from SDL_PeepEvents, expected: 1, got: %d", result);
+   SDLTest_AssertCheck(event.motion.x == 30 && event.motion.y == 60, "Check merged position, expected: 30,60, got: %d,%d", event.motion.x, event.motion.y);
+   SDLTest_AssertCheck(event.motion.xrel == 6 && event.motion.yrel == -6, "Check merged relative motion, expected: 6,-6, got: %d,%d", event.motion.xrel, event.motion.yrel);
+
+   /* With coalescing disabled every event is queued separately */
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "0");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"0\")");
+
+   for (i = 0; i < 3; ++i) {
+      SDL_PushEvent(&event);
+   }
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 3, "Check number of queued motion events without coalescing, expected: 3, got: %d", result);
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   return TEST_COMPLETED;
+}
+
+
+/**
+ * @brief Checks that an unread event at the front of the queue doesn't stop events behind it from being recycled.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_peepPastUnreadEvent(void *arg)
+{
+   SDL_Event event;
+   int i, result, failed = 0;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* This one is never read by the filtered calls below */
+   SDL_zero(event);
+   event.type = SDL_USEREVENT + 1;
+   result = SDL_PushEvent(&event);
+   SDLTest_AssertCheck(result == 1, "Check result from SDL_PushEvent, expected: 1, got: %d", result);
+
+   /* More events than the queue holds go past it one at a time */
+   event.type = SDL_USEREVENT;
+   for (i = 0; i < 200000; ++i) {
+      if (SDL_PushEvent(&event) != 1 ||
+          SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT) != 1) {
+         ++failed;
+      }
+   }
+   SDLTest_AssertCheck(failed == 0, "Check pushing and getting events past an unread one, expected: 0 failures, got: %d", failed);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_USEREVENT + 1, "Check the unread event is still queued, expected: 1 event of type %d, got: %d of type %d", (int)SDL_USEREVENT + 1, result, (int)event.type);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Pushes more events than the queue starts out with from several threads
+ *        before reading any of them, and checks they all arrive in order.
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_growQueueFromMultipleThreads(void *arg)
+{
+   SDL_Thread *threads[_EVENTS_NUM_PRODUCERS];
+   int next[_EVENTS_NUM_PRODUCERS];
+   SDL_Event event;
+   int i, result, received = 0, outOfOrder = 0;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   /* An unread event at the front has to move along with the others */
+   SDL_zero(event);
+   event.type = SDL_USEREVENT + 1;
+   result = SDL_PushEvent(&event);
+   SDLTest_AssertCheck(result == 1, "Check result from SDL_PushEvent, expected: 1, got: %d", result);
+
+   for (i = 0; i < _EVENTS_NUM_PRODUCERS; ++i) {
+      next[i] = 0;
+      threads[i] = SDL_CreateThread(_events_producerThread, "EventProducer", (void *)(intptr_t)i);
+      SDLTest_AssertCheck(threads[i] != NULL, "Check that producer thread %d was created", i);
+   }
+   for (i = 0; i < _EVENTS_NUM_PRODUCERS; ++i) {
+      SDL_WaitThread(threads[i], NULL);
+   }
+
+   result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_USEREVENT, SDL_USEREVENT);
+   SDLTest_AssertCheck(result == _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER, "Check number of queued events, expected: %d, got: %d", _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER, result);
+
+   while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT) == 1) {
+      i = (int)(intptr_t)event.user.data1;
+      if (i < 0 || i >= _EVENTS_NUM_PRODUCERS || event.user.code != next[i]) {
+         ++outOfOrder;
+      } else {
+         ++next[i];
+      }
+      ++received;
+   }
+   SDLTest_AssertCheck(received == _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER, "Check number of received events, expected: %d, got: %d", _EVENTS_NUM_PRODUCERS * _EVENTS_PER_PRODUCER, received);
+   SDLTest_AssertCheck(outOfOrder == 0, "Check that events arrived in order, got %d out of order", outOfOrder);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_USEREVENT + 1, "Check the unread event is still queued, expected: 1 event of type %d, got: %d of type %d", (int)SDL_USEREVENT + 1, result, (int)event.type);
+
+   return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -187,9 +495,27 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_pushFromMultipleThreads, "events_pushFromMultipleThreads", "Pushes user events from several threads at once", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_flushFromMiddleOfQueue, "events_flushFromMiddleOfQueue", "Flushes events from the middle of the queue", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest6 =
+        { (SDLTest_TestCaseFp)events_pollMultipleEvents, "events_pollMultipleEvents", "Polls several events with a single call", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest7 =
+        { (SDLTest_TestCaseFp)events_coalesceMotionEvents, "events_coalesceMotionEvents", "Merges motion events while they are queued", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest8 =
+        { (SDLTest_TestCaseFp)events_peepPastUnreadEvent, "events_peepPastUnreadEvent", "Gets events queued behind an unread one", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest9 =
+        { (SDLTest_TestCaseFp)events_growQueueFromMultipleThreads, "events_growQueueFromMultipleThreads", "Queues more events than the queue starts with from several threads", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, &eventsTest7, &eventsTest8, &eventsTest9, NULL
 };
 
 /* Events test suite (global) */
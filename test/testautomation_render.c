@@ -765,6 +765,929 @@ render_testBlitBlend (void *arg)
    return TEST_COMPLETED;
 }
 
+/* Draws the same scene with the software renderer, on the given number of threads */
+static SDL_Surface *
+_renderSoftwareScene(const char *threads)
+{
+   SDL_Surface *target, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_Rect viewport = { 20, 10, 280, 200 };
+   SDL_Rect cliprect = { 40, 30, 150, 120 };
+   int i;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return NULL;
+   }
+
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads);
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return NULL;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   for (i = 0; i < 200; ++i) {
+      const int x = (i * 37) % 360 - 20;
+      const int y = (i * 53) % 280 - 20;
+      SDL_Rect rect;
+
+      if (i == 50) {
+         SDL_RenderSetViewport(swrenderer, &viewport);
+      } else if (i == 100) {
+         SDL_RenderSetClipRect(swrenderer, &cliprect);
+      } else if (i == 120) {
+         /* The rest goes through the worker surfaces kept from this flush */
+         SDL_RenderFlush(swrenderer);
+      } else if (i == 150) {
+         SDL_RenderSetClipRect(swrenderer, NULL);
+         SDL_RenderSetViewport(swrenderer, NULL);
+      }
+
+      rect.x = x;
+      rect.y = y;
+      rect.w = 10 + (i * 7) % 90;
+      rect.h = 10 + (i * 11) % 70;
+      SDL_SetRenderDrawBlendMode(swrenderer, (i % 2) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+      SDL_SetRenderDrawColor(swrenderer, (i * 5) & 0xFF, (i * 9) & 0xFF, (i * 13) & 0xFF, (i * 17) & 0xFF);
+      switch (i % 6) {
+      case 0:
+         SDL_RenderFillRect(swrenderer, &rect);
+         break;
+      case 1:
+         SDL_RenderDrawRect(swrenderer, &rect);
+         break;
+      case 2:
+         SDL_RenderDrawLine(swrenderer, x, y, x + rect.w, y + rect.h);
+         break;
+      case 3:
+         SDL_RenderDrawPoint(swrenderer, x, y);
+         break;
+      case 4:
+         SDL_SetTextureAlphaMod(tface, (i * 17) & 0xFF);
+         SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+         SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+         break;
+      case 5:
+         rect.w = TESTRENDER_SCREEN_W;
+         rect.h = TESTRENDER_SCREEN_H;
+         SDL_SetTextureColorMod(tface, (i * 5) & 0xFF, 255, (i * 13) & 0xFF);
+         SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+         break;
+      }
+   }
+   SDL_RenderPresent(swrenderer);
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   return target;
+}
+
+/**
+ * @brief Tests that rendering tiles in parallel with the software renderer
+ * draws the same pixels as rendering on one thread.
+ */
+int
+render_testSoftwareThreads (void *arg)
+{
+   SDL_Surface *serial, *threaded;
+   int ret;
+
+   serial = _renderSoftwareScene("0");
+   threaded = _renderSoftwareScene("4");
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, NULL);
+
+   if (serial && threaded) {
+      ret = SDLTest_CompareSurfaces(threaded, serial, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   }
+
+   SDL_FreeSurface(serial);
+   SDL_FreeSurface(threaded);
+   return TEST_COMPLETED;
+}
+
+
+/* Draws rectangles and textured rectangles with the software renderer, either
+   with the usual functions or as two triangles each with SDL_RenderGeometry() */
+static SDL_Surface *
+_renderSoftwareQuads(SDL_bool geometry)
+{
+   static const int indices[6] = { 0, 1, 2, 2, 1, 3 };
+   SDL_Surface *target, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_Vertex verts[4];
+   int i, j;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return NULL;
+   }
+
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return NULL;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   for (i = 0; i < 60; ++i) {
+      SDL_Texture *texture = (i % 2) ? tface : NULL;
+      SDL_Rect rect;
+
+      /* A grid of cells hanging over the edges, so rounding differences don't add up */
+      rect.x = (i % 10) * 34 - 10;
+      rect.y = (i / 10) * 42 - 10;
+      if (texture) {
+         /* Scaled copies sample the texture differently, so keep it 1:1 */
+         SDL_QueryTexture(texture, NULL, NULL, &rect.w, &rect.h);
+      } else {
+         rect.w = 10 + (i * 7) % 24;
+         rect.h = 10 + (i * 11) % 32;
+      }
+      SDL_SetRenderDrawBlendMode(swrenderer, (i % 3) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+      SDL_SetRenderDrawColor(swrenderer, (i * 5) & 0xFF, (i * 9) & 0xFF, (i * 13) & 0xFF, (i * 17) & 0xFF);
+      SDL_SetTextureAlphaMod(tface, (i * 17) & 0xFF);
+      SDL_SetTextureColorMod(tface, (i * 5) & 0xFF, 255, (i * 13) & 0xFF);
+      SDL_SetTextureBlendMode(tface, (i % 3) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_ADD);
+
+      if (!geometry) {
+         if (texture) {
+            SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+         } else {
+            SDL_RenderFillRect(swrenderer, &rect);
+         }
+         continue;
+      }
+
+      for (j = 0; j < 4; ++j) {
+         verts[j].position.x = (float) (rect.x + ((j & 1) ? rect.w : 0));
+         verts[j].position.y = (float) (rect.y + ((j & 2) ? rect.h : 0));
+         verts[j].tex_coord.x = (j & 1) ? 1.0f : 0.0f;
+         verts[j].tex_coord.y = (j & 2) ? 1.0f : 0.0f;
+         if (texture) {
+            verts[j].color.r = verts[j].color.g = verts[j].color.b = verts[j].color.a = 255;
+         } else {
+            SDL_GetRenderDrawColor(swrenderer, &verts[j].color.r, &verts[j].color.g, &verts[j].color.b, &verts[j].color.a);
+         }
+      }
+      SDL_RenderGeometry(swrenderer, texture, verts, 4, indices, 6);
+   }
+   SDL_RenderPresent(swrenderer);
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   return target;
+}
+
+/**
+ * @brief Tests SDL_RenderGeometry with the software renderer, quads made of
+ * two triangles have to match SDL_RenderFillRect and SDL_RenderCopy.
+ */
+int
+render_testGeometry (void *arg)
+{
+   static const int bad_indices[3] = { 0, 1, 3 };
+   static const Uint32 ramp[2] = { 0xFF000000, 0xFFFFFFFF };
+   static const int indices[6] = { 0, 1, 2, 2, 1, 3 };
+   SDL_Surface *expected, *actual, *ramp_surface;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tramp;
+   SDL_Vertex verts[4];
+   Uint8 r[4], g, b;
+   int ret, i;
+
+   expected = _renderSoftwareQuads(SDL_FALSE);
+   actual = _renderSoftwareQuads(SDL_TRUE);
+
+   if (expected && actual) {
+      /* Blending goes through different blitters, which may round differently */
+      ret = SDLTest_CompareSurfaces(actual, expected, 3);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   }
+
+   /* Invalid parameters */
+   swrenderer = actual ? SDL_CreateSoftwareRenderer(actual) : NULL;
+   if (swrenderer) {
+      SDL_zeroa(verts);
+      ret = SDL_RenderGeometry(swrenderer, NULL, verts, 3, NULL, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate SDL_RenderGeometry with 3 vertices, expected: 0, got: %i", ret);
+      ret = SDL_RenderGeometry(swrenderer, NULL, verts, 2, NULL, 0);
+      SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with 2 vertices, expected: -1, got: %i", ret);
+      ret = SDL_RenderGeometry(swrenderer, NULL, verts, 3, bad_indices, 3);
+      SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with an index out of range, expected: -1, got: %i", ret);
+      ret = SDL_RenderGeometry(swrenderer, NULL, NULL, 3, NULL, 0);
+      SDLTest_AssertCheck(ret == -1, "Validate SDL_RenderGeometry with NULL vertices, expected: -1, got: %i", ret);
+
+      /* A black to white texture stretched over 4 pixels, linear filtering blends the middle two */
+      ramp_surface = SDL_CreateRGBSurfaceWithFormatFrom((void *) ramp, 2, 1, 32, sizeof (ramp), SDL_PIXELFORMAT_ARGB8888);
+      tramp = ramp_surface ? SDL_CreateTextureFromSurface(swrenderer, ramp_surface) : NULL;
+      SDL_FreeSurface(ramp_surface);
+      SDLTest_AssertCheck(tramp != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      if (tramp) {
+         SDL_SetTextureScaleMode(tramp, SDL_ScaleModeLinear);
+         SDL_SetTextureBlendMode(tramp, SDL_BLENDMODE_NONE);
+         for (i = 0; i < 4; ++i) {
+            verts[i].position.x = (float) ((i & 1) ? 4 : 0);
+            verts[i].position.y = (float) ((i & 2) ? 1 : 0);
+            verts[i].tex_coord.x = (i & 1) ? 1.0f : 0.0f;
+            verts[i].tex_coord.y = (i & 2) ? 1.0f : 0.0f;
+            verts[i].color.r = verts[i].color.g = verts[i].color.b = verts[i].color.a = 255;
+         }
+         SDL_RenderSetViewport(swrenderer, NULL);
+         SDL_RenderGeometry(swrenderer, tramp, verts, 4, indices, 6);
+         SDL_RenderPresent(swrenderer);
+         for (i = 0; i < 4; ++i) {
+            SDL_GetRGB(((Uint32 *) actual->pixels)[i], actual->format, &r[i], &g, &b);
+         }
+         SDLTest_AssertCheck(r[0] == 0 && r[1] > 0 && r[1] < r[2] && r[2] < 255 && r[3] == 255,
+                             "Validate linear filtering, expected: 0 < %d < %d < 255", r[1], r[2]);
+         SDL_DestroyTexture(tramp);
+      }
+      SDL_DestroyRenderer(swrenderer);
+   }
+
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(actual);
+   return TEST_COMPLETED;
+}
+
+/* Draws sprites from the test face with the software renderer, one at a time or as a batch */
+static SDL_Surface *
+_renderSoftwareSprites(SDL_bool batch)
+{
+   SDL_Surface *target, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_Rect srcrects[100];
+   SDL_FRect dstrects[100];
+   int i;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return NULL;
+   }
+
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return NULL;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   /* Pieces of the face, some scaled, some overlapping and some off the edges */
+   for (i = 0; i < SDL_arraysize(srcrects); ++i) {
+      srcrects[i].x = (i * 7) % 32 - 4;
+      srcrects[i].y = (i * 11) % 32 - 4;
+      srcrects[i].w = 4 + (i * 5) % 40;
+      srcrects[i].h = 4 + (i * 3) % 40;
+      dstrects[i].x = (float) ((i * 37) % 360 - 20);
+      dstrects[i].y = (float) ((i * 53) % 280 - 20);
+      dstrects[i].w = (float) ((i % 4) ? srcrects[i].w : srcrects[i].w * 2);
+      dstrects[i].h = (float) ((i % 4) ? srcrects[i].h : srcrects[i].h * 3);
+   }
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+   SDL_SetTextureColorMod(tface, 200, 255, 100);
+   if (batch) {
+      SDL_RenderCopyBatchF(swrenderer, tface, srcrects, dstrects, SDL_arraysize(srcrects));
+      SDL_RenderCopyBatchF(swrenderer, tface, NULL, dstrects, 10);
+
+      /* Too many rects to allocate the scratch arrays for, nothing is read or drawn */
+      i = SDL_RenderCopyBatchF(swrenderer, tface, srcrects, dstrects, SDL_MAX_SINT32);
+      SDLTest_AssertCheck(i == -1, "Validate result from SDL_RenderCopyBatchF with a huge count, expected: -1, got: %i", i);
+   } else {
+      for (i = 0; i < SDL_arraysize(srcrects); ++i) {
+         SDL_RenderCopyF(swrenderer, tface, &srcrects[i], &dstrects[i]);
+      }
+      for (i = 0; i < 10; ++i) {
+         SDL_RenderCopyF(swrenderer, tface, NULL, &dstrects[i]);
+      }
+   }
+   SDL_RenderPresent(swrenderer);
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   return target;
+}
+
+/**
+ * @brief Tests that SDL_RenderCopyBatchF draws the same pixels as SDL_RenderCopyF
+ * with the software renderer.
+ */
+int
+render_testCopyBatch (void *arg)
+{
+   SDL_Surface *expected, *actual;
+   int ret;
+
+   expected = _renderSoftwareSprites(SDL_FALSE);
+   actual = _renderSoftwareSprites(SDL_TRUE);
+
+   if (expected && actual) {
+      ret = SDLTest_CompareSurfaces(actual, expected, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   }
+
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(actual);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Draws a scene that interleaves textures, colors and draw types with the
+ * software renderer on a window, optionally letting SDL reorder and merge the batch.
+ */
+static SDL_Surface *
+_renderSoftwareBatch(SDL_bool optimize)
+{
+   SDL_Window *swwindow;
+   SDL_Renderer *swrenderer;
+   SDL_Surface *target = NULL, *face;
+   SDL_Texture *tface, *tface2;
+   SDL_Vertex verts[3];
+   SDL_FPoint points[8];
+   SDL_FRect rect;
+   SDL_Rect viewport = { 20, 20, 280, 200 };
+   int i, ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   SDL_SetHint(SDL_HINT_RENDER_OPTIMIZE_BATCHES, optimize ? "1" : "0");
+   swwindow = SDL_CreateWindow("render_testOptimizeBatches", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 320, 240, 0);
+   SDLTest_AssertCheck(swwindow != NULL, "Verify result from SDL_CreateWindow is not NULL");
+   swrenderer = swwindow ? SDL_CreateRenderer(swwindow, -1, SDL_RENDERER_SOFTWARE) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateRenderer is not NULL");
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, NULL);
+   SDL_SetHint(SDL_HINT_RENDER_OPTIMIZE_BATCHES, NULL);
+   if (swrenderer == NULL) {
+      if (swwindow) {
+         SDL_DestroyWindow(swwindow);
+      }
+      return NULL;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   tface2 = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL && tface2 != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+   SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+   SDL_SetTextureColorMod(tface2, 255, 128, 64);
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+
+   /* Alternate textures, colors and draw types, some of the draws overlap */
+   for (i = 0; i < 60; ++i) {
+      rect.x = (float) ((i * 37) % 300 - 10);
+      rect.y = (float) ((i * 53) % 220 - 10);
+      rect.w = (float) (8 + (i * 7) % 40);
+      rect.h = (float) (8 + (i * 11) % 40);
+      switch (i % 6) {
+      case 0:
+         SDL_RenderCopyF(swrenderer, tface, NULL, &rect);
+         break;
+      case 1:
+         SDL_SetRenderDrawColor(swrenderer, 255, 0, 0, 128);
+         SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_BLEND);
+         SDL_RenderFillRectF(swrenderer, &rect);
+         break;
+      case 2:
+         SDL_RenderCopyF(swrenderer, tface2, NULL, &rect);
+         break;
+      case 3:
+         SDL_SetRenderDrawColor(swrenderer, 0, 255, 0, SDL_ALPHA_OPAQUE);
+         SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_NONE);
+         SDL_RenderFillRectF(swrenderer, &rect);
+         points[0].x = rect.x;
+         points[0].y = rect.y + rect.h;
+         points[1].x = rect.x + rect.w;
+         points[1].y = rect.y;
+         SDL_RenderDrawLinesF(swrenderer, points, 2);
+         SDL_RenderDrawPointsF(swrenderer, points, 2);
+         break;
+      case 4:
+         verts[0].position.x = rect.x;
+         verts[0].position.y = rect.y;
+         verts[1].position.x = rect.x + rect.w;
+         verts[1].position.y = rect.y;
+         verts[2].position.x = rect.x;
+         verts[2].position.y = rect.y + rect.h;
+         verts[0].color.r = verts[1].color.g = verts[2].color.b = 255;
+         verts[0].color.g = verts[0].color.b = verts[1].color.r = 0;
+         verts[1].color.b = verts[2].color.r = verts[2].color.g = 0;
+         verts[0].color.a = verts[1].color.a = verts[2].color.a = 255;
+         SDL_RenderGeometry(swrenderer, NULL, verts, 3, NULL, 0);
+         break;
+      default:
+         SDL_RenderCopyExF(swrenderer, tface, NULL, &rect, i * 10.0, NULL, SDL_FLIP_NONE);
+         break;
+      }
+      if (i == 30) {
+         /* Nothing may move across a viewport change */
+         SDL_RenderSetViewport(swrenderer, &viewport);
+      }
+   }
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target) {
+      ret = SDL_RenderReadPixels(swrenderer, NULL, target->format->format, target->pixels, target->pitch);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   }
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyTexture(tface2);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_DestroyWindow(swwindow);
+   return target;
+}
+
+/**
+ * @brief Tests that SDL_HINT_RENDER_OPTIMIZE_BATCHES doesn't change what the
+ * software renderer draws.
+ */
+int
+render_testOptimizeBatches (void *arg)
+{
+   SDL_Surface *expected, *actual;
+   int ret;
+
+   expected = _renderSoftwareBatch(SDL_FALSE);
+   actual = _renderSoftwareBatch(SDL_TRUE);
+
+   if (expected && actual) {
+      ret = SDLTest_CompareSurfaces(actual, expected, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+   }
+
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(actual);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that SDL_GetRenderStats reports the work done for the last presented frame.
+ */
+int
+render_testRenderStats (void *arg)
+{
+   SDL_Surface *target, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_RenderStats stats;
+   SDL_Rect rect = { 10, 10, 32, 32 };
+   int ret;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return TEST_ABORTED;
+   }
+
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   ret = SDL_GetRenderStats(swrenderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_GetRenderStats with NULL stats, expected: -1, got: %i", ret);
+
+   /* Nothing presented yet */
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.flushes == 0 && stats.commands == 0 && stats.draw_calls == 0,
+                       "Validate that no work was reported before the first present");
+
+   SDL_RenderClear(swrenderer);
+   SDL_RenderFillRect(swrenderer, &rect);
+   SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+   rect.x += 40;
+   SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+
+   /* The frame isn't done until it is presented */
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.draw_calls == 0, "Validate draw calls before present, expected: 0, got: %u", (unsigned int) stats.draw_calls);
+
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.flushes >= 1, "Validate flushes, expected: >= 1, got: %u", (unsigned int) stats.flushes);
+   SDLTest_AssertCheck(stats.commands >= 4, "Validate commands, expected: >= 4, got: %u", (unsigned int) stats.commands);
+   SDLTest_AssertCheck(stats.draw_calls == 4, "Validate draw calls, expected: 4, got: %u", (unsigned int) stats.draw_calls);
+   SDLTest_AssertCheck(stats.texture_switches == 1, "Validate texture switches, expected: 1, got: %u", (unsigned int) stats.texture_switches);
+   SDLTest_AssertCheck(stats.vertex_bytes > 0, "Validate that vertex data was counted");
+
+   /* An empty frame resets the counters */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.flushes == 0 && stats.commands == 0 && stats.draw_calls == 0 && stats.vertex_bytes == 0,
+                       "Validate that an empty frame reports no work");
+
+   /* A new texture counts as a switch, even when it got the address of a destroyed one */
+   SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+   SDL_DestroyTexture(tface);
+   tface = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   SDL_RenderCopy(swrenderer, tface, NULL, &rect);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_GetRenderStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.texture_switches == 2, "Validate texture switches, expected: 2, got: %u", (unsigned int) stats.texture_switches);
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests packing, drawing, removing and defragmenting images in a texture atlas.
+ */
+int
+render_testTextureAtlas (void *arg)
+{
+   SDL_Surface *target, *image;
+   SDL_Renderer *swrenderer;
+   SDL_TextureAtlas *atlas;
+   SDL_Texture *texture, *other;
+   SDL_Rect rect, other_rect;
+   int ids[24];
+   int i, j, ret;
+   Uint32 pixel;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return TEST_ABORTED;
+   }
+
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   atlas = SDL_CreateTextureAtlas(swrenderer, RENDER_COMPARE_FORMAT, 64, 64);
+   SDLTest_AssertCheck(atlas != NULL, "Verify result from SDL_CreateTextureAtlas is not NULL");
+   if (atlas == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   /* Solid images of different sizes and colors, more than fit in one texture */
+   for (i = 0; i < SDL_arraysize(ids); ++i) {
+      image = SDL_CreateRGBSurfaceWithFormat(0, 4 + (i * 7) % 20, 4 + (i * 5) % 16, 32, SDL_PIXELFORMAT_ARGB8888);
+      SDL_FillRect(image, NULL, SDL_MapRGB(image->format, (Uint8) (i * 10), 255 - i, 128));
+      ids[i] = SDL_AddTextureAtlasImage(atlas, image);
+      SDL_FreeSurface(image);
+      SDLTest_AssertCheck(ids[i] >= 0, "Validate result from SDL_AddTextureAtlasImage, expected: >= 0, got: %i", ids[i]);
+   }
+
+   image = SDL_CreateRGBSurfaceWithFormat(0, 65, 8, 32, RENDER_COMPARE_FORMAT);
+   ret = SDL_AddTextureAtlasImage(atlas, image);
+   SDL_FreeSurface(image);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_AddTextureAtlasImage with an image larger than the atlas, expected: -1, got: %i", ret);
+
+   for (j = 0; j < 2; ++j) {
+      for (i = 0; i < SDL_arraysize(ids); ++i) {
+         if (ids[i] < 0) {
+            continue;
+         }
+         ret = SDL_GetTextureAtlasImage(atlas, ids[i], &texture, &rect);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetTextureAtlasImage, expected: 0, got: %i", ret);
+         SDLTest_AssertCheck(rect.w == 4 + (i * 7) % 20 && rect.h == 4 + (i * 5) % 16, "Validate the size of image %i", i);
+
+         /* Images on the same texture never overlap */
+         if (i > 0 && ids[i - 1] >= 0) {
+            SDL_GetTextureAtlasImage(atlas, ids[i - 1], &other, &other_rect);
+            SDLTest_AssertCheck(other != texture || !SDL_HasIntersection(&rect, &other_rect), "Validate that images %i and %i don't overlap", i - 1, i);
+         }
+
+         /* Every pixel drawn from the atlas has the image color */
+         SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+         SDL_RenderClear(swrenderer);
+         SDL_RenderCopy(swrenderer, texture, &rect, NULL);
+         SDL_RenderPresent(swrenderer);
+         pixel = *(Uint32 *) ((Uint8 *) target->pixels + (target->h - 1) * target->pitch + (target->w - 1) * 4);
+         SDLTest_AssertCheck(pixel == SDL_MapRGB(target->format, (Uint8) (i * 10), 255 - i, 128), "Validate the color of image %i, got: 0x%08x", i, pixel);
+      }
+
+      /* Remove every other image and repack, the rest keeps its pixels */
+      if (j == 0) {
+         for (i = 0; i < SDL_arraysize(ids); i += 2) {
+            ret = SDL_RemoveTextureAtlasImage(atlas, ids[i]);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RemoveTextureAtlasImage, expected: 0, got: %i", ret);
+            ids[i] = -1;
+         }
+         ret = SDL_DefragmentTextureAtlas(atlas);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_DefragmentTextureAtlas, expected: 0, got: %i", ret);
+      }
+   }
+
+   ret = SDL_RemoveTextureAtlasImage(atlas, ids[1] + 1000);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RemoveTextureAtlasImage with an unknown id, expected: -1, got: %i", ret);
+
+   /* An emptied page is reused without the old pixels in the padding of the new image */
+   for (i = 0; i < SDL_arraysize(ids); ++i) {
+      if (ids[i] >= 0) {
+         SDL_RemoveTextureAtlasImage(atlas, ids[i]);
+      }
+   }
+   image = SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 32, RENDER_COMPARE_FORMAT);
+   SDL_FillRect(image, NULL, SDL_MapRGB(image->format, 255, 255, 255));
+   ids[0] = SDL_AddTextureAtlasImage(atlas, image);
+   SDL_FreeSurface(image);
+   ret = SDL_GetTextureAtlasImage(atlas, ids[0], &texture, &rect);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetTextureAtlasImage, expected: 0, got: %i", ret);
+   if (ret == 0) {
+      rect.w += 1;
+      rect.h += 1;
+      SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderer);
+      SDL_RenderCopy(swrenderer, texture, &rect, NULL);
+      SDL_RenderPresent(swrenderer);
+      pixel = *(Uint32 *) ((Uint8 *) target->pixels + (target->h - 1) * target->pitch + (target->w - 1) * 4);
+      SDLTest_AssertCheck(pixel == SDL_MapRGB(target->format, 0, 0, 0), "Validate the padding of a reused page is clear, got: 0x%08x", pixel);
+   }
+
+   SDL_DestroyTextureAtlas(atlas);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
+/* Draws rotated and mirrored copies of the test face with the software renderer, either
+   with SDL_RenderCopyEx() or as two triangles with the same corners with SDL_RenderGeometry(),
+   optionally stretched by a different factor for each copy */
+static SDL_Surface *
+_renderSoftwareRotated(SDL_bool geometry, SDL_bool scaled)
+{
+   static const int indices[6] = { 0, 1, 2, 2, 1, 3 };
+   static const SDL_BlendMode modes[4] = { SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_BLEND };
+   SDL_Surface *target, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_Vertex verts[4];
+   int i, j;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return NULL;
+   }
+
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return NULL;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   for (i = 0; i < 24; ++i) {
+      const double angle = i * 37.0;
+      const SDL_RendererFlip flip = (SDL_RendererFlip) (i % 4);
+      const double radians = angle * M_PI / 180.0;
+      SDL_Rect rect;
+
+      rect.x = (i % 6) * 52 + 8;
+      rect.y = (i / 6) * 58 + 10;
+      SDL_QueryTexture(tface, NULL, NULL, &rect.w, &rect.h);
+      if (scaled) {
+         rect.w = rect.w * (3 + i % 3) / 4;
+         rect.h = rect.h * (3 + (i / 3) % 3) / 4;
+      }
+      SDL_SetTextureAlphaMod(tface, (i * 37) & 0xFF);
+      SDL_SetTextureColorMod(tface, 255, (i * 23) & 0xFF, 255);
+      SDL_SetTextureBlendMode(tface, modes[i % 4]);
+
+      if (!geometry) {
+         SDL_RenderCopyEx(swrenderer, tface, NULL, &rect, angle, NULL, flip);
+         continue;
+      }
+
+      for (j = 0; j < 4; ++j) {
+         const double x = ((j & 1) ? rect.w : 0) - rect.w / 2;
+         const double y = ((j & 2) ? rect.h : 0) - rect.h / 2;
+         verts[j].position.x = (float) (rect.x + rect.w / 2 + x * SDL_cos(radians) - y * SDL_sin(radians));
+         verts[j].position.y = (float) (rect.y + rect.h / 2 + x * SDL_sin(radians) + y * SDL_cos(radians));
+         verts[j].tex_coord.x = ((j & 1) != 0) != ((flip & SDL_FLIP_HORIZONTAL) != 0) ? 1.0f : 0.0f;
+         verts[j].tex_coord.y = ((j & 2) != 0) != ((flip & SDL_FLIP_VERTICAL) != 0) ? 1.0f : 0.0f;
+         verts[j].color.r = verts[j].color.g = verts[j].color.b = verts[j].color.a = 255;
+      }
+      SDL_RenderGeometry(swrenderer, tface, verts, 4, indices, 6);
+   }
+   SDL_RenderPresent(swrenderer);
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   return target;
+}
+
+/**
+ * @brief Tests that rotated copies with the software renderer land on the same
+ * pixels with the same colors as the rotated quad drawn with SDL_RenderGeometry.
+ */
+int
+render_testCopyExTransform (void *arg)
+{
+   SDL_Surface *expected, *actual;
+   int ret;
+
+   /* Pixel centers right on an edge or between two texels may go either way,
+      which is about 50 pixels along the edges of the 24 copies */
+   expected = _renderSoftwareRotated(SDL_TRUE, SDL_FALSE);
+   actual = _renderSoftwareRotated(SDL_FALSE, SDL_FALSE);
+   if (expected && actual) {
+      ret = SDLTest_CompareSurfaces(actual, expected, 3);
+      SDLTest_AssertCheck(ret <= 60, "Validate result from SDLTest_CompareSurfaces, expected: <= 60, got: %i", ret);
+   }
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(actual);
+
+   expected = _renderSoftwareRotated(SDL_TRUE, SDL_TRUE);
+   actual = _renderSoftwareRotated(SDL_FALSE, SDL_TRUE);
+   if (expected && actual) {
+      ret = SDLTest_CompareSurfaces(actual, expected, 3);
+      SDLTest_AssertCheck(ret <= 60, "Validate scaled result from SDLTest_CompareSurfaces, expected: <= 60, got: %i", ret);
+   }
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(actual);
+   return TEST_COMPLETED;
+}
+
+/* Checks that every pixel that differs between the surfaces is inside one of the rects */
+static int
+_countPixelsOutsideRects(SDL_Surface *a, SDL_Surface *b, const SDL_Rect *rects, int num_rects)
+{
+   int x, y, i, outside = 0;
+
+   for (y = 0; y < a->h; ++y) {
+      const Uint32 *pa = (const Uint32 *) ((const Uint8 *) a->pixels + y * a->pitch);
+      const Uint32 *pb = (const Uint32 *) ((const Uint8 *) b->pixels + y * b->pitch);
+      for (x = 0; x < a->w; ++x) {
+         if (pa[x] != pb[x]) {
+            SDL_Point p;
+            p.x = x;
+            p.y = y;
+            for (i = 0; i < num_rects; ++i) {
+               if (SDL_PointInRect(&p, &rects[i])) {
+                  break;
+               }
+            }
+            if (i == num_rects) {
+               ++outside;
+            }
+         }
+      }
+   }
+   return outside;
+}
+
+/**
+ * @brief Tests the damage rectangles collected by the software renderer.
+ */
+int
+render_testDamageRects (void *arg)
+{
+   SDL_Surface *target, *before, *face;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *tface;
+   SDL_Rect rects[16];
+   SDL_Rect rect1 = { 10, 10, 20, 20 };
+   SDL_Rect rect2 = { 200, 150, 30, 10 };
+   SDL_Point center = { 4, 30 };
+   int ret, outside;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 32, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return TEST_ABORTED;
+   }
+
+   /* Off by default, every present updates everything */
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   SDL_RenderFillRect(swrenderer, &rect1);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 1 && rects[0].w == 320 && rects[0].h == 240, "Validate that the whole output is presented by default");
+   SDL_DestroyRenderer(swrenderer);
+
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_DAMAGE, "1");
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_DAMAGE, NULL);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   face = SDLTest_ImageFace();
+   tface = SDL_CreateTextureFromSurface(swrenderer, face);
+   SDL_FreeSurface(face);
+   SDLTest_AssertCheck(tface != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+
+   /* The first present updates everything */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 1, "Validate result from SDL_RenderGetDamageRects, expected: 1, got: %i", ret);
+   SDLTest_AssertCheck(rects[0].x == 0 && rects[0].y == 0 && rects[0].w == 320 && rects[0].h == 240, "Validate that the whole output was presented");
+
+   /* Two separate fills */
+   SDL_SetRenderDrawColor(swrenderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderFillRect(swrenderer, &rect1);
+   SDL_RenderFillRect(swrenderer, &rect2);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 2, "Validate result from SDL_RenderGetDamageRects, expected: 2, got: %i", ret);
+   SDLTest_AssertCheck(ret == 2 && SDL_RectEquals(&rects[0], &rect1) && SDL_RectEquals(&rects[1], &rect2), "Validate the damage rects of two fills");
+
+   /* Overlapping draws are merged */
+   SDL_RenderFillRect(swrenderer, &rect1);
+   rect1.x += 10;
+   SDL_RenderFillRect(swrenderer, &rect1);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 1, "Validate result from SDL_RenderGetDamageRects, expected: 1, got: %i", ret);
+   SDLTest_AssertCheck(rects[0].x == 0 + 10 && rects[0].w == 30, "Validate the merged damage rect, got: x=%i, w=%i", rects[0].x, rects[0].w);
+
+   /* Nothing drawn, nothing to present */
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, NULL, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetDamageRects, expected: 0, got: %i", ret);
+
+   /* A rotated copy only changes pixels inside its damage */
+   before = SDL_DuplicateSurface(target);
+   SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+   SDL_RenderCopyEx(swrenderer, tface, NULL, &rect2, 33.0, &center, SDL_FLIP_HORIZONTAL);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret >= 1, "Validate result from SDL_RenderGetDamageRects, expected: >= 1, got: %i", ret);
+   outside = _countPixelsOutsideRects(before, target, rects, SDL_min(ret, SDL_arraysize(rects)));
+   SDLTest_AssertCheck(outside == 0, "Validate that no pixels changed outside the damage, got: %i", outside);
+   SDL_FreeSurface(before);
+
+   /* A clear updates everything */
+   SDL_RenderClear(swrenderer);
+   SDL_RenderPresent(swrenderer);
+   ret = SDL_RenderGetDamageRects(swrenderer, rects, SDL_arraysize(rects));
+   SDLTest_AssertCheck(ret == 1 && rects[0].w == 320 && rects[0].h == 240, "Validate that a clear presents the whole output");
+
+   SDL_DestroyTexture(tface);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
 
 /**
  * @brief Checks to see if functionality is supported. Helper function.
@@ -1085,9 +2008,33 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests rendering tiles in parallel with the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testGeometry, "render_testGeometry", "Tests rendering triangles with SDL_RenderGeometry", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testCopyBatch, "render_testCopyBatch", "Tests copying a batch of sprites with SDL_RenderCopyBatchF", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testOptimizeBatches, "render_testOptimizeBatches", "Tests that reordering and merging render commands doesn't change the output", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest12 =
+        { (SDLTest_TestCaseFp)render_testRenderStats, "render_testRenderStats", "Tests the counters reported by SDL_GetRenderStats", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest13 =
+        { (SDLTest_TestCaseFp)render_testTextureAtlas, "render_testTextureAtlas", "Tests packing images into a texture atlas", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest14 =
+        { (SDLTest_TestCaseFp)render_testDamageRects, "render_testDamageRects", "Tests the damage rectangles of the software renderer", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest15 =
+        { (SDLTest_TestCaseFp)render_testCopyExTransform, "render_testCopyExTransform", "Tests rotated, flipped and scaled copies with the software renderer against SDL_RenderGeometry", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, &renderTest15, NULL
 };
 
 /* Render test suite (global) */
@@ -589,6 +589,405 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * @brief Tests that converting large surfaces on several threads gives the same result
+ *
+ * @sa SDL_HINT_SURFACE_CONVERSION_THREADS
+ */
+int
+surface_testThreadedConversion(void *arg)
+{
+    Uint32 pixel_formats[] = {
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_BGRA8888,
+    };
+    const int w = 1027, h = 771;
+    SDL_Surface *face, *single, *threaded;
+    Uint32 *pixels;
+    void *single_pixels, *threaded_pixels;
+    int i, x, y, ret;
+
+    /* Create a surface big enough to be split up, with a pattern that shows misplaced rows */
+    face = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL)
+        return TEST_ABORTED;
+    for (y = 0; y < h; ++y) {
+        pixels = (Uint32 *)((Uint8 *)face->pixels + y * face->pitch);
+        for (x = 0; x < w; ++x) {
+            pixels[x] = 0xFF000000 | (y << 12) | (x ^ y);
+        }
+    }
+
+    for (i = 0; i < SDL_arraysize(pixel_formats); ++i) {
+        SDL_SetHint(SDL_HINT_SURFACE_CONVERSION_THREADS, "0");
+        single = SDL_ConvertSurfaceFormat(face, pixel_formats[i], 0);
+        SDLTest_AssertCheck(single != NULL, "Verify single threaded conversion to %s", SDL_GetPixelFormatName(pixel_formats[i]));
+
+        SDL_SetHint(SDL_HINT_SURFACE_CONVERSION_THREADS, "8");
+        threaded = SDL_ConvertSurfaceFormat(face, pixel_formats[i], 0);
+        SDLTest_AssertCheck(threaded != NULL, "Verify threaded conversion to %s", SDL_GetPixelFormatName(pixel_formats[i]));
+
+        if (single && threaded) {
+            ret = SDLTest_CompareSurfaces(threaded, single, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+        }
+        SDL_FreeSurface(single);
+        SDL_FreeSurface(threaded);
+    }
+
+    /* Same again for SDL_ConvertPixels(), which converts through surfaces on the stack */
+    single_pixels = SDL_malloc(w * h * 4);
+    threaded_pixels = SDL_malloc(w * h * 4);
+    if (single_pixels && threaded_pixels) {
+        SDL_SetHint(SDL_HINT_SURFACE_CONVERSION_THREADS, "0");
+        ret = SDL_ConvertPixels(w, h, face->format->format, face->pixels, face->pitch,
+                                SDL_PIXELFORMAT_ABGR8888, single_pixels, w * 4);
+        SDLTest_AssertCheck(ret == 0, "Verify single threaded SDL_ConvertPixels(), expected: 0, got: %i", ret);
+
+        SDL_SetHint(SDL_HINT_SURFACE_CONVERSION_THREADS, "8");
+        ret = SDL_ConvertPixels(w, h, face->format->format, face->pixels, face->pitch,
+                                SDL_PIXELFORMAT_ABGR8888, threaded_pixels, w * 4);
+        SDLTest_AssertCheck(ret == 0, "Verify threaded SDL_ConvertPixels(), expected: 0, got: %i", ret);
+
+        ret = SDL_memcmp(single_pixels, threaded_pixels, w * h * 4);
+        SDLTest_AssertCheck(ret == 0, "Verify threaded SDL_ConvertPixels() output matches");
+    }
+    SDL_free(single_pixels);
+    SDL_free(threaded_pixels);
+
+    SDL_SetHint(SDL_HINT_SURFACE_CONVERSION_THREADS, NULL);
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/* The math of the generated C blitters in SDL_blit_auto.c, one pixel at a time */
+static Uint32
+_referenceAutoBlitPixel(const SDL_PixelFormat *sf, const SDL_PixelFormat *df, int flags,
+                        Uint32 mr, Uint32 mg, Uint32 mb, Uint32 ma, Uint32 s, Uint32 d)
+{
+    Uint32 srcR = (s >> sf->Rshift) & 0xFF;
+    Uint32 srcG = (s >> sf->Gshift) & 0xFF;
+    Uint32 srcB = (s >> sf->Bshift) & 0xFF;
+    Uint32 srcA = sf->Amask ? ((s >> sf->Ashift) & 0xFF) : 0xFF;
+    Uint32 dstR = (d >> df->Rshift) & 0xFF;
+    Uint32 dstG = (d >> df->Gshift) & 0xFF;
+    Uint32 dstB = (d >> df->Bshift) & 0xFF;
+    Uint32 dstA = df->Amask ? ((d >> df->Ashift) & 0xFF) : 0xFF;
+    Uint32 result;
+
+    if (mr != 255 || mg != 255 || mb != 255) {
+        srcR = (srcR * mr) / 255;
+        srcG = (srcG * mg) / 255;
+        srcB = (srcB * mb) / 255;
+    }
+    if (ma != 255) {
+        srcA = (srcA * ma) / 255;
+    }
+    if (flags & (SDL_BLENDMODE_BLEND | SDL_BLENDMODE_ADD)) {
+        if (srcA < 255) {
+            srcR = (srcR * srcA) / 255;
+            srcG = (srcG * srcA) / 255;
+            srcB = (srcB * srcA) / 255;
+        }
+    }
+    switch (flags) {
+    case SDL_BLENDMODE_BLEND:
+        dstR = srcR + ((255 - srcA) * dstR) / 255;
+        dstG = srcG + ((255 - srcA) * dstG) / 255;
+        dstB = srcB + ((255 - srcA) * dstB) / 255;
+        dstA = srcA + ((255 - srcA) * dstA) / 255;
+        break;
+    case SDL_BLENDMODE_ADD:
+        dstR = SDL_min(srcR + dstR, 255);
+        dstG = SDL_min(srcG + dstG, 255);
+        dstB = SDL_min(srcB + dstB, 255);
+        break;
+    case SDL_BLENDMODE_MOD:
+        dstR = (srcR * dstR) / 255;
+        dstG = (srcG * dstG) / 255;
+        dstB = (srcB * dstB) / 255;
+        break;
+    case SDL_BLENDMODE_MUL:
+        dstR = SDL_min(((srcR * dstR) + (dstR * (255 - srcA))) / 255, 255);
+        dstG = SDL_min(((srcG * dstG) + (dstG * (255 - srcA))) / 255, 255);
+        dstB = SDL_min(((srcB * dstB) + (dstB * (255 - srcA))) / 255, 255);
+        if (!sf->Amask && mr == 255 && mg == 255 && mb == 255 && ma == 255) {
+            /* The unmodulated blitter treats this like an opaque blend */
+            dstA = 0xFF;
+        } else {
+            dstA = SDL_min(((srcA * dstA) + (dstA * (255 - srcA))) / 255, 255);
+        }
+        break;
+    default:
+        dstR = srcR;
+        dstG = srcG;
+        dstB = srcB;
+        dstA = srcA;
+        break;
+    }
+
+    result = (dstR << df->Rshift) | (dstG << df->Gshift) | (dstB << df->Bshift);
+    if (df->Amask) {
+        result |= dstA << df->Ashift;
+    }
+    return result;
+}
+
+/**
+ * @brief Compares the SIMD versions of the generated blitters with their C math
+ */
+int
+surface_testBlitAutoMatchesReference(void *arg)
+{
+    const Uint32 src_formats[] = {
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888
+    };
+    const Uint32 dst_formats[] = {
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888
+    };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    /* color and alpha modulation, the first entry is no modulation at all */
+    const Uint8 mods[][4] = {
+        { 255, 255, 255, 255 }, { 200, 100, 30, 255 }, { 255, 255, 255, 77 }, { 0, 128, 254, 200 }
+    };
+    /* An odd width exercises the partial vectors at the end of each row */
+    const int w = 37, h = 5;
+    SDL_Surface *src, *dst, *expected;
+    int i, j, k, m, x, y;
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+            for (k = 0; k < SDL_arraysize(modes); ++k) {
+                for (m = 0; m < SDL_arraysize(mods); ++m) {
+                    int mismatches = 0;
+
+                    src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, src_formats[i]);
+                    dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, dst_formats[j]);
+                    expected = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, dst_formats[j]);
+                    SDLTest_AssertCheck(src && dst && expected, "Verify surfaces were created");
+                    if (!src || !dst || !expected) {
+                        SDL_FreeSurface(src);
+                        SDL_FreeSurface(dst);
+                        SDL_FreeSurface(expected);
+                        return TEST_ABORTED;
+                    }
+
+                    /* Plain copies and the blends SDL_blit_A.c handles don't use the generated blitters */
+                    if ((modes[k] == SDL_BLENDMODE_NONE && m == 0) ||
+                        (modes[k] == SDL_BLENDMODE_BLEND && mods[m][0] == 255 &&
+                         (!src->format->Amask || mods[m][3] == 255))) {
+                        SDL_FreeSurface(src);
+                        SDL_FreeSurface(dst);
+                        SDL_FreeSurface(expected);
+                        continue;
+                    }
+
+                    for (y = 0; y < h; ++y) {
+                        Uint32 *s = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+                        Uint32 *d = (Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch);
+                        Uint32 *e = (Uint32 *)((Uint8 *)expected->pixels + y * expected->pitch);
+                        for (x = 0; x < w; ++x) {
+                            s[x] = SDLTest_RandomUint32();
+                            /* Make sure fully transparent and opaque pixels show up */
+                            if (src->format->Amask && (x % 7) == 0) {
+                                s[x] &= ~src->format->Amask;
+                            } else if (src->format->Amask && (x % 7) == 1) {
+                                s[x] |= src->format->Amask;
+                            }
+                            d[x] = SDLTest_RandomUint32() & (dst->format->Rmask | dst->format->Gmask |
+                                                             dst->format->Bmask | dst->format->Amask);
+                            e[x] = _referenceAutoBlitPixel(src->format, dst->format, modes[k],
+                                                           mods[m][0], mods[m][1], mods[m][2], mods[m][3],
+                                                           s[x], d[x]);
+                        }
+                    }
+
+                    SDL_SetSurfaceBlendMode(src, modes[k]);
+                    SDL_SetSurfaceColorMod(src, mods[m][0], mods[m][1], mods[m][2]);
+                    SDL_SetSurfaceAlphaMod(src, mods[m][3]);
+                    SDL_BlitSurface(src, NULL, dst, NULL);
+
+                    for (y = 0; y < h; ++y) {
+                        Uint32 *d = (Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch);
+                        Uint32 *e = (Uint32 *)((Uint8 *)expected->pixels + y * expected->pitch);
+                        for (x = 0; x < w; ++x) {
+                            if (d[x] != e[x]) {
+                                ++mismatches;
+                            }
+                        }
+                    }
+                    SDLTest_AssertCheck(mismatches == 0,
+                                        "Verify %s -> %s, blend mode 0x%x, mod %d,%d,%d,%d matches the C blitter, expected: 0 mismatches, got: %d",
+                                        SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]),
+                                        modes[k], mods[m][0], mods[m][1], mods[m][2], mods[m][3], mismatches);
+
+                    SDL_FreeSurface(src);
+                    SDL_FreeSurface(dst);
+                    SDL_FreeSurface(expected);
+                }
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/* The per-pixel math of the C blitters in SDL_blit_A.c */
+static Uint32
+_referenceBlitAPixel(Uint32 dst_format, int surface_alpha, Uint32 s, Uint32 d)
+{
+    if (dst_format == SDL_PIXELFORMAT_RGB565 || dst_format == SDL_PIXELFORMAT_BGR565) {
+        /* BlitARGBto565PixelAlpha() */
+        unsigned alpha = s >> 27;
+        if (alpha == (SDL_ALPHA_OPAQUE >> 3)) {
+            return (Uint16)((s >> 8 & 0xf800) + (s >> 5 & 0x7e0) + (s >> 3 & 0x1f));
+        } else if (alpha) {
+            s = ((s & 0xfc00) << 11) + (s >> 8 & 0xf800) + (s >> 3 & 0x1f);
+            d = (d | d << 16) & 0x07e0f81f;
+            d += (s - d) * alpha >> 5;
+            d &= 0x07e0f81f;
+            return (Uint16)(d | d >> 16);
+        }
+        return d;
+    } else if (surface_alpha >= 0) {
+        /* BlitRGBtoRGBSurfaceAlpha(), alpha 128 is special cased there but rounds the same */
+        Uint32 alpha = (Uint32)surface_alpha;
+        Uint32 s1 = s & 0xff00ff;
+        Uint32 d1 = d & 0xff00ff;
+        d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+        s &= 0xff00;
+        d &= 0xff00;
+        d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+        return d1 | d | 0xff000000;
+    } else {
+        /* BlitRGBtoRGBPixelAlpha() */
+        Uint32 alpha = s >> 24;
+        if (alpha == SDL_ALPHA_OPAQUE) {
+            return s;
+        } else if (alpha) {
+            Uint32 dalpha = d >> 24;
+            Uint32 s1 = s & 0xff00ff;
+            Uint32 d1 = d & 0xff00ff;
+            d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+            s &= 0xff00;
+            d &= 0xff00;
+            d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+            dalpha = alpha + (dalpha * (alpha ^ 0xFF) >> 8);
+            return d1 | d | (dalpha << 24);
+        }
+        return d;
+    }
+}
+
+/**
+ * @brief Compares the SIMD alpha blending blitters with the C ones they replace
+ */
+int
+surface_testBlitAlphaMatchesReference(void *arg)
+{
+    const struct {
+        Uint32 src_format;
+        Uint32 dst_format;
+        int surface_alpha;
+    } blits[] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, -1 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, -1 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, -1 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, -1 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, -1 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR565, -1 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, 1 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, 77 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, 128 },
+        { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, 200 },
+        { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ABGR8888, 254 },
+    };
+    /* An odd width exercises the partial vectors at the end of each row */
+    const int w = 37, h = 5;
+    SDL_Surface *src, *dst;
+    Uint32 *expected;
+    int i, x, y;
+
+    expected = (Uint32 *)SDL_malloc(w * h * sizeof(*expected));
+    SDLTest_AssertCheck(expected != NULL, "Verify reference buffer was allocated");
+    if (expected == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(blits); ++i) {
+        int mismatches = 0;
+
+        src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, blits[i].src_format);
+        dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, blits[i].dst_format);
+        SDLTest_AssertCheck(src && dst, "Verify surfaces were created");
+        if (!src || !dst) {
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            SDL_free(expected);
+            return TEST_ABORTED;
+        }
+
+        for (y = 0; y < h; ++y) {
+            Uint32 *s = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+            Uint8 *d = (Uint8 *)dst->pixels + y * dst->pitch;
+            for (x = 0; x < w; ++x) {
+                Uint32 dpixel = SDLTest_RandomUint32();
+
+                /* Runs of transparent and opaque pixels take shortcuts */
+                s[x] = SDLTest_RandomUint32() & (src->format->Rmask | src->format->Gmask |
+                                                 src->format->Bmask | src->format->Amask);
+                if (src->format->Amask && (y == 1 || (x % 7) == 0)) {
+                    s[x] &= ~src->format->Amask;
+                } else if (src->format->Amask && (y == 2 || (x % 7) == 1)) {
+                    s[x] |= src->format->Amask;
+                }
+                if (dst->format->BytesPerPixel == 2) {
+                    dpixel &= 0xFFFF;
+                    ((Uint16 *)d)[x] = (Uint16)dpixel;
+                } else {
+                    dpixel &= dst->format->Rmask | dst->format->Gmask |
+                              dst->format->Bmask | dst->format->Amask;
+                    ((Uint32 *)d)[x] = dpixel;
+                }
+                expected[y * w + x] = _referenceBlitAPixel(blits[i].dst_format, blits[i].surface_alpha, s[x], dpixel);
+            }
+        }
+
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        if (blits[i].surface_alpha >= 0) {
+            SDL_SetSurfaceAlphaMod(src, (Uint8)blits[i].surface_alpha);
+        }
+        SDL_BlitSurface(src, NULL, dst, NULL);
+
+        for (y = 0; y < h; ++y) {
+            Uint8 *d = (Uint8 *)dst->pixels + y * dst->pitch;
+            for (x = 0; x < w; ++x) {
+                Uint32 dpixel = (dst->format->BytesPerPixel == 2) ? ((Uint16 *)d)[x] : ((Uint32 *)d)[x];
+                if (dpixel != expected[y * w + x]) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0,
+                            "Verify %s -> %s, surface alpha %d matches the C blitter, expected: 0 mismatches, got: %d",
+                            SDL_GetPixelFormatName(blits[i].src_format), SDL_GetPixelFormatName(blits[i].dst_format),
+                            blits[i].surface_alpha, mismatches);
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+    SDL_free(expected);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -631,11 +1030,20 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testThreadedConversion, "surface_testThreadedConversion", "Tests surface conversion on several threads.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testBlitAutoMatchesReference, "surface_testBlitAutoMatchesReference", "Tests the SIMD generated blitters against their C math.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testBlitAlphaMatchesReference, "surface_testBlitAlphaMatchesReference", "Tests the SIMD alpha blending blitters against the C ones.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15, NULL
 };
 
 /* Surface test suite (global) */
@@ -103,6 +103,39 @@ timer_delayAndGetTicks(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Call to SDL_GetTicksNS, SDL_DelayNS and SDL_DelayUntilNS
+ */
+int
+timer_delayNS(void *arg)
+{
+  const Uint64 testDelay = 500000;
+  const Uint64 marginOfError = 20000000;
+  Uint64 start, result, deadline;
+
+  start = SDL_GetTicksNS();
+  SDLTest_AssertPass("Call to SDL_GetTicksNS()");
+  SDLTest_AssertCheck(start > 0, "Check result from SDL_GetTicksNS(), expected: >0, got: %"SDL_PRIu64, start);
+
+  SDL_DelayNS(testDelay);
+  SDLTest_AssertPass("Call to SDL_DelayNS(%"SDL_PRIu64")", testDelay);
+  result = SDL_GetTicksNS();
+  SDLTest_AssertCheck(result - start >= testDelay, "Check elapsed time, expected: >=%"SDL_PRIu64", got: %"SDL_PRIu64, testDelay, result - start);
+
+  deadline = SDL_GetTicksNS() + 3 * testDelay;
+  SDL_DelayUntilNS(deadline);
+  SDLTest_AssertPass("Call to SDL_DelayUntilNS()");
+  result = SDL_GetTicksNS();
+  SDLTest_AssertCheck(result >= deadline, "Check that SDL_DelayUntilNS() didn't return early, expected: >=%"SDL_PRIu64", got: %"SDL_PRIu64, deadline, result);
+  SDLTest_AssertCheck(result < deadline + marginOfError, "Check that SDL_DelayUntilNS() returned in time, expected: <%"SDL_PRIu64", got: %"SDL_PRIu64, deadline + marginOfError, result);
+
+  /* A deadline in the past returns right away */
+  SDL_DelayUntilNS(start);
+  SDLTest_AssertPass("Call to SDL_DelayUntilNS() with a past deadline");
+
+  return TEST_COMPLETED;
+}
+
 /* Test callback */
 Uint32 SDLCALL _timerTestCallback(Uint32 interval, void *param)
 {
@@ -172,6 +205,112 @@ timer_addRemoveTimer(void *arg)
   return TEST_COMPLETED;
 }
 
+/* Ticks at which each of the ordered timers was due and fired */
+#define _TIMER_NUM_ORDERED 8
+Uint32 _timerDue[_TIMER_NUM_ORDERED];
+Uint32 _timerFired[_TIMER_NUM_ORDERED];
+
+/* Test callback that records when it fired */
+Uint32 SDLCALL _timerRecordCallback(Uint32 interval, void *param)
+{
+   _timerFired[(int)(intptr_t)param] = SDL_GetTicks();
+   return 0;
+}
+
+/**
+ * @brief Call to SDL_AddTimer with intervals spanning more than one turn of the timer wheel
+ */
+int
+timer_addManyTimers(void *arg)
+{
+  const Uint32 intervals[_TIMER_NUM_ORDERED] = { 600, 1, 255, 256, 257, 20, 511, 300 };
+  SDL_TimerID ids[_TIMER_NUM_ORDERED];
+  SDL_bool result;
+  int i;
+
+  for (i = 0; i < _TIMER_NUM_ORDERED; ++i) {
+    _timerFired[i] = 0;
+    _timerDue[i] = SDL_GetTicks() + intervals[i];
+    ids[i] = SDL_AddTimer(intervals[i], _timerRecordCallback, (void *)(intptr_t)i);
+    SDLTest_AssertCheck(ids[i] > 0, "Check result value of SDL_AddTimer(%d, ...), expected: >0, got: %d", intervals[i], ids[i]);
+  }
+
+  /* Cancel one of the long timers before it fires */
+  result = SDL_RemoveTimer(ids[6]);
+  SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+  SDLTest_AssertCheck(result == SDL_TRUE, "Check result value, expected: %i, got: %i", SDL_TRUE, result);
+
+  /* Wait to let all timers trigger */
+  SDL_Delay(1000);
+  SDLTest_AssertPass("Call to SDL_Delay(1000)");
+
+  for (i = 0; i < _TIMER_NUM_ORDERED; ++i) {
+    if (i == 6) {
+      SDLTest_AssertCheck(_timerFired[i] == 0, "Check canceled %d ms timer WAS NOT called", intervals[i]);
+    } else {
+      SDLTest_AssertCheck(_timerFired[i] != 0, "Check %d ms timer WAS called", intervals[i]);
+      SDLTest_AssertCheck((Sint32)(_timerFired[i] - _timerDue[i]) >= 0, "Check %d ms timer was not called early, expected: >=%u, got: %u", intervals[i], _timerDue[i], _timerFired[i]);
+    }
+  }
+
+  return TEST_COMPLETED;
+}
+
+/* Test callback that counts its calls and keeps its interval */
+SDL_atomic_t _timerCountNS;
+Uint64 _timerFirstNS;
+
+Uint64 SDLCALL _timerCountCallbackNS(Uint64 interval, void *param)
+{
+   if (SDL_AtomicIncRef(&_timerCountNS) == 0) {
+      _timerFirstNS = SDL_GetTicksNS();
+   }
+   return interval;
+}
+
+/**
+ * @brief Call to SDL_AddTimerNS with an interval below a millisecond
+ */
+int
+timer_addTimerNS(void *arg)
+{
+  const Uint64 interval = 250000;
+  SDL_TimerID id;
+  SDL_bool result;
+  Uint64 due;
+  int count;
+
+  SDL_AtomicSet(&_timerCountNS, 0);
+  _timerFirstNS = 0;
+  due = SDL_GetTicksNS() + interval;
+  id = SDL_AddTimerNS(interval, _timerCountCallbackNS, NULL);
+  SDLTest_AssertPass("Call to SDL_AddTimerNS(%"SDL_PRIu64", ...)", interval);
+  SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+
+  /* Every 250us for 100ms is up to 400 calls, a millisecond timer would get 100 at most */
+  SDL_Delay(100);
+  SDLTest_AssertPass("Call to SDL_Delay(100)");
+
+  result = SDL_RemoveTimer(id);
+  SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+  SDLTest_AssertCheck(result == SDL_TRUE, "Check result value, expected: %i, got: %i", SDL_TRUE, result);
+  count = SDL_AtomicGet(&_timerCountNS);
+  SDLTest_AssertCheck(count > 150, "Check callback count, expected: >150, got: %d", count);
+  SDLTest_AssertCheck(_timerFirstNS >= due, "Check timer was not called early, expected: >=%"SDL_PRIu64", got: %"SDL_PRIu64, due, _timerFirstNS);
+
+  /* A removed timer stops */
+  SDL_Delay(10);
+  count = SDL_AtomicGet(&_timerCountNS);
+  SDL_Delay(10);
+  SDLTest_AssertCheck(SDL_AtomicGet(&_timerCountNS) == count, "Check callback isn't called after SDL_RemoveTimer(), expected: %d, got: %d", count, SDL_AtomicGet(&_timerCountNS));
+
+  id = SDL_AddTimerNS(interval, NULL, NULL);
+  SDLTest_AssertPass("Call to SDL_AddTimerNS(%"SDL_PRIu64", NULL, NULL)", interval);
+  SDLTest_AssertCheck(id == 0, "Check result value, expected: 0, got: %d", id);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +326,18 @@ static const SDLTest_TestCaseReference timerTest3 =
 static const SDLTest_TestCaseReference timerTest4 =
         { (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference timerTest5 =
+        { (SDLTest_TestCaseFp)timer_addManyTimers, "timer_addManyTimers", "Call to SDL_AddTimer with a range of intervals", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference timerTest6 =
+        { (SDLTest_TestCaseFp)timer_delayNS, "timer_delayNS", "Call to SDL_GetTicksNS, SDL_DelayNS and SDL_DelayUntilNS", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference timerTest7 =
+        { (SDLTest_TestCaseFp)timer_addTimerNS, "timer_addTimerNS", "Call to SDL_AddTimerNS with a sub-millisecond interval", TEST_ENABLED };
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] =  {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, &timerTest7, NULL
 };
 
 /* Timer test suite (global) */
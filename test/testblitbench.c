@@ -0,0 +1,403 @@
+/*
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark of the software blitters.
+
+   Every source format is blitted to every destination format with each of
+   the copy modes below, and the throughput is reported along with the blit
+   function SDL picked for the combination. Use --csv to get results that
+   can be diffed between two builds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define MAX_SIZES   8
+
+typedef enum
+{
+    MODE_COPY,
+    MODE_COLORKEY,
+    MODE_BLEND,
+    MODE_BLEND_ALPHAMOD,
+    MODE_MODULATE,
+    MODE_ADD,
+    MODE_RLE_COLORKEY,
+    MODE_RLE_BLEND,
+    MODE_SCALE,
+    MODE_SCALE_BLEND,
+    NUM_MODES
+} BlitMode;
+
+static const char *mode_names[NUM_MODES] = {
+    "copy",
+    "colorkey",
+    "blend",
+    "blend+alphamod",
+    "colormod",
+    "add",
+    "rle+colorkey",
+    "rle+blend",
+    "scale",
+    "scale+blend"
+};
+
+static const Uint32 src_formats[] = {
+    SDL_PIXELFORMAT_INDEX1MSB,
+    SDL_PIXELFORMAT_INDEX4MSB,
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_RGB888,
+    SDL_PIXELFORMAT_BGR888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_BGRA8888
+};
+
+/* Blitting to less than 8 bits per pixel isn't supported */
+static const Uint32 dst_formats[] = {
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_RGB888,
+    SDL_PIXELFORMAT_BGR888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_BGRA8888
+};
+
+static SDL_bool csv = SDL_FALSE;
+static Uint32 sample_ms = 10;
+static const char *filter = NULL;
+
+/* The blit function SDL picked, as logged by SDL_CalculateBlit() */
+static char chosen_blit[128];
+static SDL_LogOutputFunction default_log;
+static void *default_log_userdata;
+
+static void SDLCALL
+LogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    if (category == SDL_LOG_CATEGORY_VIDEO && SDL_strncmp(message, "blit: ", 6) == 0) {
+        const char *blitter = SDL_strrchr(message, ':');
+        if (blitter) {
+            SDL_strlcpy(chosen_blit, blitter + 2, sizeof(chosen_blit));
+        }
+        return;
+    }
+    if (priority >= SDL_LOG_PRIORITY_INFO) {
+        default_log(default_log_userdata, category, priority, message);
+    }
+}
+
+static Uint32 seed = 1;
+
+static Uint32
+Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8);
+}
+
+static void
+PutPixel(SDL_Surface *surface, int x, int y, Uint32 pixel)
+{
+    Uint8 *p = (Uint8 *)surface->pixels + y * surface->pitch + x * surface->format->BytesPerPixel;
+
+    switch (surface->format->BytesPerPixel) {
+    case 1:
+        *p = (Uint8)pixel;
+        break;
+    case 2:
+        *(Uint16 *)p = (Uint16)pixel;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        p[0] = (Uint8)(pixel >> 16);
+        p[1] = (Uint8)(pixel >> 8);
+        p[2] = (Uint8)pixel;
+#else
+        p[0] = (Uint8)pixel;
+        p[1] = (Uint8)(pixel >> 8);
+        p[2] = (Uint8)(pixel >> 16);
+#endif
+        break;
+    case 4:
+        *(Uint32 *)p = pixel;
+        break;
+    }
+}
+
+/* Fill a surface with something like a sprite: a third of the pixels are
+   transparent (and use the color key), a third are opaque and the rest
+   are translucent.
+ */
+static void
+FillSurface(SDL_Surface *surface, Uint32 colorkey)
+{
+    SDL_PixelFormat *fmt = surface->format;
+    int x, y;
+
+    if (fmt->palette) {
+        SDL_Color *colors = fmt->palette->colors;
+        int i;
+
+        for (i = 0; i < fmt->palette->ncolors; ++i) {
+            colors[i].r = (Uint8)Random();
+            colors[i].g = (Uint8)Random();
+            colors[i].b = (Uint8)Random();
+            colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+        SDL_SetPaletteColors(fmt->palette, colors, 0, fmt->palette->ncolors);
+    }
+
+    if (fmt->BitsPerPixel < 8) {
+        Uint8 *p = (Uint8 *)surface->pixels;
+        int i;
+
+        for (i = 0; i < surface->h * surface->pitch; ++i) {
+            p[i] = (Uint8)Random();
+        }
+        return;
+    }
+
+    for (y = 0; y < surface->h; ++y) {
+        for (x = 0; x < surface->w; ++x) {
+            Uint32 pixel;
+
+            switch (Random() % 3) {
+            case 0:
+                pixel = colorkey;
+                break;
+            case 1:
+                pixel = fmt->palette ? (Random() % fmt->palette->ncolors) :
+                        SDL_MapRGBA(fmt, (Uint8)Random(), (Uint8)Random(), (Uint8)Random(), SDL_ALPHA_OPAQUE);
+                break;
+            default:
+                pixel = fmt->palette ? (Random() % fmt->palette->ncolors) :
+                        SDL_MapRGBA(fmt, (Uint8)Random(), (Uint8)Random(), (Uint8)Random(), (Uint8)Random());
+                break;
+            }
+            PutPixel(surface, x, y, pixel);
+        }
+    }
+}
+
+static void
+SetupMode(SDL_Surface *src, BlitMode mode, Uint32 colorkey)
+{
+    SDL_bool colorkeyed = (mode == MODE_COLORKEY || mode == MODE_RLE_COLORKEY);
+    SDL_bool blended = (mode == MODE_BLEND || mode == MODE_BLEND_ALPHAMOD ||
+                        mode == MODE_RLE_BLEND || mode == MODE_SCALE_BLEND);
+
+    SDL_SetColorKey(src, colorkeyed, colorkey);
+    SDL_SetSurfaceRLE(src, (mode == MODE_RLE_COLORKEY || mode == MODE_RLE_BLEND));
+    SDL_SetSurfaceColorMod(src, 255, 255, 255);
+    SDL_SetSurfaceAlphaMod(src, 255);
+
+    if (mode == MODE_ADD) {
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_ADD);
+    } else if (blended) {
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    } else {
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    }
+
+    if (mode == MODE_MODULATE) {
+        SDL_SetSurfaceColorMod(src, 200, 150, 100);
+    }
+    if (mode == MODE_BLEND_ALPHAMOD || (blended && !src->format->Amask)) {
+        /* Without an alpha channel, blending uses the surface alpha */
+        SDL_SetSurfaceAlphaMod(src, 128);
+    }
+}
+
+static int
+DoBlit(SDL_Surface *src, SDL_Surface *dst, BlitMode mode)
+{
+    if (mode == MODE_SCALE || mode == MODE_SCALE_BLEND) {
+        /* Scale the top left quarter of the source up to the whole destination */
+        SDL_Rect srcrect;
+
+        srcrect.x = 0;
+        srcrect.y = 0;
+        srcrect.w = src->w / 2;
+        srcrect.h = src->h / 2;
+        return SDL_BlitScaled(src, &srcrect, dst, NULL);
+    }
+    return SDL_BlitSurface(src, NULL, dst, NULL);
+}
+
+static void
+RunBenchmark(Uint32 src_format, Uint32 dst_format, BlitMode mode, int w, int h)
+{
+    const char *src_name = SDL_GetPixelFormatName(src_format) + 16;
+    const char *dst_name = SDL_GetPixelFormatName(dst_format) + 16;
+    SDL_Surface *src, *dst;
+    Uint32 colorkey;
+    Uint64 start, elapsed, end;
+    Uint32 iterations = 0;
+    double mpixels;
+    char *function;
+    char name[128];
+
+    SDL_snprintf(name, sizeof(name), "%s->%s %s", src_name, dst_name, mode_names[mode]);
+    if (filter && !SDL_strstr(name, filter)) {
+        return;
+    }
+
+    src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, src_format);
+    dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, dst_format);
+    if (!src || !dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return;
+    }
+
+    colorkey = src->format->palette ? 0 : SDL_MapRGBA(src->format, 255, 0, 255, SDL_ALPHA_TRANSPARENT);
+    FillSurface(src, colorkey);
+    FillSurface(dst, 0);
+    SetupMode(src, mode, colorkey);
+
+    /* The first blit picks the blit function (and encodes RLE surfaces) */
+    SDL_strlcpy(chosen_blit, "SDL_SoftStretch", sizeof(chosen_blit));
+    if (DoBlit(src, dst, mode) < 0) {
+        if (!csv) {
+            printf("%-36s %5dx%-5d unsupported: %s\n", name, w, h, SDL_GetError());
+        }
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    end = start + (SDL_GetPerformanceFrequency() * sample_ms) / 1000;
+    do {
+        DoBlit(src, dst, mode);
+        ++iterations;
+        elapsed = SDL_GetPerformanceCounter();
+    } while (elapsed < end);
+    elapsed -= start;
+
+    mpixels = ((double)w * h * iterations) /
+              ((double)elapsed / SDL_GetPerformanceFrequency()) / 1000000.0;
+
+    function = SDL_strchr(chosen_blit, ' ');
+    if (function) {
+        *function++ = '\0';
+    } else {
+        function = "";
+    }
+    if (csv) {
+        printf("%s,%s,%s,%d,%d,%.2f,%s,%s\n", src_name, dst_name, mode_names[mode],
+               w, h, mpixels, chosen_blit, function);
+    } else {
+        printf("%-36s %5dx%-5d %9.2f Mpixels/s  %s %s\n", name, w, h, mpixels,
+               chosen_blit, function);
+    }
+    fflush(stdout);
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+}
+
+static void
+Usage(const char *argv0)
+{
+    SDL_Log("Usage: %s [--csv] [--time ms] [--size WxH]... [--filter text]\n", argv0);
+    SDL_Log("  --csv          print comma separated results\n");
+    SDL_Log("  --time ms      time spent on each combination (default %u)\n", sample_ms);
+    SDL_Log("  --size WxH     blit size, may be repeated (default 64x64 and 1024x768)\n");
+    SDL_Log("  --filter text  only run combinations like \"RGB565->ARGB8888 blend\" containing text\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+    int widths[MAX_SIZES], heights[MAX_SIZES];
+    int num_sizes = 0;
+    int i, j, size;
+    int mode;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--csv") == 0) {
+            csv = SDL_TRUE;
+        } else if (SDL_strcmp(argv[i], "--time") == 0 && argv[i + 1]) {
+            sample_ms = (Uint32)SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && num_sizes < MAX_SIZES) {
+            if (SDL_sscanf(argv[++i], "%dx%d", &widths[num_sizes], &heights[num_sizes]) != 2 ||
+                widths[num_sizes] < 2 || heights[num_sizes] < 2) {
+                Usage(argv[0]);
+                return 1;
+            }
+            ++num_sizes;
+        } else if (SDL_strcmp(argv[i], "--filter") == 0 && argv[i + 1]) {
+            filter = argv[++i];
+        } else {
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+    if (num_sizes == 0) {
+        widths[0] = 64;
+        heights[0] = 64;
+        widths[1] = 1024;
+        heights[1] = 768;
+        num_sizes = 2;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    /* SDL_CalculateBlit() logs the blit function it picks at debug priority */
+    SDL_LogGetOutputFunction(&default_log, &default_log_userdata);
+    SDL_LogSetOutputFunction(LogOutput, NULL);
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_VIDEO, SDL_LOG_PRIORITY_DEBUG);
+
+    if (csv) {
+        printf("src,dst,mode,width,height,mpixels_per_sec,blitter,function\n");
+    }
+    for (size = 0; size < num_sizes; ++size) {
+        for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+            for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+                for (mode = 0; mode < NUM_MODES; ++mode) {
+                    RunBenchmark(src_formats[i], dst_formats[j], (BlitMode)mode,
+                                 widths[size], heights[size]);
+                }
+            }
+        }
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,218 @@
+/*
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Simple test of the SDL job system */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_JOBS        100000
+#define NUM_PARENTS     64
+#define NUM_CHILDREN    256
+#define NUM_STAGES      4
+
+static SDL_JobSystem *jobs;
+static SDL_atomic_t ran;
+static SDL_atomic_t children;
+static SDL_atomic_t stage;
+static SDL_atomic_t stage_errors;
+static int failures;
+
+static void SDLCALL
+CountJob(void *data)
+{
+    SDL_AtomicIncRef(&ran);
+}
+
+static void SDLCALL
+ChildJob(void *data)
+{
+    SDL_AtomicIncRef(&children);
+}
+
+static void SDLCALL
+ParentJob(void *data)
+{
+    SDL_atomic_t counter;
+    int i;
+
+    SDL_AtomicSet(&counter, 0);
+    for (i = 0; i < NUM_CHILDREN; ++i) {
+        SDL_SubmitJob(jobs, ChildJob, NULL, &counter);
+    }
+    /* Waiting from inside a job runs other jobs instead of blocking */
+    SDL_WaitJobs(jobs, &counter);
+    SDL_AtomicIncRef(&ran);
+}
+
+static void SDLCALL
+StageJob(void *data)
+{
+    int expected = (int)(size_t)data;
+
+    /* Every job of the previous stage must have finished */
+    if (SDL_AtomicGet(&stage) < expected * NUM_CHILDREN) {
+        SDL_AtomicIncRef(&stage_errors);
+    }
+    if (expected == 0) {
+        /* Give the later stages a chance to start too early */
+        SDL_Delay(1);
+    }
+    SDL_AtomicIncRef(&stage);
+}
+
+static void
+quit(int rc)
+{
+    if (jobs) {
+        SDL_DestroyJobSystem(jobs);
+    }
+    SDL_Quit();
+    exit(rc);
+}
+
+static void
+RunFlatTest(void)
+{
+    SDL_atomic_t counter;
+    Uint32 start;
+    int i;
+
+    SDL_AtomicSet(&ran, 0);
+    SDL_AtomicSet(&counter, 0);
+
+    start = SDL_GetTicks();
+    for (i = 0; i < NUM_JOBS; ++i) {
+        if (SDL_SubmitJob(jobs, CountJob, NULL, &counter) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_SubmitJob() failed: %s\n", SDL_GetError());
+            quit(1);
+        }
+    }
+    SDL_WaitJobs(jobs, &counter);
+
+    SDL_Log("Ran %d of %d jobs in %u ms\n", SDL_AtomicGet(&ran), NUM_JOBS, SDL_GetTicks() - start);
+    if (SDL_AtomicGet(&ran) != NUM_JOBS || SDL_AtomicGet(&counter) != 0) {
+        ++failures;
+    }
+}
+
+static void
+RunNestedTest(void)
+{
+    SDL_atomic_t counter;
+    int i;
+
+    SDL_AtomicSet(&ran, 0);
+    SDL_AtomicSet(&children, 0);
+    SDL_AtomicSet(&counter, 0);
+
+    for (i = 0; i < NUM_PARENTS; ++i) {
+        SDL_SubmitJob(jobs, ParentJob, NULL, &counter);
+    }
+    SDL_WaitJobs(jobs, &counter);
+
+    SDL_Log("Ran %d parent jobs and %d child jobs\n", SDL_AtomicGet(&ran), SDL_AtomicGet(&children));
+    if (SDL_AtomicGet(&ran) != NUM_PARENTS ||
+        SDL_AtomicGet(&children) != NUM_PARENTS * NUM_CHILDREN) {
+        ++failures;
+    }
+}
+
+static void
+RunDependencyTest(void)
+{
+    SDL_atomic_t counters[NUM_STAGES];
+    int i, j;
+
+    SDL_AtomicSet(&stage, 0);
+    SDL_AtomicSet(&stage_errors, 0);
+    for (i = 0; i < NUM_STAGES; ++i) {
+        SDL_AtomicSet(&counters[i], 0);
+    }
+
+    /* Each stage waits for every job of the one before it */
+    for (i = 0; i < NUM_STAGES; ++i) {
+        for (j = 0; j < NUM_CHILDREN; ++j) {
+            if (i == 0) {
+                SDL_SubmitJob(jobs, StageJob, (void *)(size_t)i, &counters[i]);
+            } else {
+                SDL_SubmitJobAfter(jobs, &counters[i - 1], StageJob, (void *)(size_t)i, &counters[i]);
+            }
+        }
+    }
+    SDL_WaitJobs(jobs, &counters[NUM_STAGES - 1]);
+
+    SDL_Log("Ran %d staged jobs, %d out of order\n", SDL_AtomicGet(&stage), SDL_AtomicGet(&stage_errors));
+    if (SDL_AtomicGet(&stage) != NUM_STAGES * NUM_CHILDREN ||
+        SDL_AtomicGet(&stage_errors) != 0) {
+        ++failures;
+    }
+}
+
+static void
+RunManualDependencyTest(void)
+{
+    SDL_atomic_t gate;
+    SDL_atomic_t counter;
+
+    SDL_AtomicSet(&ran, 0);
+    SDL_AtomicSet(&gate, 1);
+    SDL_AtomicSet(&counter, 0);
+
+    /* The application opens the gate itself, no job brings it to zero */
+    SDL_SubmitJobAfter(jobs, &gate, CountJob, NULL, &counter);
+    SDL_AtomicAdd(&gate, -1);
+    SDL_WaitJobs(jobs, &counter);
+
+    SDL_Log("Ran %d jobs after a manual dependency\n", SDL_AtomicGet(&ran));
+    if (SDL_AtomicGet(&ran) != 1) {
+        ++failures;
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    int num_threads = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_threads = SDL_atoi(argv[1]);
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    jobs = SDL_CreateJobSystem(num_threads);
+    if (!jobs) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create job system: %s\n", SDL_GetError());
+        quit(1);
+    }
+    SDL_Log("Created job system with %d worker threads\n", SDL_GetJobSystemThreadCount(jobs));
+
+    RunFlatTest();
+    RunNestedTest();
+    RunDependencyTest();
+    RunManualDependencyTest();
+
+    SDL_Log("%s\n", failures ? "FAILED" : "PASSED");
+    quit(failures ? 1 : 0);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */